@@ -0,0 +1,51 @@
+#ifndef CLP_CLAIMQUEUE_HPP
+#define CLP_CLAIMQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+namespace clp {
+/**
+ * Queue of work items shared by a pool of threads. Items are handed out one at a time in the order
+ * they were specified, so that threads which finish early keep taking work until the queue is
+ * exhausted.
+ *
+ * The queue doesn't own its items, so they must outlive it.
+ * @tparam Item
+ */
+template <typename Item>
+class ClaimQueue {
+public:
+    // Constructors
+    explicit ClaimQueue(std::span<Item const> items) : m_items{items} {}
+
+    // Methods
+    /**
+     * Claims the next unclaimed item.
+     * @return A pointer to the claimed item, or nullptr if the queue is exhausted or was aborted.
+     */
+    [[nodiscard]] auto try_claim() -> Item const* {
+        if (m_aborted.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        auto const idx{m_next_item_idx.fetch_add(1, std::memory_order_relaxed)};
+        if (idx >= m_items.size()) {
+            return nullptr;
+        }
+        return &m_items[idx];
+    }
+
+    /**
+     * Prevents any further items from being claimed.
+     */
+    void abort() { m_aborted.store(true, std::memory_order_relaxed); }
+
+private:
+    std::span<Item const> m_items;
+    std::atomic_size_t m_next_item_idx{0};
+    std::atomic_bool m_aborted{false};
+};
+}  // namespace clp
+
+#endif  // CLP_CLAIMQUEUE_HPP
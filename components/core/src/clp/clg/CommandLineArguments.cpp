@@ -60,6 +60,11 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             "file,f",
             po::value<string>(&m_search_strings_file_path)->value_name("FILE"),
             "Obtain wildcard strings from FILE, one per line"
+    )(
+            "threads",
+            po::value<size_t>(&m_num_threads)->value_name("NUM")->default_value(m_num_threads),
+            "Search each archive's segments using NUM threads. With more than one thread, results"
+            " from different segments are output in no particular order."
     );
 
     // Define output options
@@ -213,6 +218,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             throw invalid_argument("Wildcard string not specified or empty.");
         }
 
+        if (m_num_threads < 1) {
+            throw invalid_argument("threads must be non-zero.");
+        }
+
         // Validate timestamp range and compute m_search_begin_ts and m_search_end_ts
         if (parsed_command_line_options.count("teq")) {
             if (parsed_command_line_options.count("tgt") + parsed_command_line_options.count("tge")
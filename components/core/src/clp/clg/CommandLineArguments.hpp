@@ -46,6 +46,8 @@ public:
 
     epochtime_t get_search_end_ts() const { return m_search_end_ts; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
     std::optional<GlobalMetadataDBConfig> const& get_metadata_db_config() const {
         return m_metadata_db_config;
     }
@@ -62,6 +64,7 @@ private:
     std::string m_file_path;
     OutputMethod m_output_method;
     epochtime_t m_search_begin_ts, m_search_end_ts;
+    size_t m_num_threads{1};
     std::optional<GlobalMetadataDBConfig> m_metadata_db_config;
 };
 }  // namespace clp::clg
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <iostream>
 #include <set>
+#include <vector>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -17,6 +18,7 @@
 #include "../streaming_archive/Constants.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
+#include "segment_search.hpp"
 
 using clp::clg::CommandLineArguments;
 using clp::CommandLineArgumentsBase;
@@ -35,7 +37,6 @@ using clp::Query;
 using clp::segment_id_t;
 using clp::streaming_archive::MetadataDB;
 using clp::streaming_archive::reader::Archive;
-using clp::streaming_archive::reader::File;
 using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::TraceableException;
@@ -54,18 +55,6 @@ using std::vector;
  * @return true on success, false otherwise
  */
 static bool open_archive(string const& archive_path, Archive& archive_reader);
-/**
- * Opens a compressed file or logs any errors if it couldn't be opened
- * @param file_metadata_ix
- * @param archive
- * @param compressed_file
- * @return true on success, false otherwise
- */
-static bool open_compressed_file(
-        MetadataDB::FileIterator& file_metadata_ix,
-        Archive& archive,
-        File& compressed_file
-);
 /**
  * Searches all files referenced by a given database cursor
  * @param queries
@@ -271,7 +260,29 @@ static bool search(
 
         if (!no_queries_match) {
             size_t num_matches;
-            if (is_superseding_query) {
+            auto const num_threads = command_line_args.get_num_threads();
+            if (num_threads > 1) {
+                clp::clg::ParallelSearchConfig const config{
+                        .queries = queries,
+                        .archive = archive,
+                        .search_begin_ts = search_begin_ts,
+                        .search_end_ts = search_end_ts,
+                        .file_path = command_line_args.get_file_path(),
+                        .output_method = command_line_args.get_output_method(),
+                        .output_file = stdout
+                };
+                num_matches = clp::clg::search_segments_in_parallel(
+                        config,
+                        clp::clg::get_ids_of_segments_to_search(
+                                queries,
+                                archive,
+                                search_begin_ts,
+                                search_end_ts,
+                                command_line_args.get_file_path()
+                        ),
+                        num_threads
+                );
+            } else if (is_superseding_query) {
                 auto file_metadata_ix = archive.get_file_iterator(
                         search_begin_ts,
                         search_end_ts,
@@ -337,36 +348,12 @@ static bool search(
     return true;
 }
 
-static bool open_compressed_file(
-        MetadataDB::FileIterator& file_metadata_ix,
-        Archive& archive,
-        File& compressed_file
-) {
-    ErrorCode error_code = archive.open_file(compressed_file, file_metadata_ix);
-    if (clp::ErrorCode_Success == error_code) {
-        return true;
-    }
-    string orig_path;
-    file_metadata_ix.get_path(orig_path);
-    if (clp::ErrorCode_FileNotFound == error_code) {
-        SPDLOG_WARN("{} not found in archive", orig_path.c_str());
-    } else if (ErrorCode_errno == error_code) {
-        SPDLOG_ERROR("Failed to open {}, errno={}", orig_path.c_str(), errno);
-    } else {
-        SPDLOG_ERROR("Failed to open {}, error={}", orig_path.c_str(), error_code);
-    }
-    return false;
-}
-
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
         MetadataDB::FileIterator& file_metadata_ix
 ) {
-    size_t num_matches = 0;
-
-    File compressed_file;
     // Setup output method
     Grep::OutputFunc output_func;
     void* output_func_arg;
@@ -381,30 +368,17 @@ static size_t search_files(
             break;
         default:
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
-            return num_matches;
-    }
-
-    // Run all queries on each file
-    for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
-        if (open_compressed_file(file_metadata_ix, archive, compressed_file)) {
-            Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
-
-            for (auto const& query : queries) {
-                archive.reset_file_indices(compressed_file);
-                num_matches += Grep::search_and_output(
-                        query,
-                        SIZE_MAX,
-                        archive,
-                        compressed_file,
-                        output_func,
-                        output_func_arg
-                );
-            }
-        }
-        archive.close_file(compressed_file);
+            return 0;
     }
 
-    return num_matches;
+    return clp::clg::search_files(
+            queries,
+            output_func,
+            output_func_arg,
+            archive,
+            nullptr,
+            file_metadata_ix
+    );
 }
 
 static void print_result_text(
@@ -477,7 +451,7 @@ static void print_result_binary(
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -0,0 +1,398 @@
+#include "segment_search.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../ClaimQueue.hpp"
+#include "../ErrorCode.hpp"
+#include "../spdlog_with_specializations.hpp"
+#include "../streaming_archive/reader/File.hpp"
+#include "../streaming_archive/reader/Message.hpp"
+#include "../Thread.hpp"
+#include "../TraceableException.hpp"
+
+using clp::streaming_archive::MetadataDB;
+using clp::streaming_archive::reader::Archive;
+using clp::streaming_archive::reader::File;
+using clp::streaming_archive::reader::Message;
+using clp::streaming_archive::reader::SegmentManager;
+using std::string;
+using std::vector;
+
+namespace clp::clg {
+namespace {
+/**
+ * Queue of segments shared by all search threads.
+ */
+using SegmentQueue = ClaimQueue<segment_id_t>;
+
+/**
+ * Buffers the results found by a search thread so that they're written to the output file in large
+ * chunks, without being interleaved with the results of other threads.
+ */
+class ResultBuffer {
+public:
+    // Constructors
+    ResultBuffer(std::FILE* output_file, std::mutex& output_file_mutex)
+            : m_output_file{output_file},
+              m_output_file_mutex{output_file_mutex} {}
+
+    // Methods
+    std::string& get_buffer() { return m_buffer; }
+
+    /**
+     * Writes the buffered results to the output file if enough of them have been buffered.
+     */
+    void flush_if_full() {
+        if (m_buffer.size() >= cFlushThreshold) {
+            flush();
+        }
+    }
+
+    /**
+     * Writes the buffered results to the output file.
+     */
+    void flush();
+
+private:
+    // Constants
+    static constexpr size_t cFlushThreshold{64 * 1024};
+
+    // Variables
+    std::FILE* m_output_file;
+    std::mutex& m_output_file_mutex;
+    std::string m_buffer;
+};
+
+/**
+ * State shared by all the threads searching an archive in parallel.
+ */
+struct ParallelSearchContext {
+    ParallelSearchConfig const& config;
+    Grep::OutputFunc output_func;
+    std::mutex output_file_mutex;
+};
+
+/**
+ * Thread that searches the files in segments claimed from a `SegmentQueue`. Each thread reads the
+ * archive's files through its own segment manager and metadata DB, while sharing the archive's
+ * dictionaries with the other threads.
+ */
+class SegmentSearchThread : public Thread {
+public:
+    // Constructors
+    SegmentSearchThread(ParallelSearchContext& context, SegmentQueue& queue)
+            : m_context{context},
+              m_queue{queue} {}
+
+    // Methods
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+    [[nodiscard]] auto get_num_matches() const -> size_t { return m_num_matches; }
+
+protected:
+    // Methods implementing `Thread`
+    void thread_method() override;
+
+private:
+    ParallelSearchContext& m_context;
+    SegmentQueue& m_queue;
+    size_t m_num_matches{0};
+    bool m_succeeded{true};
+};
+
+/**
+ * Opens a compressed file or logs any errors if it couldn't be opened
+ * @param file_metadata_ix
+ * @param archive
+ * @param segment_manager The segment manager to read the file through, or nullptr to use the
+ * archive's own
+ * @param compressed_file
+ * @return true on success, false otherwise
+ */
+bool open_compressed_file(
+        MetadataDB::FileIterator& file_metadata_ix,
+        Archive& archive,
+        SegmentManager* segment_manager,
+        File& compressed_file
+);
+
+/**
+ * Buffers search result in text format
+ * @param orig_file_path
+ * @param compressed_msg
+ * @param decompressed_msg
+ * @param custom_arg The `ResultBuffer` to buffer the result in
+ */
+void buffer_result_text(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+);
+
+/**
+ * Buffers search result in binary format
+ * @param orig_file_path
+ * @param compressed_msg
+ * @param decompressed_msg
+ * @param custom_arg The `ResultBuffer` to buffer the result in
+ */
+void buffer_result_binary(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+);
+
+void SegmentSearchThread::thread_method() {
+    try {
+        auto const& config{m_context.config};
+        // Queries are modified as they're made relevant to each segment, so each thread needs its
+        // own copy
+        auto queries = config.queries;
+
+        MetadataDB metadata_db;
+        config.archive.open_metadata_db(metadata_db);
+        SegmentManager segment_manager;
+        config.archive.open_segment_manager(segment_manager);
+
+        ResultBuffer result_buffer{config.output_file, m_context.output_file_mutex};
+        for (auto const* segment_id = m_queue.try_claim(); nullptr != segment_id;
+             segment_id = m_queue.try_claim())
+        {
+            auto file_metadata_ix = metadata_db.get_file_iterator(
+                    config.search_begin_ts,
+                    config.search_end_ts,
+                    config.file_path,
+                    "",
+                    true,
+                    *segment_id,
+                    false
+            );
+            m_num_matches += search_files(
+                    queries,
+                    m_context.output_func,
+                    &result_buffer,
+                    config.archive,
+                    &segment_manager,
+                    *file_metadata_ix
+            );
+        }
+        result_buffer.flush();
+
+        segment_manager.close();
+        metadata_db.close();
+    } catch (TraceableException& e) {
+        SPDLOG_ERROR(
+                "Search thread failed: {}:{} {}, error_code={}",
+                e.get_filename(),
+                e.get_line_number(),
+                e.what(),
+                e.get_error_code()
+        );
+        m_queue.abort();
+        m_succeeded = false;
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Search thread failed: Unexpected exception - {}", e.what());
+        m_queue.abort();
+        m_succeeded = false;
+    }
+}
+
+void ResultBuffer::flush() {
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    size_t num_elems_written;
+    {
+        std::lock_guard<std::mutex> const lock{m_output_file_mutex};
+        num_elems_written = fwrite(m_buffer.data(), sizeof(char), m_buffer.size(), m_output_file);
+    }
+    if (num_elems_written < m_buffer.size()) {
+        SPDLOG_ERROR("Failed to write results, errno={}", errno);
+    }
+    m_buffer.clear();
+}
+
+bool open_compressed_file(
+        MetadataDB::FileIterator& file_metadata_ix,
+        Archive& archive,
+        SegmentManager* segment_manager,
+        File& compressed_file
+) {
+    ErrorCode error_code
+            = nullptr == segment_manager
+                      ? archive.open_file(compressed_file, file_metadata_ix)
+                      : archive.open_file(compressed_file, file_metadata_ix, *segment_manager);
+    if (ErrorCode_Success == error_code) {
+        return true;
+    }
+    string orig_path;
+    file_metadata_ix.get_path(orig_path);
+    if (ErrorCode_FileNotFound == error_code) {
+        SPDLOG_WARN("{} not found in archive", orig_path.c_str());
+    } else if (ErrorCode_errno == error_code) {
+        SPDLOG_ERROR("Failed to open {}, errno={}", orig_path.c_str(), errno);
+    } else {
+        SPDLOG_ERROR("Failed to open {}, error={}", orig_path.c_str(), error_code);
+    }
+    return false;
+}
+
+void buffer_result_text(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+) {
+    auto& result_buffer = *static_cast<ResultBuffer*>(custom_arg);
+    auto& buffer = result_buffer.get_buffer();
+    buffer += orig_file_path;
+    buffer += ':';
+    buffer += decompressed_msg;
+    result_buffer.flush_if_full();
+}
+
+void buffer_result_binary(
+        string const& orig_file_path,
+        Message const& compressed_msg,
+        string const& decompressed_msg,
+        void* custom_arg
+) {
+    auto& result_buffer = *static_cast<ResultBuffer*>(custom_arg);
+    auto& buffer = result_buffer.get_buffer();
+    auto append_value = [&buffer](auto const value) {
+        buffer.append(reinterpret_cast<char const*>(&value), sizeof(value));
+    };
+
+    // Use the same layout as clg's print_result_binary
+    append_value(orig_file_path.length());
+    buffer += orig_file_path;
+    append_value(compressed_msg.get_ts_in_milli());
+    append_value(compressed_msg.get_logtype_id());
+    append_value(decompressed_msg.length());
+    buffer += decompressed_msg;
+    result_buffer.flush_if_full();
+}
+}  // namespace
+
+size_t search_files(
+        vector<Query>& queries,
+        Grep::OutputFunc output_func,
+        void* output_func_arg,
+        Archive& archive,
+        SegmentManager* segment_manager,
+        MetadataDB::FileIterator& file_metadata_ix
+) {
+    size_t num_matches = 0;
+
+    File compressed_file;
+
+    // Run all queries on each file
+    for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
+        if (open_compressed_file(file_metadata_ix, archive, segment_manager, compressed_file)) {
+            Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
+
+            for (auto const& query : queries) {
+                archive.reset_file_indices(compressed_file);
+                num_matches += Grep::search_and_output(
+                        query,
+                        SIZE_MAX,
+                        archive,
+                        compressed_file,
+                        output_func,
+                        output_func_arg
+                );
+            }
+        }
+        archive.close_file(compressed_file);
+    }
+
+    return num_matches;
+}
+
+vector<segment_id_t> get_ids_of_segments_to_search(
+        vector<Query> const& queries,
+        Archive& archive,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        string const& file_path
+) {
+    std::set<segment_id_t> segment_ids;
+    if (1 == queries.size() && false == queries.front().contains_sub_queries()) {
+        // Every segment containing a file in the time range may contain results
+        auto file_metadata_ix_ptr
+                = archive.get_file_iterator(search_begin_ts, search_end_ts, file_path, false);
+        for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
+             file_metadata_ix.next())
+        {
+            segment_ids.insert(file_metadata_ix.get_segment_id());
+        }
+    } else {
+        segment_ids.insert(cInvalidSegmentId);
+        for (auto const& query : queries) {
+            for (auto const& sub_query : query.get_sub_queries()) {
+                auto const& ids_of_matching_segments = sub_query.get_ids_of_matching_segments();
+                segment_ids.insert(
+                        ids_of_matching_segments.cbegin(),
+                        ids_of_matching_segments.cend()
+                );
+            }
+        }
+    }
+    return {segment_ids.cbegin(), segment_ids.cend()};
+}
+
+size_t search_segments_in_parallel(
+        ParallelSearchConfig const& config,
+        vector<segment_id_t> const& segment_ids,
+        size_t num_threads
+) {
+    ParallelSearchContext context{
+            .config = config,
+            .output_func = CommandLineArguments::OutputMethod::StdoutBinary == config.output_method
+                                   ? buffer_result_binary
+                                   : buffer_result_text
+    };
+    SegmentQueue queue{segment_ids};
+    num_threads = std::min(num_threads, segment_ids.size());
+
+    vector<std::unique_ptr<SegmentSearchThread>> threads;
+    threads.reserve(num_threads);
+    try {
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back(std::make_unique<SegmentSearchThread>(context, queue));
+            threads.back()->start();
+        }
+    } catch (...) {
+        // Stop the started threads from claiming more work before they're joined on destruction
+        queue.abort();
+        throw;
+    }
+
+    size_t num_matches = 0;
+    bool all_threads_succeeded = true;
+    for (auto& thread : threads) {
+        thread->join();
+        num_matches += thread->get_num_matches();
+        if (false == thread->succeeded()) {
+            all_threads_succeeded = false;
+        }
+    }
+    if (false == all_threads_succeeded) {
+        throw Thread::OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+
+    return num_matches;
+}
+}  // namespace clp::clg
@@ -0,0 +1,92 @@
+#ifndef CLP_CLG_SEGMENT_SEARCH_HPP
+#define CLP_CLG_SEGMENT_SEARCH_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../Defs.h"
+#include "../Grep.hpp"
+#include "../Query.hpp"
+#include "../streaming_archive/MetadataDB.hpp"
+#include "../streaming_archive/reader/Archive.hpp"
+#include "../streaming_archive/reader/SegmentManager.hpp"
+#include "CommandLineArguments.hpp"
+
+namespace clp::clg {
+/**
+ * Options for searching an archive's segments in parallel.
+ */
+struct ParallelSearchConfig {
+    std::vector<Query> const& queries;
+    streaming_archive::reader::Archive& archive;
+    epochtime_t search_begin_ts;
+    epochtime_t search_end_ts;
+    std::string const& file_path;
+    CommandLineArguments::OutputMethod output_method;
+    // Where results are written, in the same format as the serial search writes them to stdout
+    std::FILE* output_file;
+};
+
+/**
+ * Searches all files referenced by a given database cursor, outputting results with the given
+ * output function
+ * @param queries
+ * @param output_func
+ * @param output_func_arg
+ * @param archive
+ * @param segment_manager The segment manager to read the files through, or nullptr to use the
+ * archive's own
+ * @param file_metadata_ix
+ * @return The total number of matches found across all files
+ */
+size_t search_files(
+        std::vector<Query>& queries,
+        Grep::OutputFunc output_func,
+        void* output_func_arg,
+        streaming_archive::reader::Archive& archive,
+        streaming_archive::reader::SegmentManager* segment_manager,
+        streaming_archive::MetadataDB::FileIterator& file_metadata_ix
+);
+
+/**
+ * Gets the IDs of the segments that may contain results for the given queries:
+ * - for a single superseding query (one without subqueries), every segment containing a file in
+ *   the time range;
+ * - otherwise, the segments that the subqueries' matching segments were calculated to be in, plus
+ *   `cInvalidSegmentId` for the files that aren't in any segment.
+ * @param queries
+ * @param archive
+ * @param search_begin_ts
+ * @param search_end_ts
+ * @param file_path
+ * @return The IDs in ascending order
+ */
+std::vector<segment_id_t> get_ids_of_segments_to_search(
+        std::vector<Query> const& queries,
+        streaming_archive::reader::Archive& archive,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        std::string const& file_path
+);
+
+/**
+ * Searches the files in the given segments using multiple threads. Each thread buffers its results
+ * and writes them to the output file in large chunks, so results are never interleaved, but
+ * results from different segments are output in no particular order.
+ * @param config
+ * @param segment_ids
+ * @param num_threads
+ * @return The total number of matches found across all files
+ * @throw clp::Thread::OperationFailed if a thread couldn't be started
+ * @throw TraceableException if any thread failed
+ */
+size_t search_segments_in_parallel(
+        ParallelSearchConfig const& config,
+        std::vector<segment_id_t> const& segment_ids,
+        size_t num_threads
+);
+}  // namespace clp::clg
+
+#endif  // CLP_CLG_SEGMENT_SEARCH_HPP
@@ -347,6 +347,21 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("LEVEL")
                             ->default_value(m_compression_level),
                     "1 (fast/low compression) to 19 (slow/high compression)"
+            )(
+                    "segment-frame-size",
+                    po::value<size_t>(&m_segment_frame_size)
+                            ->value_name("SIZE")
+                            ->default_value(m_segment_frame_size),
+                    "Maximum uncompressed size (B) of each independently decompressible frame in a"
+                    " segment, allowing files to be read without decompressing the segment from"
+                    " its beginning. 0 compresses each segment as a single frame."
+            )(
+                    "compression-threads",
+                    po::value<size_t>(&m_num_compression_threads)
+                            ->value_name("NUM_THREADS")
+                            ->default_value(m_num_compression_threads),
+                    "Number of threads used to compress input files in parallel. Each thread"
+                    " writes its own archives."
             )(
                     "print-archive-stats-progress",
                     po::bool_switch(&m_print_archive_stats_progress),
@@ -416,6 +431,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 throw invalid_argument("target-data-size-of-dictionaries must be non-zero.");
             }
 
+            if (m_num_compression_threads < 1) {
+                throw invalid_argument("compression-threads must be non-zero.");
+            }
+
             if (false == m_path_prefix_to_remove.empty()) {
                 if (false == boost::filesystem::exists(m_path_prefix_to_remove)) {
                     throw invalid_argument("Specified prefix to remove does not exist.");
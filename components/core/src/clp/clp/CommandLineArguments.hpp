@@ -62,6 +62,10 @@ public:
 
     int get_compression_level() const { return m_compression_level; }
 
+    size_t get_segment_frame_size() const { return m_segment_frame_size; }
+
+    size_t get_num_compression_threads() const { return m_num_compression_threads; }
+
     Command get_command() const { return m_command; }
 
     std::string const& get_archives_dir() const { return m_archives_dir; }
@@ -100,6 +104,8 @@ private:
     size_t m_target_segment_uncompressed_size;
     size_t m_target_data_size_of_dictionaries;
     int m_compression_level;
+    size_t m_segment_frame_size{0};
+    size_t m_num_compression_threads{1};
     Command m_command;
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
@@ -1,16 +1,24 @@
 #include "compression.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <span>
 
 #include <archive_entry.h>
 #include <boost/filesystem/operations.hpp>
 #include <boost/uuid/random_generator.hpp>
 
+#include "../ClaimQueue.hpp"
 #include "../global_metadata_db_utils.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/writer/Archive.hpp"
 #include "../streaming_archive/writer/utils.hpp"
+#include "../Thread.hpp"
+#include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
 #include "utils.hpp"
@@ -26,33 +34,300 @@ using std::unique_ptr;
 using std::vector;
 
 namespace clp::clp {
-// Local prototypes
+namespace {
+/**
+ * Files that must be compressed into the same archive: either a single ungrouped file, or all the
+ * grouped files with the same group ID.
+ */
+using FileBatch = std::span<FileToCompress const>;
+
+/**
+ * Queue of file batches shared by all compression threads.
+ */
+using FileBatchQueue = ClaimQueue<FileBatch>;
+
+/**
+ * State shared by every batch compressed in one call to `compress`.
+ */
+struct CompressionContext {
+    CommandLineArguments const& command_line_args;
+    size_t target_encoded_file_size;
+    bool use_heuristic;
+    size_t num_files_to_compress;
+    std::atomic_size_t num_files_compressed{0};
+};
+
+/**
+ * Thread that compresses file batches claimed from a `FileBatchQueue` into its own archives. The
+ * thread's first archive is only created once the thread has claimed its first batch, so that no
+ * empty archives are written.
+ */
+class CompressionThread : public Thread {
+public:
+    // Constructors
+    CompressionThread(
+            CompressionContext& context,
+            streaming_archive::writer::Archive::UserConfig const& archive_user_config,
+            FileBatchQueue& queue
+    )
+            : m_context{context},
+              m_archive_user_config{archive_user_config},
+              m_queue{queue} {}
+
+    // Methods
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+protected:
+    // Methods implementing `Thread`
+    void thread_method() override;
+
+private:
+    CompressionContext& m_context;
+    streaming_archive::writer::Archive::UserConfig m_archive_user_config;
+    FileBatchQueue& m_queue;
+    bool m_succeeded{true};
+};
+
 /**
  * Comparator to sort files based on their group ID
  * @param lhs
  * @param rhs
  * @return true if lhs' group ID is less than rhs' group ID, false otherwise
  */
-static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
+bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
 /**
  * Comparator to sort files based on their last write time
  * @param lhs
  * @param rhs
  * @return true if lhs' last write time is greater than rhs' last write time, false otherwise
  */
-static bool
-file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
+bool file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
+
+/**
+ * Splits the files to compress into batches, in the order they should be compressed.
+ * @param files_to_compress
+ * @param grouped_files_to_compress Grouped files, sorted by their group ID
+ * @return The batches
+ */
+auto create_file_batches(
+        vector<FileToCompress> const& files_to_compress,
+        vector<FileToCompress> const& grouped_files_to_compress
+) -> vector<FileBatch>;
+
+/**
+ * Compresses a batch of files into the given archive, splitting the archive whenever its
+ * dictionaries reach their target size.
+ * @param context
+ * @param batch
+ * @param file_compressor
+ * @param archive_user_config
+ * @param archive_writer
+ * @return true if all files were compressed successfully, false otherwise
+ */
+auto compress_batch(
+        CompressionContext& context,
+        FileBatch const& batch,
+        FileCompressor& file_compressor,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+) -> bool;
+
+/**
+ * Compresses the given batch and every batch claimed from the given queue afterwards into the
+ * given archive.
+ * @param context
+ * @param first_batch
+ * @param queue
+ * @param file_compressor
+ * @param archive_user_config
+ * @param archive_writer
+ * @return true if all files were compressed successfully, false otherwise
+ */
+auto compress_claimed_batches(
+        CompressionContext& context,
+        FileBatch const& first_batch,
+        FileBatchQueue& queue,
+        FileCompressor& file_compressor,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+) -> bool;
+
+/**
+ * Opens an archive writer with the given config.
+ * @param context
+ * @param archive_user_config
+ * @param archive_writer
+ */
+void open_archive(
+        CompressionContext const& context,
+        streaming_archive::writer::Archive::UserConfig const& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+);
+
+/**
+ * @param context
+ * @return A reader parser for the schema file, or nullptr if heuristics are used to parse logs
+ */
+auto create_reader_parser(CompressionContext const& context)
+        -> std::unique_ptr<log_surgeon::ReaderParser>;
+
+void CompressionThread::thread_method() {
+    auto const* batch{m_queue.try_claim()};
+    if (nullptr == batch) {
+        return;
+    }
+
+    try {
+        auto uuid_generator = boost::uuids::random_generator();
+        m_archive_user_config.id = uuid_generator();
+        m_archive_user_config.creator_id = uuid_generator();
+        m_archive_user_config.creation_num = 0;
+
+        streaming_archive::writer::Archive archive_writer;
+        open_archive(m_context, m_archive_user_config, archive_writer);
+        FileCompressor file_compressor(uuid_generator, create_reader_parser(m_context));
+        m_succeeded = compress_claimed_batches(
+                m_context,
+                *batch,
+                m_queue,
+                file_compressor,
+                m_archive_user_config,
+                archive_writer
+        );
+        archive_writer.close();
+    } catch (TraceableException& e) {
+        SPDLOG_ERROR(
+                "Compression thread failed: {}:{} {}, error_code={}",
+                e.get_filename(),
+                e.get_line_number(),
+                e.what(),
+                e.get_error_code()
+        );
+        m_queue.abort();
+        m_succeeded = false;
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Compression thread failed: Unexpected exception - {}", e.what());
+        m_queue.abort();
+        m_succeeded = false;
+    }
+}
 
-static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
+bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
     return lhs.get_group_id() < rhs.get_group_id();
 }
 
-static bool
-file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
+bool file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
     return boost::filesystem::last_write_time(lhs.get_path())
            > boost::filesystem::last_write_time(rhs.get_path());
 }
 
+auto create_file_batches(
+        vector<FileToCompress> const& files_to_compress,
+        vector<FileToCompress> const& grouped_files_to_compress
+) -> vector<FileBatch> {
+    vector<FileBatch> batches;
+    FileBatch const files{files_to_compress};
+    for (size_t i = 0; i < files.size(); ++i) {
+        batches.emplace_back(files.subspan(i, 1));
+    }
+
+    FileBatch const grouped_files{grouped_files_to_compress};
+    size_t group_begin_ix = 0;
+    for (size_t i = 1; i <= grouped_files.size(); ++i) {
+        if (i < grouped_files.size()
+            && grouped_files[i].get_group_id() == grouped_files[group_begin_ix].get_group_id())
+        {
+            continue;
+        }
+        batches.emplace_back(grouped_files.subspan(group_begin_ix, i - group_begin_ix));
+        group_begin_ix = i;
+    }
+
+    return batches;
+}
+
+auto compress_batch(
+        CompressionContext& context,
+        FileBatch const& batch,
+        FileCompressor& file_compressor,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+) -> bool {
+    auto const& command_line_args = context.command_line_args;
+    auto target_data_size_of_dictionaries
+            = command_line_args.get_target_data_size_of_dictionaries();
+
+    bool all_files_compressed_successfully = true;
+    for (auto const& file_to_compress : batch) {
+        // NOTE: A group's files are only split across archives if the group's dictionaries exceed
+        // the target size
+        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
+            split_archive(archive_user_config, archive_writer);
+        }
+        if (false
+            == file_compressor.compress_file(
+                    target_data_size_of_dictionaries,
+                    archive_user_config,
+                    context.target_encoded_file_size,
+                    file_to_compress,
+                    archive_writer,
+                    context.use_heuristic
+            ))
+        {
+            all_files_compressed_successfully = false;
+        }
+        if (command_line_args.show_progress()) {
+            auto const num_files_compressed = ++context.num_files_compressed;
+            cerr << "Compressed " << num_files_compressed << '/' << context.num_files_to_compress
+                 << " files" << '\r';
+        }
+    }
+    return all_files_compressed_successfully;
+}
+
+auto compress_claimed_batches(
+        CompressionContext& context,
+        FileBatch const& first_batch,
+        FileBatchQueue& queue,
+        FileCompressor& file_compressor,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+) -> bool {
+    bool all_files_compressed_successfully = true;
+    for (auto const* batch = &first_batch; nullptr != batch; batch = queue.try_claim()) {
+        if (false
+            == compress_batch(context, *batch, file_compressor, archive_user_config, archive_writer
+            ))
+        {
+            all_files_compressed_successfully = false;
+        }
+    }
+    return all_files_compressed_successfully;
+}
+
+void open_archive(
+        CompressionContext const& context,
+        streaming_archive::writer::Archive::UserConfig const& archive_user_config,
+        streaming_archive::writer::Archive& archive_writer
+) {
+    // Set schema file if specified by user
+    if (false == context.use_heuristic) {
+        archive_writer.m_schema_file_path = context.command_line_args.get_schema_file_path();
+    }
+    archive_writer.open(archive_user_config);
+}
+
+auto create_reader_parser(CompressionContext const& context)
+        -> std::unique_ptr<log_surgeon::ReaderParser> {
+    if (context.use_heuristic) {
+        return nullptr;
+    }
+    return make_unique<log_surgeon::ReaderParser>(
+            context.command_line_args.get_schema_file_path()
+    );
+}
+}  // namespace
+
 bool compress(
         CommandLineArguments& command_line_args,
         vector<FileToCompress>& files_to_compress,
@@ -76,9 +351,32 @@ bool compress(
     if (nullptr == global_metadata_db) {
         return false;
     }
+    std::mutex global_metadata_db_mutex;
 
     auto uuid_generator = boost::uuids::random_generator();
 
+    if (command_line_args.sort_input_files()) {
+        sort(files_to_compress.begin(),
+             files_to_compress.end(),
+             file_gt_last_write_time_comparator);
+    }
+    // Sort files by group ID to avoid spreading groups over multiple segments
+    sort(grouped_files_to_compress.begin(),
+         grouped_files_to_compress.end(),
+         file_group_id_comparator);
+    auto const batches = create_file_batches(files_to_compress, grouped_files_to_compress);
+    auto const num_threads = std::max<size_t>(
+            std::min(command_line_args.get_num_compression_threads(), batches.size()),
+            1
+    );
+
+    CompressionContext context{
+            .command_line_args = command_line_args,
+            .target_encoded_file_size = target_encoded_file_size,
+            .use_heuristic = use_heuristic,
+            .num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size()
+    };
+
     // Setup config
     streaming_archive::writer::Archive::UserConfig archive_user_config;
     archive_user_config.id = uuid_generator();
@@ -87,87 +385,55 @@ bool compress(
     archive_user_config.target_segment_uncompressed_size
             = command_line_args.get_target_segment_uncompressed_size();
     archive_user_config.compression_level = command_line_args.get_compression_level();
+    archive_user_config.segment_frame_size = command_line_args.get_segment_frame_size();
     archive_user_config.output_dir = command_line_args.get_output_dir();
     archive_user_config.global_metadata_db = global_metadata_db.get();
+    if (num_threads > 1) {
+        archive_user_config.global_metadata_db_mutex = &global_metadata_db_mutex;
+    }
     archive_user_config.print_archive_stats_progress
             = command_line_args.print_archive_stats_progress();
 
     // Open Archive
     streaming_archive::writer::Archive archive_writer;
-    // Set schema file if specified by user
-    if (false == command_line_args.get_use_heuristic()) {
-        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
-    }
-    // Open archive
-    archive_writer.open(archive_user_config);
+    open_archive(context, archive_user_config, archive_writer);
 
     archive_writer.add_empty_directories(empty_directory_paths);
 
-    bool all_files_compressed_successfully = true;
     FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
-    auto target_data_size_of_dictionaries
-            = command_line_args.get_target_data_size_of_dictionaries();
 
-    // Compress all files
-    size_t num_files_compressed = 0;
-    size_t num_files_to_compress = 0;
-    if (command_line_args.show_progress()) {
-        num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
+    // This thread acts as one of the compression threads, so we only need to spawn the remainder.
+    FileBatchQueue queue{batches};
+    vector<unique_ptr<CompressionThread>> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(make_unique<CompressionThread>(context, archive_user_config, queue));
+        threads.back()->start();
     }
-    if (command_line_args.sort_input_files()) {
-        sort(files_to_compress.begin(),
-             files_to_compress.end(),
-             file_gt_last_write_time_comparator);
-    }
-    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
+
+    bool all_files_compressed_successfully = true;
+    try {
+        if (auto const* batch = queue.try_claim(); nullptr != batch) {
+            all_files_compressed_successfully = compress_claimed_batches(
+                    context,
+                    *batch,
+                    queue,
+                    file_compressor,
                     archive_user_config,
-                    target_encoded_file_size,
-                    *it,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
-            all_files_compressed_successfully = false;
-        }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
+                    archive_writer
+            );
         }
+    } catch (...) {
+        // Stop the other threads from claiming more work before they're joined on destruction
+        queue.abort();
+        throw;
     }
 
-    // Sort files by group ID to avoid spreading groups over multiple segments
-    sort(grouped_files_to_compress.begin(),
-         grouped_files_to_compress.end(),
-         file_group_id_comparator);
-    // Compress grouped files
-    for (auto const& file_to_compress : grouped_files_to_compress) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    file_to_compress,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
+    for (auto& thread : threads) {
+        thread->join();
+        if (false == thread->succeeded()) {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
     }
 
     archive_writer.close();
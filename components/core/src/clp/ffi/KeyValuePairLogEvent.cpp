@@ -17,6 +17,7 @@
 
 #include "../ir/EncodedTextAst.hpp"
 #include "../time_types.hpp"
+#include "NodeIdValuePairs.hpp"
 #include "SchemaTree.hpp"
 #include "Value.hpp"
 
@@ -474,12 +475,14 @@ auto serialize_node_id_value_pairs_to_json(
         }
         auto const child_schema_tree_node_id{top.get_next_child_schema_tree_node()};
         auto const& child_schema_tree_node{schema_tree.get_node(child_schema_tree_node_id)};
-        if (node_id_value_pairs.contains(child_schema_tree_node_id)) {
+        if (auto const pair_it{node_id_value_pairs.find(child_schema_tree_node_id)};
+            node_id_value_pairs.end() != pair_it)
+        {
             // Handle leaf node
             if (false
                 == insert_kv_pair_into_json_obj(
                         child_schema_tree_node,
-                        node_id_value_pairs.at(child_schema_tree_node_id),
+                        pair_it->second,
                         top.get_json_obj()
                 ))
             {
@@ -3,7 +3,6 @@
 
 #include <memory>
 #include <optional>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -11,6 +10,7 @@
 #include <ystdlib/error_handling/Result.hpp>
 
 #include "../time_types.hpp"
+#include "NodeIdValuePairs.hpp"
 #include "SchemaTree.hpp"
 #include "Value.hpp"
 
@@ -28,7 +28,7 @@ namespace clp::ffi {
 class KeyValuePairLogEvent {
 public:
     // Types
-    using NodeIdValuePairs = std::unordered_map<SchemaTree::Node::id_t, std::optional<Value>>;
+    using NodeIdValuePairs = ffi::NodeIdValuePairs;
 
     // Factory functions
     /**
@@ -0,0 +1,136 @@
+#ifndef CLP_FFI_NODEIDVALUEPAIRS_HPP
+#define CLP_FFI_NODEIDVALUEPAIRS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SchemaTree.hpp"
+#include "Value.hpp"
+
+namespace clp::ffi {
+/**
+ * A flat collection of schema-tree-node-ID & value pairs, sorted by node ID, where each node ID
+ * appears at most once.
+ *
+ * The pairs are stored contiguously in a single vector so that building a collection costs at most
+ * one allocation (none if the collection is reused after `clear`, or `reserve` is called with an
+ * accurate size), and consumers iterate over the pairs linearly. Lookups use a binary search.
+ *
+ * Inserting pairs in increasing node-ID order (the common case when deserializing an IR stream,
+ * since node IDs are assigned in the order keys are first seen) appends to the vector; inserting
+ * out of order shifts the pairs that follow the insertion point.
+ */
+class NodeIdValuePairs {
+public:
+    // Types
+    using value_type = std::pair<SchemaTree::Node::id_t, std::optional<Value>>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    // Constructors
+    NodeIdValuePairs() = default;
+
+    /**
+     * @param pairs Pairs to insert. If a node ID appears more than once, only its first pair is
+     * inserted.
+     */
+    NodeIdValuePairs(std::initializer_list<value_type> pairs) {
+        m_pairs.reserve(pairs.size());
+        for (auto const& [node_id, value] : pairs) {
+            emplace(node_id, value);
+        }
+    }
+
+    // Methods
+    [[nodiscard]] auto begin() const -> const_iterator { return m_pairs.cbegin(); }
+
+    [[nodiscard]] auto end() const -> const_iterator { return m_pairs.cend(); }
+
+    [[nodiscard]] auto size() const -> size_t { return m_pairs.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_pairs.empty(); }
+
+    /**
+     * Removes all pairs while keeping the underlying storage for reuse.
+     */
+    auto clear() -> void { m_pairs.clear(); }
+
+    auto reserve(size_t num_pairs) -> void { m_pairs.reserve(num_pairs); }
+
+    /**
+     * Inserts a pair unless the collection already contains a pair with the given node ID.
+     * @tparam ValueType
+     * @param node_id
+     * @param value Argument to construct the pair's `std::optional<Value>` from.
+     * @return A pair:
+     * - An iterator to the pair with the given node ID.
+     * - Whether the pair was inserted.
+     */
+    template <typename ValueType>
+    auto emplace(SchemaTree::Node::id_t node_id, ValueType&& value)
+            -> std::pair<const_iterator, bool> {
+        if (m_pairs.empty() || m_pairs.back().first < node_id) {
+            m_pairs.emplace_back(node_id, std::forward<ValueType>(value));
+            return {m_pairs.cend() - 1, true};
+        }
+        auto const it{lower_bound(node_id)};
+        if (it->first == node_id) {
+            return {it, false};
+        }
+        return {m_pairs.emplace(it, node_id, std::forward<ValueType>(value)), true};
+    }
+
+    /**
+     * @param node_id
+     * @return An iterator to the pair with the given node ID, or `end()` if there's no such pair.
+     */
+    [[nodiscard]] auto find(SchemaTree::Node::id_t node_id) const -> const_iterator {
+        auto const it{lower_bound(node_id)};
+        if (m_pairs.cend() == it || it->first != node_id) {
+            return m_pairs.cend();
+        }
+        return it;
+    }
+
+    [[nodiscard]] auto contains(SchemaTree::Node::id_t node_id) const -> bool {
+        return m_pairs.cend() != find(node_id);
+    }
+
+    /**
+     * @param node_id
+     * @return The value of the pair with the given node ID.
+     * @throw std::out_of_range if there's no pair with the given node ID.
+     */
+    [[nodiscard]] auto at(SchemaTree::Node::id_t node_id) const -> std::optional<Value> const& {
+        auto const it{find(node_id)};
+        if (m_pairs.cend() == it) {
+            throw std::out_of_range("Node ID not found in node-ID-value pairs.");
+        }
+        return it->second;
+    }
+
+private:
+    // Methods
+    /**
+     * @param node_id
+     * @return An iterator to the first pair whose node ID isn't less than the given node ID.
+     */
+    [[nodiscard]] auto lower_bound(SchemaTree::Node::id_t node_id) const -> const_iterator {
+        return std::lower_bound(
+                m_pairs.cbegin(),
+                m_pairs.cend(),
+                node_id,
+                [](value_type const& pair, SchemaTree::Node::id_t id) { return pair.first < id; }
+        );
+    }
+
+    // Variables
+    std::vector<value_type> m_pairs;
+};
+}  // namespace clp::ffi
+
+#endif  // CLP_FFI_NODEIDVALUEPAIRS_HPP
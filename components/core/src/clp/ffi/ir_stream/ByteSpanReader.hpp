@@ -0,0 +1,117 @@
+#ifndef CLP_FFI_IR_STREAM_BYTESPANREADER_HPP
+#define CLP_FFI_IR_STREAM_BYTESPANREADER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+
+#include "../../ErrorCode.hpp"
+#include "../../ReaderInterface.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * A reader over a contiguous span of IR bytes that are already in memory (e.g., a decompressed
+ * buffer or a memory-mapped file).
+ *
+ * The reader provides the subset of `ReaderInterface`'s methods that the deserialization methods
+ * use, but none of them are virtual, so deserialization methods instantiated for this reader decode
+ * the IR with inlined bounds checks and pointer arithmetic.
+ *
+ * If a read runs past the end of the span, the reader is marked as truncated so that callers can
+ * distinguish an IR unit that's only partially contained in the span (and which can be retried
+ * once more bytes are available) from corrupted IR.
+ */
+class ByteSpanReader {
+public:
+    // Constructors
+    explicit ByteSpanReader(std::span<char const> buf) : m_buf{buf} {}
+
+    // Methods
+    /**
+     * @return The number of bytes consumed from the span.
+     */
+    [[nodiscard]] auto get_pos() const -> size_t { return m_pos; }
+
+    /**
+     * @return Whether any read failed because it ran past the end of the span.
+     */
+    [[nodiscard]] auto is_truncated() const -> bool { return m_is_truncated; }
+
+    /**
+     * Reads exactly `num_bytes` bytes into `buf`.
+     * @param buf
+     * @param num_bytes
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_Truncated if the span doesn't contain enough bytes.
+     */
+    [[nodiscard]] auto try_read_exact_length(char* buf, size_t num_bytes) -> ErrorCode {
+        auto const* const bytes{try_consume(num_bytes)};
+        if (nullptr == bytes) {
+            return ErrorCode_Truncated;
+        }
+        std::memcpy(buf, bytes, num_bytes);
+        return ErrorCode_Success;
+    }
+
+    /**
+     * Reads a numeric value in the platform's byte order.
+     * @tparam ValueType
+     * @param value Returns the value read.
+     * @return Same as `try_read_exact_length`.
+     */
+    template <typename ValueType>
+    [[nodiscard]] auto try_read_numeric_value(ValueType& value) -> ErrorCode {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return try_read_exact_length(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+
+    /**
+     * Reads a string of the given length, copying it out of the span.
+     * @param str_length
+     * @param str Returns the string read.
+     * @return Same as `try_read_exact_length`.
+     */
+    [[nodiscard]] auto try_read_string(size_t str_length, std::string& str) -> ErrorCode {
+        auto const* const bytes{try_consume(str_length)};
+        if (nullptr == bytes) {
+            return ErrorCode_Truncated;
+        }
+        str.assign(bytes, str_length);
+        return ErrorCode_Success;
+    }
+
+private:
+    /**
+     * Consumes the given number of bytes from the span.
+     * @param num_bytes
+     * @return A pointer to the first consumed byte, or nullptr if the span doesn't contain enough
+     * bytes (in which case, the reader is marked as truncated).
+     */
+    [[nodiscard]] auto try_consume(size_t num_bytes) -> char const* {
+        if (m_buf.size() - m_pos < num_bytes) {
+            m_is_truncated = true;
+            return nullptr;
+        }
+        auto const* const bytes{m_buf.data() + m_pos};
+        m_pos += num_bytes;
+        return bytes;
+    }
+
+    std::span<char const> m_buf;
+    size_t m_pos{0};
+    bool m_is_truncated{false};
+};
+
+/**
+ * Requirement for the readers that IR can be deserialized from: any `ReaderInterface`, or a
+ * `ByteSpanReader` for IR that's already in memory.
+ * @tparam ReaderType
+ */
+template <typename ReaderType>
+concept IrReaderReq = std::is_base_of_v<ReaderInterface, ReaderType>
+                      || std::is_same_v<ByteSpanReader, ReaderType>;
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_BYTESPANREADER_HPP
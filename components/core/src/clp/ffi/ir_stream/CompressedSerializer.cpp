@@ -0,0 +1,152 @@
+#include "CompressedSerializer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../../ErrorCode.hpp"
+#include "../../ir/types.hpp"
+#include "../../streaming_compression/zstd/Compressor.hpp"
+#include "../../time_types.hpp"
+#include "../../type_utils.hpp"
+#include "../../WriterInterface.hpp"
+#include "protocol_constants.hpp"
+#include "Serializer.hpp"
+
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+
+namespace clp::ffi::ir_stream {
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::create(
+        WriterInterface& writer,
+        Config const& config,
+        std::optional<nlohmann::json> optional_user_defined_metadata
+) -> ystdlib::error_handling::Result<CompressedSerializer<encoded_variable_t>> {
+    auto serializer{YSTDLIB_ERROR_HANDLING_TRYX(
+            Serializer<encoded_variable_t>::create(std::move(optional_user_defined_metadata))
+    )};
+
+    auto compressor{std::make_unique<streaming_compression::zstd::Compressor>()};
+    compressor->open(writer, config.compression_level);
+
+    CompressedSerializer<encoded_variable_t> compressed_serializer{
+            std::move(serializer),
+            std::move(compressor),
+            writer,
+            config
+    };
+    compressed_serializer.compress_ir_buf();
+    return compressed_serializer;
+}
+
+template <typename encoded_variable_t>
+CompressedSerializer<encoded_variable_t>::~CompressedSerializer() {
+    if (nullptr != m_compressor) {
+        SPDLOG_ERROR(
+                "clp::ffi::ir_stream::CompressedSerializer not closed before being destroyed - "
+                "output maybe corrupted."
+        );
+    }
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::change_utc_offset(UtcOffset utc_offset) -> void {
+    validate_is_open();
+    m_serializer.change_utc_offset(utc_offset);
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::serialize_msgpack_maps(
+        std::span<MsgpackMapPair const> msgpack_map_pairs
+) -> size_t {
+    validate_is_open();
+
+    size_t num_serialized_log_events{0};
+    for (auto const& msgpack_map_pair : msgpack_map_pairs) {
+        if (0 == m_serializer.serialize_msgpack_maps({&msgpack_map_pair, 1})) {
+            break;
+        }
+        ++num_serialized_log_events;
+
+        // Check the size threshold after every log event so that frames don't grow much larger
+        // than the configured size, even for large batches.
+        if (m_frame_size + m_serializer.get_ir_buf_view().size() >= m_config.max_frame_size) {
+            compress_ir_buf();
+            end_frame();
+        }
+    }
+
+    compress_ir_buf();
+    if (m_frame_size > 0 && Clock::now() - m_frame_begin_time >= m_config.max_frame_duration) {
+        end_frame();
+    }
+    return num_serialized_log_events;
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::flush() -> void {
+    validate_is_open();
+    compress_ir_buf();
+    end_frame();
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::close() -> void {
+    validate_is_open();
+    compress_ir_buf();
+    auto const eof{static_cast<char>(cProtocol::Eof)};
+    m_compressor->write(&eof, sizeof(eof));
+    // Closing the compressor ends the current frame, which contains at least the EOF tag
+    m_compressor->close();
+    ++m_num_frames;
+    m_writer->flush();
+    m_compressor.reset();
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::compress_ir_buf() -> void {
+    auto const ir_buf_view{m_serializer.get_ir_buf_view()};
+    if (ir_buf_view.empty()) {
+        return;
+    }
+    if (0 == m_frame_size) {
+        m_frame_begin_time = Clock::now();
+    }
+    m_compressor->write(
+            size_checked_pointer_cast<char const>(ir_buf_view.data()),
+            ir_buf_view.size()
+    );
+    m_frame_size += ir_buf_view.size();
+    m_serializer.clear_ir_buf();
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::end_frame() -> void {
+    if (0 == m_frame_size) {
+        return;
+    }
+    m_compressor->flush();
+    m_writer->flush();
+    m_frame_size = 0;
+    ++m_num_frames;
+}
+
+template <typename encoded_variable_t>
+auto CompressedSerializer<encoded_variable_t>::validate_is_open() const -> void {
+    if (nullptr == m_compressor) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+}
+
+// Explicitly declare template specializations so that we can define the template methods in this
+// file
+template class CompressedSerializer<eight_byte_encoded_variable_t>;
+template class CompressedSerializer<four_byte_encoded_variable_t>;
+}  // namespace clp::ffi::ir_stream
@@ -0,0 +1,200 @@
+#ifndef CLP_FFI_IR_STREAM_COMPRESSEDSERIALIZER_HPP
+#define CLP_FFI_IR_STREAM_COMPRESSEDSERIALIZER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <msgpack.hpp>
+#include <nlohmann/json.hpp>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../../ErrorCode.hpp"
+#include "../../streaming_compression/zstd/Compressor.hpp"
+#include "../../streaming_compression/zstd/Constants.hpp"
+#include "../../time_types.hpp"
+#include "../../TraceableException.hpp"
+#include "../../WriterInterface.hpp"
+#include "Serializer.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * Class for serializing log events into a Zstandard-compressed kv-pair IR stream.
+ *
+ * Log events are serialized with a `Serializer`, whose IR buffer is piped directly into a streaming
+ * Zstandard compressor writing to the given writer, so callers never need to handle the serialized
+ * bytes themselves.
+ *
+ * The compressed stream is split into Zstandard frames at log event boundaries. The current frame
+ * is ended (and the writer flushed) once either:
+ * - the frame contains at least `Config::max_frame_size` uncompressed bytes; or
+ * - `Config::max_frame_duration` has elapsed since the frame's first byte was written.
+ * This allows readers to start decoding log events soon after they're serialized, without waiting
+ * for the stream to be closed. Thresholds are only checked when log events are serialized, so
+ * callers that may stay idle for long should call `flush` to end the current frame.
+ * @tparam encoded_variable_t Type of encoded variables in the serialized IR stream.
+ */
+template <typename encoded_variable_t>
+class CompressedSerializer {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException{error_code, filename, line_number} {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::ffi::ir_stream::CompressedSerializer operation failed";
+        }
+    };
+
+    using MsgpackMapPair = typename Serializer<encoded_variable_t>::MsgpackMapPair;
+
+    struct Config {
+        // Constants
+        static constexpr size_t cDefaultMaxFrameSize{1024ULL * 1024};  // 1 MiB
+        static constexpr std::chrono::milliseconds cDefaultMaxFrameDuration{1000};
+
+        // Variables
+        int compression_level{streaming_compression::zstd::cDefaultCompressionLevel};
+        size_t max_frame_size{cDefaultMaxFrameSize};  // Uncompressed bytes
+        std::chrono::milliseconds max_frame_duration{cDefaultMaxFrameDuration};
+    };
+
+    // Factory functions
+    /**
+     * Creates a compressed IR serializer and serializes the stream's preamble.
+     * @param writer The writer to write the compressed stream to. It must outlive the serializer.
+     * @param config
+     * @param optional_user_defined_metadata Stream-level user-defined metadata, given as a JSON
+     * object.
+     * @return A result containing the serializer or an error code indicating the failure:
+     * - Forwards `Serializer::create`'s return values.
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if the compressor couldn't be
+     * opened.
+     */
+    [[nodiscard]] static auto create(
+            WriterInterface& writer,
+            Config const& config,
+            std::optional<nlohmann::json> optional_user_defined_metadata = std::nullopt
+    ) -> ystdlib::error_handling::Result<CompressedSerializer<encoded_variable_t>>;
+
+    // Disable copy constructor/assignment operator
+    CompressedSerializer(CompressedSerializer const&) = delete;
+    auto operator=(CompressedSerializer const&) -> CompressedSerializer& = delete;
+
+    // Define default move constructor/assignment operator
+    CompressedSerializer(CompressedSerializer&&) = default;
+    auto operator=(CompressedSerializer&&) -> CompressedSerializer& = default;
+
+    // Destructor
+    ~CompressedSerializer();
+
+    // Methods
+    /**
+     * @return The number of Zstandard frames that have been ended so far.
+     */
+    [[nodiscard]] auto get_num_frames() const -> size_t { return m_num_frames; }
+
+    /**
+     * Changes the UTC offset and serializes a UTC offset change packet, if the given UTC offset is
+     * different than the current UTC offset.
+     * @param utc_offset
+     * @throw OperationFailed if the serializer has been closed.
+     */
+    auto change_utc_offset(UtcOffset utc_offset) -> void;
+
+    /**
+     * Serializes the given msgpack maps as a key-value pair log event.
+     * @param auto_gen_kv_pairs_map
+     * @param user_gen_kv_pairs_map
+     * @return Whether serialization succeeded.
+     * @throw OperationFailed if the serializer has been closed.
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if compression fails.
+     */
+    [[nodiscard]] auto serialize_msgpack_map(
+            msgpack::object_map const& auto_gen_kv_pairs_map,
+            msgpack::object_map const& user_gen_kv_pairs_map
+    ) -> bool {
+        MsgpackMapPair const msgpack_map_pair{auto_gen_kv_pairs_map, user_gen_kv_pairs_map};
+        return 1 == serialize_msgpack_maps({&msgpack_map_pair, 1});
+    }
+
+    /**
+     * Serializes each of the given pairs of msgpack maps as a key-value pair log event, in order,
+     * stopping at the first log event that fails to serialize.
+     * @param msgpack_map_pairs
+     * @return Forwards `Serializer::serialize_msgpack_maps`'s return values.
+     * @throw OperationFailed if the serializer has been closed.
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if compression fails.
+     */
+    [[nodiscard]] auto serialize_msgpack_maps(std::span<MsgpackMapPair const> msgpack_map_pairs)
+            -> size_t;
+
+    /**
+     * Compresses any buffered IR, ends the current frame, and flushes the writer.
+     * @throw OperationFailed if the serializer has been closed.
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if compression fails.
+     */
+    auto flush() -> void;
+
+    /**
+     * Serializes the end-of-stream tag, ends the current frame, and closes the compressor. The
+     * writer is flushed but not closed.
+     * @throw OperationFailed if the serializer has been closed.
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if compression fails.
+     */
+    auto close() -> void;
+
+private:
+    // Types
+    using Clock = std::chrono::steady_clock;
+
+    // Constructors
+    CompressedSerializer(
+            Serializer<encoded_variable_t> serializer,
+            std::unique_ptr<streaming_compression::zstd::Compressor> compressor,
+            WriterInterface& writer,
+            Config const& config
+    )
+            : m_serializer{std::move(serializer)},
+              m_compressor{std::move(compressor)},
+              m_writer{&writer},
+              m_config{config} {}
+
+    // Methods
+    /**
+     * Compresses the serializer's IR buffer into the current frame and clears the buffer.
+     */
+    auto compress_ir_buf() -> void;
+
+    /**
+     * Ends the current frame (if it's non-empty) and flushes the writer.
+     */
+    auto end_frame() -> void;
+
+    /**
+     * @throw OperationFailed if the serializer has been closed.
+     */
+    auto validate_is_open() const -> void;
+
+    // Variables
+    Serializer<encoded_variable_t> m_serializer;
+    // The compressor is stored on the heap since it owns a raw Zstandard stream that can't be
+    // safely moved.
+    std::unique_ptr<streaming_compression::zstd::Compressor> m_compressor;
+    WriterInterface* m_writer;
+    Config m_config;
+
+    size_t m_frame_size{0};  // Uncompressed bytes
+    Clock::time_point m_frame_begin_time;
+    size_t m_num_frames{0};
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_COMPRESSEDSERIALIZER_HPP
@@ -0,0 +1,36 @@
+#include "ContiguousIrBuffer.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#include "../../ErrorCode.hpp"
+
+namespace clp::ffi::ir_stream {
+auto ContiguousIrBuffer::read_more() -> ErrorCode {
+    auto const num_unconsumed_bytes{m_end_pos - m_begin_pos};
+    if (m_begin_pos > 0) {
+        std::memmove(m_buf.data(), m_buf.data() + m_begin_pos, num_unconsumed_bytes);
+        m_begin_pos = 0;
+        m_end_pos = num_unconsumed_bytes;
+    }
+    if (m_buf.size() == m_end_pos) {
+        m_buf.resize(m_buf.size() * 2);
+    }
+
+    size_t num_bytes_read{0};
+    if (auto const error_code{m_reader.try_read(
+                m_buf.data() + m_end_pos,
+                m_buf.size() - m_end_pos,
+                num_bytes_read
+        )};
+        ErrorCode_Success != error_code)
+    {
+        return error_code;
+    }
+    if (0 == num_bytes_read) {
+        return ErrorCode_EndOfFile;
+    }
+    m_end_pos += num_bytes_read;
+    return ErrorCode_Success;
+}
+}  // namespace clp::ffi::ir_stream
@@ -0,0 +1,116 @@
+#ifndef CLP_FFI_IR_STREAM_CONTIGUOUSIRBUFFER_HPP
+#define CLP_FFI_IR_STREAM_CONTIGUOUSIRBUFFER_HPP
+
+#include <cstddef>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../../ErrorCode.hpp"
+#include "../../ReaderInterface.hpp"
+#include "ByteSpanReader.hpp"
+#include "IrUnitType.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * A buffer that reads a kv-pair IR stream from a `ReaderInterface` in large chunks, so that each IR
+ * unit can be deserialized from contiguous memory using a `ByteSpanReader` rather than with a
+ * virtual call for every field.
+ *
+ * If an IR unit straddles the end of the buffered bytes, the buffer reads more of the stream
+ * (growing if the IR unit is larger than the buffer) and deserializes the IR unit again.
+ */
+class ContiguousIrBuffer {
+public:
+    // Constants
+    static constexpr size_t cDefaultCapacity{64ULL * 1024};
+
+    // Constructors
+    /**
+     * @param reader The reader to read the stream from, positioned after the stream's preamble
+     * (i.e., after the deserializer has been created).
+     * @param capacity The buffer's initial capacity.
+     */
+    explicit ContiguousIrBuffer(ReaderInterface& reader, size_t capacity = cDefaultCapacity)
+            : m_reader{reader},
+              m_buf(capacity > 0 ? capacity : cDefaultCapacity),
+              m_stream_pos{reader.get_pos()} {}
+
+    // Delete copy & move constructors and assignment operators
+    ContiguousIrBuffer(ContiguousIrBuffer const&) = delete;
+    ContiguousIrBuffer(ContiguousIrBuffer&&) = delete;
+    auto operator=(ContiguousIrBuffer const&) -> ContiguousIrBuffer& = delete;
+    auto operator=(ContiguousIrBuffer&&) -> ContiguousIrBuffer& = delete;
+
+    // Destructor
+    ~ContiguousIrBuffer() = default;
+
+    // Methods
+    /**
+     * Deserializes the next IR unit from the buffered stream using the given deserializer.
+     * @tparam DeserializerType
+     * @param deserializer
+     * @return A result containing the deserialized IR unit's type or an error code indicating the
+     * failure:
+     * - std::errc::io_error if reading from the underlying reader failed.
+     * - Forwards `Deserializer::deserialize_next_ir_unit`'s return values.
+     */
+    template <typename DeserializerType>
+    [[nodiscard]] auto deserialize_next_ir_unit(DeserializerType& deserializer)
+            -> ystdlib::error_handling::Result<IrUnitType>;
+
+    /**
+     * @return The position in the underlying stream of the first byte that hasn't been
+     * deserialized yet.
+     */
+    [[nodiscard]] auto get_pos() const -> size_t { return m_stream_pos; }
+
+private:
+    // Methods
+    /**
+     * Reads more of the stream into the buffer, after moving the unconsumed bytes to the front of
+     * the buffer and doubling its size if it's full.
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_EndOfFile if the stream has no more bytes.
+     * @return Forwards `ReaderInterface::try_read`'s return values on any other failure.
+     */
+    [[nodiscard]] auto read_more() -> ErrorCode;
+
+    // Variables
+    ReaderInterface& m_reader;
+    std::vector<char> m_buf;
+    size_t m_begin_pos{0};
+    size_t m_end_pos{0};
+    size_t m_stream_pos;
+};
+
+template <typename DeserializerType>
+auto ContiguousIrBuffer::deserialize_next_ir_unit(DeserializerType& deserializer)
+        -> ystdlib::error_handling::Result<IrUnitType> {
+    while (true) {
+        ByteSpanReader span_reader{
+                std::span<char const>{m_buf.data() + m_begin_pos, m_end_pos - m_begin_pos}
+        };
+        auto result{deserializer.deserialize_next_ir_unit(span_reader)};
+        if (false == result.has_error() || false == span_reader.is_truncated()) {
+            m_begin_pos += span_reader.get_pos();
+            m_stream_pos += span_reader.get_pos();
+            return result;
+        }
+
+        // The IR unit is incomplete, so the deserializer's state is unchanged and we can retry
+        // once more of the stream has been read.
+        auto const error_code{read_more()};
+        if (ErrorCode_EndOfFile == error_code) {
+            return result;
+        }
+        if (ErrorCode_Success != error_code) {
+            return std::errc::io_error;
+        }
+    }
+}
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_CONTIGUOUSIRBUFFER_HPP
@@ -16,6 +16,7 @@
 #include "../../ReaderInterface.hpp"
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
+#include "ByteSpanReader.hpp"
 #include "ir_unit_deserialization_methods.hpp"
 #include "IrUnitHandlerReq.hpp"
 #include "IrUnitType.hpp"
@@ -36,7 +37,9 @@ namespace clp::ffi::ir_stream {
  * handler can be provided to handle queries and column projections.
  *
  * NOTE: This class is designed only to provide deserialization functionalities. Callers are
- * responsible for maintaining a `ReaderInterface` to input IR bytes from an I/O stream.
+ * responsible for maintaining a `ReaderInterface` to input IR bytes from an I/O stream. To avoid a
+ * virtual call for every field of an IR unit, callers can instead read the stream through a
+ * `ContiguousIrBuffer`, which deserializes IR units from contiguous chunks of the stream.
  *
  * @tparam IrUnitHandlerType
  * @tparam QueryHandlerType
@@ -140,7 +143,26 @@ public:
      *   unit handling failure.
      */
     [[nodiscard]] auto deserialize_next_ir_unit(ReaderInterface& reader)
-            -> ystdlib::error_handling::Result<IrUnitType>;
+            -> ystdlib::error_handling::Result<IrUnitType> {
+        return generic_deserialize_next_ir_unit(reader);
+    }
+
+    /**
+     * Equivalent to `deserialize_next_ir_unit` above, but deserializes from IR that's already in
+     * memory, avoiding a virtual call for every field of the IR unit.
+     *
+     * NOTE: The deserializer's state is only updated once an entire IR unit has been deserialized.
+     * So if this method fails and `reader.is_truncated()` is true, the span ended partway through
+     * the next IR unit and the call can be retried with a span that contains more of the stream
+     * (starting from the same IR unit).
+     *
+     * @param reader
+     * @return Same as `deserialize_next_ir_unit` above.
+     */
+    [[nodiscard]] auto deserialize_next_ir_unit(ByteSpanReader& reader)
+            -> ystdlib::error_handling::Result<IrUnitType> {
+        return generic_deserialize_next_ir_unit(reader);
+    }
 
     /**
      * @return Whether the stream has completed. A stream is considered completed if an
@@ -198,6 +220,17 @@ private:
               m_ir_unit_handler{std::move(ir_unit_handler)},
               m_query_handler{std::move(query_handler)} {}
 
+    // Methods
+    /**
+     * Generic implementation of `deserialize_next_ir_unit`.
+     * @tparam ReaderType
+     * @param reader
+     * @return Same as `deserialize_next_ir_unit`.
+     */
+    template <IrReaderReq ReaderType>
+    [[nodiscard]] auto generic_deserialize_next_ir_unit(ReaderType& reader)
+            -> ystdlib::error_handling::Result<IrUnitType>;
+
     // Variables
     std::shared_ptr<SchemaTree> m_auto_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
     std::shared_ptr<SchemaTree> m_user_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
@@ -287,8 +320,9 @@ auto Deserializer<IrUnitHandlerType, QueryHandlerType>::create_generic(
 }
 
 template <IrUnitHandlerReq IrUnitHandler, search::QueryHandlerReq QueryHandlerType>
-auto Deserializer<IrUnitHandler, QueryHandlerType>::deserialize_next_ir_unit(
-        ReaderInterface& reader
+template <IrReaderReq ReaderType>
+auto Deserializer<IrUnitHandler, QueryHandlerType>::generic_deserialize_next_ir_unit(
+        ReaderType& reader
 ) -> ystdlib::error_handling::Result<IrUnitType> {
     if (is_stream_completed()) {
         return std::errc::operation_not_permitted;
@@ -0,0 +1,130 @@
+#ifndef CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
+#define CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../SchemaTree.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * A hash-based cache mapping schema-tree node locators to node IDs.
+ *
+ * `SchemaTree::try_get_node_id` scans every child of the locator's parent, so looking up keys under
+ * a wide object costs time proportional to the object's width on every log event. When a
+ * serializer sees the same key paths over and over, caching each locator's node ID turns these
+ * lookups into a single hash-table probe.
+ *
+ * NOTE: The cache must be kept consistent with its schema tree, i.e., callers must call
+ * `erase_nodes_not_in` whenever nodes are removed from the tree (e.g., when it's reverted).
+ */
+class SchemaTreeNodeIdCache {
+public:
+    // Methods
+    /**
+     * @param locator
+     * @return The cached ID of the node corresponding to the given locator, or std::nullopt if the
+     * locator isn't cached.
+     */
+    [[nodiscard]] auto find(SchemaTree::NodeLocator const& locator) const
+            -> std::optional<SchemaTree::Node::id_t> {
+        auto const it{m_node_ids.find(LocatorView{locator})};
+        if (m_node_ids.cend() == it) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * Caches the given locator's node ID, unless the locator is already cached.
+     * @param locator
+     * @param node_id
+     */
+    auto insert(SchemaTree::NodeLocator const& locator, SchemaTree::Node::id_t node_id) -> void {
+        m_node_ids.try_emplace(
+                Locator{locator.get_parent_id(),
+                        std::string{locator.get_key_name()},
+                        locator.get_type()},
+                node_id
+        );
+    }
+
+    /**
+     * Removes every cached node whose ID doesn't exist in a tree of the given size.
+     * @param schema_tree_size
+     */
+    auto erase_nodes_not_in(size_t schema_tree_size) -> void {
+        std::erase_if(m_node_ids, [&](auto const& entry) -> bool {
+            return entry.second >= schema_tree_size;
+        });
+    }
+
+    auto clear() -> void { m_node_ids.clear(); }
+
+private:
+    // Types
+    /**
+     * An owning copy of a `SchemaTree::NodeLocator`.
+     */
+    struct Locator {
+        SchemaTree::Node::id_t parent_id;
+        std::string key_name;
+        SchemaTree::Node::Type type;
+    };
+
+    /**
+     * A non-owning view of a locator, used to look up the cache without copying the key name.
+     */
+    struct LocatorView {
+        explicit LocatorView(SchemaTree::NodeLocator const& locator)
+                : parent_id{locator.get_parent_id()},
+                  key_name{locator.get_key_name()},
+                  type{locator.get_type()} {}
+
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        LocatorView(Locator const& locator)
+                : parent_id{locator.parent_id},
+                  key_name{locator.key_name},
+                  type{locator.type} {}
+
+        SchemaTree::Node::id_t parent_id;
+        std::string_view key_name;
+        SchemaTree::Node::Type type;
+    };
+
+    struct LocatorHash {
+        using is_transparent = void;
+
+        // Odd 64-bit constant (derived from the golden ratio) used to spread the mixed-in bits
+        static constexpr size_t cHashMultiplier{0x9E37'79B9'7F4A'7C15ULL};
+
+        [[nodiscard]] auto operator()(LocatorView const& locator) const -> size_t {
+            auto const parent_id_and_type{
+                    (static_cast<size_t>(locator.parent_id) << 8U)
+                    | static_cast<size_t>(locator.type)
+            };
+            return std::hash<std::string_view>{}(locator.key_name)
+                   ^ (std::hash<size_t>{}(parent_id_and_type) * cHashMultiplier);
+        }
+    };
+
+    struct LocatorEqual {
+        using is_transparent = void;
+
+        [[nodiscard]] auto operator()(LocatorView const& lhs, LocatorView const& rhs) const
+                -> bool {
+            return lhs.parent_id == rhs.parent_id && lhs.type == rhs.type
+                   && lhs.key_name == rhs.key_name;
+        }
+    };
+
+    // Variables
+    std::unordered_map<Locator, SchemaTree::Node::id_t, LocatorHash, LocatorEqual> m_node_ids;
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
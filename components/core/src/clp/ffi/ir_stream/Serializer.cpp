@@ -1,6 +1,7 @@
 #include "Serializer.hpp"
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
@@ -23,6 +24,7 @@
 #include "../SchemaTree.hpp"
 #include "encoding_methods.hpp"
 #include "protocol_constants.hpp"
+#include "SchemaTreeNodeIdCache.hpp"
 #include "utils.hpp"
 
 using std::optional;
@@ -223,6 +225,7 @@ template <typename encoded_variable_t>
  * @tparam EmptyMapSerializationMethod
  * @param msgpack_map
  * @param schema_tree
+ * @param node_id_cache Cache of `schema_tree`'s node IDs, which is updated with any inserted nodes.
  * @param schema_tree_node_serialization_method
  * @param node_id_value_pair_serialization_method
  * @param empty_map_serialization_method
@@ -236,6 +239,7 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeIdCache& node_id_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
@@ -435,6 +439,7 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeIdCache& node_id_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
@@ -472,13 +477,18 @@ template <
         };
 
         // Get the schema-tree node that corresponds with the current kv-pair, or add it if it
-        // doesn't exist.
-        auto opt_schema_tree_node_id{schema_tree.try_get_node_id(locator)};
+        // doesn't exist. Every node is cached once it's been looked up or inserted, so recurring
+        // key paths never need to scan their parent's children.
+        auto opt_schema_tree_node_id{node_id_cache.find(locator)};
         if (false == opt_schema_tree_node_id.has_value()) {
-            opt_schema_tree_node_id.emplace(schema_tree.insert_node(locator));
-            if (false == schema_tree_node_serialization_method(locator)) {
-                return false;
+            opt_schema_tree_node_id = schema_tree.try_get_node_id(locator);
+            if (false == opt_schema_tree_node_id.has_value()) {
+                opt_schema_tree_node_id.emplace(schema_tree.insert_node(locator));
+                if (false == schema_tree_node_serialization_method(locator)) {
+                    return false;
+                }
             }
+            node_id_cache.insert(locator, opt_schema_tree_node_id.value());
         }
         auto const schema_tree_node_id{opt_schema_tree_node_id.value()};
 
@@ -582,6 +592,8 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             [&]() noexcept -> void {
                 m_user_gen_keys_schema_tree.revert();
                 m_auto_gen_keys_schema_tree.revert();
+                m_user_gen_node_id_cache.erase_nodes_not_in(m_user_gen_keys_schema_tree.get_size());
+                m_auto_gen_node_id_cache.erase_nodes_not_in(m_auto_gen_keys_schema_tree.get_size());
             }
     };
 
@@ -642,6 +654,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
                    == serialize_msgpack_map_using_dfs(
                            auto_gen_kv_pairs_map,
                            m_auto_gen_keys_schema_tree,
+                           m_auto_gen_node_id_cache,
                            auto_gen_schema_tree_node_serialization_method,
                            auto_gen_node_id_value_pairs_serialization_method,
                            auto_gen_empty_map_serialization_method
@@ -705,6 +718,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             == serialize_msgpack_map_using_dfs(
                     user_gen_kv_pairs_map,
                     m_user_gen_keys_schema_tree,
+                    m_user_gen_node_id_cache,
                     user_gen_schema_tree_node_serialization_method,
                     user_gen_node_id_value_pairs_serialization_method,
                     user_gen_empty_map_serialization_method
@@ -735,6 +749,20 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
     return true;
 }
 
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_msgpack_maps(
+        span<MsgpackMapPair const> msgpack_map_pairs
+) -> size_t {
+    size_t num_serialized_log_events{0};
+    for (auto const& [auto_gen_kv_pairs_map, user_gen_kv_pairs_map] : msgpack_map_pairs) {
+        if (false == serialize_msgpack_map(auto_gen_kv_pairs_map, user_gen_kv_pairs_map)) {
+            break;
+        }
+        ++num_serialized_log_events;
+    }
+    return num_serialized_log_events;
+}
+
 template <typename encoded_variable_t>
 template <bool is_auto_generated_node>
 auto Serializer<encoded_variable_t>::serialize_schema_tree_node(
@@ -801,6 +829,13 @@ template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& user_gen_kv_pairs_map
 ) -> bool;
 
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_msgpack_maps(
+        span<MsgpackMapPair const> msgpack_map_pairs
+) -> size_t;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_maps(
+        span<MsgpackMapPair const> msgpack_map_pairs
+) -> size_t;
+
 template auto Serializer<eight_byte_encoded_variable_t>::serialize_schema_tree_node<true>(
         SchemaTree::NodeLocator const& locator
 ) -> bool;
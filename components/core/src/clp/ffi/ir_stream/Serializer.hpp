@@ -1,10 +1,12 @@
 #ifndef CLP_FFI_IR_STREAM_SERIALIZER_HPP
 #define CLP_FFI_IR_STREAM_SERIALIZER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <msgpack.hpp>
@@ -13,6 +15,7 @@
 
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
+#include "SchemaTreeNodeIdCache.hpp"
 
 namespace clp::ffi::ir_stream {
 /**
@@ -38,6 +41,11 @@ public:
     using Buffer = std::vector<int8_t>;
     using BufferView = std::span<int8_t const>;
 
+    /**
+     * A log event's auto-generated and user-generated kv-pairs maps, in that order.
+     */
+    using MsgpackMapPair = std::pair<msgpack::object_map, msgpack::object_map>;
+
     // Factory functions
     /**
      * Creates an IR serializer and serializes the stream's preamble.
@@ -98,6 +106,20 @@ public:
             msgpack::object_map const& user_gen_kv_pairs_map
     ) -> bool;
 
+    /**
+     * Serializes each of the given pairs of msgpack maps as a key-value pair log event, in order,
+     * stopping at the first log event that fails to serialize.
+     *
+     * Schema-tree node IDs are cached across log events (and batches), so batches whose log events
+     * share key paths only resolve each key path through the schema tree once.
+     * @param msgpack_map_pairs
+     * @return The number of log events that were serialized. If this is less than
+     * `msgpack_map_pairs.size()`, the log event at this index failed to serialize (see
+     * `serialize_msgpack_map`) and none of the log events after it were serialized.
+     */
+    [[nodiscard]] auto serialize_msgpack_maps(std::span<MsgpackMapPair const> msgpack_map_pairs)
+            -> size_t;
+
 private:
     // Constructors
     Serializer() = default;
@@ -116,6 +138,8 @@ private:
     Buffer m_ir_buf;
     SchemaTree m_auto_gen_keys_schema_tree;
     SchemaTree m_user_gen_keys_schema_tree;
+    SchemaTreeNodeIdCache m_auto_gen_node_id_cache;
+    SchemaTreeNodeIdCache m_user_gen_node_id_cache;
 
     std::string m_logtype_buf;
     Buffer m_schema_tree_node_buf;
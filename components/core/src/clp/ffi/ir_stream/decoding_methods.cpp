@@ -7,6 +7,7 @@
 #include <string_view>
 
 #include "../../ir/types.hpp"
+#include "ByteSpanReader.hpp"
 #include "byteswap.hpp"
 #include "protocol_constants.hpp"
 #include "utils.hpp"
@@ -31,6 +32,7 @@ static bool is_variable_tag(encoded_tag_t tag, bool& is_encoded_var);
 
 /**
  * Deserializes a logtype from the given reader
+ * @tparam ReaderType
  * @param reader
  * @param encoded_tag
  * @param logtype Returns the logtype
@@ -38,11 +40,13 @@ static bool is_variable_tag(encoded_tag_t tag, bool& is_encoded_var);
  * @return IRErrorCode_Corrupted_IR if reader contains invalid IR
  * @return IRErrorCode_Incomplete_IR if reader doesn't contain enough data to deserialize
  */
+template <IrReaderReq ReaderType>
 static IRErrorCode
-deserialize_logtype(ReaderInterface& reader, encoded_tag_t encoded_tag, string& logtype);
+deserialize_logtype(ReaderType& reader, encoded_tag_t encoded_tag, string& logtype);
 
 /**
  * Deserializes a dictionary-type variable from the given reader
+ * @tparam ReaderType
  * @param reader
  * @param encoded_tag
  * @param dict_var Returns the dictionary variable
@@ -50,8 +54,9 @@ deserialize_logtype(ReaderInterface& reader, encoded_tag_t encoded_tag, string&
  * @return IRErrorCode_Corrupted_IR if reader contains invalid IR
  * @return IRErrorCode_Incomplete_IR if input buffer doesn't contain enough data to deserialize
  */
+template <IrReaderReq ReaderType>
 static IRErrorCode
-deserialize_dict_var(ReaderInterface& reader, encoded_tag_t encoded_tag, string& dict_var);
+deserialize_dict_var(ReaderType& reader, encoded_tag_t encoded_tag, string& dict_var);
 
 /**
  * Deserializes a timestamp from the given reader
@@ -89,6 +94,38 @@ static IRErrorCode generic_deserialize_log_event(
         epoch_time_ms_t& timestamp
 );
 
+/**
+ * Deserializes a UTC offset change packet from the given reader
+ * @tparam ReaderType
+ * @param reader
+ * @param utc_offset Returns the deserialized UTC offset
+ * @return IRErrorCode_Success on success
+ * @return IRErrorCode_Incomplete_IR if reader doesn't contain enough data to deserialize
+ */
+template <IrReaderReq ReaderType>
+static IRErrorCode
+generic_deserialize_utc_offset_change(ReaderType& reader, UtcOffset& utc_offset);
+
+/**
+ * Generic implementation of `deserialize_encoded_text_ast`
+ * @tparam encoded_variable_t
+ * @tparam ReaderType
+ * @param reader
+ * @param encoded_tag
+ * @param logtype
+ * @param encoded_vars
+ * @param dict_vars
+ * @return Same as `deserialize_encoded_text_ast`
+ */
+template <typename encoded_variable_t, IrReaderReq ReaderType>
+static IRErrorCode generic_deserialize_encoded_text_ast(
+        ReaderType& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+);
+
 /**
  * Deserializes metadata from the given reader
  * @param reader
@@ -133,8 +170,9 @@ static bool is_variable_tag(encoded_tag_t tag, bool& is_encoded_var) {
     return false;
 }
 
+template <IrReaderReq ReaderType>
 static IRErrorCode
-deserialize_logtype(ReaderInterface& reader, encoded_tag_t encoded_tag, string& logtype) {
+deserialize_logtype(ReaderType& reader, encoded_tag_t encoded_tag, string& logtype) {
     size_t logtype_length;
     if (encoded_tag == cProtocol::Payload::LogtypeStrLenUByte) {
         uint8_t length;
@@ -164,8 +202,9 @@ deserialize_logtype(ReaderInterface& reader, encoded_tag_t encoded_tag, string&
     return IRErrorCode_Success;
 }
 
+template <IrReaderReq ReaderType>
 static IRErrorCode
-deserialize_dict_var(ReaderInterface& reader, encoded_tag_t encoded_tag, string& dict_var) {
+deserialize_dict_var(ReaderType& reader, encoded_tag_t encoded_tag, string& dict_var) {
     // Deserialize variable's length
     size_t var_length;
     if (cProtocol::Payload::VarStrLenUByte == encoded_tag) {
@@ -198,6 +237,17 @@ deserialize_dict_var(ReaderInterface& reader, encoded_tag_t encoded_tag, string&
     return IRErrorCode_Success;
 }
 
+template <IrReaderReq ReaderType>
+static IRErrorCode
+generic_deserialize_utc_offset_change(ReaderType& reader, UtcOffset& utc_offset) {
+    int64_t serialized_utc_offset{};
+    if (false == deserialize_int(reader, serialized_utc_offset)) {
+        return IRErrorCode_Incomplete_IR;
+    }
+    utc_offset = UtcOffset{serialized_utc_offset};
+    return IRErrorCode_Success;
+}
+
 template <typename encoded_variable_t>
 static IRErrorCode
 deserialize_timestamp(ReaderInterface& reader, encoded_tag_t encoded_tag, epoch_time_ms_t& ts) {
@@ -361,14 +411,14 @@ auto deserialize_log_event(
     return IRErrorCode_Success;
 }
 
-template <typename encoded_variable_t>
-auto deserialize_encoded_text_ast(
-        ReaderInterface& reader,
+template <typename encoded_variable_t, IrReaderReq ReaderType>
+static IRErrorCode generic_deserialize_encoded_text_ast(
+        ReaderType& reader,
         encoded_tag_t encoded_tag,
         std::string& logtype,
         std::vector<encoded_variable_t>& encoded_vars,
         std::vector<std::string>& dict_vars
-) -> IRErrorCode {
+) {
     // Handle variables
     string var_str;
     bool is_encoded_var{false};
@@ -402,6 +452,40 @@ auto deserialize_encoded_text_ast(
     return IRErrorCode_Success;
 }
 
+template <typename encoded_variable_t>
+auto deserialize_encoded_text_ast(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+) -> IRErrorCode {
+    return generic_deserialize_encoded_text_ast(
+            reader,
+            encoded_tag,
+            logtype,
+            encoded_vars,
+            dict_vars
+    );
+}
+
+template <typename encoded_variable_t>
+auto deserialize_encoded_text_ast(
+        ByteSpanReader& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+) -> IRErrorCode {
+    return generic_deserialize_encoded_text_ast(
+            reader,
+            encoded_tag,
+            logtype,
+            encoded_vars,
+            dict_vars
+    );
+}
+
 IRErrorCode get_encoding_type(ReaderInterface& reader, bool& is_four_bytes_encoding) {
     char buffer[cProtocol::MagicNumberLength];
     auto error_code = reader.try_read_exact_length(buffer, cProtocol::MagicNumberLength);
@@ -509,12 +593,11 @@ auto validate_protocol_version(std::string_view protocol_version) -> IRProtocolE
 }
 
 IRErrorCode deserialize_utc_offset_change(ReaderInterface& reader, UtcOffset& utc_offset) {
-    int64_t serialized_utc_offset{};
-    if (false == deserialize_int(reader, serialized_utc_offset)) {
-        return IRErrorCode_Incomplete_IR;
-    }
-    utc_offset = UtcOffset{serialized_utc_offset};
-    return IRErrorCode_Success;
+    return generic_deserialize_utc_offset_change(reader, utc_offset);
+}
+
+IRErrorCode deserialize_utc_offset_change(ByteSpanReader& reader, UtcOffset& utc_offset) {
+    return generic_deserialize_utc_offset_change(reader, utc_offset);
 }
 
 namespace four_byte_encoding {
@@ -583,4 +666,20 @@ template auto deserialize_encoded_text_ast<eight_byte_encoded_variable_t>(
         std::vector<eight_byte_encoded_variable_t>& encoded_vars,
         std::vector<std::string>& dict_vars
 ) -> IRErrorCode;
+
+template auto deserialize_encoded_text_ast<four_byte_encoded_variable_t>(
+        ByteSpanReader& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<four_byte_encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+) -> IRErrorCode;
+
+template auto deserialize_encoded_text_ast<eight_byte_encoded_variable_t>(
+        ByteSpanReader& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<eight_byte_encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+) -> IRErrorCode;
 }  // namespace clp::ffi::ir_stream
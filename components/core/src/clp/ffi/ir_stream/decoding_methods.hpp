@@ -9,6 +9,7 @@
 #include "../../ReaderInterface.hpp"
 #include "../../time_types.hpp"
 #include "../encoding_methods.hpp"
+#include "ByteSpanReader.hpp"
 
 namespace clp::ffi::ir_stream {
 using encoded_tag_t = int8_t;
@@ -66,6 +67,20 @@ IRErrorCode get_encoding_type(ReaderInterface& reader, bool& is_four_bytes_encod
  */
 [[nodiscard]] IRErrorCode deserialize_tag(ReaderInterface& reader, encoded_tag_t& tag);
 
+/**
+ * Deserializes the tag for the next packet from a span of IR bytes.
+ * @param reader
+ * @param tag Returns the tag of the next packet.
+ * @return IRErrorCode_Success on success
+ * @return IRErrorCode_Incomplete_IR if reader doesn't contain enough data to deserialize
+ */
+[[nodiscard]] inline IRErrorCode deserialize_tag(ByteSpanReader& reader, encoded_tag_t& tag) {
+    if (ErrorCode_Success != reader.try_read_numeric_value(tag)) {
+        return IRErrorCode_Incomplete_IR;
+    }
+    return IRErrorCode_Success;
+}
+
 /**
  * Deserializes a log event from the given stream
  * @tparam encoded_variable_t
@@ -111,6 +126,18 @@ auto deserialize_encoded_text_ast(
         std::vector<std::string>& dict_vars
 ) -> IRErrorCode;
 
+/**
+ * Equivalent to `deserialize_encoded_text_ast` above, but deserializes from a span of IR bytes.
+ */
+template <typename encoded_variable_t>
+auto deserialize_encoded_text_ast(
+        ByteSpanReader& reader,
+        encoded_tag_t encoded_tag,
+        std::string& logtype,
+        std::vector<encoded_variable_t>& encoded_vars,
+        std::vector<std::string>& dict_vars
+) -> IRErrorCode;
+
 /**
  * Decodes the IR message calls the given methods to handle each component of the message
  * @tparam unescape_logtype Whether to remove the escape characters from the logtype before calling
@@ -192,6 +219,14 @@ IRErrorCode deserialize_preamble(
  */
 IRErrorCode deserialize_utc_offset_change(ReaderInterface& reader, UtcOffset& utc_offset);
 
+/**
+ * Deserializes a UTC offset change packet from a span of IR bytes.
+ * @param reader
+ * @param utc_offset The deserialized UTC offset.
+ * @return Same as `deserialize_utc_offset_change(ReaderInterface&, UtcOffset&)`
+ */
+IRErrorCode deserialize_utc_offset_change(ByteSpanReader& reader, UtcOffset& utc_offset);
+
 /**
  * Validates whether the given protocol version can be supported by the current build.
  * @param protocol_version
@@ -21,6 +21,7 @@
 #include "../KeyValuePairLogEvent.hpp"
 #include "../SchemaTree.hpp"
 #include "../Value.hpp"
+#include "ByteSpanReader.hpp"
 #include "decoding_methods.hpp"
 #include "IrUnitType.hpp"
 #include "protocol_constants.hpp"
@@ -43,6 +44,7 @@ using Schema = std::vector<SchemaTree::Node::id_t>;
 
 /**
  * Deserializes the parent ID of a schema tree node.
+ * @tparam ReaderType
  * @param reader
  * @return A result containing a pair or an error code indicating the failure:
  * - The pair:
@@ -52,23 +54,27 @@ using Schema = std::vector<SchemaTree::Node::id_t>;
  *   - Forwards `deserialize_tag`'s return values.
  * @return Forwards `deserialize_and_decode_schema_tree_node_id`'s return values.
  */
-[[nodiscard]] auto deserialize_schema_tree_node_parent_id(ReaderInterface& reader)
+template <IrReaderReq ReaderType>
+[[nodiscard]] auto deserialize_schema_tree_node_parent_id(ReaderType& reader)
         -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::Node::id_t>>;
 
 /**
  * Deserializes the key name of a schema tree node.
+ * @tparam ReaderType
  * @param reader
  * @param key_name Returns the deserialized key name.
  * @return IRErrorCode::IRErrorCode_Success on success.
  * @return Forwards `deserialize_tag`'s return values on failure.
  * @return Forwards `deserialize_string`'s return values on failure.
  */
+template <IrReaderReq ReaderType>
 [[nodiscard]] auto
-deserialize_schema_tree_node_key_name(ReaderInterface& reader, std::string& key_name)
+deserialize_schema_tree_node_key_name(ReaderType& reader, std::string& key_name)
         -> IRErrorCode;
 
 /**
  * Deserializes an integer value packet.
+ * @tparam ReaderType
  * @param reader
  * @param tag
  * @param val Returns the deserialized value.
@@ -77,11 +83,13 @@ deserialize_schema_tree_node_key_name(ReaderInterface& reader, std::string& key_
  * @return IRErrorCode::IRErrorCode_Corrupted_IR if the given tag doesn't correspond to an integer
  * packet.
  */
-[[nodiscard]] auto deserialize_int_val(ReaderInterface& reader, encoded_tag_t tag, value_int_t& val)
+template <IrReaderReq ReaderType>
+[[nodiscard]] auto deserialize_int_val(ReaderType& reader, encoded_tag_t tag, value_int_t& val)
         -> IRErrorCode;
 
 /**
  * Deserializes a string packet.
+ * @tparam ReaderType
  * @param reader
  * @param tag
  * @param deserialized_str Returns the deserialized string.
@@ -90,13 +98,15 @@ deserialize_schema_tree_node_key_name(ReaderInterface& reader, std::string& key_
  * @return IRErrorCode::IRErrorCode_Corrupted_IR if the given tag doesn't correspond to a string
  * packet.
  */
+template <IrReaderReq ReaderType>
 [[nodiscard]] auto
-deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& deserialized_str)
+deserialize_string(ReaderType& reader, encoded_tag_t tag, std::string& deserialized_str)
         -> IRErrorCode;
 
 /**
  * Deserializes the auto-generated node-ID-value pairs and the IDs of all user-generated keys in a
  * log event.
+ * @tparam ReaderType
  * @param reader
  * @param tag Takes the current tag as input and returns the last tag read.
  * @return A result containing a pair or an error code indicating the failure:
@@ -109,13 +119,15 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
  *   - std::err::protocol_error if the IR stream contains auto-generated key IDs *after* a
  *     user-generated key ID has been deserialized.
  */
+template <IrReaderReq ReaderType>
 [[nodiscard]] auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t& tag
 ) -> ystdlib::error_handling::Result<std::pair<KeyValuePairLogEvent::NodeIdValuePairs, Schema>>;
 
 /**
  * Deserializes the next value and pushes the result into `node_id_value_pairs`.
+ * @tparam ReaderType
  * @param reader
  * @param tag
  * @param node_id The node ID that corresponds to the value.
@@ -127,8 +139,9 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
  * @return Forwards `deserialize_encoded_text_ast_and_insert_to_node_id_value_pairs`'s return
  * values on any other failure.
  */
+template <IrReaderReq ReaderType>
 [[nodiscard]] auto deserialize_value_and_insert_to_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t tag,
         SchemaTree::Node::id_t node_id,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
@@ -137,6 +150,7 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
 /**
  * Deserializes an encoded text AST and pushes the result into node_id_value_pairs.
  * @tparam encoded_variable_t
+ * @tparam ReaderType
  * @param reader
  * @param node_id The node ID that corresponds to the value.
  * @param node_id_value_pairs Returns the ID-value pair constructed by the deserialized encoded text
@@ -145,13 +159,13 @@ deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& dese
  * @return Forwards `deserialize_tag`'s return values on failure.
  * @return Forwards `deserialize_encoded_text_ast`'s return values on failure.
  */
-template <typename encoded_variable_t>
+template <typename encoded_variable_t, IrReaderReq ReaderType>
 requires(
         std::is_same_v<ir::four_byte_encoded_variable_t, encoded_variable_t>
         || std::is_same_v<ir::eight_byte_encoded_variable_t, encoded_variable_t>
 )
 [[nodiscard]] auto deserialize_encoded_text_ast_and_insert_to_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         SchemaTree::Node::id_t node_id,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
 ) -> IRErrorCode;
@@ -159,6 +173,7 @@ requires(
 /**
  * Deserializes values and constructs ID-value pairs according to the given schema. The number of
  * values to deserialize is indicated by the size of the given schema.
+ * @tparam ReaderType
  * @param reader
  * @param tag
  * @param schema The log event's schema.
@@ -170,8 +185,9 @@ requires(
  * @return Forwards `deserialize_value_and_insert_to_node_id_value_pairs`'s return values on
  * failure.
  */
+template <IrReaderReq ReaderType>
 [[nodiscard]] auto deserialize_value_and_construct_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t tag,
         Schema const& schema,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
@@ -189,6 +205,50 @@ requires(
  */
 [[nodiscard]] auto is_encoded_key_id_tag(encoded_tag_t tag) -> bool;
 
+/**
+ * Generic implementation of `deserialize_ir_unit_schema_tree_node_insertion`.
+ * @tparam ReaderType
+ * @param reader
+ * @param tag
+ * @param key_name
+ * @return Same as `deserialize_ir_unit_schema_tree_node_insertion`.
+ */
+template <IrReaderReq ReaderType>
+[[nodiscard]] auto generic_deserialize_ir_unit_schema_tree_node_insertion(
+        ReaderType& reader,
+        encoded_tag_t tag,
+        std::string& key_name
+) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>>;
+
+/**
+ * Generic implementation of `deserialize_ir_unit_utc_offset_change`.
+ * @tparam ReaderType
+ * @param reader
+ * @return Same as `deserialize_ir_unit_utc_offset_change`.
+ */
+template <IrReaderReq ReaderType>
+[[nodiscard]] auto generic_deserialize_ir_unit_utc_offset_change(ReaderType& reader)
+        -> ystdlib::error_handling::Result<UtcOffset>;
+
+/**
+ * Generic implementation of `deserialize_ir_unit_kv_pair_log_event`.
+ * @tparam ReaderType
+ * @param reader
+ * @param tag
+ * @param auto_gen_keys_schema_tree
+ * @param user_gen_keys_schema_tree
+ * @param utc_offset
+ * @return Same as `deserialize_ir_unit_kv_pair_log_event`.
+ */
+template <IrReaderReq ReaderType>
+[[nodiscard]] auto generic_deserialize_ir_unit_kv_pair_log_event(
+        ReaderType& reader,
+        encoded_tag_t tag,
+        std::shared_ptr<SchemaTree> auto_gen_keys_schema_tree,
+        std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
+        UtcOffset utc_offset
+) -> ystdlib::error_handling::Result<KeyValuePairLogEvent>;
+
 auto schema_tree_node_tag_to_type(encoded_tag_t tag) -> std::optional<SchemaTree::Node::Type> {
     switch (tag) {
         case cProtocol::Payload::SchemaTreeNodeInt:
@@ -208,7 +268,8 @@ auto schema_tree_node_tag_to_type(encoded_tag_t tag) -> std::optional<SchemaTree
     }
 }
 
-auto deserialize_schema_tree_node_parent_id(ReaderInterface& reader)
+template <IrReaderReq ReaderType>
+auto deserialize_schema_tree_node_parent_id(ReaderType& reader)
         -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::Node::id_t>> {
     encoded_tag_t tag{};
     if (auto const err{deserialize_tag(reader, tag)}; IRErrorCode::IRErrorCode_Success != err) {
@@ -221,7 +282,8 @@ auto deserialize_schema_tree_node_parent_id(ReaderInterface& reader)
     >(tag, reader);
 }
 
-auto deserialize_schema_tree_node_key_name(ReaderInterface& reader, std::string& key_name)
+template <IrReaderReq ReaderType>
+auto deserialize_schema_tree_node_key_name(ReaderType& reader, std::string& key_name)
         -> IRErrorCode {
     encoded_tag_t str_packet_tag{};
     if (auto const err{deserialize_tag(reader, str_packet_tag)};
@@ -237,7 +299,8 @@ auto deserialize_schema_tree_node_key_name(ReaderInterface& reader, std::string&
     return IRErrorCode::IRErrorCode_Success;
 }
 
-auto deserialize_int_val(ReaderInterface& reader, encoded_tag_t tag, value_int_t& val)
+template <IrReaderReq ReaderType>
+auto deserialize_int_val(ReaderType& reader, encoded_tag_t tag, value_int_t& val)
         -> IRErrorCode {
     if (cProtocol::Payload::ValueInt8 == tag) {
         int8_t deserialized_val{};
@@ -269,7 +332,8 @@ auto deserialize_int_val(ReaderInterface& reader, encoded_tag_t tag, value_int_t
     return IRErrorCode::IRErrorCode_Success;
 }
 
-auto deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string& deserialized_str)
+template <IrReaderReq ReaderType>
+auto deserialize_string(ReaderType& reader, encoded_tag_t tag, std::string& deserialized_str)
         -> IRErrorCode {
     size_t str_length{};
     if (cProtocol::Payload::StrLenUByte == tag) {
@@ -299,8 +363,9 @@ auto deserialize_string(ReaderInterface& reader, encoded_tag_t tag, std::string&
     return IRErrorCode::IRErrorCode_Success;
 }
 
+template <IrReaderReq ReaderType>
 auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t& tag
 ) -> ystdlib::error_handling::Result<std::pair<KeyValuePairLogEvent::NodeIdValuePairs, Schema>> {
     KeyValuePairLogEvent::NodeIdValuePairs auto_gen_node_id_value_pairs;
@@ -379,8 +444,9 @@ auto deserialize_auto_gen_node_id_value_pairs_and_user_gen_schema(
     return {std::move(auto_gen_node_id_value_pairs), std::move(user_gen_schema)};
 }
 
+template <IrReaderReq ReaderType>
 auto deserialize_value_and_insert_to_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t tag,
         SchemaTree::Node::id_t node_id,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
@@ -455,13 +521,13 @@ auto deserialize_value_and_insert_to_node_id_value_pairs(
     return IRErrorCode::IRErrorCode_Success;
 }
 
-template <typename encoded_variable_t>
+template <typename encoded_variable_t, IrReaderReq ReaderType>
 requires(
         std::is_same_v<ir::four_byte_encoded_variable_t, encoded_variable_t>
         || std::is_same_v<ir::eight_byte_encoded_variable_t, encoded_variable_t>
 )
 [[nodiscard]] auto deserialize_encoded_text_ast_and_insert_to_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         SchemaTree::Node::id_t node_id,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
 ) -> IRErrorCode {
@@ -481,13 +547,18 @@ requires(
 
     node_id_value_pairs.emplace(
             node_id,
-            Value{ir::EncodedTextAst<encoded_variable_t>{logtype, dict_vars, encoded_vars}}
+            Value{ir::EncodedTextAst<encoded_variable_t>{
+                    std::move(logtype),
+                    std::move(dict_vars),
+                    std::move(encoded_vars)
+            }}
     );
     return IRErrorCode::IRErrorCode_Success;
 }
 
+template <IrReaderReq ReaderType>
 auto deserialize_value_and_construct_node_id_value_pairs(
-        ReaderInterface& reader,
+        ReaderType& reader,
         encoded_tag_t tag,
         Schema const& schema,
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
@@ -545,31 +616,10 @@ auto is_encoded_key_id_tag(encoded_tag_t tag) -> bool {
            || cProtocol::Payload::EncodedSchemaTreeNodeIdShort == tag
            || cProtocol::Payload::EncodedSchemaTreeNodeIdInt == tag;
 }
-}  // namespace
 
-auto get_ir_unit_type_from_tag(encoded_tag_t tag) -> std::optional<IrUnitType> {
-    // First, we check the tags that have one-to-one IR unit mapping
-    if (cProtocol::Eof == tag) {
-        return IrUnitType::EndOfStream;
-    }
-    if (cProtocol::Payload::UtcOffsetChange == tag) {
-        return IrUnitType::UtcOffsetChange;
-    }
-
-    // Then, check tags that may match any byte within a continuous range
-    if ((tag & cProtocol::Payload::SchemaTreeNodeMask) == cProtocol::Payload::SchemaTreeNodeMask) {
-        return IrUnitType::SchemaTreeNodeInsertion;
-    }
-
-    if (is_log_event_ir_unit_tag(tag)) {
-        return IrUnitType::LogEvent;
-    }
-
-    return std::nullopt;
-}
-
-auto deserialize_ir_unit_schema_tree_node_insertion(
-        ReaderInterface& reader,
+template <IrReaderReq ReaderType>
+auto generic_deserialize_ir_unit_schema_tree_node_insertion(
+        ReaderType& reader,
         encoded_tag_t tag,
         std::string& key_name
 ) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>> {
@@ -592,7 +642,8 @@ auto deserialize_ir_unit_schema_tree_node_insertion(
     return {is_auto_generated, SchemaTree::NodeLocator{parent_id, key_name, type.value()}};
 }
 
-auto deserialize_ir_unit_utc_offset_change(ReaderInterface& reader)
+template <IrReaderReq ReaderType>
+auto generic_deserialize_ir_unit_utc_offset_change(ReaderType& reader)
         -> ystdlib::error_handling::Result<UtcOffset> {
     UtcOffset utc_offset{0};
     if (auto const err{deserialize_utc_offset_change(reader, utc_offset)};
@@ -603,8 +654,9 @@ auto deserialize_ir_unit_utc_offset_change(ReaderInterface& reader)
     return utc_offset;
 }
 
-auto deserialize_ir_unit_kv_pair_log_event(
-        ReaderInterface& reader,
+template <IrReaderReq ReaderType>
+auto generic_deserialize_ir_unit_kv_pair_log_event(
+        ReaderType& reader,
         encoded_tag_t tag,
         std::shared_ptr<SchemaTree> auto_gen_keys_schema_tree,
         std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
@@ -645,4 +697,84 @@ auto deserialize_ir_unit_kv_pair_log_event(
             utc_offset
     );
 }
+}  // namespace
+
+auto get_ir_unit_type_from_tag(encoded_tag_t tag) -> std::optional<IrUnitType> {
+    // First, we check the tags that have one-to-one IR unit mapping
+    if (cProtocol::Eof == tag) {
+        return IrUnitType::EndOfStream;
+    }
+    if (cProtocol::Payload::UtcOffsetChange == tag) {
+        return IrUnitType::UtcOffsetChange;
+    }
+
+    // Then, check tags that may match any byte within a continuous range
+    if ((tag & cProtocol::Payload::SchemaTreeNodeMask) == cProtocol::Payload::SchemaTreeNodeMask) {
+        return IrUnitType::SchemaTreeNodeInsertion;
+    }
+
+    if (is_log_event_ir_unit_tag(tag)) {
+        return IrUnitType::LogEvent;
+    }
+
+    return std::nullopt;
+}
+
+auto deserialize_ir_unit_schema_tree_node_insertion(
+        ReaderInterface& reader,
+        encoded_tag_t tag,
+        std::string& key_name
+) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>> {
+    return generic_deserialize_ir_unit_schema_tree_node_insertion(reader, tag, key_name);
+}
+
+auto deserialize_ir_unit_schema_tree_node_insertion(
+        ByteSpanReader& reader,
+        encoded_tag_t tag,
+        std::string& key_name
+) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>> {
+    return generic_deserialize_ir_unit_schema_tree_node_insertion(reader, tag, key_name);
+}
+
+auto deserialize_ir_unit_utc_offset_change(ReaderInterface& reader)
+        -> ystdlib::error_handling::Result<UtcOffset> {
+    return generic_deserialize_ir_unit_utc_offset_change(reader);
+}
+
+auto deserialize_ir_unit_utc_offset_change(ByteSpanReader& reader)
+        -> ystdlib::error_handling::Result<UtcOffset> {
+    return generic_deserialize_ir_unit_utc_offset_change(reader);
+}
+
+auto deserialize_ir_unit_kv_pair_log_event(
+        ReaderInterface& reader,
+        encoded_tag_t tag,
+        std::shared_ptr<SchemaTree> auto_gen_keys_schema_tree,
+        std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
+        UtcOffset utc_offset
+) -> ystdlib::error_handling::Result<KeyValuePairLogEvent> {
+    return generic_deserialize_ir_unit_kv_pair_log_event(
+            reader,
+            tag,
+            std::move(auto_gen_keys_schema_tree),
+            std::move(user_gen_keys_schema_tree),
+            utc_offset
+    );
+}
+
+auto deserialize_ir_unit_kv_pair_log_event(
+        ByteSpanReader& reader,
+        encoded_tag_t tag,
+        std::shared_ptr<SchemaTree> auto_gen_keys_schema_tree,
+        std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
+        UtcOffset utc_offset
+) -> ystdlib::error_handling::Result<KeyValuePairLogEvent> {
+    return generic_deserialize_ir_unit_kv_pair_log_event(
+            reader,
+            tag,
+            std::move(auto_gen_keys_schema_tree),
+            std::move(user_gen_keys_schema_tree),
+            utc_offset
+    );
+}
 }  // namespace clp::ffi::ir_stream
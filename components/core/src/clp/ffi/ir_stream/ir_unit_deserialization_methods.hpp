@@ -12,6 +12,7 @@
 #include "../../time_types.hpp"
 #include "../KeyValuePairLogEvent.hpp"
 #include "../SchemaTree.hpp"
+#include "ByteSpanReader.hpp"
 #include "decoding_methods.hpp"
 #include "IrUnitType.hpp"
 
@@ -45,6 +46,16 @@ namespace clp::ffi::ir_stream {
         std::string& key_name
 ) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>>;
 
+/**
+ * Equivalent to `deserialize_ir_unit_schema_tree_node_insertion` above, but deserializes from IR
+ * that's already in memory.
+ */
+[[nodiscard]] auto deserialize_ir_unit_schema_tree_node_insertion(
+        ByteSpanReader& reader,
+        encoded_tag_t tag,
+        std::string& key_name
+) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::NodeLocator>>;
+
 /**
  * Deserializes a UTC offset change IR unit.
  * @param reader
@@ -55,6 +66,13 @@ namespace clp::ffi::ir_stream {
 [[nodiscard]] auto deserialize_ir_unit_utc_offset_change(ReaderInterface& reader)
         -> ystdlib::error_handling::Result<UtcOffset>;
 
+/**
+ * Equivalent to `deserialize_ir_unit_utc_offset_change` above, but deserializes from IR that's
+ * already in memory.
+ */
+[[nodiscard]] auto deserialize_ir_unit_utc_offset_change(ByteSpanReader& reader)
+        -> ystdlib::error_handling::Result<UtcOffset>;
+
 /**
  * Deserializes a key-value pair log event IR unit.
  * @param reader
@@ -80,6 +98,18 @@ namespace clp::ffi::ir_stream {
         std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
         UtcOffset utc_offset
 ) -> ystdlib::error_handling::Result<KeyValuePairLogEvent>;
+
+/**
+ * Equivalent to `deserialize_ir_unit_kv_pair_log_event` above, but deserializes from IR that's
+ * already in memory.
+ */
+[[nodiscard]] auto deserialize_ir_unit_kv_pair_log_event(
+        ByteSpanReader& reader,
+        encoded_tag_t tag,
+        std::shared_ptr<SchemaTree> auto_gen_keys_schema_tree,
+        std::shared_ptr<SchemaTree> user_gen_keys_schema_tree,
+        UtcOffset utc_offset
+) -> ystdlib::error_handling::Result<KeyValuePairLogEvent>;
 }  // namespace clp::ffi::ir_stream
 
 #endif  // CLP_FFI_IR_STREAM_IR_UNIT_DESERIALIZATION_METHODS_HPP
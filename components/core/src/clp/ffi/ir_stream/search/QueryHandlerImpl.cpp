@@ -565,14 +565,15 @@ auto QueryHandlerImpl::evaluate_filter_expr(
 
     ast_evaluation_result_bitmask_t evaluation_results{};
     for (auto const matchable_node_id : matchable_node_ids) {
-        if (false == node_id_value_pairs.contains(matchable_node_id)) {
+        auto const pair_it{node_id_value_pairs.find(matchable_node_id)};
+        if (node_id_value_pairs.end() == pair_it) {
             continue;
         }
         auto const evaluation_result{
                 YSTDLIB_ERROR_HANDLING_TRYX(evaluate_filter_against_node_id_value_pair(
                         filter_expr,
                         matchable_node_id,
-                        node_id_value_pairs.at(matchable_node_id),
+                        pair_it->second,
                         schema_tree,
                         m_case_sensitive_match
                 ))
@@ -17,6 +17,7 @@
 #include "../../ReaderInterface.hpp"
 #include "../../type_utils.hpp"
 #include "../SchemaTree.hpp"
+#include "ByteSpanReader.hpp"
 #include "byteswap.hpp"
 #include "decoding_methods.hpp"
 #include "encoding_methods.hpp"
@@ -44,12 +45,13 @@ auto serialize_int(integer_t value, std::vector<int8_t>& output_buf) -> void;
 /**
  * Deserializes an integer from the given reader
  * @tparam integer_t Type of the integer to deserialize
+ * @tparam ReaderType
  * @param reader
  * @param value Returns the deserialized integer
  * @return Whether the reader contained enough data to deserialize.
  */
-template <IntegerType integer_t>
-[[nodiscard]] auto deserialize_int(ReaderInterface& reader, integer_t& value) -> bool;
+template <IntegerType integer_t, IrReaderReq ReaderType>
+[[nodiscard]] auto deserialize_int(ReaderType& reader, integer_t& value) -> bool;
 
 /**
  * Serializes a string using CLP's encoding for unstructured text.
@@ -108,6 +110,7 @@ template <
  * @tparam one_byte_length_indicator_tag Tag for one-byte node ID encoding.
  * @tparam two_byte_length_indicator_tag Tag for two-byte node ID encoding.
  * @tparam four_byte_length_indicator_tag Tag for four-byte node ID encoding.
+ * @tparam ReaderType
  * @param length_indicator_tag
  * @param reader
  * @return A result containing a pair or an error code indicating the failure:
@@ -121,11 +124,12 @@ template <
 template <
         int8_t one_byte_length_indicator_tag,
         int8_t two_byte_length_indicator_tag,
-        int8_t four_byte_length_indicator_tag
+        int8_t four_byte_length_indicator_tag,
+        IrReaderReq ReaderType = ReaderInterface
 >
 [[nodiscard]] auto deserialize_and_decode_schema_tree_node_id(
         encoded_tag_t length_indicator_tag,
-        ReaderInterface& reader
+        ReaderType& reader
 ) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::Node::id_t>>;
 
 /**
@@ -152,8 +156,8 @@ auto serialize_int(integer_t value, std::vector<int8_t>& output_buf) -> void {
     output_buf.insert(output_buf.end(), data_view.begin(), data_view.end());
 }
 
-template <IntegerType integer_t>
-auto deserialize_int(ReaderInterface& reader, integer_t& value) -> bool {
+template <IntegerType integer_t, IrReaderReq ReaderType>
+auto deserialize_int(ReaderType& reader, integer_t& value) -> bool {
     integer_t value_little_endian;
     if (reader.try_read_numeric_value(value_little_endian) != clp::ErrorCode_Success) {
         return false;
@@ -239,11 +243,12 @@ auto encode_and_serialize_schema_tree_node_id(
 template <
         int8_t one_byte_length_indicator_tag,
         int8_t two_byte_length_indicator_tag,
-        int8_t four_byte_length_indicator_tag
+        int8_t four_byte_length_indicator_tag,
+        IrReaderReq ReaderType
 >
 auto deserialize_and_decode_schema_tree_node_id(
         encoded_tag_t length_indicator_tag,
-        ReaderInterface& reader
+        ReaderType& reader
 ) -> ystdlib::error_handling::Result<std::pair<bool, SchemaTree::Node::id_t>> {
     auto size_dependent_deserialize_and_decode_schema_tree_node_id
             = [&reader]<SignedIntegerType encoded_node_id_t>()
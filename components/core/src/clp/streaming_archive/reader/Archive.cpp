@@ -124,7 +124,24 @@ void Archive::refresh_dictionaries() {
 }
 
 ErrorCode Archive::open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix) {
-    return file.open_me(m_logtype_dictionary, file_metadata_ix, m_segment_manager);
+    return open_file(file, file_metadata_ix, m_segment_manager);
+}
+
+ErrorCode Archive::open_file(
+        File& file,
+        MetadataDB::FileIterator const& file_metadata_ix,
+        SegmentManager& segment_manager
+) {
+    return file.open_me(m_logtype_dictionary, file_metadata_ix, segment_manager);
+}
+
+void Archive::open_segment_manager(SegmentManager& segment_manager) const {
+    segment_manager.open(m_segments_dir_path);
+}
+
+void Archive::open_metadata_db(MetadataDB& metadata_db) const {
+    auto metadata_db_path = boost::filesystem::path(m_path) / cMetadataDBFileName;
+    metadata_db.open(metadata_db_path.string());
 }
 
 void Archive::close_file(File& file) {
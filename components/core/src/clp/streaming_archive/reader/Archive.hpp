@@ -16,6 +16,7 @@
 #include "../MetadataDB.hpp"
 #include "File.hpp"
 #include "Message.hpp"
+#include "SegmentManager.hpp"
 
 namespace clp::streaming_archive::reader {
 class Archive {
@@ -59,6 +60,33 @@ public:
      * @return Same as streaming_archive::reader::File::open_me
      */
     ErrorCode open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix);
+    /**
+     * Opens file with given path, reading its content through the given segment manager rather
+     * than the archive's own
+     * @param file
+     * @param file_metadata_ix
+     * @param segment_manager
+     * @return Same as streaming_archive::reader::File::open_me
+     */
+    ErrorCode open_file(
+            File& file,
+            MetadataDB::FileIterator const& file_metadata_ix,
+            SegmentManager& segment_manager
+    );
+
+    /**
+     * Opens the given segment manager on the archive's segments. Since neither a segment manager
+     * nor a metadata DB may be used concurrently, each thread that reads the archive's files in
+     * parallel needs its own of both, while the archive's dictionaries can be shared by all the
+     * threads.
+     * @param segment_manager
+     */
+    void open_segment_manager(SegmentManager& segment_manager) const;
+    /**
+     * Opens the given metadata DB on the archive's metadata. See `open_segment_manager`.
+     * @param metadata_db
+     */
+    void open_metadata_db(MetadataDB& metadata_db) const;
     /**
      * Wrapper for streaming_archive::reader::File::close_me
      * @param file
@@ -0,0 +1,117 @@
+#include "CandidateMessageFinder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace clp::streaming_archive::reader {
+void CandidateMessageFinder::index_logtypes(
+        logtype_dictionary_id_t const* logtypes,
+        size_t num_messages
+) {
+    clear();
+    m_num_messages = num_messages;
+    m_msgs_logtype_ix.resize(num_messages);
+
+    // Files typically use few logtypes, so a direct-mapped cache (indexed by a Fibonacci hash of
+    // the logtype ID) in front of the hash map resolves most messages without a hash map lookup.
+    constexpr size_t cNumCacheSlots{1024};
+    constexpr uint64_t cCacheSlotMultiplier{0x9E37'79B9'7F4A'7C15ULL};
+    constexpr int cCacheSlotShift{64 - std::countr_zero(cNumCacheSlots)};
+    std::array<logtype_dictionary_id_t, cNumCacheSlots> cached_logtype_ids;
+    cached_logtype_ids.fill(-1);
+    std::array<uint32_t, cNumCacheSlots> cached_logtype_ixs{};
+    absl::flat_hash_map<logtype_dictionary_id_t, uint32_t> logtype_ix_by_id;
+    for (size_t msg_ix = 0; msg_ix < num_messages; ++msg_ix) {
+        auto const logtype_id{logtypes[msg_ix]};
+        auto const slot{static_cast<size_t>(
+                (static_cast<uint64_t>(logtype_id) * cCacheSlotMultiplier) >> cCacheSlotShift
+        )};
+        if (cached_logtype_ids[slot] == logtype_id) {
+            m_msgs_logtype_ix[msg_ix] = cached_logtype_ixs[slot];
+            continue;
+        }
+        auto const [it, inserted] = logtype_ix_by_id.try_emplace(
+                logtype_id,
+                static_cast<uint32_t>(m_logtype_ids.size())
+        );
+        if (inserted) {
+            m_logtype_ids.push_back(logtype_id);
+        }
+        cached_logtype_ids[slot] = logtype_id;
+        cached_logtype_ixs[slot] = it->second;
+        m_msgs_logtype_ix[msg_ix] = it->second;
+    }
+    m_is_indexed = true;
+}
+
+void CandidateMessageFinder::compute_candidate_msgs(
+        Query const& query,
+        epochtime_t const* timestamps
+) {
+    // NOTE: Possible logtypes that the file doesn't use are never looked at
+    auto const num_logtypes{m_logtype_ids.size()};
+    m_logtype_is_candidate.assign(num_logtypes, 0);
+    auto const& sub_queries{query.get_relevant_sub_queries()};
+    for (size_t logtype_ix = 0; logtype_ix < num_logtypes; ++logtype_ix) {
+        m_logtype_is_candidate[logtype_ix] = static_cast<uint8_t>(std::any_of(
+                sub_queries.cbegin(),
+                sub_queries.cend(),
+                [&](SubQuery const* sub_query) {
+                    return sub_query->matches_logtype(m_logtype_ids[logtype_ix]);
+                }
+        ));
+    }
+
+    auto const search_begin_ts{query.get_search_begin_timestamp()};
+    auto const search_end_ts{query.get_search_end_timestamp()};
+    auto const* logtype_is_candidate{m_logtype_is_candidate.data()};
+    auto const* msgs_logtype_ix{m_msgs_logtype_ix.data()};
+    auto const num_words{(m_num_messages + cNumBitsPerWord - 1) / cNumBitsPerWord};
+    m_candidate_msgs_bitmap.resize(num_words);
+    for (size_t word_ix = 0; word_ix < num_words; ++word_ix) {
+        auto const begin_msg_ix{word_ix * cNumBitsPerWord};
+        auto const end_msg_ix{std::min<size_t>(begin_msg_ix + cNumBitsPerWord, m_num_messages)};
+
+        uint64_t word{0};
+        for (auto msg_ix{begin_msg_ix}; msg_ix < end_msg_ix; ++msg_ix) {
+            auto const timestamp{timestamps[msg_ix]};
+            uint64_t const is_candidate = logtype_is_candidate[msgs_logtype_ix[msg_ix]]
+                                          & static_cast<uint8_t>(search_begin_ts <= timestamp)
+                                          & static_cast<uint8_t>(timestamp <= search_end_ts);
+            word |= is_candidate << (msg_ix - begin_msg_ix);
+        }
+        m_candidate_msgs_bitmap[word_ix] = word;
+    }
+}
+
+size_t CandidateMessageFinder::get_next_candidate_msg_ix(size_t msg_ix) const {
+    auto word_ix{msg_ix / cNumBitsPerWord};
+    if (word_ix >= m_candidate_msgs_bitmap.size()) {
+        return m_num_messages;
+    }
+    // Ignore the messages before `msg_ix` in its word
+    auto word{m_candidate_msgs_bitmap[word_ix] & (~uint64_t{0} << (msg_ix % cNumBitsPerWord))};
+    while (0 == word) {
+        ++word_ix;
+        if (word_ix >= m_candidate_msgs_bitmap.size()) {
+            return m_num_messages;
+        }
+        word = m_candidate_msgs_bitmap[word_ix];
+    }
+    return word_ix * cNumBitsPerWord + std::countr_zero(word);
+}
+
+void CandidateMessageFinder::clear() {
+    m_num_messages = 0;
+    m_is_indexed = false;
+    m_logtype_ids.clear();
+    m_msgs_logtype_ix.clear();
+    m_logtype_is_candidate.clear();
+    m_candidate_msgs_bitmap.clear();
+}
+}  // namespace clp::streaming_archive::reader
@@ -0,0 +1,83 @@
+#ifndef CLP_STREAMING_ARCHIVE_READER_CANDIDATEMESSAGEFINDER_HPP
+#define CLP_STREAMING_ARCHIVE_READER_CANDIDATEMESSAGEFINDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../Defs.h"
+#include "../../Query.hpp"
+
+namespace clp::streaming_archive::reader {
+/**
+ * Finds the messages of a file that are candidates for a query, i.e., messages whose timestamp is in
+ * the query's time range and whose logtype is one of the possible logtypes of the query's relevant
+ * subqueries.
+ *
+ * All per-logtype state is indexed by the position of the logtype among the distinct logtypes used
+ * by the file, so its size doesn't depend on the size of the archive's logtype dictionary.
+ */
+class CandidateMessageFinder {
+public:
+    // Methods
+    /**
+     * Indexes the distinct logtypes used by a file's messages.
+     * @param logtypes The logtype ID of each message
+     * @param num_messages
+     */
+    void index_logtypes(logtype_dictionary_id_t const* logtypes, size_t num_messages);
+
+    /**
+     * @return Whether `index_logtypes` has been called since the finder was last cleared.
+     */
+    bool is_indexed() const { return m_is_indexed; }
+
+    /**
+     * @return The distinct logtypes used by the file, in order of first use.
+     */
+    std::vector<logtype_dictionary_id_t> const& get_logtype_ids() const { return m_logtype_ids; }
+
+    /**
+     * @param msg_ix
+     * @return The position of the given message's logtype in `get_logtype_ids()`.
+     */
+    uint32_t get_msg_logtype_ix(size_t msg_ix) const { return m_msgs_logtype_ix[msg_ix]; }
+
+    /**
+     * Computes which messages are candidates for the given query.
+     * @param query
+     * @param timestamps The timestamp of each message
+     */
+    void compute_candidate_msgs(Query const& query, epochtime_t const* timestamps);
+
+    /**
+     * @param msg_ix
+     * @return The index of the first candidate message at or after `msg_ix`, or the number of
+     * messages if there is none
+     */
+    size_t get_next_candidate_msg_ix(size_t msg_ix) const;
+
+    /**
+     * Clears the index and candidates so that the finder can be reused for another file.
+     */
+    void clear();
+
+private:
+    // Constants
+    static constexpr size_t cNumBitsPerWord{64};
+
+    // Variables
+    size_t m_num_messages{0};
+    bool m_is_indexed{false};
+    // Distinct logtypes used by the file
+    std::vector<logtype_dictionary_id_t> m_logtype_ids;
+    // Position of each message's logtype in `m_logtype_ids`
+    std::vector<uint32_t> m_msgs_logtype_ix;
+    // Whether each logtype in `m_logtype_ids` is a possible logtype of the last query
+    std::vector<uint8_t> m_logtype_is_candidate;
+    // One bit per message indicating whether the message is a candidate for the last query
+    std::vector<uint64_t> m_candidate_msgs_bitmap;
+};
+}  // namespace clp::streaming_archive::reader
+
+#endif  // CLP_STREAMING_ARCHIVE_READER_CANDIDATEMESSAGEFINDER_HPP
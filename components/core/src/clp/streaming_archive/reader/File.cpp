@@ -3,6 +3,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../Constants.hpp"
@@ -168,6 +172,10 @@ void File::close_me() {
     m_current_ts_in_milli = 0;
     m_timestamp_patterns.clear();
 
+    m_msgs_variables_begin_ix.clear();
+    m_candidate_msg_finder.clear();
+    m_candidate_msgs_query = nullptr;
+
     m_begin_ts = cEpochTimeMax;
     m_end_ts = cEpochTimeMin;
     m_orig_path.clear();
@@ -178,6 +186,9 @@ void File::close_me() {
 void File::reset_indices() {
     m_msgs_ix = 0;
     m_variables_ix = 0;
+
+    // The query's relevant subqueries may have changed, so its candidates must be recomputed
+    m_candidate_msgs_query = nullptr;
 }
 
 string const& File::get_orig_path() const {
@@ -250,27 +261,36 @@ bool File::find_message_in_time_range(
 }
 
 SubQuery const* File::find_message_matching_query(Query const& query, Message& msg) {
-    SubQuery const* matching_sub_query = nullptr;
-    while (m_msgs_ix < m_num_messages && nullptr == matching_sub_query) {
-        auto const curr_msg_ix{m_msgs_ix};
-        auto logtype_id = m_logtypes[curr_msg_ix];
+    if (m_msgs_variables_begin_ix.empty()) {
+        compute_msgs_variables_begin_ix();
+    }
+    if (&query != m_candidate_msgs_query) {
+        m_candidate_msg_finder.compute_candidate_msgs(query, m_timestamps);
+        m_candidate_msgs_query = &query;
+    }
 
-        // Get number of variables in logtype
-        auto const& logtype_dictionary_entry = m_archive_logtype_dict->get_entry(logtype_id);
-        auto const num_vars = logtype_dictionary_entry.get_num_variables();
+    while (true) {
+        auto const curr_msg_ix{m_candidate_msg_finder.get_next_candidate_msg_ix(m_msgs_ix)};
+        if (curr_msg_ix >= m_num_messages) {
+            m_msgs_ix = m_num_messages;
+            m_variables_ix = m_msgs_variables_begin_ix[m_num_messages];
+            return nullptr;
+        }
 
-        auto const vars_begin_ix{m_variables_ix};
-        auto const vars_end_ix{m_variables_ix + num_vars};
+        auto const vars_begin_ix{m_msgs_variables_begin_ix[curr_msg_ix]};
+        auto const vars_end_ix{m_msgs_variables_begin_ix[curr_msg_ix + 1]};
 
         // Advance indices
-        ++m_msgs_ix;
+        m_msgs_ix = curr_msg_ix + 1;
         m_variables_ix = vars_end_ix;
 
-        auto const timestamp{m_timestamps[curr_msg_ix]};
-        if (false == query.timestamp_is_in_search_time_range(timestamp)) {
-            continue;
+        if (vars_end_ix > m_num_variables) {
+            // Logtypes not in sync with variables, so stop search
+            m_msgs_ix = m_num_messages;
+            return nullptr;
         }
 
+        auto const logtype_id{m_logtypes[curr_msg_ix]};
         for (auto const* sub_query : query.get_relevant_sub_queries()) {
             if (false == sub_query->matches_logtype(logtype_id)) {
                 continue;
@@ -285,14 +305,36 @@ SubQuery const* File::find_message_matching_query(Query const& query, Message& m
             }
 
             msg.set_logtype_id(logtype_id);
-            msg.set_timestamp(timestamp);
+            msg.set_timestamp(m_timestamps[curr_msg_ix]);
             msg.set_msg_ix(m_begin_message_ix, curr_msg_ix);
-            matching_sub_query = sub_query;
-            break;
+            return sub_query;
         }
     }
+}
 
-    return matching_sub_query;
+void File::compute_msgs_variables_begin_ix() {
+    // Look up each logtype used by the file in the dictionary only once, rather than once per
+    // message
+    m_candidate_msg_finder.index_logtypes(m_logtypes, m_num_messages);
+    auto const& logtype_ids{m_candidate_msg_finder.get_logtype_ids()};
+    auto const num_dict_logtypes{m_archive_logtype_dict->get_entries().size()};
+    std::vector<uint64_t> logtype_num_vars(logtype_ids.size());
+    for (size_t logtype_ix = 0; logtype_ix < logtype_ids.size(); ++logtype_ix) {
+        auto const logtype_id{logtype_ids[logtype_ix]};
+        if (logtype_id < 0 || static_cast<size_t>(logtype_id) >= num_dict_logtypes) {
+            throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+        logtype_num_vars[logtype_ix]
+                = m_archive_logtype_dict->get_entry(logtype_id).get_num_variables();
+    }
+
+    m_msgs_variables_begin_ix.resize(m_num_messages + 1);
+    m_msgs_variables_begin_ix[0] = 0;
+    for (size_t msg_ix = 0; msg_ix < m_num_messages; ++msg_ix) {
+        m_msgs_variables_begin_ix[msg_ix + 1]
+                = m_msgs_variables_begin_ix[msg_ix]
+                  + logtype_num_vars[m_candidate_msg_finder.get_msg_logtype_ix(msg_ix)];
+    }
 }
 
 bool File::get_next_message(Message& msg) {
@@ -1,6 +1,8 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 #define CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <set>
 #include <vector>
@@ -11,6 +13,7 @@
 #include "../../Query.hpp"
 #include "../../TimestampPattern.hpp"
 #include "../MetadataDB.hpp"
+#include "CandidateMessageFinder.hpp"
 #include "Message.hpp"
 #include "SegmentManager.hpp"
 
@@ -114,12 +117,22 @@ private:
     );
     /**
      * Finds message matching the given query
+     *
+     * NOTE: Only messages that are candidates for the query (see `CandidateMessageFinder`) are
+     * matched against the query's subqueries, and the variables of each candidate are located
+     * using `m_msgs_variables_begin_ix` rather than by walking every preceding message.
      * @param query
      * @param msg
      * @return nullptr if no message matched
      * @return pointer to matching subquery otherwise
      */
     SubQuery const* find_message_matching_query(Query const& query, Message& msg);
+    /**
+     * Computes the index of the first variable of each message in the file, using the number of
+     * variables in each message's logtype.
+     * @throw OperationFailed if a message's logtype isn't in the logtype dictionary
+     */
+    void compute_msgs_variables_begin_ix();
     /**
      * Get next message in file
      * @param msg
@@ -157,6 +170,12 @@ private:
     epochtime_t* m_timestamps;
     encoded_variable_t* m_variables;
 
+    // Index of each message's first variable, followed by the total number of variables
+    std::vector<uint64_t> m_msgs_variables_begin_ix;
+    CandidateMessageFinder m_candidate_msg_finder;
+    // The query whose candidates were last computed by `m_candidate_msg_finder`
+    Query const* m_candidate_msgs_query{nullptr};
+
     size_t m_current_ts_pattern_ix;
     epochtime_t m_current_ts_in_milli;
 
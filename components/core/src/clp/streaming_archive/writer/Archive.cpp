@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <boost/asio.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -121,6 +122,7 @@ void Archive::open(UserConfig const& user_config) {
     m_target_segment_uncompressed_size = user_config.target_segment_uncompressed_size;
     m_next_segment_id = 0;
     m_compression_level = user_config.compression_level;
+    m_segment_frame_size = user_config.segment_frame_size;
 
     /// TODO: add schema file size to m_stable_size???
     // Copy schema file into archive
@@ -156,6 +158,7 @@ void Archive::open(UserConfig const& user_config) {
     }
 
     m_global_metadata_db = user_config.global_metadata_db;
+    m_global_metadata_db_mutex = user_config.global_metadata_db_mutex;
 
     m_file = nullptr;
 
@@ -236,6 +239,7 @@ void Archive::close() {
 
     update_global_metadata();
     m_global_metadata_db = nullptr;
+    m_global_metadata_db_mutex = nullptr;
 
     for (auto* file : m_file_metadata_for_global_update) {
         delete file;
@@ -504,7 +508,12 @@ void Archive::append_file_contents_to_segment(
         vector<File*>& files_in_segment
 ) {
     if (!segment.is_open()) {
-        segment.open(m_segments_dir_path, m_next_segment_id++, m_compression_level);
+        segment.open(
+                m_segments_dir_path,
+                m_next_segment_id++,
+                m_compression_level,
+                m_segment_frame_size
+        );
     }
 
     m_file->append_to_segment(m_logtype_dict, segment);
@@ -652,6 +661,10 @@ void Archive::update_local_metadata() {
 }
 
 auto Archive::update_global_metadata() -> void {
+    std::unique_lock<std::mutex> global_metadata_db_lock;
+    if (nullptr != m_global_metadata_db_mutex) {
+        global_metadata_db_lock = std::unique_lock<std::mutex>{*m_global_metadata_db_mutex};
+    }
     m_global_metadata_db->open();
     if (false == m_local_metadata.has_value()) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -34,6 +35,8 @@ public:
      * @param creation_num
      * @param target_segment_uncompressed_size
      * @param compression_level Compression level of the compressor being opened
+     * @param segment_frame_size Maximum uncompressed size of each independently decompressible
+     * frame in a segment, or 0 to compress each segment as a single frame
      * @param output_dir Output directory
      * @param global_metadata_db
      * @param print_archive_stats_progress Enable printing statistics about the archive as it's
@@ -45,8 +48,12 @@ public:
         size_t creation_num;
         size_t target_segment_uncompressed_size;
         int compression_level;
+        size_t segment_frame_size{0};
         std::string output_dir;
         GlobalMetadataDB* global_metadata_db;
+        // Mutex held while updating the global metadata DB, if the DB is shared with archives
+        // being written by other threads
+        std::mutex* global_metadata_db_mutex{nullptr};
         bool print_archive_stats_progress;
     };
 
@@ -347,6 +354,7 @@ private:
             m_var_ids_in_segment_for_files_without_timestamps;
 
     int m_compression_level;
+    size_t m_segment_frame_size{0};
 
     MetadataDB m_metadata_db;
 
@@ -354,6 +362,7 @@ private:
     FileWriter m_metadata_file_writer;
 
     GlobalMetadataDB* m_global_metadata_db;
+    std::mutex* m_global_metadata_db_mutex{nullptr};
 
     bool m_print_archive_stats_progress;
 };
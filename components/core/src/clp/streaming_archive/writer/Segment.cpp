@@ -26,7 +26,12 @@ Segment::~Segment() {
     }
 }
 
-void Segment::open(string const& segments_dir_path, segment_id_t id, int compression_level) {
+void Segment::open(
+        string const& segments_dir_path,
+        segment_id_t id,
+        int compression_level,
+        size_t max_frame_size
+) {
     if (!m_segment_path.empty()) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
@@ -44,7 +49,7 @@ void Segment::open(string const& segments_dir_path, segment_id_t id, int compres
 #if USE_PASSTHROUGH_COMPRESSION
     m_compressor.open(m_file_writer);
 #elif USE_ZSTD_COMPRESSION
-    m_compressor.open(m_file_writer, compression_level);
+    m_compressor.open(m_file_writer, compression_level, max_frame_size);
 #else
     static_assert(false, "Unsupported compression mode.");
 #endif
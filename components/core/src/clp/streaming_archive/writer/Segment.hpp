@@ -44,10 +44,18 @@ public:
      * @param segments_dir_path
      * @param id
      * @param compression_level
+     * @param max_frame_size Maximum uncompressed size of each independently decompressible frame,
+     * or 0 to compress the segment as a single frame. Frames let readers seek directly to the
+     * content they need instead of decompressing the segment from its beginning.
      * @throw streaming_archive::writer::Segment::OperationFailed if segment wasn't closed
      * before this call
      */
-    void open(std::string const& segments_dir_path, segment_id_t id, int compression_level);
+    void open(
+            std::string const& segments_dir_path,
+            segment_id_t id,
+            int compression_level,
+            size_t max_frame_size = 0
+    );
     /**
      * Closes the segment
      * @throw streaming_archive::writer::Segment::OperationFailed if compression fails
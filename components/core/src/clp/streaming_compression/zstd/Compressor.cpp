@@ -1,6 +1,9 @@
 #include "Compressor.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 #include <zstd.h>
@@ -8,8 +11,23 @@
 #include "../../ErrorCode.hpp"
 #include "../../TraceableException.hpp"
 #include "../../WriterInterface.hpp"
+#include "Constants.hpp"
 
 namespace clp::streaming_compression::zstd {
+namespace {
+/**
+ * Appends the given value to the buffer in little-endian byte order, as required by zstd's
+ * seekable format.
+ * @param value
+ * @param buffer
+ */
+auto append_little_endian(uint32_t value, std::vector<char>& buffer) -> void {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFFU));
+    }
+}
+}  // namespace
+
 Compressor::Compressor()
         : m_compressed_stream_block_buffer(ZSTD_CStreamOutSize()),
           m_compressed_stream_block{
@@ -27,10 +45,15 @@ Compressor::~Compressor() {
     ZSTD_freeCStream(m_compression_stream);
 }
 
-auto Compressor::open(WriterInterface& writer, int compression_level) -> void {
+auto Compressor::open(WriterInterface& writer, int compression_level, size_t max_frame_size)
+        -> void {
     if (nullptr != m_compressed_stream_writer) {
         throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
     }
+    // Each frame's compressed and uncompressed sizes must fit in the seek table's 32-bit fields
+    if (max_frame_size > 0 && ZSTD_compressBound(max_frame_size) > UINT32_MAX) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
 
     // Setup compression stream
     auto const init_result{ZSTD_initCStream(m_compression_stream, compression_level)};
@@ -45,6 +68,11 @@ auto Compressor::open(WriterInterface& writer, int compression_level) -> void {
     m_compressed_stream_writer = &writer;
 
     m_uncompressed_stream_pos = 0;
+
+    m_max_frame_size = max_frame_size;
+    m_frame_uncompressed_size = 0;
+    m_frame_compressed_size = 0;
+    m_seek_table.clear();
 }
 
 auto Compressor::close() -> void {
@@ -53,6 +81,9 @@ auto Compressor::close() -> void {
     }
 
     flush();
+    if (m_max_frame_size > 0) {
+        write_seek_table();
+    }
     m_compressed_stream_writer = nullptr;
 }
 
@@ -69,6 +100,25 @@ auto Compressor::write(char const* data, size_t data_length) -> void {
         throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
     }
 
+    if (0 == m_max_frame_size) {
+        compress(data, data_length);
+        return;
+    }
+
+    // End the current frame whenever it reaches the maximum frame size
+    while (data_length > 0) {
+        auto const num_bytes_to_compress
+                = std::min(data_length, m_max_frame_size - m_frame_uncompressed_size);
+        compress(data, num_bytes_to_compress);
+        data += num_bytes_to_compress;
+        data_length -= num_bytes_to_compress;
+        if (m_frame_uncompressed_size == m_max_frame_size) {
+            flush();
+        }
+    }
+}
+
+auto Compressor::compress(char const* data, size_t data_length) -> void {
     ZSTD_inBuffer uncompressed_stream_block = {data, data_length, 0};
     while (uncompressed_stream_block.pos < uncompressed_stream_block.size) {
         m_compressed_stream_block.pos = 0;
@@ -87,15 +137,13 @@ auto Compressor::write(char const* data, size_t data_length) -> void {
         if (m_compressed_stream_block.pos > 0) {
             // Write to disk only if there is data in the compressed stream
             // block buffer
-            m_compressed_stream_writer->write(
-                    static_cast<char const*>(m_compressed_stream_block.dst),
-                    m_compressed_stream_block.pos
-            );
+            write_compressed_stream_block();
         }
     }
 
     m_compression_stream_contains_data = true;
     m_uncompressed_stream_pos += data_length;
+    m_frame_uncompressed_size += data_length;
 }
 
 auto Compressor::flush() -> void {
@@ -114,10 +162,16 @@ auto Compressor::flush() -> void {
         );
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
-    m_compressed_stream_writer->write(
-            static_cast<char const*>(m_compressed_stream_block.dst),
-            m_compressed_stream_block.pos
-    );
+    write_compressed_stream_block();
+
+    if (m_max_frame_size > 0) {
+        m_seek_table.push_back(
+                {.compressed_size = static_cast<uint32_t>(m_frame_compressed_size),
+                 .uncompressed_size = static_cast<uint32_t>(m_frame_uncompressed_size)}
+        );
+    }
+    m_frame_uncompressed_size = 0;
+    m_frame_compressed_size = 0;
 
     m_compression_stream_contains_data = false;
 }
@@ -147,14 +201,41 @@ auto Compressor::flush_without_ending_frame() -> void {
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
         }
         if (m_compressed_stream_block.pos > 0) {
-            m_compressed_stream_writer->write(
-                    static_cast<char const*>(m_compressed_stream_block.dst),
-                    m_compressed_stream_block.pos
-            );
+            write_compressed_stream_block();
         }
         if (0 == flush_result) {
             break;
         }
     }
 }
+
+auto Compressor::write_compressed_stream_block() -> void {
+    m_compressed_stream_writer->write(
+            static_cast<char const*>(m_compressed_stream_block.dst),
+            m_compressed_stream_block.pos
+    );
+    m_frame_compressed_size += m_compressed_stream_block.pos;
+}
+
+auto Compressor::write_seek_table() -> void {
+    auto const seek_table_size{
+            m_seek_table.size() * seekable::cSeekTableEntrySize + seekable::cSeekTableFooterSize
+    };
+    std::vector<char> buffer;
+    buffer.reserve(seekable::cSkippableFrameHeaderSize + seek_table_size);
+
+    append_little_endian(seekable::cSkippableFrameMagicNumber, buffer);
+    append_little_endian(static_cast<uint32_t>(seek_table_size), buffer);
+    for (auto const& entry : m_seek_table) {
+        append_little_endian(entry.compressed_size, buffer);
+        append_little_endian(entry.uncompressed_size, buffer);
+    }
+    append_little_endian(static_cast<uint32_t>(m_seek_table.size()), buffer);
+    // Seek table descriptor: no checksums
+    buffer.push_back(0);
+    append_little_endian(seekable::cSeekableMagicNumber, buffer);
+
+    m_compressed_stream_writer->write(buffer.data(), buffer.size());
+    m_seek_table.clear();
+}
 }  // namespace clp::streaming_compression::zstd
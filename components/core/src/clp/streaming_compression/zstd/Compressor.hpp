@@ -2,6 +2,8 @@
 #define CLP_STREAMING_COMPRESSION_ZSTD_COMPRESSOR_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include <ystdlib/containers/Array.hpp>
 #include <zstd.h>
@@ -83,7 +85,22 @@ public:
      * @param writer
      * @param compression_level
      */
-    auto open(WriterInterface& writer, int compression_level) -> void;
+    auto open(WriterInterface& writer, int compression_level) -> void {
+        this->open(writer, compression_level, 0);
+    }
+
+    /**
+     * Initializes the compression stream with the given compression level. If `max_frame_size` is
+     * non-zero, the stream is split into independently decompressible frames of at most
+     * `max_frame_size` uncompressed bytes, and a seek table in zstd's seekable format is appended
+     * when the compressor is closed. Decompressors can use the seek table to jump directly to the
+     * frame containing a given position, while other zstd decompressors ignore it.
+     * @param writer
+     * @param compression_level
+     * @param max_frame_size
+     * @throw OperationFailed if `max_frame_size` can't be represented in the seek table
+     */
+    auto open(WriterInterface& writer, int compression_level, size_t max_frame_size) -> void;
 
     /**
      * Flushes the stream without ending the current frame
@@ -91,6 +108,30 @@ public:
     auto flush_without_ending_frame() -> void;
 
 private:
+    // Types
+    struct SeekTableEntry {
+        uint32_t compressed_size;
+        uint32_t uncompressed_size;
+    };
+
+    // Methods
+    /**
+     * Compresses the given data into the current frame
+     * @param data
+     * @param data_length
+     */
+    auto compress(char const* data, size_t data_length) -> void;
+
+    /**
+     * Writes the contents of the compressed stream block buffer to the underlying writer
+     */
+    auto write_compressed_stream_block() -> void;
+
+    /**
+     * Writes the seek table describing every frame written since the compressor was opened
+     */
+    auto write_seek_table() -> void;
+
     // Variables
     WriterInterface* m_compressed_stream_writer{nullptr};
 
@@ -102,6 +143,12 @@ private:
     ZSTD_outBuffer m_compressed_stream_block;
 
     size_t m_uncompressed_stream_pos{0};
+
+    // Seekable format variables
+    size_t m_max_frame_size{0};
+    size_t m_frame_uncompressed_size{0};
+    size_t m_frame_compressed_size{0};
+    std::vector<SeekTableEntry> m_seek_table;
 };
 }  // namespace clp::streaming_compression::zstd
 
@@ -1,8 +1,26 @@
 #ifndef CLP_STREAMING_COMPRESSION_ZSTD_CONSTANTS_HPP
 #define CLP_STREAMING_COMPRESSION_ZSTD_CONSTANTS_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 namespace clp::streaming_compression::zstd {
 constexpr int cDefaultCompressionLevel{3};
+
+/**
+ * Constants of zstd's seekable format (see zstd's contrib/seekable_format), which appends a seek
+ * table describing every frame of a stream in a skippable frame at the end of the stream.
+ */
+namespace seekable {
+constexpr uint32_t cSkippableFrameMagicNumber{0x184D'2A5E};
+constexpr uint32_t cSeekableMagicNumber{0x8F92'EAB1};
+constexpr size_t cSkippableFrameHeaderSize{8};
+constexpr size_t cSeekTableFooterSize{9};
+constexpr size_t cSeekTableEntrySize{8};
+constexpr size_t cSeekTableEntryWithChecksumSize{12};
+constexpr uint8_t cChecksumFlag{1U << 7U};
+constexpr uint8_t cReservedDescriptorBits{0x7C};
+}  // namespace seekable
 }  // namespace clp::streaming_compression::zstd
 
 #endif  // CLP_STREAMING_COMPRESSION_ZSTD_CONSTANTS_HPP
@@ -1,14 +1,34 @@
 #include "Decompressor.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 #include "../../Defs.h"
 #include "../../ErrorCode.hpp"
 #include "../../ReadOnlyMemoryMappedFile.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../../TraceableException.hpp"
+#include "Constants.hpp"
 
 namespace clp::streaming_compression::zstd {
+namespace {
+/**
+ * @param buf
+ * @return The little-endian 32-bit value at the beginning of `buf`
+ */
+auto read_little_endian(char const* buf) -> uint32_t {
+    uint32_t value{0};
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(buf[i])) << (i * 8);
+    }
+    return value;
+}
+}  // namespace
+
 Decompressor::Decompressor()
         : ::clp::streaming_compression::Decompressor{CompressorType::ZSTD},
           m_decompression_stream{ZSTD_createDStream()},
@@ -79,10 +99,25 @@ auto Decompressor::try_seek_from_begin(size_t pos) -> ErrorCode {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
-    // Check if we've already decompressed passed the desired position
-    if (m_decompressed_stream_pos > pos) {
-        // ZStd has no way for us to seek back to the desired position, so just reset the stream
-        // to the beginning
+    if (false == m_frame_decompressed_offsets.empty()) {
+        // Jump to the frame containing the desired position unless we can reach it by continuing
+        // to decompress the current frame
+        auto const frame_it = std::upper_bound(
+                m_frame_decompressed_offsets.cbegin(),
+                m_frame_decompressed_offsets.cend(),
+                pos
+        );
+        auto const frame_idx = static_cast<size_t>(
+                std::distance(m_frame_decompressed_offsets.cbegin(), frame_it) - 1
+        );
+        if (m_decompressed_stream_pos > pos
+            || m_decompressed_stream_pos < m_frame_decompressed_offsets[frame_idx])
+        {
+            reset_stream_to_frame(frame_idx);
+        }
+    } else if (m_decompressed_stream_pos > pos) {
+        // We've already decompressed past the desired position. ZStd has no way for us to seek
+        // back to the desired position, so just reset the stream to the beginning
         reset_stream();
     }
 
@@ -123,6 +158,7 @@ auto Decompressor::open(char const* compressed_data_buf, size_t compressed_data_
     m_compressed_stream_block = {compressed_data_buf, compressed_data_buf_size, 0};
 
     reset_stream();
+    load_seek_table();
 }
 
 auto Decompressor::open(ReaderInterface& reader, size_t read_buffer_capacity) -> void {
@@ -163,6 +199,8 @@ auto Decompressor::close() -> void {
         default:
             throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
     }
+    m_frame_compressed_offsets.clear();
+    m_frame_decompressed_offsets.clear();
     m_input_type = InputType::NotInitialized;
 }
 
@@ -180,6 +218,7 @@ auto Decompressor::open(std::string const& compressed_file_path) -> ErrorCode {
     m_compressed_stream_block = {file_view.data(), file_view.size(), 0};
 
     reset_stream();
+    load_seek_table();
 
     return ErrorCode_Success;
 }
@@ -246,4 +285,72 @@ auto Decompressor::reset_stream() -> void {
 
     m_compressed_stream_block.pos = 0;
 }
+
+auto Decompressor::load_seek_table() -> void {
+    m_frame_compressed_offsets.clear();
+    m_frame_decompressed_offsets.clear();
+
+    auto const* stream = static_cast<char const*>(m_compressed_stream_block.src);
+    auto const stream_size = m_compressed_stream_block.size;
+    if (stream_size < seekable::cSkippableFrameHeaderSize + seekable::cSeekTableFooterSize) {
+        return;
+    }
+
+    // Parse the footer
+    auto const* footer = stream + stream_size - seekable::cSeekTableFooterSize;
+    auto const num_frames = static_cast<size_t>(read_little_endian(footer));
+    auto const descriptor = static_cast<uint8_t>(footer[sizeof(uint32_t)]);
+    if (seekable::cSeekableMagicNumber != read_little_endian(footer + sizeof(uint32_t) + 1)
+        || 0 != (descriptor & seekable::cReservedDescriptorBits))
+    {
+        return;
+    }
+    auto const entry_size = (0 != (descriptor & seekable::cChecksumFlag))
+                                    ? seekable::cSeekTableEntryWithChecksumSize
+                                    : seekable::cSeekTableEntrySize;
+
+    // Validate the skippable frame containing the seek table
+    auto const seek_table_size = num_frames * entry_size + seekable::cSeekTableFooterSize;
+    if (stream_size < seekable::cSkippableFrameHeaderSize + seek_table_size) {
+        return;
+    }
+    auto const seek_table_frame_offset
+            = stream_size - seek_table_size - seekable::cSkippableFrameHeaderSize;
+    auto const* seek_table_frame = stream + seek_table_frame_offset;
+    if (seekable::cSkippableFrameMagicNumber != read_little_endian(seek_table_frame)
+        || seek_table_size != read_little_endian(seek_table_frame + sizeof(uint32_t)))
+    {
+        return;
+    }
+
+    std::vector<size_t> compressed_offsets;
+    std::vector<size_t> decompressed_offsets;
+    compressed_offsets.reserve(num_frames);
+    decompressed_offsets.reserve(num_frames);
+    size_t compressed_offset{0};
+    size_t decompressed_offset{0};
+    auto const* entry = seek_table_frame + seekable::cSkippableFrameHeaderSize;
+    for (size_t i = 0; i < num_frames; ++i) {
+        compressed_offsets.push_back(compressed_offset);
+        decompressed_offsets.push_back(decompressed_offset);
+        compressed_offset += read_little_endian(entry);
+        decompressed_offset += read_little_endian(entry + sizeof(uint32_t));
+        entry += entry_size;
+    }
+
+    // The frames must exactly fill the stream preceding the seek table
+    if (0 == num_frames || compressed_offset != seek_table_frame_offset) {
+        return;
+    }
+    m_frame_compressed_offsets = std::move(compressed_offsets);
+    m_frame_decompressed_offsets = std::move(decompressed_offsets);
+}
+
+auto Decompressor::reset_stream_to_frame(size_t frame_idx) -> void {
+    ZSTD_initDStream(m_decompression_stream);
+    m_decompressed_stream_pos = m_frame_decompressed_offsets[frame_idx];
+    m_zstd_frame_might_have_more_data = false;
+
+    m_compressed_stream_block.pos = m_frame_compressed_offsets[frame_idx];
+}
 }  // namespace clp::streaming_compression::zstd
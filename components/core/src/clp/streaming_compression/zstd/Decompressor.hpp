@@ -1,9 +1,11 @@
 #ifndef CLP_STREAMING_COMPRESSION_ZSTD_DECOMPRESSOR_HPP
 #define CLP_STREAMING_COMPRESSION_ZSTD_DECOMPRESSOR_HPP
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <ystdlib/containers/Array.hpp>
 #include <zstd.h>
@@ -63,7 +65,10 @@ public:
     [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
             -> ErrorCode override;
     /**
-     * Tries to seek from the beginning to the given position
+     * Tries to seek from the beginning to the given position. If the stream ends with a seek table
+     * (see `Compressor::open`), decompression restarts from the frame containing the position;
+     * otherwise, the stream is decompressed from its beginning (or from the current position when
+     * seeking forwards) up to the position.
      * @param pos
      * @return ErrorCode_NotInit if the decompressor is not open
      * @return Same as ReaderInterface::try_read_exact_length
@@ -135,6 +140,19 @@ private:
      */
     void reset_stream();
 
+    /**
+     * Loads the seek table from the end of the compressed stream, if the stream is fully in memory
+     * and has a valid seek table. Otherwise, the seek table is left empty.
+     */
+    void load_seek_table();
+
+    /**
+     * Resets the streaming decompression state so that it will start decompressing from the
+     * beginning of the given frame
+     * @param frame_idx Index of the frame in the seek table
+     */
+    void reset_stream_to_frame(size_t frame_idx);
+
     // Variables
     InputType m_input_type{InputType::NotInitialized};
 
@@ -154,6 +172,11 @@ private:
     bool m_zstd_frame_might_have_more_data{false};
 
     ystdlib::containers::Array<char> m_unused_decompressed_stream_block_buffer;
+
+    // The compressed and decompressed offsets of the beginning of every frame, loaded from the
+    // stream's seek table
+    std::vector<size_t> m_frame_compressed_offsets;
+    std::vector<size_t> m_frame_decompressed_offsets;
 };
 }  // namespace clp::streaming_compression::zstd
 #endif  // CLP_STREAMING_COMPRESSION_ZSTD_DECOMPRESSOR_HPP
@@ -1,11 +1,16 @@
 #include "ArchiveReader.hpp"
 
+#include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string_view>
+#include <vector>
 
 #include "archive_constants.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "InputConfig.hpp"
+#include "PackedStreamPrefetcher.hpp"
 #include "ReaderUtils.hpp"
 
 using std::string_view;
@@ -140,6 +145,40 @@ void ArchiveReader::open_packed_streams() {
     m_stream_reader.open_packed_streams(m_archive_reader_adaptor);
 }
 
+void ArchiveReader::rewind_packed_streams() {
+    m_stream_prefetcher.reset();
+    m_stream_reader.rewind();
+}
+
+void ArchiveReader::prefetch_schema_tables(std::span<int32_t const> schema_ids) {
+    if (0 == m_num_prefetched_streams || schema_ids.empty()) {
+        return;
+    }
+    if (nullptr != m_stream_prefetcher) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+
+    // Tables sharing a stream are adjacent, so the streams are deduplicated as they're collected
+    std::vector<size_t> stream_ids;
+    for (auto const schema_id : schema_ids) {
+        auto const stream_id{get_schema_metadata(schema_id).stream_id};
+        if (false == stream_ids.empty() && stream_ids.back() >= stream_id) {
+            if (stream_ids.back() == stream_id) {
+                continue;
+            }
+            throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+        }
+        stream_ids.push_back(stream_id);
+    }
+
+    m_stream_prefetcher = std::make_unique<PackedStreamPrefetcher>(
+            m_stream_reader,
+            std::move(stream_ids),
+            m_num_prefetched_streams
+    );
+    m_stream_prefetcher->start_prefetching();
+}
+
 SchemaReader& ArchiveReader::read_schema_table(
         int32_t schema_id,
         bool should_extract_timestamp,
@@ -354,11 +393,13 @@ void ArchiveReader::initialize_schema_reader(
 }
 
 void ArchiveReader::store(FileWriter& writer) {
-    std::string message;
+    constexpr size_t cMaxNumMessagesPerBatch{1024};
+    std::string messages;
     for (auto schema_id : m_schema_ids) {
         auto& schema_reader = read_schema_table(schema_id, false, true);
-        while (schema_reader.get_next_message(message)) {
-            writer.write(message.c_str(), message.length());
+        while (schema_reader.get_next_messages(messages, cMaxNumMessagesPerBatch) > 0) {
+            writer.write(messages.c_str(), messages.length());
+            messages.clear();
         }
     }
 }
@@ -373,6 +414,7 @@ void ArchiveReader::close() {
     m_log_dict->close();
     m_array_dict->close();
 
+    m_stream_prefetcher.reset();
     m_stream_reader.close();
     m_archive_reader_adaptor.reset();
 
@@ -389,6 +431,16 @@ std::shared_ptr<char[]> ArchiveReader::read_stream(size_t stream_id, bool reuse_
         return m_stream_buffer;
     }
 
+    if (nullptr != m_stream_prefetcher) {
+        // The prefetcher's buffers return to it once no schema reader refers to them, so the
+        // buffer is released regardless of `reuse_buffer`.
+        m_stream_buffer.reset();
+        m_stream_buffer_size = 0;
+        m_stream_prefetcher->get_stream(stream_id, m_stream_buffer, m_stream_buffer_size);
+        m_cur_stream_id = stream_id;
+        return m_stream_buffer;
+    }
+
     if (false == reuse_buffer) {
         m_stream_buffer.reset();
         m_stream_buffer_size = 0;
@@ -1,7 +1,9 @@
 #ifndef CLP_S_ARCHIVEREADER_HPP
 #define CLP_S_ARCHIVEREADER_HPP
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <set>
 #include <span>
 #include <string_view>
@@ -10,10 +12,12 @@
 #include "ArchiveReaderAdaptor.hpp"
 #include "DictionaryReader.hpp"
 #include "InputConfig.hpp"
+#include "PackedStreamPrefetcher.hpp"
 #include "PackedStreamReader.hpp"
 #include "ReaderUtils.hpp"
 #include "SchemaReader.hpp"
 #include "search/Projection.hpp"
+#include "TableStatistics.hpp"
 #include "TimestampDictionaryReader.hpp"
 
 namespace clp_s {
@@ -46,33 +50,60 @@ public:
      */
     void open_packed_streams();
 
+    /**
+     * Rewinds the packed streams so that they can be read again from the first stream. Streams
+     * must still be read in ascending order after the rewind.
+     */
+    void rewind_packed_streams();
+
+    /**
+     * Starts decompressing the packed streams containing the given schema tables on a background
+     * thread, up to `get_num_prefetched_streams()` streams ahead of the table being read. Does
+     * nothing if prefetching is disabled.
+     *
+     * Must be called after `open_packed_streams` and before any table is read. Afterwards, only the
+     * given tables can be read, in the given order, though any of them may be skipped.
+     * @param schema_ids The schema tables to prefetch, in the order given by `get_schema_ids()`
+     * @throw OperationFailed if the schema tables aren't in the order given by `get_schema_ids()`
+     */
+    void prefetch_schema_tables(std::span<int32_t const> schema_ids);
+
+    /**
+     * @param num_prefetched_streams The maximum number of packed streams decompressed ahead of the
+     * table being read by `prefetch_schema_tables`. 0 disables prefetching.
+     */
+    void set_num_prefetched_streams(size_t num_prefetched_streams) {
+        m_num_prefetched_streams = num_prefetched_streams;
+    }
+
+    [[nodiscard]] auto get_num_prefetched_streams() const -> size_t {
+        return m_num_prefetched_streams;
+    }
+
     /**
      * Reads the variable dictionary from the archive.
-     * @param lazy
      * @return the variable dictionary reader
      */
-    std::shared_ptr<VariableDictionaryReader> read_variable_dictionary(bool lazy = false) {
-        m_var_dict->read_entries(lazy);
+    std::shared_ptr<VariableDictionaryReader> read_variable_dictionary() {
+        m_var_dict->read_entries();
         return m_var_dict;
     }
 
     /**
      * Reads the log type dictionary from the archive.
-     * @param lazy
      * @return the log type dictionary reader
      */
-    std::shared_ptr<LogTypeDictionaryReader> read_log_type_dictionary(bool lazy = false) {
-        m_log_dict->read_entries(lazy);
+    std::shared_ptr<LogTypeDictionaryReader> read_log_type_dictionary() {
+        m_log_dict->read_entries();
         return m_log_dict;
     }
 
     /**
      * Reads the array dictionary from the archive.
-     * @param lazy
      * @return the array dictionary reader
      */
-    std::shared_ptr<LogTypeDictionaryReader> read_array_dictionary(bool lazy = false) {
-        m_array_dict->read_entries(lazy);
+    std::shared_ptr<LogTypeDictionaryReader> read_array_dictionary() {
+        m_array_dict->read_entries();
         return m_array_dict;
     }
 
@@ -100,6 +131,16 @@ public:
      */
     std::vector<std::shared_ptr<SchemaReader>> read_all_tables();
 
+    /**
+     * @param schema_id
+     * @return The metadata of the given schema table
+     * @throw std::out_of_range if the archive doesn't contain the given schema table
+     */
+    [[nodiscard]] auto get_schema_metadata(int32_t schema_id) const
+            -> SchemaReader::SchemaMetadata const& {
+        return m_id_to_schema_metadata.at(schema_id);
+    }
+
     std::string_view get_archive_id() { return m_archive_id; }
 
     std::shared_ptr<VariableDictionaryReader> get_variable_dictionary() { return m_var_dict; }
@@ -120,6 +161,17 @@ public:
         return m_archive_reader_adaptor->get_range_index();
     }
 
+    /**
+     * @param schema_id
+     * @return The statistics of the given schema table, or nullptr if the archive doesn't contain
+     * statistics for it
+     */
+    auto get_table_statistics(int32_t schema_id) const -> TableStatistics const* {
+        auto const& table_statistics = m_archive_reader_adaptor->get_table_statistics();
+        auto const it = table_statistics.find(schema_id);
+        return table_statistics.end() == it ? nullptr : &it->second;
+    }
+
     /**
      * Writes decoded messages to a file.
      * @param writer
@@ -185,10 +237,11 @@ private:
     );
 
     /**
-     * Reads a table with given ID from the packed stream reader. If read_stream is called multiple
-     * times in a row for the same stream_id a cached buffer is returned. This function allows the
-     * caller to ask for the same buffer to be reused to read multiple different tables: this can
-     * save memory allocations, but can only be used when tables are read one at a time.
+     * Reads a table with given ID from the packed stream reader, or from the prefetcher if one is
+     * running. If read_stream is called multiple times in a row for the same stream_id a cached
+     * buffer is returned. This function allows the caller to ask for the same buffer to be reused
+     * to read multiple different tables: this can save memory allocations, but can only be used
+     * when tables are read one at a time.
      * @param stream_id
      * @param reuse_buffer when true the same buffer is reused across invocations, overwriting data
      * returned previous calls to read_stream
@@ -217,6 +270,9 @@ private:
     std::shared_ptr<char[]> m_stream_buffer{};
     size_t m_stream_buffer_size{0ULL};
     size_t m_cur_stream_id{0ULL};
+    size_t m_num_prefetched_streams{0ULL};
+    // Declared after `m_stream_reader` so that it's stopped before the reader is destroyed
+    std::unique_ptr<PackedStreamPrefetcher> m_stream_prefetcher;
     int32_t m_log_event_idx_column_id{-1};
 };
 }  // namespace clp_s
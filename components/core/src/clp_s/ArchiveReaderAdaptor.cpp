@@ -1,11 +1,14 @@
 #include "ArchiveReaderAdaptor.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -19,6 +22,7 @@
 #include "InputConfig.hpp"
 #include "RangeIndexWriter.hpp"
 #include "SingleFileArchiveDefs.hpp"
+#include "TableStatistics.hpp"
 
 namespace clp_s {
 ArchiveReaderAdaptor::ArchiveReaderAdaptor(
@@ -151,6 +155,87 @@ auto ArchiveReaderAdaptor::try_read_range_index(ZstdDecompressor& decompressor,
     return ErrorCodeSuccess;
 }
 
+auto ArchiveReaderAdaptor::try_read_table_statistics(ZstdDecompressor& decompressor, size_t size)
+        -> ErrorCode {
+    std::vector<char> buffer(size);
+    if (auto const rc = decompressor.try_read_exact_length(buffer.data(), buffer.size());
+        ErrorCodeSuccess != rc)
+    {
+        return rc;
+    }
+
+    auto tables_json = nlohmann::json::from_msgpack(buffer.begin(), buffer.end(), true, false);
+    if (false == tables_json.is_array()) {
+        return ErrorCodeCorrupt;
+    }
+
+    try {
+        for (auto const& table_json : tables_json) {
+            TableStatistics table;
+            table.num_messages
+                    = table_json.at(table_statistics::cNumMessagesName).template get<uint64_t>();
+            for (auto const& column_json : table_json.at(table_statistics::cColumnsName)) {
+                ColumnStatistics column;
+                column.num_values = column_json.at(table_statistics::cNumValuesName)
+                                            .template get<uint64_t>();
+                column.logtype_ids.reset();
+                if (column_json.contains(table_statistics::cMinName)) {
+                    auto const& min = column_json.at(table_statistics::cMinName);
+                    auto const& max = column_json.at(table_statistics::cMaxName);
+                    if (min.is_number_integer() && max.is_number_integer()) {
+                        column.int_range.emplace(
+                                min.template get<int64_t>(),
+                                max.template get<int64_t>()
+                        );
+                    } else {
+                        column.float_range.emplace(
+                                min.template get<double>(),
+                                max.template get<double>()
+                        );
+                    }
+                }
+                if (column_json.contains(table_statistics::cNumTrueName)) {
+                    column.num_true = column_json.at(table_statistics::cNumTrueName)
+                                              .template get<uint64_t>();
+                }
+                if (column_json.contains(table_statistics::cLogtypeIdsName)) {
+                    column.logtype_ids.emplace(
+                            column_json.at(table_statistics::cLogtypeIdsName)
+                                    .template get<std::set<clp::logtype_dictionary_id_t>>()
+                    );
+                }
+                if (column_json.contains(table_statistics::cLogtypeIdFilterName)) {
+                    column.logtype_id_filter = BloomFilter::try_deserialize(
+                            column_json.at(table_statistics::cLogtypeIdFilterName).get_binary()
+                    );
+                    if (false == column.logtype_id_filter.has_value()) {
+                        return ErrorCodeCorrupt;
+                    }
+                }
+                if (column_json.contains(table_statistics::cVarIdFilterName)) {
+                    column.var_id_filter = BloomFilter::try_deserialize(
+                            column_json.at(table_statistics::cVarIdFilterName).get_binary()
+                    );
+                    if (false == column.var_id_filter.has_value()) {
+                        return ErrorCodeCorrupt;
+                    }
+                }
+                table.columns.emplace(
+                        column_json.at(table_statistics::cColumnIdName).template get<int32_t>(),
+                        std::move(column)
+                );
+            }
+            m_table_statistics.emplace(
+                    table_json.at(table_statistics::cSchemaIdName).template get<int32_t>(),
+                    std::move(table)
+            );
+        }
+    } catch (std::exception const&) {
+        return ErrorCodeCorrupt;
+    }
+    return ErrorCodeSuccess;
+}
+
 auto
 ArchiveReaderAdaptor::try_read_unknown_metadata_packet(ZstdDecompressor& decompressor, size_t size)
         -> ErrorCode {
@@ -238,6 +323,9 @@ ErrorCode ArchiveReaderAdaptor::try_read_archive_metadata(ZstdDecompressor& deco
             case ArchiveMetadataPacketType::RangeIndex:
                 rc = try_read_range_index(decompressor, packet_size);
                 break;
+            case ArchiveMetadataPacketType::TableStatistics:
+                rc = try_read_table_statistics(decompressor, packet_size);
+                break;
             default:
                 rc = try_read_unknown_metadata_packet(decompressor, packet_size);
                 break;
@@ -318,6 +406,18 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     return std::make_unique<clp::BoundedReader>(m_reader.get(), next_file_offset);
 }
 
+auto ArchiveReaderAdaptor::has_section(std::string_view section) const -> bool {
+    if (m_single_file_archive) {
+        return std::any_of(
+                m_archive_file_info.files.begin(),
+                m_archive_file_info.files.end(),
+                [&](ArchiveFileInfo const& info) { return info.n == section; }
+        );
+    }
+    std::error_code ec;
+    return std::filesystem::exists(m_archive_path.path + std::string{section}, ec);
+}
+
 void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section) {
     if (false == m_current_reader_holder.has_value()) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
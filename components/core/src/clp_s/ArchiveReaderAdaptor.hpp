@@ -6,6 +6,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -20,6 +21,7 @@
 #include "../clp/ReaderInterface.hpp"
 #include "InputConfig.hpp"
 #include "SingleFileArchiveDefs.hpp"
+#include "TableStatistics.hpp"
 #include "TimestampDictionaryReader.hpp"
 #include "TraceableException.hpp"
 #include "ZstdDecompressor.hpp"
@@ -81,6 +83,12 @@ public:
      */
     void checkin_reader_for_section(std::string_view section);
 
+    /**
+     * @param section
+     * @return Whether the archive contains the given section. Used to detect optional sections.
+     */
+    [[nodiscard]] auto has_section(std::string_view section) const -> bool;
+
     std::shared_ptr<TimestampDictionaryReader> get_timestamp_dictionary() {
         return m_timestamp_dictionary;
     }
@@ -89,6 +97,15 @@ public:
 
     std::vector<RangeIndexEntry> const& get_range_index() const { return m_range_index; }
 
+    /**
+     * @return A map from schema ID to the statistics of the corresponding schema table. The map is
+     * empty if the archive doesn't contain table statistics.
+     */
+    [[nodiscard]] auto get_table_statistics() const
+            -> std::unordered_map<int32_t, TableStatistics> const& {
+        return m_table_statistics;
+    }
+
 private:
     /**
      * Tries to read an ArchiveFileInfo packet from the archive metadata.
@@ -125,6 +142,14 @@ private:
      */
     auto try_read_range_index(ZstdDecompressor& decompressor, size_t size) -> ErrorCode;
 
+    /**
+     * Tries to read a TableStatistics packet from the archive metadata.
+     * @param decompressor
+     * @param size The number of decompressed bytes making up the packet.
+     * @return ErrorCodeSuccess on success or the relevant ErrorCode on failure.
+     */
+    auto try_read_table_statistics(ZstdDecompressor& decompressor, size_t size) -> ErrorCode;
+
     /**
      * Tries to read an unknown metadata packet from the archive metadata.
      * @param decompressor
@@ -176,6 +201,7 @@ private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dictionary;
     std::shared_ptr<clp::ReaderInterface> m_reader;
     std::vector<RangeIndexEntry> m_range_index;
+    std::unordered_map<int32_t, TableStatistics> m_table_statistics;
 };
 }  // namespace clp_s
 #endif  // CLP_S_ARCHIVEREADERADAPTOR_HPP
@@ -1,23 +1,162 @@
 #include "ArchiveWriter.hpp"
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include "../clp/Thread.hpp"
 #include "archive_constants.hpp"
 #include "Defs.hpp"
 #include "SchemaTree.hpp"
 
 namespace clp_s {
+namespace {
+/**
+ * State shared between the threads that compress packed streams in parallel. Threads claim
+ * streams one at a time and publish each compressed stream so that it can be written out in order.
+ */
+class PackedStreamCompressionState {
+public:
+    // Constructors
+    PackedStreamCompressionState(
+            std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& packed_streams,
+            int compression_level
+    )
+            : m_packed_streams{packed_streams},
+              m_compression_level{compression_level},
+              m_compressed_streams(packed_streams.size()) {}
+
+    // Methods
+    [[nodiscard]] auto get_compression_level() const -> int { return m_compression_level; }
+
+    /**
+     * Claims the next stream that hasn't been compressed yet.
+     * @return The ID of the claimed stream, or std::nullopt if there are no streams left or
+     * compression was aborted.
+     */
+    [[nodiscard]] auto try_claim_stream() -> std::optional<size_t> {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        if (m_aborted || m_next_stream_id >= m_packed_streams.size()) {
+            return std::nullopt;
+        }
+        return m_next_stream_id++;
+    }
+
+    /**
+     * @param stream_id The ID of a stream claimed by the calling thread.
+     * @return The schema writers belonging to the stream.
+     */
+    [[nodiscard]] auto get_schema_writers(size_t stream_id)
+            -> std::vector<std::unique_ptr<SchemaWriter>>& {
+        return m_packed_streams[stream_id];
+    }
+
+    /**
+     * Publishes a compressed stream.
+     * @param stream_id
+     * @param compressed_stream
+     */
+    void publish_stream(size_t stream_id, std::vector<char>&& compressed_stream) {
+        {
+            std::lock_guard<std::mutex> const lock{m_mutex};
+            m_compressed_streams[stream_id] = std::move(compressed_stream);
+        }
+        m_stream_published.notify_all();
+    }
+
+    /**
+     * Marks compression as failed and wakes up any waiting threads.
+     */
+    void abort() {
+        {
+            std::lock_guard<std::mutex> const lock{m_mutex};
+            m_aborted = true;
+        }
+        m_stream_published.notify_all();
+    }
+
+    /**
+     * Waits until the given stream has been compressed and takes ownership of it.
+     * @param stream_id
+     * @return The compressed stream, or std::nullopt if compression was aborted.
+     */
+    [[nodiscard]] auto wait_for_stream(size_t stream_id) -> std::optional<std::vector<char>> {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_stream_published.wait(lock, [&] {
+            return m_aborted || m_compressed_streams[stream_id].has_value();
+        });
+        if (false == m_compressed_streams[stream_id].has_value()) {
+            return std::nullopt;
+        }
+        auto compressed_stream{std::move(m_compressed_streams[stream_id])};
+        m_compressed_streams[stream_id].reset();
+        return compressed_stream;
+    }
+
+private:
+    std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& m_packed_streams;
+    int m_compression_level;
+
+    std::mutex m_mutex;
+    std::condition_variable m_stream_published;
+    size_t m_next_stream_id{0};
+    std::vector<std::optional<std::vector<char>>> m_compressed_streams;
+    bool m_aborted{false};
+};
+
+/**
+ * Thread that compresses packed streams into memory.
+ */
+class PackedStreamCompressionThread : public clp::Thread {
+public:
+    // Constructors
+    explicit PackedStreamCompressionThread(PackedStreamCompressionState& state) : m_state{state} {}
+
+protected:
+    // Methods implementing `clp::Thread`
+    void thread_method() override {
+        try {
+            ZstdCompressor compressor;
+            while (auto const stream_id{m_state.try_claim_stream()}) {
+                std::vector<char> compressed_stream;
+                compressor.open(compressed_stream, m_state.get_compression_level());
+                for (auto& schema_writer : m_state.get_schema_writers(stream_id.value())) {
+                    schema_writer->store(compressor);
+                    schema_writer.reset();
+                }
+                compressor.close();
+                m_state.publish_stream(stream_id.value(), std::move(compressed_stream));
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to compress packed stream - {}", e.what());
+            m_state.abort();
+        }
+    }
+
+private:
+    PackedStreamCompressionState& m_state;
+};
+}  // namespace
+
 void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_id = boost::uuids::to_string(option.id);
     m_compression_level = option.compression_level;
     m_print_archive_stats = option.print_archive_stats;
     m_single_file_archive = option.single_file_archive;
+    m_index_dictionaries = option.index_dictionaries;
     m_min_table_size = option.min_table_size;
+    m_num_table_compression_threads = std::max<size_t>(option.num_table_compression_threads, 1);
     m_archives_dir = option.archives_dir;
     m_authoritative_timestamp = option.authoritative_timestamp;
     m_authoritative_timestamp_namespace = option.authoritative_timestamp_namespace;
@@ -63,6 +202,18 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
             throw OperationFailed(rc, __FILENAME__, __LINE__);
         }
     }
+    std::string const var_dict_index_file
+            = std::string{constants::cArchiveVarDictFile} + constants::cDictionaryIndexSuffix;
+    std::string const log_dict_index_file
+            = std::string{constants::cArchiveLogDictFile} + constants::cDictionaryIndexSuffix;
+    size_t var_dict_index_compressed_size{0};
+    size_t log_dict_index_compressed_size{0};
+    if (m_index_dictionaries) {
+        var_dict_index_compressed_size
+                = m_var_dict->write_index(m_archive_path + var_dict_index_file);
+        log_dict_index_compressed_size
+                = m_log_dict->write_index(m_archive_path + log_dict_index_file);
+    }
     auto var_dict_compressed_size = m_var_dict->close();
     auto log_dict_compressed_size = m_log_dict->close();
     auto array_dict_compressed_size = m_array_dict->close();
@@ -70,15 +221,23 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
     auto schema_map_compressed_size = m_schema_map.store(m_archive_path, m_compression_level);
     auto [table_metadata_compressed_size, table_compressed_size] = store_tables();
 
+    // Each dictionary's index immediately follows the dictionary so that readers can load both
+    // without seeking backwards.
     std::vector<ArchiveFileInfo> files{
             {constants::cArchiveSchemaTreeFile, schema_tree_compressed_size},
             {constants::cArchiveSchemaMapFile, schema_map_compressed_size},
             {constants::cArchiveTableMetadataFile, table_metadata_compressed_size},
-            {constants::cArchiveVarDictFile, var_dict_compressed_size},
-            {constants::cArchiveLogDictFile, log_dict_compressed_size},
-            {constants::cArchiveArrayDictFile, array_dict_compressed_size},
-            {constants::cArchiveTablesFile, table_compressed_size}
+            {constants::cArchiveVarDictFile, var_dict_compressed_size}
     };
+    if (m_index_dictionaries) {
+        files.push_back({var_dict_index_file, var_dict_index_compressed_size});
+    }
+    files.push_back({constants::cArchiveLogDictFile, log_dict_compressed_size});
+    if (m_index_dictionaries) {
+        files.push_back({log_dict_index_file, log_dict_index_compressed_size});
+    }
+    files.push_back({constants::cArchiveArrayDictFile, array_dict_compressed_size});
+    files.push_back({constants::cArchiveTablesFile, table_compressed_size});
     uint64_t offset = 0;
     for (auto& file : files) {
         uint64_t original_size = file.o;
@@ -101,7 +260,8 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
         m_compressed_size
                 = var_dict_compressed_size + log_dict_compressed_size + array_dict_compressed_size
                   + metadata_size + schema_tree_compressed_size + schema_map_compressed_size
-                  + table_metadata_compressed_size + table_compressed_size + sizeof(ArchiveHeader);
+                  + table_metadata_compressed_size + table_compressed_size + sizeof(ArchiveHeader)
+                  + var_dict_index_compressed_size + log_dict_index_compressed_size;
 
         write_archive_header(header_and_metadata_writer, metadata_size);
         header_and_metadata_writer.close();
@@ -169,6 +329,9 @@ auto ArchiveWriter::write_archive_metadata(
     if (false == m_range_index_writer.empty()) {
         ++num_optional_packets;
     }
+    if (false == m_table_statistics_writer.empty()) {
+        ++num_optional_packets;
+    }
     uint8_t const num_constant_packets{3U};
     compressor.write_numeric_value<uint8_t>(num_constant_packets + num_optional_packets);
 
@@ -205,6 +368,11 @@ auto ArchiveWriter::write_archive_metadata(
         throw OperationFailed(rc, __FILENAME__, __LINE__);
     }
 
+    // Write table statistics
+    if (auto rc = m_table_statistics_writer.write(compressor); ErrorCodeSuccess != rc) {
+        throw OperationFailed(rc, __FILENAME__, __LINE__);
+    }
+
     compressor.close();
     return archive_range_index;
 }
@@ -412,34 +580,39 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     };
     std::sort(schemas.begin(), schemas.end(), comp);
 
+    // Assign schema tables to packed streams. A new stream is started once the current stream
+    // grows beyond the minimum table size. The packed streams take ownership of the schema writers,
+    // so that any writers left unstored when compression fails are still released.
+    std::vector<std::vector<std::unique_ptr<SchemaWriter>>> packed_streams;
     uint64_t current_stream_offset = 0;
-    uint64_t current_stream_id = 0;
-    uint64_t current_table_file_offset = 0;
-    m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+    bool start_new_stream{true};
     for (auto it : schemas) {
-        it->second->store(m_tables_compressor);
+        if (start_new_stream) {
+            packed_streams.emplace_back();
+            start_new_stream = false;
+        }
+        packed_streams.back().emplace_back(it->second);
+        m_table_statistics_writer.add_table(it->first, *it->second);
         schema_metadata.emplace_back(
-                current_stream_id,
+                packed_streams.size() - 1,
                 current_stream_offset,
                 it->first,
                 it->second->get_num_messages()
         );
         current_stream_offset += it->second->get_total_uncompressed_size();
-        delete it->second;
-
-        if (current_stream_offset > m_min_table_size || schemas.size() == schema_metadata.size()) {
-            stream_metadata.emplace_back(current_table_file_offset, current_stream_offset);
-            m_tables_compressor.close();
+        if (current_stream_offset > m_min_table_size) {
             current_stream_offset = 0;
-            ++current_stream_id;
-            current_table_file_offset = m_tables_file_writer.get_pos();
-
-            if (schemas.size() != schema_metadata.size()) {
-                m_tables_compressor.open(m_tables_file_writer, m_compression_level);
-            }
+            start_new_stream = true;
         }
     }
 
+    stream_metadata.reserve(packed_streams.size());
+    if (m_num_table_compression_threads > 1 && packed_streams.size() > 1) {
+        store_packed_streams_in_parallel(packed_streams, stream_metadata);
+    } else {
+        store_packed_streams(packed_streams, stream_metadata);
+    }
+
     m_table_metadata_compressor.write_numeric_value(stream_metadata.size());
     for (auto& stream : stream_metadata) {
         m_table_metadata_compressor.write_numeric_value(stream.file_offset);
@@ -468,4 +641,64 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
 
     return {table_metadata_compressed_size, table_compressed_size};
 }
+
+void ArchiveWriter::store_packed_streams(
+        std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    for (auto& schema_writers : packed_streams) {
+        auto const file_offset{m_tables_file_writer.get_pos()};
+        uint64_t uncompressed_size{0};
+        m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+        for (auto& schema_writer : schema_writers) {
+            schema_writer->store(m_tables_compressor);
+            uncompressed_size += schema_writer->get_total_uncompressed_size();
+            schema_writer.reset();
+        }
+        m_tables_compressor.close();
+        stream_metadata.emplace_back(file_offset, uncompressed_size);
+    }
+}
+
+void ArchiveWriter::store_packed_streams_in_parallel(
+        std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    std::vector<uint64_t> uncompressed_sizes(packed_streams.size(), 0);
+    for (size_t i{0}; i < packed_streams.size(); ++i) {
+        for (auto const& schema_writer : packed_streams[i]) {
+            uncompressed_sizes[i] += schema_writer->get_total_uncompressed_size();
+        }
+    }
+
+    PackedStreamCompressionState state{packed_streams, m_compression_level};
+    auto const num_threads{std::min(m_num_table_compression_threads, packed_streams.size())};
+    std::vector<std::unique_ptr<PackedStreamCompressionThread>> threads;
+    threads.reserve(num_threads);
+    for (size_t i{0}; i < num_threads; ++i) {
+        threads.emplace_back(std::make_unique<PackedStreamCompressionThread>(state));
+        threads.back()->start();
+    }
+
+    // Write the streams to the tables file in order, releasing each buffer once it is written.
+    std::optional<ErrorCode> error;
+    for (size_t stream_id{0}; stream_id < packed_streams.size(); ++stream_id) {
+        auto compressed_stream{state.wait_for_stream(stream_id)};
+        if (false == compressed_stream.has_value()) {
+            error = ErrorCodeFailure;
+            break;
+        }
+        auto const file_offset{m_tables_file_writer.get_pos()};
+        m_tables_file_writer.write(compressed_stream->data(), compressed_stream->size());
+        stream_metadata.emplace_back(file_offset, uncompressed_sizes[stream_id]);
+    }
+
+    state.abort();
+    for (auto& thread : threads) {
+        thread->join();
+    }
+    if (error.has_value()) {
+        throw OperationFailed(error.value(), __FILENAME__, __LINE__);
+    }
+}
 }  // namespace clp_s
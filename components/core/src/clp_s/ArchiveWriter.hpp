@@ -1,6 +1,7 @@
 #ifndef CLP_S_ARCHIVEWRITER_HPP
 #define CLP_S_ARCHIVEWRITER_HPP
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -19,6 +20,7 @@
 #include "SchemaTree.hpp"
 #include "SchemaWriter.hpp"
 #include "SingleFileArchiveDefs.hpp"
+#include "TableStatisticsWriter.hpp"
 #include "TimestampDictionaryWriter.hpp"
 
 namespace clp_s {
@@ -28,7 +30,9 @@ struct ArchiveWriterOption {
     int compression_level;
     bool print_archive_stats;
     bool single_file_archive;
+    bool index_dictionaries{false};
     size_t min_table_size;
+    size_t num_table_compression_threads{1};
     std::vector<std::string> authoritative_timestamp;
     std::string authoritative_timestamp_namespace;
 };
@@ -285,6 +289,29 @@ private:
      */
     [[nodiscard]] std::pair<size_t, size_t> store_tables();
 
+    /**
+     * Compresses each packed stream into the tables file one after another.
+     * @param packed_streams The schema writers belonging to each packed stream. Every schema writer
+     * is released once it has been stored.
+     * @param stream_metadata Returns the metadata for each packed stream.
+     */
+    void store_packed_streams(
+            std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
+
+    /**
+     * Compresses the packed streams into memory using a pool of threads, and writes them to the
+     * tables file in order as they become available.
+     * @param packed_streams The schema writers belonging to each packed stream. Every schema writer
+     * is released once it has been stored.
+     * @param stream_metadata Returns the metadata for each packed stream.
+     */
+    void store_packed_streams_in_parallel(
+            std::vector<std::vector<std::unique_ptr<SchemaWriter>>>& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
+
     /**
      * Writes the archive to a single file
      * @param files
@@ -337,7 +364,9 @@ private:
     int m_compression_level{};
     bool m_print_archive_stats{};
     bool m_single_file_archive{};
+    bool m_index_dictionaries{};
     size_t m_min_table_size{};
+    size_t m_num_table_compression_threads{1};
 
     std::vector<std::string> m_authoritative_timestamp;
     std::string m_authoritative_timestamp_namespace;
@@ -355,6 +384,7 @@ private:
     ZstdCompressor m_table_metadata_compressor;
 
     RangeIndexWriter m_range_index_writer;
+    TableStatisticsWriter m_table_statistics_writer;
     bool m_range_open{false};
 };
 }  // namespace clp_s
@@ -0,0 +1,88 @@
+#include "BloomFilter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include "Utils.hpp"
+
+namespace clp_s {
+namespace {
+// Odd constants used to derive the bit set in each word of a block (from the Parquet spec)
+constexpr std::array<uint32_t, 8> cSalts{
+        0x47b6'137bU,
+        0x4497'4d91U,
+        0x8824'ad5bU,
+        0xa2b7'289dU,
+        0x7054'95c7U,
+        0x2df1'424bU,
+        0x9efc'4947U,
+        0x5c6b'fb31U
+};
+}  // namespace
+
+BloomFilter::BloomFilter(size_t num_values) {
+    constexpr size_t cNumBitsPerBlock{cNumWordsPerBlock * 32};
+    auto const num_bits = std::max<size_t>(num_values * cBitsPerValue, 1);
+    m_blocks.resize((num_bits + cNumBitsPerBlock - 1) / cNumBitsPerBlock, Block{});
+}
+
+auto BloomFilter::try_deserialize(std::vector<uint8_t> const& bytes)
+        -> std::optional<BloomFilter> {
+    if (bytes.empty() || 0 != bytes.size() % sizeof(Block)) {
+        return std::nullopt;
+    }
+    BloomFilter filter;
+    filter.m_blocks.resize(bytes.size() / sizeof(Block));
+    std::memcpy(filter.m_blocks.data(), bytes.data(), bytes.size());
+    return filter;
+}
+
+auto BloomFilter::serialize() const -> std::vector<uint8_t> {
+    std::vector<uint8_t> bytes(m_blocks.size() * sizeof(Block));
+    std::memcpy(bytes.data(), m_blocks.data(), bytes.size());
+    return bytes;
+}
+
+void BloomFilter::add(uint64_t value) {
+    auto const value_hash = mix64(value);
+    auto& block = m_blocks[get_block_index(value_hash)];
+    auto const mask = get_block_mask(value_hash);
+    for (size_t i = 0; i < cNumWordsPerBlock; ++i) {
+        block[i] |= mask[i];
+    }
+}
+
+auto BloomFilter::possibly_contains(uint64_t value) const -> bool {
+    if (m_blocks.empty()) {
+        return false;
+    }
+    auto const value_hash = mix64(value);
+    auto const& block = m_blocks[get_block_index(value_hash)];
+    auto const mask = get_block_mask(value_hash);
+    for (size_t i = 0; i < cNumWordsPerBlock; ++i) {
+        if (mask[i] != (block[i] & mask[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto BloomFilter::get_block_index(uint64_t hash) const -> size_t {
+    // Maps the upper 32 bits of the hash onto [0, m_blocks.size()) without a division
+    return static_cast<size_t>(((hash >> 32) * m_blocks.size()) >> 32);
+}
+
+auto BloomFilter::get_block_mask(uint64_t hash) -> Block {
+    auto const key = static_cast<uint32_t>(hash);
+    Block mask{};
+    for (size_t i = 0; i < cNumWordsPerBlock; ++i) {
+        mask[i] = 1U << ((key * cSalts[i]) >> 27);
+    }
+    return mask;
+}
+}  // namespace clp_s
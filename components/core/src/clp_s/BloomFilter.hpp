@@ -0,0 +1,80 @@
+#ifndef CLP_S_BLOOMFILTER_HPP
+#define CLP_S_BLOOMFILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace clp_s {
+/**
+ * A split block Bloom filter over 64-bit values (e.g., dictionary IDs).
+ *
+ * The filter is an array of 256-bit blocks. Each value is hashed to a single block, in which it
+ * sets one bit in each of the block's eight 32-bit words, so a lookup touches a single cache line.
+ * With `cBitsPerValue` bits per distinct value, the false positive rate is roughly 1%.
+ */
+class BloomFilter {
+public:
+    // Constants
+    static constexpr size_t cBitsPerValue{10};
+
+    // Constructors
+    BloomFilter() = default;
+
+    /**
+     * Creates an empty filter sized for the given number of distinct values.
+     * @param num_values
+     */
+    explicit BloomFilter(size_t num_values);
+
+    // Methods
+    /**
+     * Deserializes a filter serialized with `serialize`.
+     * @param bytes
+     * @return The filter, or std::nullopt if `bytes` isn't a valid serialized filter
+     */
+    [[nodiscard]] static auto try_deserialize(std::vector<uint8_t> const& bytes)
+            -> std::optional<BloomFilter>;
+
+    /**
+     * @return The filter's blocks as a byte array
+     */
+    [[nodiscard]] auto serialize() const -> std::vector<uint8_t>;
+
+    /**
+     * Adds a value to the filter.
+     * @param value
+     */
+    void add(uint64_t value);
+
+    /**
+     * @param value
+     * @return false if the value was definitely never added to the filter, true otherwise
+     */
+    [[nodiscard]] auto possibly_contains(uint64_t value) const -> bool;
+
+private:
+    // Types
+    static constexpr size_t cNumWordsPerBlock{8};
+    using Block = std::array<uint32_t, cNumWordsPerBlock>;
+
+    // Methods
+    /**
+     * @param hash
+     * @return The block that a value with the given hash maps to
+     */
+    [[nodiscard]] auto get_block_index(uint64_t hash) const -> size_t;
+
+    /**
+     * @param hash
+     * @return The bits that a value with the given hash sets in its block
+     */
+    [[nodiscard]] static auto get_block_mask(uint64_t hash) -> Block;
+
+    std::vector<Block> m_blocks;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_BLOOMFILTER_HPP
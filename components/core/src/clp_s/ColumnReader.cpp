@@ -52,6 +52,16 @@ std::variant<int64_t, double, std::string, uint8_t> DeltaEncodedInt64ColumnReade
     return get_value_at_idx(cur_message);
 }
 
+void DeltaEncodedInt64ColumnReader::extract_values(
+        uint64_t begin_message,
+        size_t num_messages,
+        int64_t* values
+) {
+    for (size_t i = 0; i < num_messages; ++i) {
+        values[i] = get_value_at_idx(begin_message + i);
+    }
+}
+
 void FloatColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
     m_values = reader.read_unaligned_span<double>(num_messages);
 }
@@ -63,14 +73,14 @@ void FormattedFloatColumnReader::load(BufferViewReader& reader, uint64_t num_mes
 
 void
 Int64ColumnReader::extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) {
-    buffer.append(std::to_string(m_values[cur_message]));
+    StringUtils::append_integer(buffer, m_values[cur_message]);
 }
 
 void DeltaEncodedInt64ColumnReader::extract_string_value_into_buffer(
         uint64_t cur_message,
         std::string& buffer
 ) {
-    buffer.append(std::to_string(get_value_at_idx(cur_message)));
+    StringUtils::append_integer(buffer, get_value_at_idx(cur_message));
 }
 
 std::variant<int64_t, double, std::string, uint8_t> FloatColumnReader::extract_value(
@@ -91,7 +101,7 @@ void BooleanColumnReader::load(BufferViewReader& reader, uint64_t num_messages)
 
 void
 FloatColumnReader::extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) {
-    buffer.append(std::to_string(m_values[cur_message]));
+    StringUtils::append_float(buffer, m_values[cur_message]);
 }
 
 void FormattedFloatColumnReader::extract_string_value_into_buffer(
@@ -121,7 +131,7 @@ void DictionaryFloatColumnReader::extract_string_value_into_buffer(
         uint64_t cur_message,
         std::string& buffer
 ) {
-    buffer.append(m_var_dict->get_value(m_var_dict_ids[cur_message]));
+    buffer.append(m_var_dict->get_value_view(m_var_dict_ids[cur_message]));
 }
 
 void ClpStringColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
@@ -147,11 +157,7 @@ void
 ClpStringColumnReader::extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) {
     auto value = m_logtypes[cur_message];
     int64_t logtype_id = ClpStringColumnWriter::get_encoded_log_dict_id(value);
-    auto& entry = m_log_dict->get_entry(logtype_id);
-
-    if (false == entry.initialized()) {
-        entry.decode_log_type();
-    }
+    auto const& entry = m_log_dict->get_entry(logtype_id);
 
     int64_t encoded_vars_offset = ClpStringColumnWriter::get_encoded_offset(value);
     auto encoded_vars = m_encoded_vars.sub_span(encoded_vars_offset, entry.get_num_variables());
@@ -186,12 +192,7 @@ int64_t ClpStringColumnReader::get_encoded_id(uint64_t cur_message) {
 UnalignedMemSpan<int64_t> ClpStringColumnReader::get_encoded_vars(uint64_t cur_message) {
     auto value = m_logtypes[cur_message];
     auto logtype_id = ClpStringColumnWriter::get_encoded_log_dict_id(value);
-    auto& entry = m_log_dict->get_entry(logtype_id);
-
-    // It should be initialized before because we are searching on this field
-    if (false == entry.initialized()) {
-        entry.decode_log_type();
-    }
+    auto const& entry = m_log_dict->get_entry(logtype_id);
 
     int64_t encoded_vars_offset = ClpStringColumnWriter::get_encoded_offset(value);
 
@@ -205,21 +206,24 @@ void VariableStringColumnReader::load(BufferViewReader& reader, uint64_t num_mes
 std::variant<int64_t, double, std::string, uint8_t> VariableStringColumnReader::extract_value(
         uint64_t cur_message
 ) {
-    return m_var_dict->get_value(m_variables[cur_message]);
+    return std::string{m_var_dict->get_value_view(m_variables[cur_message])};
 }
 
 void VariableStringColumnReader::extract_string_value_into_buffer(
         uint64_t cur_message,
         std::string& buffer
 ) {
-    buffer.append(m_var_dict->get_value(m_variables[cur_message]));
+    buffer.append(m_var_dict->get_value_view(m_variables[cur_message]));
 }
 
 void VariableStringColumnReader::extract_escaped_string_value_into_buffer(
         uint64_t cur_message,
         std::string& buffer
 ) {
-    StringUtils::escape_json_string(buffer, m_var_dict->get_value(m_variables[cur_message]));
+    StringUtils::escape_json_string(
+            buffer,
+            m_var_dict->get_value_view(m_variables[cur_message])
+    );
 }
 
 int64_t VariableStringColumnReader::get_variable_id(uint64_t cur_message) {
@@ -90,6 +90,19 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @param cur_message
+     * @return The value of the given message
+     */
+    [[nodiscard]] auto get_value(uint64_t cur_message) const -> int64_t {
+        return m_values[cur_message];
+    }
+
+    /**
+     * @return The values of all messages in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<int64_t> { return m_values; }
+
 private:
     UnalignedMemSpan<int64_t> m_values;
 };
@@ -113,6 +126,22 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @param cur_message
+     * @return The decoded value of the given message
+     */
+    [[nodiscard]] auto get_value(uint64_t cur_message) -> int64_t {
+        return get_value_at_idx(cur_message);
+    }
+
+    /**
+     * Decodes the values of a contiguous range of messages.
+     * @param begin_message
+     * @param num_messages
+     * @param values Returns the decoded values
+     */
+    void extract_values(uint64_t begin_message, size_t num_messages, int64_t* values);
+
 private:
     /**
      * Gets the value stored at a given index by summing up the stored deltas between the requested
@@ -146,6 +175,19 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @param cur_message
+     * @return The value of the given message
+     */
+    [[nodiscard]] auto get_value(uint64_t cur_message) const -> double {
+        return m_values[cur_message];
+    }
+
+    /**
+     * @return The values of all messages in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<double> { return m_values; }
+
 private:
     UnalignedMemSpan<double> m_values;
 };
@@ -176,6 +218,11 @@ public:
      */
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return The values of all messages in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<double> { return m_values; }
+
 private:
     UnalignedMemSpan<double> m_values;
     UnalignedMemSpan<float_format_t> m_formats;
@@ -229,6 +276,19 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @param cur_message
+     * @return The value of the given message
+     */
+    [[nodiscard]] auto get_value(uint64_t cur_message) const -> bool {
+        return 0 != m_values[cur_message];
+    }
+
+    /**
+     * @return The values of all messages in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<uint8_t> { return m_values; }
+
 private:
     UnalignedMemSpan<uint8_t> m_values;
 };
@@ -321,6 +381,13 @@ public:
      */
     int64_t get_variable_id(uint64_t cur_message);
 
+    /**
+     * @return The encoded variable ids of all messages in the column
+     */
+    [[nodiscard]] auto get_variable_ids() const -> UnalignedMemSpan<uint64_t> {
+        return m_variables;
+    }
+
 private:
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
 
@@ -354,6 +421,13 @@ public:
      */
     epochtime_t get_encoded_time(uint64_t cur_message);
 
+    /**
+     * @return The encoded times of all messages in the column in epoch time
+     */
+    [[nodiscard]] auto get_encoded_times() const -> UnalignedMemSpan<int64_t> {
+        return m_timestamps;
+    }
+
 private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
 
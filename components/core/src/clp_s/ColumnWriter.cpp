@@ -4,11 +4,13 @@
 #include <cassert>
 #include <cctype>
 #include <cstdint>
+#include <string_view>
 #include <variant>
 
 #include "../clp/Defs.h"
 #include "../clp/EncodedVariableInterpreter.hpp"
 #include "ParsedMessage.hpp"
+#include "TableStatistics.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
@@ -22,6 +24,12 @@ void Int64ColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void Int64ColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const value : m_values) {
+        statistics.add_int_value(value);
+    }
+}
+
 size_t DeltaEncodedInt64ColumnWriter::add_value(ParsedMessage::variable_t& value) {
     if (0 == m_values.size()) {
         m_cur = std::get<int64_t>(value);
@@ -39,6 +47,15 @@ void DeltaEncodedInt64ColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void DeltaEncodedInt64ColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    // The first entry holds the first value; every following entry holds a delta.
+    int64_t value{0};
+    for (auto const delta : m_values) {
+        value += delta;
+        statistics.add_int_value(value);
+    }
+}
+
 size_t FloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<double>(value));
     return sizeof(double);
@@ -49,6 +66,12 @@ void FloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void FloatColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const value : m_values) {
+        statistics.add_float_value(value);
+    }
+}
+
 size_t FormattedFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     auto const& [float_value, format]{std::get<std::pair<double, float_format_t>>(value)};
     m_values.push_back(float_value);
@@ -64,9 +87,15 @@ void FormattedFloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_formats.data()), format_size);
 }
 
+void FormattedFloatColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const value : m_values) {
+        statistics.add_float_value(value);
+    }
+}
+
 size_t DictionaryFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     clp::variable_dictionary_id_t id{};
-    m_var_dict->add_entry(std::get<std::string>(value), id);
+    m_var_dict->add_entry(std::get<std::string_view>(value), id);
     m_var_dict_ids.push_back(id);
     return sizeof(clp::variable_dictionary_id_t);
 }
@@ -86,16 +115,23 @@ void BooleanColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void BooleanColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const value : m_values) {
+        statistics.add_bool_value(0 != value);
+    }
+}
+
 size_t ClpStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     uint64_t offset{m_encoded_vars.size()};
-    std::vector<clp::variable_dictionary_id_t> temp_var_dict_ids;
+    m_temp_var_dict_ids.clear();
     clp::EncodedVariableInterpreter::encode_and_add_to_dictionary(
-            std::get<std::string>(value),
+            std::get<std::string_view>(value),
             m_logtype_entry,
             *m_var_dict,
             m_encoded_vars,
-            temp_var_dict_ids
+            m_temp_var_dict_ids
     );
+    m_distinct_var_dict_ids.insert(m_temp_var_dict_ids.cbegin(), m_temp_var_dict_ids.cend());
     clp::logtype_dictionary_id_t id{};
     m_log_dict->add_entry(m_logtype_entry, id);
     auto encoded_id = encode_log_dict_id(id, offset);
@@ -112,9 +148,18 @@ void ClpStringColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_encoded_vars.data()), encoded_vars_size);
 }
 
+void ClpStringColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const encoded_id : m_logtypes) {
+        statistics.add_logtype_id(get_encoded_log_dict_id(encoded_id));
+    }
+    for (auto const var_id : m_distinct_var_dict_ids) {
+        statistics.add_var_id(var_id);
+    }
+}
+
 size_t VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     clp::variable_dictionary_id_t id{};
-    m_var_dict->add_entry(std::get<std::string>(value), id);
+    m_var_dict->add_entry(std::get<std::string_view>(value), id);
     m_var_dict_ids.push_back(id);
     return sizeof(clp::variable_dictionary_id_t);
 }
@@ -124,6 +169,12 @@ void VariableStringColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_var_dict_ids.data()), size);
 }
 
+void VariableStringColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const var_id : m_var_dict_ids) {
+        statistics.add_var_id(var_id);
+    }
+}
+
 size_t DateStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     auto encoded_timestamp = std::get<std::pair<uint64_t, epochtime_t>>(value);
     m_timestamps.push_back(encoded_timestamp.second);
@@ -138,4 +189,10 @@ void DateStringColumnWriter::store(ZstdCompressor& compressor) {
     size_t encodings_size = m_timestamp_encodings.size() * sizeof(int64_t);
     compressor.write(reinterpret_cast<char const*>(m_timestamp_encodings.data()), encodings_size);
 }
+
+void DateStringColumnWriter::update_statistics(ColumnStatistics& statistics) const {
+    for (auto const timestamp : m_timestamps) {
+        statistics.add_int_value(timestamp);
+    }
+}
 }  // namespace clp_s
@@ -1,6 +1,7 @@
 #ifndef CLP_S_COLUMNWRITER_HPP
 #define CLP_S_COLUMNWRITER_HPP
 
+#include <unordered_set>
 #include <utility>
 #include <variant>
 
@@ -9,6 +10,7 @@
 #include "FileWriter.hpp"
 #include "FloatFormatEncoding.hpp"
 #include "ParsedMessage.hpp"
+#include "TableStatistics.hpp"
 #include "TimestampDictionaryWriter.hpp"
 #include "ZstdCompressor.hpp"
 
@@ -43,6 +45,15 @@ public:
      */
     virtual size_t get_total_header_size() const { return 0; }
 
+    /**
+     * Records statistics about the values added to the column. Columns whose values can't be used
+     * to prune searches leave the statistics untouched.
+     * @param statistics
+     */
+    virtual void update_statistics(ColumnStatistics& statistics) const {}
+
+    int32_t get_id() const { return m_id; }
+
 protected:
     int32_t m_id;
 };
@@ -60,6 +71,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_values;
 };
@@ -77,6 +90,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_values;
     int64_t m_cur{};
@@ -95,6 +110,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<double> m_values;
 };
@@ -112,6 +129,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<double> m_values;
     std::vector<float_format_t> m_formats;
@@ -132,6 +151,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::vector<clp::variable_dictionary_id_t> m_var_dict_ids;
@@ -150,6 +171,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<uint8_t> m_values;
 };
@@ -177,6 +200,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
     size_t get_total_header_size() const override { return sizeof(size_t); }
 
     /**
@@ -217,6 +242,10 @@ private:
 
     std::vector<encoded_log_dict_id_t> m_logtypes;
     std::vector<clp::encoded_variable_t> m_encoded_vars;
+    // Scratch space reused across calls to `add_value`
+    std::vector<clp::variable_dictionary_id_t> m_temp_var_dict_ids;
+    // The distinct dictionary IDs of the dictionary variables added to the column
+    std::unordered_set<clp::variable_dictionary_id_t> m_distinct_var_dict_ids;
 };
 
 class VariableStringColumnWriter : public BaseColumnWriter {
@@ -234,6 +263,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::vector<clp::variable_dictionary_id_t> m_var_dict_ids;
@@ -252,6 +283,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void update_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_timestamps;
     std::vector<int64_t> m_timestamp_encodings;
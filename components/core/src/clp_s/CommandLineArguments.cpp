@@ -252,6 +252,11 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "single-file-archive",
                     po::bool_switch(&m_single_file_archive),
                     "Create a single archive file instead of multiple files."
+            )(
+                    "index-dictionaries",
+                    po::bool_switch(&m_index_dictionaries),
+                    "Store a search index alongside the variable and log type dictionaries to speed"
+                    " up wildcard searches."
             )(
                     "structurize-arrays",
                     po::bool_switch(&m_structurize_arrays),
@@ -261,6 +266,19 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::bool_switch(&m_disable_log_order),
                     "Do not record log order at ingestion time; Do not record the archive range"
                     " index."
+            )(
+                    "ingestion-threads",
+                    po::value<size_t>(&m_num_ingestion_threads)->value_name("NUM_THREADS")->
+                        default_value(m_num_ingestion_threads),
+                    "Number of threads used to ingest input files in parallel. Each thread writes"
+                    " its own archives."
+            )(
+                    "table-compression-threads",
+                    po::value<size_t>(&m_num_table_compression_threads)
+                            ->value_name("NUM_THREADS")
+                            ->default_value(m_num_table_compression_threads),
+                    "Number of threads used to compress the packed tables of each archive when"
+                    " the archive is closed."
             )(
                     "auth",
                     po::value<std::string>(&auth)
@@ -328,6 +346,14 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No input paths specified.");
             }
 
+            if (0 == m_num_ingestion_threads) {
+                throw std::invalid_argument("ingestion-threads must be greater than 0.");
+            }
+
+            if (0 == m_num_table_compression_threads) {
+                throw std::invalid_argument("table-compression-threads must be greater than 0.");
+            }
+
             validate_network_auth(auth, m_network_auth);
         } else if ((char)Command::Extract == command_input) {
             po::options_description extraction_options;
@@ -359,6 +385,14 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                             ->value_name("SIZE"),
                     "Chunk size (B) for each output file when decompressing records in log order."
                     " When set to 0, no chunking is performed."
+            )(
+                    "ordered-memory-budget",
+                    po::value<size_t>(&m_ordered_memory_budget)
+                            ->default_value(m_ordered_memory_budget)
+                            ->value_name("SIZE"),
+                    "Soft limit (B) on the memory used to hold records when decompressing in log"
+                    " order. Archives that don't fit are decompressed in several passes. When set"
+                    " to 0, every table of the archive is held in memory."
             )(
                     "print-ordered-chunk-stats",
                     po::bool_switch(&m_print_ordered_chunk_stats),
@@ -450,6 +484,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     );
                 }
 
+                if (0 != m_ordered_memory_budget) {
+                    throw std::invalid_argument(
+                            "ordered-memory-budget must be used with ordered argument"
+                    );
+                }
+
                 if (false == m_mongodb_uri.empty()) {
                     throw std::invalid_argument(
                             "Recording decompression metadata only supported for ordered"
@@ -524,6 +564,33 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "Project only the given set of columns for matching results. This option must be"
                 " specified after all positional options. Values that are objects or structured"
                 " arrays are currently unsupported."
+            )(
+                "search-threads",
+                po::value<size_t>(&m_num_search_threads)
+                    ->value_name("NUM_THREADS")
+                    ->default_value(m_num_search_threads),
+                "Number of threads used to search archives in parallel. Results from all threads"
+                " are output by a single output handler in no particular order."
+            )(
+                "prefetch-streams",
+                po::value<size_t>(&m_num_prefetched_streams)
+                    ->value_name("NUM_STREAMS")
+                    ->default_value(m_num_prefetched_streams),
+                "Number of packed streams to decompress in the background ahead of the table being"
+                " searched (0 disables prefetching)"
+            )(
+                "result-cache-dir",
+                po::value<std::string>(&m_result_cache_dir)->value_name("DIR"),
+                "Directory used to cache the results of each archive's search, so that repeated"
+                " searches skip decompressing the archive (caching is disabled if unset, and"
+                " doesn't apply to --count or --count-by-time)"
+            )(
+                "result-cache-size",
+                po::value<size_t>(&m_result_cache_size)
+                    ->value_name("SIZE")
+                    ->default_value(m_result_cache_size),
+                "Maximum total size, in bytes, of the result cache; the least recently used"
+                " results are evicted first"
             )(
                 "auth",
                 po::value<std::string>(&auth)
@@ -605,6 +672,11 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::value<uint64_t>(&m_max_num_results)->value_name("MAX")->
                             default_value(m_max_num_results),
                     "The maximum number of results to output"
+            )(
+                    "merge-top-results",
+                    po::bool_switch(&m_merge_top_results),
+                    "Output the max-num-results latest results across all searched archives,"
+                    " instead of the latest results of each searched table"
             );
 
             std::vector<std::string> unrecognized_options
@@ -701,6 +773,14 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 m_search_end_ts = parsed_command_line_options["tle"].as<epochtime_t>();
             }
 
+            if (0 == m_num_search_threads) {
+                throw std::invalid_argument("search-threads must be greater than 0.");
+            }
+
+            if (false == m_result_cache_dir.empty() && 0 == m_result_cache_size) {
+                throw std::invalid_argument("result-cache-size must be greater than 0.");
+            }
+
             if (m_search_begin_ts.has_value() && m_search_end_ts.has_value()
                 && m_search_begin_ts.value() > m_search_end_ts.value())
             {
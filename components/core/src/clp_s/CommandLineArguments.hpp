@@ -76,6 +76,8 @@ public:
 
     uint64_t get_max_num_results() const { return m_max_num_results; }
 
+    [[nodiscard]] auto get_merge_top_results() const -> bool { return m_merge_top_results; }
+
     std::string const& get_network_dest_host() const { return m_network_dest_host; }
 
     int const& get_network_dest_port() const { return m_network_dest_port; }
@@ -88,6 +90,18 @@ public:
 
     bool get_ignore_case() const { return m_ignore_case; }
 
+    [[nodiscard]] auto get_num_search_threads() const -> size_t { return m_num_search_threads; }
+
+    [[nodiscard]] auto get_num_prefetched_streams() const -> size_t {
+        return m_num_prefetched_streams;
+    }
+
+    [[nodiscard]] auto get_result_cache_dir() const -> std::string const& {
+        return m_result_cache_dir;
+    }
+
+    [[nodiscard]] auto get_result_cache_size() const -> size_t { return m_result_cache_size; }
+
     std::string const& get_reducer_host() const { return m_reducer_host; }
 
     int get_reducer_port() const { return m_reducer_port; }
@@ -108,14 +122,28 @@ public:
 
     bool get_single_file_archive() const { return m_single_file_archive; }
 
+    [[nodiscard]] auto get_index_dictionaries() const -> bool { return m_index_dictionaries; }
+
     bool get_structurize_arrays() const { return m_structurize_arrays; }
 
     bool get_ordered_decompression() const { return m_ordered_decompression; }
 
     size_t get_target_ordered_chunk_size() const { return m_target_ordered_chunk_size; }
 
+    [[nodiscard]] auto get_ordered_memory_budget() const -> size_t {
+        return m_ordered_memory_budget;
+    }
+
     size_t get_minimum_table_size() const { return m_minimum_table_size; }
 
+    [[nodiscard]] auto get_num_ingestion_threads() const -> size_t {
+        return m_num_ingestion_threads;
+    }
+
+    [[nodiscard]] auto get_num_table_compression_threads() const -> size_t {
+        return m_num_table_compression_threads;
+    }
+
     std::vector<std::string> const& get_projection_columns() const { return m_projection_columns; }
 
     bool get_record_log_order() const { return false == m_disable_log_order; }
@@ -185,18 +213,23 @@ private:
     size_t m_max_document_size{512ULL * 1024 * 1024};  // 512 MB
     bool m_no_retain_float_format{false};
     bool m_single_file_archive{false};
+    bool m_index_dictionaries{false};
     bool m_structurize_arrays{false};
     bool m_ordered_decompression{false};
     size_t m_target_ordered_chunk_size{};
+    size_t m_ordered_memory_budget{};
     bool m_print_ordered_chunk_stats{false};
     size_t m_minimum_table_size{1ULL * 1024 * 1024};  // 1 MB
     bool m_disable_log_order{false};
+    size_t m_num_ingestion_threads{1};
+    size_t m_num_table_compression_threads{1};
 
     // MongoDB configuration variables
     std::string m_mongodb_uri;
     std::string m_mongodb_collection;
     uint64_t m_batch_size{1000};
     uint64_t m_max_num_results{1000};
+    bool m_merge_top_results{false};
 
     // Network configuration variables
     std::string m_network_dest_host;
@@ -208,6 +241,10 @@ private:
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
     std::vector<std::string> m_projection_columns;
+    size_t m_num_search_threads{1};
+    size_t m_num_prefetched_streams{2};
+    std::string m_result_cache_dir;
+    size_t m_result_cache_size{1024ULL * 1024 * 1024};
 
     // Search aggregation variables
     std::string m_reducer_host;
@@ -111,7 +111,6 @@ void LogTypeDictionaryEntry::clear() {
     m_value.clear();
     m_placeholder_positions.clear();
     m_num_escaped_placeholders = 0;
-    m_init = false;
 }
 
 void LogTypeDictionaryEntry::write_to_file(ZstdCompressor& compressor) const {
@@ -119,87 +118,44 @@ void LogTypeDictionaryEntry::write_to_file(ZstdCompressor& compressor) const {
     compressor.write_string(m_value);
 }
 
-ErrorCode LogTypeDictionaryEntry::try_read_from_file(
-        ZstdDecompressor& decompressor,
-        clp::logtype_dictionary_id_t id,
-        bool lazy
+void LogTypeDictionaryEntry::read_from_buffer(
+        string_view escaped_value,
+        clp::logtype_dictionary_id_t id
 ) {
     clear();
-
     m_id = id;
-    ErrorCode error_code;
-    uint64_t escaped_value_length{};
-    error_code = decompressor.try_read_numeric_value(escaped_value_length);
-    if (ErrorCodeSuccess != error_code) {
-        return error_code;
-    }
-
-    string escaped_value;
-    error_code = decompressor.try_read_string(escaped_value_length, escaped_value);
-    if (ErrorCodeSuccess != error_code) {
-        return error_code;
-    }
-
-    if (lazy) {
-        m_value = std::move(escaped_value);
-    } else {
-        decode_log_type(escaped_value);
-    }
-
-    return error_code;
-}
-
-void LogTypeDictionaryEntry::read_from_file(
-        ZstdDecompressor& decompressor,
-        clp::logtype_dictionary_id_t id,
-        bool lazy
-) {
-    auto error_code = try_read_from_file(decompressor, id, lazy);
-    if (ErrorCodeSuccess != error_code) {
-        throw OperationFailed(error_code, __FILENAME__, __LINE__);
-    }
-}
+    m_value.reserve(escaped_value.length());
 
-void LogTypeDictionaryEntry::decode_log_type(string& escaped_value) {
     bool is_escaped = false;
-    string constant;
-    for (char c : escaped_value) {
+    size_t constant_begin_pos = 0;
+    for (size_t i = 0; i < escaped_value.length(); ++i) {
+        auto const c = escaped_value[i];
         if (is_escaped) {
-            constant += c;
             is_escaped = false;
         } else if (enum_to_underlying_type(VariablePlaceholder::Escape) == c) {
             is_escaped = true;
-            add_constant(constant, 0, constant.length());
-            constant.clear();
+            add_constant(escaped_value, constant_begin_pos, i - constant_begin_pos);
             add_escape();
-        } else {
-            if (enum_to_underlying_type(VariablePlaceholder::Integer) == c) {
-                add_constant(constant, 0, constant.length());
-                constant.clear();
-                add_int_var();
-            } else if (enum_to_underlying_type(VariablePlaceholder::Float) == c) {
-                add_constant(constant, 0, constant.length());
-                constant.clear();
-                add_float_var();
-            } else if (enum_to_underlying_type(VariablePlaceholder::Dictionary) == c) {
-                add_constant(constant, 0, constant.length());
-                constant.clear();
-                add_dictionary_var();
-            } else {
-                constant += c;
-            }
+            constant_begin_pos = i + 1;
+        } else if (enum_to_underlying_type(VariablePlaceholder::Integer) == c) {
+            add_constant(escaped_value, constant_begin_pos, i - constant_begin_pos);
+            add_int_var();
+            constant_begin_pos = i + 1;
+        } else if (enum_to_underlying_type(VariablePlaceholder::Float) == c) {
+            add_constant(escaped_value, constant_begin_pos, i - constant_begin_pos);
+            add_float_var();
+            constant_begin_pos = i + 1;
+        } else if (enum_to_underlying_type(VariablePlaceholder::Dictionary) == c) {
+            add_constant(escaped_value, constant_begin_pos, i - constant_begin_pos);
+            add_dictionary_var();
+            constant_begin_pos = i + 1;
         }
     }
-    if (false == constant.empty()) {
-        add_constant(constant, 0, constant.length());
-    }
-    m_init = true;
-}
-
-void LogTypeDictionaryEntry::decode_log_type() {
-    string escaped_value = std::move(m_value);
-    m_value.clear();
-    decode_log_type(escaped_value);
+    add_constant(
+            escaped_value,
+            constant_begin_pos,
+            escaped_value.length() - constant_begin_pos
+    );
 }
 
 size_t VariableDictionaryEntry::get_data_size() const {
@@ -211,34 +167,11 @@ void VariableDictionaryEntry::write_to_file(ZstdCompressor& compressor) const {
     compressor.write_string(m_value);
 }
 
-ErrorCode VariableDictionaryEntry::try_read_from_file(
-        ZstdDecompressor& decompressor,
+void VariableDictionaryEntry::read_from_buffer(
+        string_view value,
         clp::variable_dictionary_id_t id
 ) {
+    m_value.assign(value);
     m_id = id;
-
-    ErrorCode error_code;
-    uint64_t value_length{};
-    error_code = decompressor.try_read_numeric_value(value_length);
-    if (ErrorCodeSuccess != error_code) {
-        return error_code;
-    }
-    error_code = decompressor.try_read_string(value_length, m_value);
-    if (ErrorCodeSuccess != error_code) {
-        return error_code;
-    }
-
-    return error_code;
-}
-
-void VariableDictionaryEntry::read_from_file(
-        ZstdDecompressor& decompressor,
-        clp::variable_dictionary_id_t id,
-        bool lazy
-) {
-    auto error_code = try_read_from_file(decompressor, id);
-    if (ErrorCodeSuccess != error_code) {
-        throw OperationFailed(error_code, __FILENAME__, __LINE__);
-    }
 }
 }  // namespace clp_s
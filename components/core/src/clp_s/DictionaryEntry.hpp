@@ -12,7 +12,6 @@
 #include "../clp/ir/types.hpp"
 #include "TraceableException.hpp"
 #include "ZstdCompressor.hpp"
-#include "ZstdDecompressor.hpp"
 
 namespace clp_s {
 /**
@@ -52,7 +51,7 @@ public:
     };
 
     // Constructors
-    LogTypeDictionaryEntry() : m_init(false) {}
+    LogTypeDictionaryEntry() = default;
 
     // Use default copy constructor
     LogTypeDictionaryEntry(LogTypeDictionaryEntry const&) = default;
@@ -151,44 +150,17 @@ public:
     void write_to_file(ZstdCompressor& compressor) const;
 
     /**
-     * Tries to read an entry from the given decompressor
-     * @param decompressor
-     * @return Same as streaming_compression::Decompressor::try_read_numeric_value
-     * @return Same as streaming_compression::Decompressor::try_read_string
-     */
-    ErrorCode
-    try_read_from_file(ZstdDecompressor& decompressor, clp::logtype_dictionary_id_t id, bool lazy);
-
-    /**
-     * Reads an entry from the given decompressor
-     * @param decompressor
-     * @param lazy apply lazy decoding
-     */
-    void read_from_file(ZstdDecompressor& decompressor, clp::logtype_dictionary_id_t id, bool lazy);
-
-    /**
-     * Decodes the log type
-     */
-    void decode_log_type();
-
-    /**
-     * Checks if the entry has been initialized
-     * @return true if the entry has been initialized, false otherwise
-     */
-    bool initialized() const { return m_init; }
-
-private:
-    // Methods
-    /**
-     * Decodes the log type
+     * Initializes the entry from its value as stored in the dictionary, decoding the positions of
+     * its variable placeholders
      * @param escaped_value
+     * @param id
      */
-    void decode_log_type(std::string& escaped_value);
+    void read_from_buffer(std::string_view escaped_value, clp::logtype_dictionary_id_t id);
 
+private:
     // Variables
     std::vector<size_t> m_placeholder_positions;
     size_t m_num_escaped_placeholders{};
-    bool m_init{false};
 };
 
 class VariableDictionaryEntry : public DictionaryEntry<clp::variable_dictionary_id_t> {
@@ -233,22 +205,11 @@ public:
     void write_to_file(ZstdCompressor& compressor) const;
 
     /**
-     * Tries to read an entry from the given decompressor
-     * @param decompressor
-     * @param id
-     * @return Same as streaming_compression::Decompressor::try_read_numeric_value
-     * @return Same as streaming_compression::Decompressor::try_read_string
-     */
-    ErrorCode try_read_from_file(ZstdDecompressor& decompressor, clp::variable_dictionary_id_t id);
-
-    /**
-     * Reads an entry from the given decompressor
-     * @param decompressor
+     * Initializes the entry from its value as stored in the dictionary
+     * @param value
      * @param id
-     * @param lazy
      */
-    void
-    read_from_file(ZstdDecompressor& decompressor, clp::variable_dictionary_id_t id, bool lazy);
+    void read_from_buffer(std::string_view value, clp::variable_dictionary_id_t id);
 };
 }  // namespace clp_s
 
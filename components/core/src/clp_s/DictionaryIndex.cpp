@@ -0,0 +1,226 @@
+#include "DictionaryIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * @param c
+ * @return `c` converted to lowercase if it's an ASCII uppercase letter, `c` otherwise
+ */
+constexpr auto to_ascii_lower(char c) -> uint8_t {
+    if (c >= 'A' && c <= 'Z') {
+        return static_cast<uint8_t>(c - 'A' + 'a');
+    }
+    return static_cast<uint8_t>(c);
+}
+}  // namespace
+
+DictionaryIndex::DictionaryIndex(std::vector<std::string_view> const& values) {
+    m_sorted_ids.resize(values.size());
+    std::iota(m_sorted_ids.begin(), m_sorted_ids.end(), 0);
+    std::ranges::sort(m_sorted_ids, [&](entry_id_t lhs, entry_id_t rhs) {
+        return values[lhs] < values[rhs];
+    });
+
+    // Visiting the entries in ID order keeps every posting list sorted
+    std::vector<uint32_t> trigrams;
+    for (entry_id_t id = 0; id < values.size(); ++id) {
+        trigrams.clear();
+        append_trigrams(values[id], trigrams);
+        for (auto const trigram : trigrams) {
+            m_postings[trigram].push_back(id);
+        }
+    }
+}
+
+void DictionaryIndex::write(ZstdCompressor& compressor) const {
+    compressor.write_numeric_value<uint64_t>(m_sorted_ids.size());
+    compressor.write(
+            reinterpret_cast<char const*>(m_sorted_ids.data()),
+            m_sorted_ids.size() * sizeof(entry_id_t)
+    );
+
+    // Write the posting lists in trigram order so that the output is deterministic
+    std::vector<uint32_t> trigrams;
+    trigrams.reserve(m_postings.size());
+    for (auto const& [trigram, posting] : m_postings) {
+        trigrams.push_back(trigram);
+    }
+    std::ranges::sort(trigrams);
+
+    compressor.write_numeric_value<uint64_t>(trigrams.size());
+    std::vector<entry_id_t> deltas;
+    for (auto const trigram : trigrams) {
+        auto const& posting = m_postings.at(trigram);
+        deltas.resize(posting.size());
+        std::adjacent_difference(posting.begin(), posting.end(), deltas.begin());
+        compressor.write_numeric_value<uint32_t>(trigram);
+        compressor.write_numeric_value<uint64_t>(deltas.size());
+        compressor.write(
+                reinterpret_cast<char const*>(deltas.data()),
+                deltas.size() * sizeof(entry_id_t)
+        );
+    }
+}
+
+auto DictionaryIndex::try_read(ZstdDecompressor& decompressor) -> ErrorCode {
+    m_sorted_ids.clear();
+    m_postings.clear();
+
+    uint64_t num_entries{};
+    if (auto const rc = decompressor.try_read_numeric_value(num_entries); ErrorCodeSuccess != rc) {
+        return rc;
+    }
+    m_sorted_ids.resize(num_entries);
+    if (auto const rc = decompressor.try_read_exact_length(
+                reinterpret_cast<char*>(m_sorted_ids.data()),
+                m_sorted_ids.size() * sizeof(entry_id_t)
+        );
+        ErrorCodeSuccess != rc)
+    {
+        return rc;
+    }
+    if (std::ranges::any_of(m_sorted_ids, [&](entry_id_t id) { return id >= num_entries; })) {
+        return ErrorCodeCorrupt;
+    }
+
+    uint64_t num_trigrams{};
+    if (auto const rc = decompressor.try_read_numeric_value(num_trigrams); ErrorCodeSuccess != rc) {
+        return rc;
+    }
+    for (uint64_t i = 0; i < num_trigrams; ++i) {
+        uint32_t trigram{};
+        uint64_t posting_size{};
+        if (auto const rc = decompressor.try_read_numeric_value(trigram); ErrorCodeSuccess != rc) {
+            return rc;
+        }
+        if (auto const rc = decompressor.try_read_numeric_value(posting_size);
+            ErrorCodeSuccess != rc)
+        {
+            return rc;
+        }
+        if (posting_size > num_entries) {
+            return ErrorCodeCorrupt;
+        }
+
+        auto& posting = m_postings[trigram];
+        posting.resize(posting_size);
+        if (auto const rc = decompressor.try_read_exact_length(
+                    reinterpret_cast<char*>(posting.data()),
+                    posting.size() * sizeof(entry_id_t)
+            );
+            ErrorCodeSuccess != rc)
+        {
+            return rc;
+        }
+        std::partial_sum(posting.begin(), posting.end(), posting.begin());
+        if (false == posting.empty() && posting.back() >= num_entries) {
+            return ErrorCodeCorrupt;
+        }
+    }
+    return ErrorCodeSuccess;
+}
+
+void DictionaryIndex::split_wildcard_string(
+        std::string_view wildcard_string,
+        std::string& prefix,
+        std::vector<std::string>& literals
+) {
+    bool is_prefix{true};
+    std::string literal;
+    for (size_t i = 0; i < wildcard_string.size(); ++i) {
+        auto const c = wildcard_string[i];
+        if ('\\' == c) {
+            if (i + 1 < wildcard_string.size()) {
+                ++i;
+                literal += wildcard_string[i];
+            }
+            continue;
+        }
+        if ('*' != c && '?' != c) {
+            literal += c;
+            continue;
+        }
+
+        if (is_prefix) {
+            prefix = literal;
+            is_prefix = false;
+        }
+        if (false == literal.empty()) {
+            literals.emplace_back(std::move(literal));
+            literal.clear();
+        }
+    }
+
+    if (is_prefix) {
+        prefix = literal;
+    }
+    if (false == literal.empty()) {
+        literals.emplace_back(std::move(literal));
+    }
+}
+
+void DictionaryIndex::append_trigrams(std::string_view value, std::vector<uint32_t>& trigrams) {
+    auto const begin = trigrams.size();
+    for (size_t i = 2; i < value.size(); ++i) {
+        trigrams.push_back(
+                (static_cast<uint32_t>(to_ascii_lower(value[i - 2])) << 16)
+                | (static_cast<uint32_t>(to_ascii_lower(value[i - 1])) << 8)
+                | to_ascii_lower(value[i])
+        );
+    }
+    std::sort(trigrams.begin() + begin, trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin() + begin, trigrams.end()), trigrams.end());
+}
+
+auto DictionaryIndex::intersect_postings(
+        std::vector<std::string> const& literals,
+        std::vector<entry_id_t>& candidates
+) const -> bool {
+    std::vector<uint32_t> trigrams;
+    for (auto const& literal : literals) {
+        append_trigrams(literal, trigrams);
+    }
+    if (trigrams.empty()) {
+        return false;
+    }
+
+    std::vector<std::vector<entry_id_t> const*> postings;
+    postings.reserve(trigrams.size());
+    for (auto const trigram : trigrams) {
+        auto const it = m_postings.find(trigram);
+        if (m_postings.end() == it) {
+            // No value contains this trigram
+            candidates.clear();
+            return true;
+        }
+        postings.push_back(&it->second);
+    }
+
+    // Intersect the shortest posting lists first to keep the intermediate results small
+    std::ranges::sort(postings, [](auto const* lhs, auto const* rhs) {
+        return lhs->size() < rhs->size();
+    });
+    candidates = *postings.front();
+    std::vector<entry_id_t> intersection;
+    for (size_t i = 1; i < postings.size() && false == candidates.empty(); ++i) {
+        intersection.clear();
+        std::ranges::set_intersection(candidates, *postings[i], std::back_inserter(intersection));
+        std::swap(candidates, intersection);
+    }
+    return true;
+}
+}  // namespace clp_s
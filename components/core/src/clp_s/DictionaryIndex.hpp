@@ -0,0 +1,193 @@
+#ifndef CLP_S_DICTIONARYINDEX_HPP
+#define CLP_S_DICTIONARYINDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * A search index over the values of a dictionary. It narrows exact and wildcard lookups down to a
+ * set of candidate entries so that a search doesn't need to scan every entry.
+ *
+ * The index consists of:
+ * - the IDs of all entries sorted by value, used to find the entries that start with the literal
+ *   prefix of a case-sensitive query with a binary search;
+ * - a posting list for every trigram of every (ASCII lowercased) value, containing the sorted IDs of
+ *   the entries containing that trigram. Intersecting the posting lists of a query's trigrams
+ *   yields every entry that could match the query.
+ *
+ * Candidates are a superset of the matching entries, so callers must still match each candidate
+ * against the query.
+ */
+class DictionaryIndex {
+public:
+    // Types
+    using entry_id_t = uint32_t;
+
+    // Constructors
+    DictionaryIndex() = default;
+
+    /**
+     * Builds an index over the given values.
+     * @param values The dictionary's values, indexed by entry ID
+     */
+    explicit DictionaryIndex(std::vector<std::string_view> const& values);
+
+    // Methods
+    /**
+     * Writes the index to the given compressor.
+     * @param compressor
+     */
+    void write(ZstdCompressor& compressor) const;
+
+    /**
+     * Reads an index written by `write`.
+     * @param decompressor
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeCorrupt if the index is malformed
+     * @return Same as ZstdDecompressor::try_read_exact_length on failure
+     */
+    [[nodiscard]] auto try_read(ZstdDecompressor& decompressor) -> ErrorCode;
+
+    /**
+     * @return The number of dictionary entries covered by the index
+     */
+    [[nodiscard]] auto get_num_entries() const -> size_t { return m_sorted_ids.size(); }
+
+    /**
+     * Finds the entries that could match the given wildcard string.
+     * @tparam ValueGetter Callable returning the value of the entry with a given ID
+     * @param wildcard_string
+     * @param ignore_case
+     * @param get_value
+     * @param candidates Returns the IDs of the candidate entries
+     * @return Whether the index could narrow down the candidates. If false, every entry is a
+     * candidate and `candidates` is left empty.
+     */
+    template <typename ValueGetter>
+    [[nodiscard]] auto find_candidates(
+            std::string_view wildcard_string,
+            bool ignore_case,
+            ValueGetter get_value,
+            std::vector<entry_id_t>& candidates
+    ) const -> bool {
+        std::string prefix;
+        std::vector<std::string> literals;
+        split_wildcard_string(wildcard_string, prefix, literals);
+        return narrow_candidates(prefix, literals, ignore_case, get_value, candidates);
+    }
+
+    /**
+     * Finds the entries that could be equal to the given value.
+     * @tparam ValueGetter Callable returning the value of the entry with a given ID
+     * @param value
+     * @param ignore_case
+     * @param get_value
+     * @param candidates Returns the IDs of the candidate entries
+     * @return Same as `find_candidates`
+     */
+    template <typename ValueGetter>
+    [[nodiscard]] auto find_value_candidates(
+            std::string_view value,
+            bool ignore_case,
+            ValueGetter get_value,
+            std::vector<entry_id_t>& candidates
+    ) const -> bool {
+        std::string prefix{value};
+        std::vector<std::string> literals{prefix};
+        return narrow_candidates(prefix, literals, ignore_case, get_value, candidates);
+    }
+
+private:
+    /**
+     * Finds the entries that start with the given prefix and contain every given literal.
+     * @tparam ValueGetter
+     * @param prefix
+     * @param literals
+     * @param ignore_case Whether `prefix` and `literals` should be matched case-insensitively
+     * @param get_value
+     * @param candidates
+     * @return Same as `find_candidates`
+     */
+    template <typename ValueGetter>
+    [[nodiscard]] auto narrow_candidates(
+            std::string_view prefix,
+            std::vector<std::string> const& literals,
+            bool ignore_case,
+            ValueGetter get_value,
+            std::vector<entry_id_t>& candidates
+    ) const -> bool;
+
+    /**
+     * Splits a wildcard string into the literal segments between its wildcards, unescaping any
+     * escaped characters.
+     * @param wildcard_string
+     * @param prefix Returns the literal segment preceding the first wildcard
+     * @param literals Returns all non-empty literal segments
+     */
+    static void split_wildcard_string(
+            std::string_view wildcard_string,
+            std::string& prefix,
+            std::vector<std::string>& literals
+    );
+
+    /**
+     * Appends the distinct trigrams of the given (ASCII lowercased) string to `trigrams`.
+     * @param value
+     * @param trigrams
+     */
+    static void append_trigrams(std::string_view value, std::vector<uint32_t>& trigrams);
+
+    /**
+     * Intersects the posting lists of every trigram in the given literals.
+     * @param literals
+     * @param candidates Returns the IDs of the entries containing every trigram
+     * @return Whether any of the literals contained a trigram
+     */
+    auto intersect_postings(
+            std::vector<std::string> const& literals,
+            std::vector<entry_id_t>& candidates
+    ) const -> bool;
+
+    std::vector<entry_id_t> m_sorted_ids;
+    std::unordered_map<uint32_t, std::vector<entry_id_t>> m_postings;
+};
+
+template <typename ValueGetter>
+auto DictionaryIndex::narrow_candidates(
+        std::string_view prefix,
+        std::vector<std::string> const& literals,
+        bool ignore_case,
+        ValueGetter get_value,
+        std::vector<entry_id_t>& candidates
+) const -> bool {
+    auto const has_trigram_candidates = intersect_postings(literals, candidates);
+    if (ignore_case || prefix.empty()) {
+        return has_trigram_candidates;
+    }
+
+    // Values starting with the prefix are contiguous in the sorted order
+    auto const prefix_begin = std::ranges::partition_point(m_sorted_ids, [&](entry_id_t id) {
+        return std::string_view{get_value(id)} < prefix;
+    });
+    auto const prefix_end = std::partition_point(prefix_begin, m_sorted_ids.cend(), [&](auto id) {
+        return std::string_view{get_value(id)}.starts_with(prefix);
+    });
+    auto const num_prefix_candidates = static_cast<size_t>(prefix_end - prefix_begin);
+    if (false == has_trigram_candidates || num_prefix_candidates < candidates.size()) {
+        candidates.assign(prefix_begin, prefix_end);
+    }
+    return true;
+}
+}  // namespace clp_s
+
+#endif  // CLP_S_DICTIONARYINDEX_HPP
@@ -3,20 +3,38 @@
 #ifndef CLP_S_DICTIONARYREADER_HPP
 #define CLP_S_DICTIONARYREADER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <string_utils/string_utils.hpp>
 
 #include "../clp/Defs.h"
+#include "archive_constants.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "DictionaryEntry.hpp"
+#include "DictionaryIndex.hpp"
+#include "ZstdDecompressor.hpp"
 
 namespace clp_s {
+/**
+ * Reader for a dictionary in an archive.
+ *
+ * The values of all entries are read into a single contiguous buffer, indexed by an array of
+ * offsets. Searches compare against views of this buffer, and an entry object (including, for
+ * logtypes, its decoded variable placeholders) is only materialized the first time it's accessed.
+ * This keeps opening an archive cheap when a search only ends up touching a few entries.
+ *
+ * Since materializing entries modifies the reader, it isn't safe to use from multiple threads
+ * concurrently, even through const methods.
+ */
 template <typename DictionaryIdType, typename EntryType>
 class DictionaryReader {
 public:
@@ -47,14 +65,26 @@ public:
     void close();
 
     /**
-     * Reads all entries from disk
+     * Reads the values of all entries from disk
      */
-    void read_entries(bool lazy = false);
+    void read_entries();
 
     /**
+     * Reads the dictionary's search index from disk if the archive contains one. Lookups fall back
+     * to scanning every entry when there is no index. Must be called after `read_entries`.
+     */
+    void read_index();
+
+    /**
+     * @return The number of entries in the dictionary
+     */
+    size_t get_num_entries() const { return m_entries.size(); }
+
+    /**
+     * Materializes every entry in the dictionary.
      * @return All dictionary entries
      */
-    std::vector<EntryType> const& get_entries() const { return m_entries; }
+    std::vector<EntryType> const& get_entries() const;
 
     /**
      * @param id
@@ -68,6 +98,13 @@ public:
      */
     std::string const& get_value(DictionaryIdType id) const;
 
+    /**
+     * @param id
+     * @return A view of the value of the entry with the specified ID, without materializing the
+     * entry
+     */
+    std::string_view get_value_view(DictionaryIdType id) const;
+
     /**
      * Gets the entries matching the given search string
      * @param search_string
@@ -90,11 +127,35 @@ public:
     ) const;
 
 protected:
+    // Methods
+    /**
+     * @param id An ID that's known to be in bounds
+     * @return A view of the value of the entry with the given ID
+     */
+    std::string_view get_value_view_unsafe(DictionaryIdType id) const {
+        return {m_values.data() + m_value_offsets[id],
+                m_value_offsets[id + 1] - m_value_offsets[id]};
+    }
+
+    /**
+     * Materializes the entry with the given ID if it hasn't been yet.
+     * @param id An ID that's known to be in bounds
+     * @return The entry
+     */
+    EntryType& load_entry(DictionaryIdType id) const;
+
+    // Variables
     bool m_is_open;
     ArchiveReaderAdaptor& m_adaptor;
     std::string m_dictionary_path;
     ZstdDecompressor m_dictionary_decompressor;
-    std::vector<EntryType> m_entries;
+    // The values of all entries, back to back, with the value of entry `i` spanning
+    // [m_value_offsets[i], m_value_offsets[i + 1])
+    std::string m_values;
+    std::vector<uint64_t> m_value_offsets;
+    mutable std::vector<EntryType> m_entries;
+    mutable std::vector<bool> m_is_entry_loaded;
+    std::optional<DictionaryIndex> m_index;
 };
 
 using VariableDictionaryReader
@@ -117,11 +178,12 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
+    m_index.reset();
     m_is_open = false;
 }
 
 template <typename DictionaryIdType, typename EntryType>
-void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
+void DictionaryReader<DictionaryIdType, EntryType>::read_entries() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
@@ -133,15 +195,64 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
     dictionary_reader->read_numeric_value(num_dictionary_entries, false);
     m_dictionary_decompressor.open(*dictionary_reader, cDecompressorFileReadBufferCapacity);
 
-    // Read dictionary entries
-    m_entries.resize(num_dictionary_entries);
+    // Read the value of each entry directly into the contiguous buffer
+    m_values.clear();
+    m_value_offsets.clear();
+    m_value_offsets.reserve(num_dictionary_entries + 1);
+    m_value_offsets.push_back(0);
     for (size_t i = 0; i < num_dictionary_entries; ++i) {
-        auto& entry = m_entries[i];
-        entry.read_from_file(m_dictionary_decompressor, i, lazy);
+        uint64_t value_length{};
+        auto error_code = m_dictionary_decompressor.try_read_numeric_value(value_length);
+        if (ErrorCodeSuccess != error_code) {
+            throw OperationFailed(error_code, __FILENAME__, __LINE__);
+        }
+        auto const value_begin_pos = m_values.size();
+        m_values.resize(value_begin_pos + value_length);
+        error_code = m_dictionary_decompressor.try_read_exact_length(
+                m_values.data() + value_begin_pos,
+                value_length
+        );
+        if (ErrorCodeSuccess != error_code) {
+            throw OperationFailed(error_code, __FILENAME__, __LINE__);
+        }
+        m_value_offsets.push_back(m_values.size());
     }
+    m_values.shrink_to_fit();
 
     m_dictionary_decompressor.close();
     m_adaptor.checkin_reader_for_section(m_dictionary_path);
+
+    m_entries.clear();
+    m_entries.resize(num_dictionary_entries);
+    m_is_entry_loaded.assign(num_dictionary_entries, false);
+}
+
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::read_index() {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+
+    auto const index_path = m_dictionary_path + constants::cDictionaryIndexSuffix;
+    if (false == m_adaptor.has_section(index_path)) {
+        return;
+    }
+
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+    auto index_reader = m_adaptor.checkout_reader_for_section(index_path);
+    ZstdDecompressor index_decompressor;
+    index_decompressor.open(*index_reader, cDecompressorFileReadBufferCapacity);
+    DictionaryIndex index;
+    auto const rc = index.try_read(index_decompressor);
+    index_decompressor.close();
+    m_adaptor.checkin_reader_for_section(index_path);
+    if (ErrorCodeSuccess != rc) {
+        throw OperationFailed(rc, __FILENAME__, __LINE__);
+    }
+    if (index.get_num_entries() != m_entries.size()) {
+        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+    m_index.emplace(std::move(index));
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -153,7 +264,15 @@ EntryType& DictionaryReader<DictionaryIdType, EntryType>::get_entry(DictionaryId
         throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
     }
 
-    return m_entries[id];
+    return load_entry(id);
+}
+
+template <typename DictionaryIdType, typename EntryType>
+std::vector<EntryType> const& DictionaryReader<DictionaryIdType, EntryType>::get_entries() const {
+    for (size_t id = 0; id < m_entries.size(); ++id) {
+        load_entry(id);
+    }
+    return m_entries;
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -162,7 +281,26 @@ DictionaryReader<DictionaryIdType, EntryType>::get_value(DictionaryIdType id) co
     if (id >= m_entries.size()) {
         throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
     }
-    return m_entries[id].get_value();
+    return load_entry(id).get_value();
+}
+
+template <typename DictionaryIdType, typename EntryType>
+std::string_view
+DictionaryReader<DictionaryIdType, EntryType>::get_value_view(DictionaryIdType id) const {
+    if (id >= m_entries.size()) {
+        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+    return get_value_view_unsafe(id);
+}
+
+template <typename DictionaryIdType, typename EntryType>
+EntryType& DictionaryReader<DictionaryIdType, EntryType>::load_entry(DictionaryIdType id) const {
+    auto& entry = m_entries[id];
+    if (false == m_is_entry_loaded[id]) {
+        entry.read_from_buffer(get_value_view_unsafe(id), id);
+        m_is_entry_loaded[id] = true;
+    }
+    return entry;
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -171,15 +309,29 @@ DictionaryReader<DictionaryIdType, EntryType>::get_entry_matching_value(
         std::string_view search_string,
         bool ignore_case
 ) const {
+    auto const get_value = [&](DictionaryIndex::entry_id_t id) -> std::string_view {
+        return get_value_view_unsafe(id);
+    };
+    std::vector<DictionaryIndex::entry_id_t> candidates;
+    bool const has_candidates{
+            m_index.has_value()
+            && m_index->find_value_candidates(search_string, ignore_case, get_value, candidates)
+    };
+
     if (false == ignore_case) {
         // In case-sensitive match, there can be only one matched entry.
-        if (auto const it = std::ranges::find_if(
-                    m_entries,
-                    [&](auto const& entry) { return entry.get_value() == search_string; }
-            );
-            m_entries.cend() != it)
-        {
-            return {&(*it)};
+        if (has_candidates) {
+            for (auto const id : candidates) {
+                if (get_value_view_unsafe(id) == search_string) {
+                    return {&load_entry(id)};
+                }
+            }
+            return {};
+        }
+        for (size_t id = 0; id < m_entries.size(); ++id) {
+            if (get_value_view_unsafe(id) == search_string) {
+                return {&load_entry(id)};
+            }
         }
         return {};
     }
@@ -190,9 +342,26 @@ DictionaryReader<DictionaryIdType, EntryType>::get_entry_matching_value(
             std::back_inserter(search_string_uppercase),
             search_string
     );
-    for (auto const& entry : m_entries) {
-        if (boost::algorithm::to_upper_copy(entry.get_value()) == search_string_uppercase) {
-            entries.push_back(&entry);
+    std::string value_uppercase;
+    auto const matches = [&](size_t id) -> bool {
+        value_uppercase.clear();
+        std::ignore = boost::algorithm::to_upper_copy(
+                std::back_inserter(value_uppercase),
+                get_value_view_unsafe(id)
+        );
+        return value_uppercase == search_string_uppercase;
+    };
+    if (has_candidates) {
+        for (auto const id : candidates) {
+            if (matches(id)) {
+                entries.push_back(&load_entry(id));
+            }
+        }
+        return entries;
+    }
+    for (size_t id = 0; id < m_entries.size(); ++id) {
+        if (matches(id)) {
+            entries.push_back(&load_entry(id));
         }
     }
     return entries;
@@ -204,14 +373,38 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
-    for (auto const& entry : m_entries) {
+    std::vector<DictionaryIndex::entry_id_t> candidates;
+    if (m_index.has_value()
+        && m_index->find_candidates(
+                wildcard_string,
+                ignore_case,
+                [&](DictionaryIndex::entry_id_t id) -> std::string_view {
+                    return get_value_view_unsafe(id);
+                },
+                candidates
+        ))
+    {
+        for (auto const id : candidates) {
+            if (clp::string_utils::wildcard_match_unsafe(
+                        get_value_view_unsafe(id),
+                        wildcard_string,
+                        !ignore_case
+                ))
+            {
+                entries.insert(&load_entry(id));
+            }
+        }
+        return;
+    }
+
+    for (size_t id = 0; id < m_entries.size(); ++id) {
         if (clp::string_utils::wildcard_match_unsafe(
-                    entry.get_value(),
+                    get_value_view_unsafe(id),
                     wildcard_string,
                     !ignore_case
             ))
         {
-            entries.insert(&entry);
+            entries.insert(&load_entry(id));
         }
     }
 }
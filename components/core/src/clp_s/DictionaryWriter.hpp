@@ -3,10 +3,16 @@
 #ifndef CLP_S_DICTIONARYWRITER_HPP
 #define CLP_S_DICTIONARYWRITER_HPP
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <absl/container/flat_hash_map.h>
 
 #include "../clp/Defs.h"
 #include "DictionaryEntry.hpp"
+#include "DictionaryIndex.hpp"
 
 namespace clp_s {
 template <typename DictionaryIdType, typename EntryType>
@@ -43,6 +49,15 @@ public:
      */
     [[nodiscard]] size_t close();
 
+    /**
+     * Writes a search index over the dictionary's entries to the given path. Must be called before
+     * `close`.
+     * @param index_path
+     * @return the compressed size of the index in bytes
+     * @throw OperationFailed if the dictionary isn't open or has too many entries to be indexed
+     */
+    [[nodiscard]] size_t write_index(std::string const& index_path);
+
     /**
      * Writes the dictionary's header and flushes unwritten content to disk
      */
@@ -68,6 +83,7 @@ protected:
     value_to_id_t m_value_to_id;
     uint64_t m_next_id{};
     uint64_t m_max_id{};
+    int m_compression_level{};
 
     // Size (in-memory) of the data contained in the dictionary
     size_t m_data_size{};
@@ -127,6 +143,7 @@ void DictionaryWriter<DictionaryIdType, EntryType>::open(
 
     m_next_id = 0;
     m_max_id = max_id;
+    m_compression_level = compression_level;
 
     m_data_size = 0;
     m_is_open = true;
@@ -149,6 +166,32 @@ size_t DictionaryWriter<DictionaryIdType, EntryType>::close() {
     return compressed_size;
 }
 
+template <typename DictionaryIdType, typename EntryType>
+size_t DictionaryWriter<DictionaryIdType, EntryType>::write_index(std::string const& index_path) {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+    if (m_value_to_id.size() > UINT32_MAX) {
+        throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
+    }
+
+    std::vector<std::string_view> values(m_value_to_id.size());
+    for (auto const& [value, id] : m_value_to_id) {
+        values[id] = value;
+    }
+    DictionaryIndex const index{values};
+
+    FileWriter index_file_writer;
+    index_file_writer.open(index_path, FileWriter::OpenMode::CreateForWriting);
+    ZstdCompressor index_compressor;
+    index_compressor.open(index_file_writer, m_compression_level);
+    index.write(index_compressor);
+    index_compressor.close();
+    size_t compressed_size = index_file_writer.get_pos();
+    index_file_writer.close();
+    return compressed_size;
+}
+
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryWriter<DictionaryIdType, EntryType>::write_header_and_flush_to_disk() {
     if (false == m_is_open) {
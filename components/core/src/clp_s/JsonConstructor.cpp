@@ -1,8 +1,16 @@
 #include "JsonConstructor.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <iostream>
+#include <limits>
 #include <queue>
+#include <string>
+#include <string_view>
 #include <system_error>
+#include <vector>
 
 #include <fmt/format.h>
 #include <mongocxx/client.hpp>
@@ -61,132 +69,316 @@ void JsonConstructor::store() {
     m_archive_reader->close();
 }
 
-void JsonConstructor::construct_in_order() {
-    std::string buffer;
-    auto tables = m_archive_reader->read_all_tables();
-    using ReaderPointer = std::shared_ptr<SchemaReader>;
-    auto cmp = [](ReaderPointer& left, ReaderPointer& right) {
-        return left->get_next_log_event_idx() > right->get_next_log_event_idx();
-    };
-    std::priority_queue record_queue(tables.begin(), tables.end(), cmp);
-    // Clear tables vector so that memory gets deallocated after we have marshalled all records for
-    // a given table
-    tables.clear();
+/**
+ * Writes records in log order into chunk files, recording the metadata of each chunk if requested.
+ */
+class JsonConstructor::OrderedChunkWriter {
+public:
+    // Constructors
+    OrderedChunkWriter(JsonConstructorOption const& option, std::string_view archive_id);
 
-    int64_t first_idx{};
-    int64_t last_idx{};
-    size_t chunk_size{};
-    auto src_path = std::filesystem::path(m_option.output_dir) / m_archive_reader->get_archive_id();
-    FileWriter writer;
-    writer.open(src_path, FileWriter::OpenMode::CreateForWriting);
+    // Methods
+    /**
+     * Writes a record, which must come after every record written previously in log order.
+     * @param log_event_idx
+     * @param record
+     */
+    void write(int64_t log_event_idx, std::string_view record);
 
-    mongocxx::client client;
-    mongocxx::collection collection;
+    /**
+     * Finalizes the last chunk and writes the metadata of every chunk.
+     */
+    void finish();
+
+private:
+    /**
+     * Closes the current chunk, renaming it to include the range of records it contains.
+     * @param open_new_writer Whether to open a new chunk for subsequent records
+     */
+    void finalize_chunk(bool open_new_writer);
+
+    JsonConstructorOption const& m_option;
+    std::string m_archive_id;
+    std::filesystem::path m_src_path;
+    FileWriter m_writer;
+    int64_t m_first_idx{};
+    int64_t m_last_idx{};
+    size_t m_chunk_size{};
+
+    mongocxx::client m_client;
+    mongocxx::collection m_collection;
+    std::vector<bsoncxx::document::value> m_results;
+};
+
+JsonConstructor::OrderedChunkWriter::OrderedChunkWriter(
+        JsonConstructorOption const& option,
+        std::string_view archive_id
+)
+        : m_option{option},
+          m_archive_id{archive_id},
+          m_src_path{std::filesystem::path(option.output_dir) / archive_id} {
+    m_writer.open(m_src_path, FileWriter::OpenMode::CreateForWriting);
 
     if (m_option.metadata_db.has_value()) {
         try {
             auto const mongo_uri{mongocxx::uri(m_option.metadata_db->mongodb_uri)};
-            client = mongocxx::client{mongo_uri};
-            collection = client[mongo_uri.database()][m_option.metadata_db->mongodb_collection];
+            m_client = mongocxx::client{mongo_uri};
+            m_collection = m_client[mongo_uri.database()][m_option.metadata_db->mongodb_collection];
         } catch (mongocxx::exception const& e) {
             throw OperationFailed(ErrorCodeBadParamDbUri, __FILE__, __LINE__, e.what());
         }
     }
+}
 
-    std::vector<bsoncxx::document::value> results;
-    auto finalize_chunk = [&](bool open_new_writer) {
-        // Add one to last_idx to match clp's behaviour of having the end index be exclusive
-        ++last_idx;
-        writer.close();
-        std::string new_file_name = src_path.string() + "_" + std::to_string(first_idx) + "_"
-                                    + std::to_string(last_idx) + ".jsonl";
-        auto new_file_path = std::filesystem::path(new_file_name);
+void JsonConstructor::OrderedChunkWriter::write(int64_t log_event_idx, std::string_view record) {
+    m_last_idx = log_event_idx;
+    if (0 == m_chunk_size) {
+        m_first_idx = m_last_idx;
+    }
+    m_writer.write(record.data(), record.length());
+    m_chunk_size += record.length();
+
+    if (0 != m_option.target_ordered_chunk_size
+        && m_chunk_size >= m_option.target_ordered_chunk_size)
+    {
+        finalize_chunk(true);
+        m_chunk_size = 0;
+    }
+}
+
+void JsonConstructor::OrderedChunkWriter::finish() {
+    if (m_chunk_size > 0) {
+        finalize_chunk(false);
+    } else {
+        m_writer.close();
         std::error_code ec;
-        std::filesystem::rename(src_path, new_file_path, ec);
+        std::filesystem::remove(m_src_path, ec);
         if (ec) {
             throw OperationFailed(ErrorCodeFailure, __FILE__, __LINE__, ec.message());
         }
+    }
 
-        if (m_option.metadata_db.has_value()) {
-            results.emplace_back(
-                    std::move(
-                            bsoncxx::builder::basic::make_document(
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cPath,
-                                            new_file_path.filename()
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cStreamId,
-                                            std::string{m_archive_reader->get_archive_id()}
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cBeginMsgIx,
-                                            first_idx
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cEndMsgIx,
-                                            last_idx
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cIsLastChunk,
-                                            false == open_new_writer
-                                    )
-                            )
-                    )
-            );
+    if (false == m_results.empty()) {
+        try {
+            m_collection.insert_many(m_results);
+        } catch (mongocxx::exception const& e) {
+            throw OperationFailed(ErrorCodeFailureDbBulkWrite, __FILE__, __LINE__, e.what());
         }
+    }
+}
 
-        if (m_option.print_ordered_chunk_stats) {
-            nlohmann::json json_msg;
-            json_msg["path"] = new_file_path.string();
-            std::cout << json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore)
-                      << std::endl;
-        }
+void JsonConstructor::OrderedChunkWriter::finalize_chunk(bool open_new_writer) {
+    // Add one to last_idx to match clp's behaviour of having the end index be exclusive
+    ++m_last_idx;
+    m_writer.close();
+    std::string new_file_name = m_src_path.string() + "_" + std::to_string(m_first_idx) + "_"
+                                + std::to_string(m_last_idx) + ".jsonl";
+    auto new_file_path = std::filesystem::path(new_file_name);
+    std::error_code ec;
+    std::filesystem::rename(m_src_path, new_file_path, ec);
+    if (ec) {
+        throw OperationFailed(ErrorCodeFailure, __FILE__, __LINE__, ec.message());
+    }
 
-        if (open_new_writer) {
-            writer.open(src_path, FileWriter::OpenMode::CreateForWriting);
-        }
+    if (m_option.metadata_db.has_value()) {
+        m_results.emplace_back(
+                std::move(
+                        bsoncxx::builder::basic::make_document(
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cPath,
+                                        new_file_path.filename()
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cStreamId,
+                                        m_archive_id
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cBeginMsgIx,
+                                        m_first_idx
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cEndMsgIx,
+                                        m_last_idx
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cIsLastChunk,
+                                        false == open_new_writer
+                                )
+                        )
+                )
+        );
+    }
+
+    if (m_option.print_ordered_chunk_stats) {
+        nlohmann::json json_msg;
+        json_msg["path"] = new_file_path.string();
+        std::cout << json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore)
+                  << std::endl;
+    }
+
+    if (open_new_writer) {
+        m_writer.open(m_src_path, FileWriter::OpenMode::CreateForWriting);
+    }
+}
+
+void JsonConstructor::construct_in_order() {
+    OrderedChunkWriter chunk_writer{m_option, m_archive_reader->get_archive_id()};
+    if (0 == m_option.ordered_memory_budget) {
+        construct_in_order_in_memory(chunk_writer);
+    } else if (InputSource::Network == m_option.archive_path.source) {
+        SPDLOG_WARN(
+                "Archives read over the network can't be decompressed in log order with a bounded"
+                " amount of memory. Falling back to decompressing every table in memory."
+        );
+        construct_in_order_in_memory(chunk_writer);
+    } else {
+        construct_in_order_with_bounded_memory(chunk_writer);
+    }
+    chunk_writer.finish();
+}
+
+void JsonConstructor::construct_in_order_in_memory(OrderedChunkWriter& chunk_writer) {
+    std::string buffer;
+    auto tables = m_archive_reader->read_all_tables();
+    using ReaderPointer = std::shared_ptr<SchemaReader>;
+    auto cmp = [](ReaderPointer& left, ReaderPointer& right) {
+        return left->get_next_log_event_idx() > right->get_next_log_event_idx();
     };
+    std::priority_queue record_queue(tables.begin(), tables.end(), cmp);
+    // Clear tables vector so that memory gets deallocated after we have marshalled all records for
+    // a given table
+    tables.clear();
 
     while (false == record_queue.empty()) {
         ReaderPointer next = record_queue.top();
         record_queue.pop();
-        last_idx = next->get_next_log_event_idx();
-        if (0 == chunk_size) {
-            first_idx = last_idx;
-        }
+        auto const log_event_idx{next->get_next_log_event_idx()};
         next->get_next_message(buffer);
         if (false == next->done()) {
             record_queue.emplace(std::move(next));
         }
-        writer.write(buffer.c_str(), buffer.length());
-        chunk_size += buffer.length();
-
-        if (0 != m_option.target_ordered_chunk_size
-            && chunk_size >= m_option.target_ordered_chunk_size)
-        {
-            finalize_chunk(true);
-            chunk_size = 0;
-        }
+        chunk_writer.write(log_event_idx, buffer);
     }
+}
 
-    if (chunk_size > 0) {
-        finalize_chunk(false);
-    } else {
-        writer.close();
-        std::error_code ec;
-        std::filesystem::remove(src_path, ec);
-        if (ec) {
-            throw OperationFailed(ErrorCodeFailure, __FILE__, __LINE__, ec.message());
+void JsonConstructor::construct_in_order_with_bounded_memory(OrderedChunkWriter& chunk_writer) {
+    // Position of the next record to be written from each table that has records left
+    struct TableCursor {
+        int32_t schema_id;
+        uint64_t num_messages;
+        uint64_t next_message{0};
+        int64_t next_log_event_idx{0};
+    };
+    // Offset and length of a record in the window's buffer
+    struct RecordLocation {
+        size_t offset{0};
+        size_t length{0};
+    };
+
+    std::vector<TableCursor> cursors;
+    uint64_t num_records{0};
+    uint64_t tables_size{0};
+    for (auto const schema_id : m_archive_reader->get_schema_ids()) {
+        auto const& schema_metadata = m_archive_reader->get_schema_metadata(schema_id);
+        if (0 == schema_metadata.num_messages) {
+            continue;
         }
+        cursors.push_back({schema_id, schema_metadata.num_messages});
+        num_records += schema_metadata.num_messages;
+        tables_size += schema_metadata.uncompressed_size;
+    }
+    if (cursors.empty()) {
+        return;
     }
 
-    if (false == results.empty()) {
-        try {
-            collection.insert_many(results);
-        } catch (mongocxx::exception const& e) {
-            throw OperationFailed(ErrorCodeFailureDbBulkWrite, __FILE__, __LINE__, e.what());
+    // Until some records have been marshalled, estimate their size from the size of the encoded
+    // tables, conservatively assuming that marshalling expands records several times over.
+    constexpr double cEstimatedMarshallingExpansion{4.0};
+    double avg_record_size{std::max(
+            1.0,
+            cEstimatedMarshallingExpansion * static_cast<double>(tables_size)
+                    / static_cast<double>(num_records)
+    )};
+
+    std::string message;
+    std::string window_buffer;
+    std::vector<RecordLocation> window;
+    int64_t window_begin{0};
+    bool is_first_pass{true};
+    while (false == cursors.empty()) {
+        // Every pass marshals the records in the window [window_begin, window_end) from each table
+        // in turn, reading the packed streams in order and holding one decompressed stream at a
+        // time, then writes the window's records in log order.
+        auto const window_size{std::max<int64_t>(
+                1,
+                static_cast<int64_t>(
+                        static_cast<double>(m_option.ordered_memory_budget)
+                        / (avg_record_size + static_cast<double>(sizeof(RecordLocation)))
+                )
+        )};
+        if (false == is_first_pass) {
+            // Skip any gap in the log event indices
+            window_begin = std::ranges::min(cursors, {}, &TableCursor::next_log_event_idx)
+                                   .next_log_event_idx;
+            m_archive_reader->rewind_packed_streams();
+        }
+        auto const window_end{window_begin + window_size};
+        window_buffer.clear();
+        window.assign(window_size, RecordLocation{});
+
+        for (auto& cursor : cursors) {
+            if (cursor.next_log_event_idx >= window_end) {
+                continue;
+            }
+            auto& reader = m_archive_reader->read_schema_table(cursor.schema_id, false, true);
+            reader.skip_messages(cursor.next_message);
+            while (false == reader.done()) {
+                auto const log_event_idx{reader.get_next_log_event_idx()};
+                if (log_event_idx >= window_end) {
+                    break;
+                }
+                if (log_event_idx < window_begin) {
+                    throw OperationFailed(
+                            ErrorCodeCorrupt,
+                            __FILE__,
+                            __LINE__,
+                            fmt::format(
+                                    "Records in table {} aren't in log order",
+                                    cursor.schema_id
+                            )
+                    );
+                }
+                reader.get_next_message(message);
+                ++cursor.next_message;
+                window[log_event_idx - window_begin] = {window_buffer.size(), message.size()};
+                window_buffer += message;
+            }
+            cursor.next_log_event_idx = reader.done() ? std::numeric_limits<int64_t>::max()
+                                                      : reader.get_next_log_event_idx();
         }
+        std::erase_if(cursors, [](TableCursor const& cursor) {
+            return cursor.next_message >= cursor.num_messages;
+        });
+
+        size_t num_window_records{0};
+        for (int64_t i{0}; i < window_size; ++i) {
+            auto const& [offset, length] = window[i];
+            if (0 == length) {
+                continue;
+            }
+            chunk_writer.write(
+                    window_begin + i,
+                    std::string_view{window_buffer}.substr(offset, length)
+            );
+            ++num_window_records;
+        }
+        if (num_window_records > 0) {
+            avg_record_size = static_cast<double>(window_buffer.size())
+                              / static_cast<double>(num_window_records);
+        }
+
+        window_begin = window_end;
+        is_first_pass = false;
     }
 }
 }  // namespace clp_s
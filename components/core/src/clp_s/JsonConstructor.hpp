@@ -1,6 +1,8 @@
 #ifndef CLP_S_JSONCONSTRUCTOR_HPP
 #define CLP_S_JSONCONSTRUCTOR_HPP
 
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -28,6 +30,9 @@ struct JsonConstructorOption {
     bool ordered{false};
     bool print_ordered_chunk_stats{false};
     size_t target_ordered_chunk_size{};
+    // Soft limit on the size (B) of the records held in memory while decompressing in log order.
+    // When 0, every table of the archive is held in memory.
+    size_t ordered_memory_budget{};
     std::optional<MetadataDbOption> metadata_db{std::nullopt};
 };
 
@@ -61,12 +66,31 @@ public:
     void store();
 
 private:
+    // Types
+    class OrderedChunkWriter;
+
     /**
      * Reads all of the tables from m_archive_reader and writes all of the records
      * they contain to writer in log order.
      */
     void construct_in_order();
 
+    /**
+     * Writes the records of every table in log order by loading every table into memory and
+     * merging them.
+     * @param chunk_writer
+     */
+    void construct_in_order_in_memory(OrderedChunkWriter& chunk_writer);
+
+    /**
+     * Writes the records of every table in log order by making several passes over the tables.
+     * Each pass marshals the records within a window of log event indices, sized to fit within
+     * `JsonConstructorOption::ordered_memory_budget`, while holding a single decompressed packed
+     * stream at a time. This trades repeated decompression for a bounded memory footprint.
+     * @param chunk_writer
+     */
+    void construct_in_order_with_bounded_memory(OrderedChunkWriter& chunk_writer);
+
     JsonConstructorOption m_option{};
     std::unique_ptr<ArchiveReader> m_archive_reader;
 };
@@ -1,9 +1,12 @@
 #include "JsonParser.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -18,6 +21,7 @@
 #include <simdjson.h>
 #include <spdlog/spdlog.h>
 
+#include "../clp/ffi/ir_stream/ContiguousIrBuffer.hpp"
 #include "../clp/ffi/ir_stream/decoding_methods.hpp"
 #include "../clp/ffi/ir_stream/Deserializer.hpp"
 #include "../clp/ffi/ir_stream/IrUnitType.hpp"
@@ -28,6 +32,7 @@
 #include "../clp/ir/EncodedTextAst.hpp"
 #include "../clp/NetworkReader.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "../clp/Thread.hpp"
 #include "../clp/time_types.hpp"
 #include "archive_constants.hpp"
 #include "ErrorCode.hpp"
@@ -137,6 +142,58 @@ auto round_trip_is_identical(std::string_view float_str, double value, float_for
 }
 }  // namespace
 
+/**
+ * Thread that ingests input paths claimed from an `InputPathQueue` into its own archives. The
+ * thread's `JsonParser` (and therefore its first archive) is only created once the thread has
+ * claimed its first path, so that threads which find the queue drained don't write empty archives.
+ */
+class JsonParser::IngestionThread : public clp::Thread {
+public:
+    // Constructors
+    IngestionThread(
+            JsonParserOption const& option,
+            InputPathQueue& queue,
+            std::string const& archive_creator_id
+    )
+            : m_option{option},
+              m_queue{queue},
+              m_archive_creator_id{archive_creator_id} {}
+
+    // Methods
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+    [[nodiscard]] auto get_archive_stats() -> std::vector<ArchiveStats>& { return m_archive_stats; }
+
+protected:
+    // Methods implementing `clp::Thread`
+    void thread_method() override {
+        auto const* path{m_queue.try_claim()};
+        if (nullptr == path) {
+            return;
+        }
+
+        try {
+            JsonParser parser{m_option};
+            if (false == parser.ingest_claimed_paths(*path, m_queue, m_archive_creator_id)) {
+                m_succeeded = false;
+                return;
+            }
+            m_archive_stats = parser.store();
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Encountered error in ingestion thread - {}", e.what());
+            m_queue.abort();
+            m_succeeded = false;
+        }
+    }
+
+private:
+    JsonParserOption const& m_option;
+    InputPathQueue& m_queue;
+    std::string const& m_archive_creator_id;
+    std::vector<ArchiveStats> m_archive_stats;
+    bool m_succeeded{true};
+};
+
 JsonParser::JsonParser(JsonParserOption const& option)
         : m_target_encoded_size(option.target_encoded_size),
           m_max_document_size(option.max_document_size),
@@ -178,13 +235,25 @@ JsonParser::JsonParser(JsonParserOption const& option)
     m_archive_options.compression_level = option.compression_level;
     m_archive_options.print_archive_stats = option.print_archive_stats;
     m_archive_options.single_file_archive = option.single_file_archive;
+    m_archive_options.index_dictionaries = option.index_dictionaries;
     m_archive_options.min_table_size = option.min_table_size;
+    m_archive_options.num_table_compression_threads = option.num_table_compression_threads;
     m_archive_options.id = m_generator();
     m_archive_options.authoritative_timestamp = m_timestamp_column;
     m_archive_options.authoritative_timestamp_namespace = m_timestamp_namespace;
 
-    m_archive_writer = std::make_unique<ArchiveWriter>();
-    m_archive_writer->open(m_archive_options);
+    m_num_ingestion_threads = std::max<size_t>(option.num_ingestion_threads, 1);
+    if (m_num_ingestion_threads > 1) {
+        m_worker_option = option;
+        m_worker_option.input_paths.clear();
+        m_worker_option.num_ingestion_threads = 1;
+    }
+
+    // When ingesting in parallel, this parser's archive is only opened once it claims an input
+    // path (see `ingest_in_parallel`), since the other threads may claim every path first.
+    if (false == is_parallel_ingestion()) {
+        open_archive();
+    }
 }
 
 void JsonParser::parse_obj_in_array(simdjson::ondemand::object line, int32_t parent_node_id) {
@@ -621,42 +690,112 @@ void JsonParser::parse_line(
 
 bool JsonParser::ingest() {
     auto archive_creator_id = boost::uuids::to_string(m_generator());
+    if (is_parallel_ingestion()) {
+        return ingest_in_parallel(archive_creator_id);
+    }
     for (auto const& path : m_input_paths) {
-        auto reader{try_create_reader(path, m_network_auth)};
-        if (nullptr == reader) {
+        if (false == ingest_path(path, archive_creator_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto JsonParser::ingest_path(Path const& path, std::string const& archive_creator_id) -> bool {
+    auto reader{try_create_reader(path, m_network_auth)};
+    if (nullptr == reader) {
+        std::ignore = m_archive_writer->close();
+        return false;
+    }
+
+    auto const [nested_readers, file_type] = try_deduce_reader_type(reader);
+    bool ingestion_successful{};
+    switch (file_type) {
+        case FileType::Json:
+            ingestion_successful = ingest_json(nested_readers.back(), path, archive_creator_id);
+            break;
+        case FileType::KeyValueIr:
+            ingestion_successful = ingest_kvir(nested_readers.back(), path, archive_creator_id);
+            break;
+        case FileType::LogText:
+            SPDLOG_ERROR(
+                    "Direct ingestion of unstructured logtext is not supported from input {}",
+                    path.path
+            );
+            std::ignore = m_archive_writer->close();
+            return false;
+        case FileType::Zstd:
+        case FileType::Unknown:
+        default: {
+            std::ignore = check_and_log_curl_error(path, reader);
+            SPDLOG_ERROR("Could not deduce content type for input {}", path.path);
             std::ignore = m_archive_writer->close();
             return false;
         }
+    }
 
-        auto const [nested_readers, file_type] = try_deduce_reader_type(reader);
-        bool ingestion_successful{};
-        switch (file_type) {
-            case FileType::Json:
-                ingestion_successful = ingest_json(nested_readers.back(), path, archive_creator_id);
-                break;
-            case FileType::KeyValueIr:
-                ingestion_successful = ingest_kvir(nested_readers.back(), path, archive_creator_id);
-                break;
-            case FileType::LogText:
-                SPDLOG_ERROR(
-                        "Direct ingestion of unstructured logtext is not supported from input {}",
-                        path.path
-                );
-                std::ignore = m_archive_writer->close();
-                return false;
-            case FileType::Zstd:
-            case FileType::Unknown:
-            default: {
-                std::ignore = check_and_log_curl_error(path, reader);
-                SPDLOG_ERROR("Could not deduce content type for input {}", path.path);
-                std::ignore = m_archive_writer->close();
-                return false;
-            }
+    close_nested_readers(nested_readers);
+    if (false == ingestion_successful || check_and_log_curl_error(path, reader)) {
+        std::ignore = m_archive_writer->close();
+        return false;
+    }
+    return true;
+}
+
+auto JsonParser::ingest_in_parallel(std::string const& archive_creator_id) -> bool {
+    InputPathQueue queue{m_input_paths};
+    auto const num_threads{std::min(m_num_ingestion_threads, m_input_paths.size())};
+
+    // This parser acts as one of the ingestion threads, so we only need to spawn the remainder.
+    std::vector<std::unique_ptr<IngestionThread>> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i{1}; i < num_threads; ++i) {
+        threads.emplace_back(
+                std::make_unique<IngestionThread>(m_worker_option, queue, archive_creator_id)
+        );
+        threads.back()->start();
+    }
+
+    bool succeeded{true};
+    try {
+        if (auto const* path{queue.try_claim()}; nullptr != path) {
+            open_archive();
+            succeeded = ingest_claimed_paths(*path, queue, archive_creator_id);
         }
+    } catch (...) {
+        // Stop the other threads from claiming more work before they're joined on destruction.
+        queue.abort();
+        throw;
+    }
 
-        close_nested_readers(nested_readers);
-        if (false == ingestion_successful || check_and_log_curl_error(path, reader)) {
-            std::ignore = m_archive_writer->close();
+    bool const archive_closed{false == succeeded};
+    for (auto& thread : threads) {
+        thread->join();
+        if (false == thread->succeeded()) {
+            succeeded = false;
+        }
+        auto& thread_archive_stats{thread->get_archive_stats()};
+        m_archive_stats.insert(
+                m_archive_stats.end(),
+                std::make_move_iterator(thread_archive_stats.begin()),
+                std::make_move_iterator(thread_archive_stats.end())
+        );
+    }
+
+    if (false == succeeded && false == archive_closed && nullptr != m_archive_writer) {
+        std::ignore = m_archive_writer->close();
+    }
+    return succeeded;
+}
+
+auto JsonParser::ingest_claimed_paths(
+        Path const& first_path,
+        InputPathQueue& queue,
+        std::string const& archive_creator_id
+) -> bool {
+    for (auto const* path{&first_path}; nullptr != path; path = queue.try_claim()) {
+        if (false == ingest_path(*path, archive_creator_id)) {
+            queue.abort();
             return false;
         }
     }
@@ -923,10 +1062,11 @@ auto JsonParser::ingest_kvir(
     }
     auto update_fields_after_archive_split = [&]() { ++file_split_number; };
 
+    clp::ffi::ir_stream::ContiguousIrBuffer ir_buffer{*reader};
     size_t curr_pos{};
     size_t last_pos{};
     while (true) {
-        auto const kv_log_event_result{deserializer.deserialize_next_ir_unit(*reader)};
+        auto const kv_log_event_result{ir_buffer.deserialize_next_ir_unit(deserializer)};
 
         if (kv_log_event_result.has_error()) {
             auto err = kv_log_event_result.error();
@@ -967,7 +1107,7 @@ auto JsonParser::ingest_kvir(
             if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
                 m_ir_node_to_archive_node_id_mapping.clear();
                 m_autogen_ir_node_to_archive_node_id_mapping.clear();
-                curr_pos = reader->get_pos();
+                curr_pos = ir_buffer.get_pos();
                 m_archive_writer->increment_uncompressed_size(curr_pos - last_pos);
                 last_pos = curr_pos;
                 split_archive();
@@ -993,7 +1133,7 @@ auto JsonParser::ingest_kvir(
     }
     m_ir_node_to_archive_node_id_mapping.clear();
     m_autogen_ir_node_to_archive_node_id_mapping.clear();
-    curr_pos = reader->get_pos();
+    curr_pos = ir_buffer.get_pos();
     m_archive_writer->increment_uncompressed_size(curr_pos - last_pos);
 
     if (m_record_log_order) {
@@ -1284,10 +1424,17 @@ void JsonParser::parse_kv_log_event(KeyValuePairLogEvent const& kv) {
 }
 
 auto JsonParser::store() -> std::vector<ArchiveStats> {
-    m_archive_stats.emplace_back(m_archive_writer->close());
+    if (nullptr != m_archive_writer) {
+        m_archive_stats.emplace_back(m_archive_writer->close());
+    }
     return std::move(m_archive_stats);
 }
 
+void JsonParser::open_archive() {
+    m_archive_writer = std::make_unique<ArchiveWriter>();
+    m_archive_writer->open(m_archive_options);
+}
+
 void JsonParser::split_archive() {
     m_archive_stats.emplace_back(m_archive_writer->close(true));
     m_archive_options.id = m_generator();
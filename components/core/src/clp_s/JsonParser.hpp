@@ -14,10 +14,12 @@
 #include <boost/uuid/random_generator.hpp>
 #include <simdjson.h>
 
+#include "../clp/ClaimQueue.hpp"
 #include "../clp/ffi/KeyValuePairLogEvent.hpp"
 #include "../clp/ffi/SchemaTree.hpp"
 #include "../clp/ffi/Value.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "../clp/Thread.hpp"
 #include "ArchiveWriter.hpp"
 #include "DictionaryWriter.hpp"
 #include "FileReader.hpp"
@@ -43,6 +45,9 @@ struct JsonParserOption {
     bool record_log_order{true};
     bool retain_float_format{false};
     bool single_file_archive{false};
+    bool index_dictionaries{false};
+    size_t num_ingestion_threads{1};
+    size_t num_table_compression_threads{1};
     NetworkAuthOption network_auth{};
 };
 
@@ -74,6 +79,61 @@ public:
     [[nodiscard]] auto store() -> std::vector<ArchiveStats>;
 
 private:
+    // Types
+    // Queue of input paths shared by all ingestion threads
+    using InputPathQueue = clp::ClaimQueue<Path>;
+    class IngestionThread;
+
+    /**
+     * Ingests a single input path into the current archive.
+     *
+     * NOTE: The current archive is closed if ingestion fails.
+     * @param path
+     * @param archive_creator_id
+     * @return Whether ingestion was successful or not.
+     */
+    [[nodiscard]] auto ingest_path(Path const& path, std::string const& archive_creator_id) -> bool;
+
+    /**
+     * Ingests the input paths with a pool of threads. Each thread owns a separate `JsonParser` and
+     * therefore writes its own archives; this parser acts as one of the threads. Threads claim
+     * input paths from a shared queue one at a time, so that threads which finish early keep
+     * taking work until all inputs have been ingested.
+     *
+     * This parser's archive is only opened once it claims an input path, so no archive is written
+     * by this parser if the other threads claim every path. Statistics for the archives written by
+     * the other threads are returned by `store`.
+     * @param archive_creator_id
+     * @return Whether all of the input was ingested successfully.
+     */
+    [[nodiscard]] auto ingest_in_parallel(std::string const& archive_creator_id) -> bool;
+
+    /**
+     * Ingests `first_path` followed by every input path claimed from `queue` until the queue is
+     * exhausted or aborted. The queue is aborted if ingestion fails.
+     * @param first_path
+     * @param queue
+     * @param archive_creator_id
+     * @return Whether every path claimed by this parser was ingested successfully.
+     */
+    [[nodiscard]] auto ingest_claimed_paths(
+            Path const& first_path,
+            InputPathQueue& queue,
+            std::string const& archive_creator_id
+    ) -> bool;
+
+    /**
+     * @return Whether the input paths will be ingested by a pool of threads.
+     */
+    [[nodiscard]] auto is_parallel_ingestion() const -> bool {
+        return m_num_ingestion_threads > 1 && m_input_paths.size() > 1;
+    }
+
+    /**
+     * Creates and opens this parser's archive writer.
+     */
+    void open_archive();
+
     /**
      * Parses JSON input and ingests it into the current archive, splitting the archive if it grows
      * beyond the target encoded size.
@@ -226,6 +286,8 @@ private:
 
     std::vector<Path> m_input_paths;
     NetworkAuthOption m_network_auth{};
+    JsonParserOption m_worker_option{};
+    size_t m_num_ingestion_threads{1};
 
     Schema m_current_schema;
     ParsedMessage m_current_parsed_message;
@@ -15,6 +15,7 @@ public:
         BeginObject,
         EndObject,
         AddIntField,
+        AddDeltaIntField,
         AddFloatField,
         AddFormattedFloatField,
         AddBoolField,
@@ -22,6 +23,7 @@ public:
         AddArrayField,
         AddNullField,
         AddIntValue,
+        AddDeltaIntValue,
         AddFloatValue,
         AddFormattedFloatValue,
         AddBoolValue,
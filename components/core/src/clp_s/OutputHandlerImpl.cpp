@@ -1,5 +1,8 @@
 #include "OutputHandlerImpl.hpp"
 
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -14,8 +17,9 @@
 
 #include "../clp/networking/socket_utils.hpp"
 #include "../reducer/CountOperator.hpp"
+#include "../reducer/GroupTags.hpp"
 #include "../reducer/network_utils.hpp"
-#include "../reducer/Record.hpp"
+#include "../reducer/RecordGroupIterator.hpp"
 #include "archive_constants.hpp"
 #include "search/OutputHandler.hpp"
 
@@ -161,18 +165,23 @@ void ResultsCacheOutputHandler::write(
 
 CountOutputHandler::CountOutputHandler(int reducer_socket_fd)
         : ::clp_s::search::OutputHandler(false, false),
-          m_reducer_socket_fd(reducer_socket_fd),
-          m_pipeline(reducer::PipelineInputMode::InterStage) {
-    m_pipeline.add_pipeline_stage(std::make_shared<reducer::CountOperator>());
-}
-
-void CountOutputHandler::write(string_view message) {
-    m_pipeline.push_record(reducer::EmptyRecord{});
-}
+          m_reducer_socket_fd(reducer_socket_fd) {}
 
 ErrorCode CountOutputHandler::finish() {
+    // Send the same results as a `CountOperator` that was given each matching record, i.e., no
+    // record group if there were no matches.
+    std::map<reducer::GroupTags, int64_t> group_counts;
+    if (m_count.get_count() > 0) {
+        group_counts.emplace(reducer::GroupTags{}, m_count.get_count());
+    }
     if (false
-        == reducer::send_pipeline_results(m_reducer_socket_fd, std::move(m_pipeline.finish())))
+        == reducer::send_pipeline_results(
+                m_reducer_socket_fd,
+                std::make_unique<reducer::Int64MapRecordGroupIterator>(
+                        group_counts,
+                        reducer::CountOperator::cRecordElementKey
+                )
+        ))
     {
         return ErrorCode::ErrorCodeFailureNetwork;
     }
@@ -184,7 +193,7 @@ ErrorCode CountByTimeOutputHandler::finish() {
         == reducer::send_pipeline_results(
                 m_reducer_socket_fd,
                 std::make_unique<reducer::Int64Int64MapRecordGroupIterator>(
-                        m_bucket_counts,
+                        m_histogram.get_bucket_counts(),
                         reducer::CountOperator::cRecordElementKey
                 )
         ))
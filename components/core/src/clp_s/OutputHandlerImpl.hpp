@@ -5,7 +5,9 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <string>
 #include <string_view>
@@ -14,10 +16,13 @@
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 
-#include "../reducer/Pipeline.hpp"
 #include "../reducer/RecordGroupIterator.hpp"
 #include "Defs.hpp"
+#include "search/BatchAggregate.hpp"
+#include "search/CountAggregate.hpp"
+#include "search/MessageBatch.hpp"
 #include "search/OutputHandler.hpp"
+#include "search/TimeBucketHistogram.hpp"
 #include "TraceableException.hpp"
 
 namespace clp_s {
@@ -186,7 +191,20 @@ public:
             int64_t log_event_idx
     ) override {}
 
-    void write(std::string_view message) override;
+    void write(std::string_view message) override { m_count.increment(); }
+
+    [[nodiscard]] auto should_aggregate_batches() const -> bool override { return true; }
+
+    auto aggregate(search::MessageBatch const& batch) -> void override { m_count.add(batch); }
+
+    [[nodiscard]] auto create_batch_aggregate() const
+            -> std::unique_ptr<search::BatchAggregate> override {
+        return std::make_unique<search::CountAggregate>();
+    }
+
+    auto merge(search::BatchAggregate const& aggregate) -> void override {
+        m_count.merge(aggregate);
+    }
 
     /**
      * Flushes the count.
@@ -195,9 +213,12 @@ public:
      */
     ErrorCode finish() override;
 
+    // Methods
+    [[nodiscard]] auto get_count() const -> int64_t { return m_count.get_count(); }
+
 private:
     int m_reducer_socket_fd;
-    reducer::Pipeline m_pipeline;
+    search::CountAggregate m_count;
 };
 
 /**
@@ -210,7 +231,7 @@ public:
     CountByTimeOutputHandler(int reducer_socket_fd, int64_t count_by_time_bucket_size)
             : search::OutputHandler{true, false},
               m_reducer_socket_fd{reducer_socket_fd},
-              m_count_by_time_bucket_size{count_by_time_bucket_size} {}
+              m_histogram{count_by_time_bucket_size} {}
 
     // Methods inherited from OutputHandler
     void write(
@@ -219,12 +240,24 @@ public:
             std::string_view archive_id,
             int64_t log_event_idx
     ) override {
-        int64_t bucket = (timestamp / m_count_by_time_bucket_size) * m_count_by_time_bucket_size;
-        m_bucket_counts[bucket] += 1;
+        m_histogram.add(timestamp);
     }
 
     void write(std::string_view message) override {}
 
+    [[nodiscard]] auto should_aggregate_batches() const -> bool override { return true; }
+
+    auto aggregate(search::MessageBatch const& batch) -> void override { m_histogram.add(batch); }
+
+    [[nodiscard]] auto create_batch_aggregate() const
+            -> std::unique_ptr<search::BatchAggregate> override {
+        return std::make_unique<search::TimeBucketHistogram>(m_histogram.get_bucket_size());
+    }
+
+    auto merge(search::BatchAggregate const& aggregate) -> void override {
+        m_histogram.merge(aggregate);
+    }
+
     /**
      * Flushes the counts.
      * @return ErrorCodeSuccess on success
@@ -232,10 +265,17 @@ public:
      */
     ErrorCode finish() override;
 
+    // Methods
+    /**
+     * @return A map from each non-empty bucket's start time to its count
+     */
+    [[nodiscard]] auto get_bucket_counts() const -> std::map<int64_t, int64_t> const& {
+        return m_histogram.get_bucket_counts();
+    }
+
 private:
     int m_reducer_socket_fd;
-    std::map<int64_t, int64_t> m_bucket_counts;
-    int64_t m_count_by_time_bucket_size;
+    search::TimeBucketHistogram m_histogram;
 };
 
 /**
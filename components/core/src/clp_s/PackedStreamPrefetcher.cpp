@@ -0,0 +1,162 @@
+#include "PackedStreamPrefetcher.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+void PackedStreamPrefetcher::start_prefetching() {
+    std::unique_lock lock{m_mutex};
+    if (m_is_started) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+    m_is_started = true;
+    lock.unlock();
+    start();
+}
+
+void PackedStreamPrefetcher::get_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        m_not_empty.wait(lock, [&] {
+            return m_is_stopped || m_is_done || false == m_decompressed_streams.empty();
+        });
+        if (m_decompressed_streams.empty()) {
+            // Either the background thread failed or the stream isn't part of the sequence
+            throw OperationFailed(
+                    ErrorCodeSuccess != m_error_code ? m_error_code : ErrorCodeBadParam,
+                    __FILENAME__,
+                    __LINE__
+            );
+        }
+
+        auto& stream{m_decompressed_streams.front()};
+        if (stream.stream_id > stream_id) {
+            throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+        }
+        if (stream.stream_id == stream_id) {
+            buf = std::move(stream.buf);
+            buf_size = stream.buf_size;
+            m_decompressed_streams.pop_front();
+            m_not_full.notify_one();
+            return;
+        }
+
+        // The caller skipped this stream
+        m_decompressed_streams.pop_front();
+        m_not_full.notify_one();
+    }
+}
+
+void PackedStreamPrefetcher::stop() {
+    std::unique_lock lock{m_mutex};
+    m_is_stopped = true;
+    m_not_full.notify_all();
+    m_not_empty.notify_all();
+    if (false == m_is_started) {
+        return;
+    }
+    m_is_started = false;
+    lock.unlock();
+    join();
+}
+
+void PackedStreamPrefetcher::thread_method() {
+    for (auto const stream_id : m_stream_ids) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_not_full.wait(lock, [&] {
+                return m_is_stopped || m_decompressed_streams.size() < m_capacity;
+            });
+            if (m_is_stopped) {
+                return;
+            }
+        }
+        std::shared_ptr<char[]> buf;
+        size_t buf_size{0ULL};
+        get_pooled_buffer(m_reader.get_uncompressed_stream_size(stream_id), buf, buf_size);
+
+        // Decompress the stream without holding the lock so that the caller can keep consuming
+        // previously decompressed streams
+        ErrorCode error_code{ErrorCodeSuccess};
+        try {
+            m_reader.read_stream(stream_id, buf, buf_size);
+        } catch (TraceableException const& e) {
+            SPDLOG_ERROR("Failed to prefetch packed stream {} - {}", stream_id, e.what());
+            error_code = e.get_error_code();
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to prefetch packed stream {} - {}", stream_id, e.what());
+            error_code = ErrorCodeFailure;
+        }
+
+        std::lock_guard const lock{m_mutex};
+        if (ErrorCodeSuccess != error_code) {
+            m_error_code = error_code;
+            m_is_done = true;
+            m_not_empty.notify_all();
+            return;
+        }
+        m_decompressed_streams.push_back({stream_id, std::move(buf), buf_size});
+        m_not_empty.notify_all();
+    }
+
+    std::lock_guard const lock{m_mutex};
+    m_is_done = true;
+    m_not_empty.notify_all();
+}
+
+void PackedStreamPrefetcher::get_pooled_buffer(
+        size_t size,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    auto pooled_buf{m_buffer_pool->take(size, buf_size)};
+    // The buffer is large enough for the stream, so `PackedStreamReader::read_stream` won't replace
+    // it with a buffer that doesn't return to the pool.
+    buf = std::shared_ptr<char[]>{
+            pooled_buf.release(),
+            [pool = std::weak_ptr{m_buffer_pool}, buf_size](char* released_buf) {
+                std::unique_ptr<char[]> owned_buf{released_buf};
+                if (auto const locked_pool{pool.lock()}; nullptr != locked_pool) {
+                    locked_pool->add(std::move(owned_buf), buf_size);
+                }
+            }
+    };
+}
+
+auto PackedStreamPrefetcher::BufferPool::take(size_t size, size_t& buf_size)
+        -> std::unique_ptr<char[]> {
+    {
+        std::lock_guard const lock{m_mutex};
+        for (auto it{m_buffers.begin()}; it != m_buffers.end(); ++it) {
+            if (it->second >= size) {
+                auto buf{std::move(it->first)};
+                buf_size = it->second;
+                m_buffers.erase(it);
+                return buf;
+            }
+        }
+    }
+    buf_size = size;
+    return std::make_unique<char[]>(size);
+}
+
+void PackedStreamPrefetcher::BufferPool::add(std::unique_ptr<char[]> buf, size_t buf_size) {
+    std::lock_guard const lock{m_mutex};
+    if (m_buffers.size() >= m_max_num_buffers) {
+        m_buffers.pop_front();
+    }
+    m_buffers.emplace_back(std::move(buf), buf_size);
+}
+}  // namespace clp_s
@@ -0,0 +1,155 @@
+#ifndef CLP_S_PACKEDSTREAMPREFETCHER_HPP
+#define CLP_S_PACKEDSTREAMPREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../clp/Thread.hpp"
+#include "ErrorCode.hpp"
+#include "PackedStreamReader.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * Decompresses a known sequence of packed streams on a background thread so that reading and
+ * decompressing the next streams overlaps with the caller's processing of the current one.
+ *
+ * At most `capacity` decompressed streams are buffered ahead of the caller. To avoid reallocating
+ * buffers, each buffer handed out returns to the prefetcher's pool once its last owner releases it.
+ *
+ * While the prefetcher is running, it has exclusive use of the `PackedStreamReader` it was given.
+ */
+class PackedStreamPrefetcher : public clp::Thread {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param reader An open packed stream reader
+     * @param stream_ids The IDs of the streams to decompress, in strictly ascending order
+     * @param capacity The maximum number of decompressed streams buffered ahead of the caller
+     */
+    PackedStreamPrefetcher(
+            PackedStreamReader& reader,
+            std::vector<size_t> stream_ids,
+            size_t capacity
+    )
+            : m_reader{reader},
+              m_stream_ids{std::move(stream_ids)},
+              m_capacity{capacity},
+              m_buffer_pool{std::make_shared<BufferPool>(capacity + 1)} {}
+
+    // Delete copy & move constructors and assignment operators
+    PackedStreamPrefetcher(PackedStreamPrefetcher const&) = delete;
+    PackedStreamPrefetcher(PackedStreamPrefetcher&&) = delete;
+    auto operator=(PackedStreamPrefetcher const&) -> PackedStreamPrefetcher& = delete;
+    auto operator=(PackedStreamPrefetcher&&) -> PackedStreamPrefetcher& = delete;
+
+    // Destructor
+    ~PackedStreamPrefetcher() override { stop(); }
+
+    // Methods
+    /**
+     * Starts decompressing streams in the background.
+     */
+    void start_prefetching();
+
+    /**
+     * Waits for the given stream to be decompressed and takes ownership of it. Any streams that
+     * precede it in the sequence and haven't been taken are discarded. Streams must be requested in
+     * ascending order.
+     * @param stream_id
+     * @param buf Returns the buffer containing the decompressed stream
+     * @param buf_size Returns the size of the buffer owned by `buf`
+     * @throw OperationFailed if the stream isn't part of the remaining sequence, or if the
+     * background thread failed to decompress a stream
+     */
+    void get_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
+    /**
+     * Stops decompressing streams and waits for the background thread to exit. Idempotent.
+     */
+    void stop();
+
+protected:
+    // Methods implementing `clp::Thread`
+    void thread_method() override;
+
+private:
+    // Types
+    struct DecompressedStream {
+        size_t stream_id;
+        std::shared_ptr<char[]> buf;
+        size_t buf_size;
+    };
+
+    /**
+     * Buffers that are no longer in use. Since a buffer's last owner may release it on any thread,
+     * even after the prefetcher is destroyed, the pool is shared with the buffers' deleters.
+     */
+    class BufferPool {
+    public:
+        // Constructors
+        explicit BufferPool(size_t max_num_buffers) : m_max_num_buffers{max_num_buffers} {}
+
+        // Methods
+        /**
+         * Takes a buffer that can hold at least the given number of bytes, allocating one if the
+         * pool has none.
+         * @param size
+         * @param buf_size Returns the size of the buffer
+         * @return The buffer
+         */
+        [[nodiscard]] auto take(size_t size, size_t& buf_size) -> std::unique_ptr<char[]>;
+
+        /**
+         * Adds a buffer to the pool, freeing the least recently added buffer if the pool is full.
+         * @param buf
+         * @param buf_size
+         */
+        void add(std::unique_ptr<char[]> buf, size_t buf_size);
+
+    private:
+        std::mutex m_mutex;
+        std::deque<std::pair<std::unique_ptr<char[]>, size_t>> m_buffers;
+        size_t m_max_num_buffers;
+    };
+
+    // Methods
+    /**
+     * Gets a buffer from the pool that returns to the pool once its last owner releases it.
+     * @param size
+     * @param buf Returns the buffer
+     * @param buf_size Returns the size of the buffer
+     */
+    void get_pooled_buffer(size_t size, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
+    PackedStreamReader& m_reader;
+    std::vector<size_t> m_stream_ids;
+    size_t m_capacity;
+    // At most `m_capacity` buffered streams, plus the one the caller is using, are in use at once
+    std::shared_ptr<BufferPool> m_buffer_pool;
+
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+    std::deque<DecompressedStream> m_decompressed_streams;
+    bool m_is_started{false};
+    bool m_is_done{false};
+    bool m_is_stopped{false};
+    ErrorCode m_error_code{ErrorCodeSuccess};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_PACKEDSTREAMPREFETCHER_HPP
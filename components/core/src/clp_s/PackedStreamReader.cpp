@@ -79,6 +79,18 @@ void PackedStreamReader::close() {
     m_state = PackedStreamReaderState::Uninitialized;
 }
 
+void PackedStreamReader::rewind() {
+    switch (m_state) {
+        case PackedStreamReaderState::PackedStreamsOpened:
+        case PackedStreamReaderState::ReadingPackedStreams:
+            m_state = PackedStreamReaderState::PackedStreamsOpened;
+            break;
+        default:
+            throw OperationFailed(ErrorCodeNotReady, __FILE__, __LINE__);
+    }
+    m_prev_stream_id = 0ULL;
+}
+
 void
 PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size) {
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
@@ -73,6 +73,13 @@ public:
      */
     void read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
 
+    /**
+     * Allows streams to be read again starting from any stream ID, as if no stream had been read
+     * since the packed streams were opened. This requires the underlying reader to support seeking
+     * backwards.
+     */
+    void rewind();
+
     [[nodiscard]] size_t get_uncompressed_stream_size(size_t stream_id) const {
         return m_stream_metadata.at(stream_id).uncompressed_size;
     }
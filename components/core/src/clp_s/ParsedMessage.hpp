@@ -1,24 +1,37 @@
 #ifndef CLP_S_PARSEDMESSAGE_HPP
 #define CLP_S_PARSEDMESSAGE_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <map>
-#include <string>
+#include <cstring>
+#include <memory>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "Defs.hpp"
 #include "FloatFormatEncoding.hpp"
 
 namespace clp_s {
+/**
+ * A single parsed record, stored as a flat list of values in the order expected by the record's
+ * schema.
+ *
+ * Every value is trivially destructible; string values are views into a string arena owned by the
+ * message. Clearing the message therefore only rewinds the value lists and the arena, keeping their
+ * memory for the next record, so that parsing a record doesn't allocate once the message has grown
+ * to fit the largest records.
+ */
 class ParsedMessage {
 public:
     // Types
     using variable_t = std::
             variant<int64_t,
                     double,
-                    std::string,
+                    std::string_view,
                     bool,
                     std::pair<uint64_t, epochtime_t>,
                     std::pair<double, float_format_t>>;
@@ -32,18 +45,19 @@ public:
     void set_id(int32_t schema_id) { m_schema_id = schema_id; }
 
     /**
-     * Adds a value to the message for a given MST node ID.
+     * Adds a value to the message for a given MST node ID. String values are copied into the
+     * message's arena.
      * @tparam T
      * @param node_id
      * @param value
      */
     template <typename T>
     inline void add_value(int32_t node_id, T const& value) {
-        m_message.emplace(node_id, value);
-    }
-
-    inline void add_value(int32_t node_id, std::string_view value) {
-        m_message.emplace(node_id, std::string{value});
+        if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+            add_ordered_value(node_id, m_string_arena.copy(value));
+        } else {
+            add_ordered_value(node_id, value);
+        }
     }
 
     /**
@@ -53,7 +67,7 @@ public:
      * @param value
      */
     inline void add_value(int32_t node_id, uint64_t encoding_id, epochtime_t value) {
-        m_message.emplace(node_id, std::make_pair(encoding_id, value));
+        add_ordered_value(node_id, std::make_pair(encoding_id, value));
     }
 
     /**
@@ -63,22 +77,22 @@ public:
      * @param format
      */
     inline void add_value(int32_t node_id, double value, float_format_t format) {
-        m_message.emplace(node_id, std::make_pair(value, format));
+        add_ordered_value(node_id, std::make_pair(value, format));
     }
 
     /**
      * Adds a value to the unordered region of the message. The order in which unordered values are
      * added to the message must match the order in which the corresponding MST node IDs are added
-     * to the unordered region of the schema.
+     * to the unordered region of the schema. String values are copied into the message's arena.
      * @param value
      */
     template <typename T>
     inline void add_unordered_value(T const& value) {
-        m_unordered_message.emplace_back(value);
-    }
-
-    inline void add_unordered_value(std::string_view value) {
-        m_unordered_message.emplace_back(std::string{value});
+        if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+            m_unordered_message.emplace_back(m_string_arena.copy(value));
+        } else {
+            m_unordered_message.emplace_back(value);
+        }
     }
 
     /**
@@ -98,12 +112,13 @@ public:
         m_schema_id = -1;
         m_message.clear();
         m_unordered_message.clear();
+        m_string_arena.clear();
     }
 
     /**
-     * @return The content of the message
+     * @return The content of the message as (MST node ID, value) pairs sorted by node ID
      */
-    std::map<int32_t, variable_t>& get_content() { return m_message; }
+    std::vector<std::pair<int32_t, variable_t>>& get_content() { return m_message; }
 
     /**
      * @return the unordered content of the message
@@ -111,9 +126,105 @@ public:
     std::vector<variable_t>& get_unordered_content() { return m_unordered_message; }
 
 private:
+    /**
+     * Arena owning the string values of a message. Strings are copied into fixed-size blocks that
+     * are kept across `clear` calls, so a view returned by `copy` stays valid until the next
+     * `clear`.
+     */
+    class StringArena {
+    public:
+        // Methods
+        /**
+         * Copies a string into the arena.
+         * @param value
+         * @return A view of the copy
+         */
+        auto copy(std::string_view value) -> std::string_view {
+            if (value.empty()) {
+                return {};
+            }
+            if (m_blocks.empty() || m_blocks[m_cur_block_idx].size - m_cur_block_pos < value.size())
+            {
+                advance_to_block_fitting(value.size());
+            }
+            auto* dest{m_blocks[m_cur_block_idx].buffer.get() + m_cur_block_pos};
+            std::memcpy(dest, value.data(), value.size());
+            m_cur_block_pos += value.size();
+            return {dest, value.size()};
+        }
+
+        /**
+         * Releases every string in the arena while keeping its blocks for reuse.
+         */
+        void clear() {
+            m_cur_block_idx = 0;
+            m_cur_block_pos = 0;
+        }
+
+    private:
+        // Types
+        struct Block {
+            std::unique_ptr<char[]> buffer;
+            size_t size;
+        };
+
+        // Constants
+        static constexpr size_t cMinBlockSize{64ULL * 1024};  // 64 KiB
+
+        /**
+         * Moves to the next block, growing or allocating it if it can't fit `size` bytes.
+         * @param size
+         */
+        void advance_to_block_fitting(size_t size) {
+            if (false == m_blocks.empty()) {
+                ++m_cur_block_idx;
+            }
+            m_cur_block_pos = 0;
+            auto const block_size{std::max(size, cMinBlockSize)};
+            if (m_cur_block_idx == m_blocks.size()) {
+                m_blocks.emplace_back(
+                        std::make_unique_for_overwrite<char[]>(block_size),
+                        block_size
+                );
+            } else if (m_blocks[m_cur_block_idx].size < size) {
+                // The block isn't in use, so it can be replaced
+                m_blocks[m_cur_block_idx]
+                        = {std::make_unique_for_overwrite<char[]>(block_size), block_size};
+            }
+        }
+
+        std::vector<Block> m_blocks;
+        size_t m_cur_block_idx{0};
+        size_t m_cur_block_pos{0};
+    };
+
+    /**
+     * Adds a value to the ordered region of the message, keeping the region sorted by MST node ID.
+     * If the message already has a value for the node, the existing value is kept.
+     * @param node_id
+     * @param value
+     */
+    void add_ordered_value(int32_t node_id, variable_t value) {
+        // Values are usually added in increasing node ID order
+        if (m_message.empty() || m_message.back().first < node_id) {
+            m_message.emplace_back(node_id, value);
+            return;
+        }
+        auto const it{std::ranges::lower_bound(
+                m_message,
+                node_id,
+                {},
+                &std::pair<int32_t, variable_t>::first
+        )};
+        if (it->first != node_id) {
+            m_message.emplace(it, node_id, value);
+        }
+    }
+
     int32_t m_schema_id;
-    std::map<int32_t, variable_t> m_message;
+    std::vector<std::pair<int32_t, variable_t>> m_message;
     std::vector<variable_t> m_unordered_message;
+    StringArena m_string_arena;
 };
 }  // namespace clp_s
 
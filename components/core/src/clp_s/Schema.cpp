@@ -1,6 +1,10 @@
 #include "Schema.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "Utils.hpp"
 
 namespace clp_s {
 void Schema::insert_ordered(int32_t mst_node_id) {
@@ -14,13 +18,58 @@ void Schema::insert_ordered(int32_t mst_node_id) {
             mst_node_id
     );
     ++m_num_ordered;
+    m_ordered_hash += hash_ordered_entry(mst_node_id);
 }
 
 void Schema::insert_unordered(int32_t mst_node_id) {
     m_schema.push_back(mst_node_id);
+    m_unordered_hash = append_to_unordered_hash(m_unordered_hash, mst_node_id);
 }
 
 void Schema::insert_unordered(Schema const& schema) {
     m_schema.insert(m_schema.end(), schema.begin(), schema.end());
+    for (auto const schema_entry : schema) {
+        m_unordered_hash = append_to_unordered_hash(m_unordered_hash, schema_entry);
+    }
+}
+
+auto Schema::get_hash() const -> size_t {
+    if (m_hash_is_valid) {
+        return combine_hashes(m_ordered_hash, m_unordered_hash, m_num_ordered);
+    }
+
+    uint64_t ordered_hash{0};
+    uint64_t unordered_hash{0};
+    for (size_t i{0}; i < m_schema.size(); ++i) {
+        if (i < m_num_ordered) {
+            ordered_hash += hash_ordered_entry(m_schema[i]);
+        } else {
+            unordered_hash = append_to_unordered_hash(unordered_hash, m_schema[i]);
+        }
+    }
+    return combine_hashes(ordered_hash, unordered_hash, m_num_ordered);
+}
+
+auto Schema::hash_ordered_entry(int32_t mst_node_id) -> uint64_t {
+    return mix64(static_cast<uint64_t>(static_cast<uint32_t>(mst_node_id)));
+}
+
+auto Schema::pow_unordered_hash_multiplier(size_t exponent) -> uint64_t {
+    uint64_t result{1};
+    uint64_t base{cUnorderedHashMultiplier};
+    for (; exponent > 0; exponent >>= 1) {
+        if (0 != (exponent & 1)) {
+            result *= base;
+        }
+        base *= base;
+    }
+    return result;
+}
+
+auto Schema::combine_hashes(uint64_t ordered_hash, uint64_t unordered_hash, size_t num_ordered)
+        -> size_t {
+    return static_cast<size_t>(
+            mix64(ordered_hash ^ mix64(unordered_hash + static_cast<uint64_t>(num_ordered)))
+    );
 }
 }  // namespace clp_s
@@ -19,6 +19,13 @@ namespace clp_s {
  * In the current implementation of clp-s, MST node IDs must be unique in the ordered region of a
  * schema, but can be repeated in the unordered region. The caller is responsible for not inserting
  * duplicate MST nodes into the ordered region of a schema.
+ *
+ * The schema maintains a hash of its contents as nodes are inserted, so that it can be looked up in
+ * a hash map without rehashing every node. The hash of the ordered region is a sum of the hashes of
+ * its entries, so it doesn't depend on where each entry is inserted. The hash of the unordered
+ * region is a polynomial hash, which can be extended by appending and adjusted when an unordered
+ * object's delimiter is updated. Modifying the schema through its mutable iterators or views, or
+ * resizing it, invalidates the maintained hash, in which case `get_hash` recomputes it.
  */
 class Schema {
 public:
@@ -51,6 +58,9 @@ public:
     void clear() {
         m_schema.clear();
         m_num_ordered = 0;
+        m_ordered_hash = 0;
+        m_unordered_hash = 0;
+        m_hash_is_valid = true;
     }
 
     /**
@@ -58,7 +68,10 @@ public:
      * decompression to help initialize this object.
      * @param num_ordered
      */
-    void set_num_ordered(size_t num_ordered) { m_num_ordered = num_ordered; }
+    void set_num_ordered(size_t num_ordered) {
+        m_num_ordered = num_ordered;
+        m_hash_is_valid = false;
+    }
 
     /**
      * @return the number of ordered elements in the underlying schema
@@ -73,12 +86,18 @@ public:
     /**
      * @return iterator to the start of the underlying schema
      */
-    [[nodiscard]] auto begin() { return m_schema.begin(); }
+    [[nodiscard]] auto begin() {
+        m_hash_is_valid = false;
+        return m_schema.begin();
+    }
 
     /**
      * @return iterator to the end of the underlying schema
      */
-    [[nodiscard]] auto end() { return m_schema.end(); }
+    [[nodiscard]] auto end() {
+        m_hash_is_valid = false;
+        return m_schema.end();
+    }
 
     /**
      * @return constant iterator to the start of the underlying schema
@@ -109,6 +128,7 @@ public:
      * @return a view into the ordered region of the underlying schema
      */
     [[nodiscard]] std::span<int32_t> get_ordered_schema_view() {
+        m_hash_is_valid = false;
         return std::span<int32_t>{m_schema.data(), m_num_ordered};
     }
 
@@ -121,6 +141,7 @@ public:
         if (i + size > m_schema.size()) {
             throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
         }
+        m_hash_is_valid = false;
         return std::span<int32_t>{m_schema.data() + i, size};
     }
 
@@ -128,7 +149,10 @@ public:
      * Resizes the internal schema vector to match the given length.
      * @param size
      */
-    void resize(size_t size) { m_schema.resize(size); }
+    void resize(size_t size) {
+        m_schema.resize(size);
+        m_hash_is_valid = false;
+    }
 
     /**
      * Less than comparison operator so that Schema can act as a key for SchemaMap
@@ -142,7 +166,14 @@ public:
      * @return true if this schema is equal to the schema on the right hand side
      * @return false otherwise
      */
-    bool operator==(Schema const& rhs) const { return m_schema == rhs.m_schema; }
+    bool operator==(Schema const& rhs) const {
+        return m_num_ordered == rhs.m_num_ordered && m_schema == rhs.m_schema;
+    }
+
+    /**
+     * @return A hash of the schema, consistent with `operator==`
+     */
+    [[nodiscard]] auto get_hash() const -> size_t;
 
     /**
      * Starts an unordered object of a given NodeType.
@@ -162,7 +193,16 @@ public:
      * @param start_position
      */
     void end_unordered_object(size_t start_position) {
-        m_schema[start_position - 1] |= static_cast<int32_t>(m_schema.size() - start_position);
+        auto& delimiter{m_schema[start_position - 1]};
+        auto const updated_delimiter{
+                delimiter | static_cast<int32_t>(m_schema.size() - start_position)
+        };
+        // The delimiter's weight in the unordered hash is the multiplier raised to the number of
+        // entries following it.
+        m_unordered_hash += (static_cast<uint64_t>(updated_delimiter)
+                             - static_cast<uint64_t>(delimiter))
+                            * pow_unordered_hash_multiplier(m_schema.size() - start_position);
+        delimiter = updated_delimiter;
     }
 
     /**
@@ -202,12 +242,58 @@ public:
     }
 
 private:
+    // Odd multiplier for the polynomial hash of the unordered region
+    static constexpr uint64_t cUnorderedHashMultiplier{0x9E37'79B9'7F4A'7C15ULL};
+
+    /**
+     * @param mst_node_id
+     * @return The hash of an entry in the ordered region
+     */
+    static auto hash_ordered_entry(int32_t mst_node_id) -> uint64_t;
+
+    /**
+     * Appends an entry to the polynomial hash of the unordered region.
+     * @param unordered_hash
+     * @param schema_entry
+     * @return The updated hash
+     */
+    static auto append_to_unordered_hash(uint64_t unordered_hash, int32_t schema_entry)
+            -> uint64_t {
+        return unordered_hash * cUnorderedHashMultiplier + static_cast<uint64_t>(schema_entry);
+    }
+
+    /**
+     * @param exponent
+     * @return `cUnorderedHashMultiplier` raised to the given power, modulo 2^64
+     */
+    static auto pow_unordered_hash_multiplier(size_t exponent) -> uint64_t;
+
+    /**
+     * Combines the hashes of the ordered and unordered regions.
+     * @param ordered_hash
+     * @param unordered_hash
+     * @param num_ordered
+     * @return The hash of the schema
+     */
+    static auto
+    combine_hashes(uint64_t ordered_hash, uint64_t unordered_hash, size_t num_ordered) -> size_t;
+
     static constexpr size_t cEncodedTypeOffset = (sizeof(int32_t) - 1) * 8;
     static constexpr int32_t cEncodedTypeBitmask = 0xFF00'0000;
     static constexpr int32_t cEncodedTypeLengthBitmask = ~cEncodedTypeBitmask;
 
     std::vector<int32_t> m_schema;
     size_t m_num_ordered{0};
+    uint64_t m_ordered_hash{0};
+    uint64_t m_unordered_hash{0};
+    bool m_hash_is_valid{true};
+};
+
+/**
+ * Hash functor for using `Schema` as the key of a hash map.
+ */
+struct SchemaHash {
+    auto operator()(Schema const& schema) const -> size_t { return schema.get_hash(); }
 };
 }  // namespace clp_s
 
@@ -1,17 +1,31 @@
 #include "SchemaMap.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "archive_constants.hpp"
 #include "FileWriter.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
 int32_t SchemaMap::add_schema(Schema const& schema) {
-    auto const schema_it = m_schema_map.find(schema);
-    if (m_schema_map.end() != schema_it) {
-        return schema_it->second;
+    auto const hash{schema.get_hash()};
+    if (nullptr != m_last_schema && m_last_schema_hash == hash && *m_last_schema == schema) {
+        return m_last_schema_id;
+    }
+
+    auto [schema_it, inserted] = m_schema_map.try_emplace(schema, m_current_schema_id);
+    if (inserted) {
+        ++m_current_schema_id;
     }
-    m_schema_map.emplace(schema, m_current_schema_id);
-    return m_current_schema_id++;
+    m_last_schema = &schema_it->first;
+    m_last_schema_hash = hash;
+    m_last_schema_id = schema_it->second;
+    return m_last_schema_id;
 }
 
 size_t SchemaMap::store(std::string const& archives_dir, int compression_level) {
@@ -24,10 +38,19 @@ size_t SchemaMap::store(std::string const& archives_dir, int compression_level)
             FileWriter::OpenMode::CreateForWriting
     );
     schema_map_compressor.open(schema_map_writer, compression_level);
+
+    // Write the schemas in ID order so that the output doesn't depend on the hash map's layout
+    std::vector<std::pair<int32_t, Schema const*>> schemas;
+    schemas.reserve(m_schema_map.size());
+    for (auto const& [schema, schema_id] : m_schema_map) {
+        schemas.emplace_back(schema_id, &schema);
+    }
+    std::ranges::sort(schemas, {}, &std::pair<int32_t, Schema const*>::first);
+
     schema_map_compressor.write_numeric_value(m_schema_map.size());
-    for (auto const& schema_mapping : m_schema_map) {
-        auto const& schema = schema_mapping.first;
-        schema_map_compressor.write_numeric_value(schema_mapping.second);
+    for (auto const& [schema_id, schema_ptr] : schemas) {
+        auto const& schema = *schema_ptr;
+        schema_map_compressor.write_numeric_value(schema_id);
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.size()));
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.get_num_ordered()));
         for (int32_t mst_node_id : schema) {
@@ -1,15 +1,22 @@
 #ifndef CLP_S_SCHEMAMAP_HPP
 #define CLP_S_SCHEMAMAP_HPP
 
-#include <map>
+#include <cstdint>
 #include <string>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "Schema.hpp"
 
 namespace clp_s {
+/**
+ * Registry assigning an ID to every distinct schema. Schemas are looked up by their incrementally
+ * maintained hash. Consecutive records frequently share a schema, so the most recently added schema
+ * is checked before the hash map.
+ */
 class SchemaMap {
 public:
-    using schema_map_t = std::map<Schema, int32_t>;
+    using schema_map_t = absl::flat_hash_map<Schema, int32_t, SchemaHash>;
 
     // Constructor
     SchemaMap() : m_current_schema_id(0) {}
@@ -33,7 +40,10 @@ public:
     /**
      * Clear the schema map
      */
-    void clear() { m_schema_map.clear(); }
+    void clear() {
+        m_schema_map.clear();
+        m_last_schema = nullptr;
+    }
 
     /**
      * Get const iterators into the schema map
@@ -50,6 +60,11 @@ public:
 private:
     int32_t m_current_schema_id;
     schema_map_t m_schema_map;
+    // The most recently added schema and its ID. The pointer is into `m_schema_map`, so it's reset
+    // whenever the map could be rehashed.
+    Schema const* m_last_schema{nullptr};
+    size_t m_last_schema_hash{0};
+    int32_t m_last_schema_id{-1};
 };
 }  // namespace clp_s
 
@@ -1,5 +1,6 @@
 #include "SchemaReader.hpp"
 
+#include <algorithm>
 #include <stack>
 #include <string>
 
@@ -26,19 +27,17 @@ void SchemaReader::mark_column_as_timestamp(BaseColumnReader* column_reader) {
         };
     } else if (m_timestamp_column->get_type() == NodeType::Integer) {
         m_get_timestamp = [this]() {
-            return std::get<int64_t>(static_cast<Int64ColumnReader*>(m_timestamp_column)
-                                             ->extract_value(m_cur_message));
+            return static_cast<Int64ColumnReader*>(m_timestamp_column)->get_value(m_cur_message);
         };
     } else if (m_timestamp_column->get_type() == NodeType::DeltaInteger) {
         m_get_timestamp = [this]() {
-            return std::get<int64_t>(static_cast<DeltaEncodedInt64ColumnReader*>(m_timestamp_column)
-                                             ->extract_value(m_cur_message));
+            return static_cast<DeltaEncodedInt64ColumnReader*>(m_timestamp_column)
+                    ->get_value(m_cur_message);
         };
     } else if (m_timestamp_column->get_type() == NodeType::Float) {
         m_get_timestamp = [this]() {
             return static_cast<epochtime_t>(
-                    std::get<double>(static_cast<FloatColumnReader*>(m_timestamp_column)
-                                             ->extract_value(m_cur_message))
+                    static_cast<FloatColumnReader*>(m_timestamp_column)->get_value(m_cur_message)
             );
         };
     }
@@ -64,10 +63,83 @@ SchemaReader::load(std::shared_ptr<char[]> stream_buffer, size_t offset, size_t
 }
 
 auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
+    std::string json_string;
+    marshal_record(message_index, json_string);
+    return json_string;
+}
+
+void SchemaReader::marshal_record(uint64_t message_index, std::string& buffer) {
+    for (auto const& instruction : m_marshal_instructions) {
+        buffer.append(
+                m_template_fragments.data() + instruction.fragment_begin,
+                instruction.fragment_length
+        );
+        auto* column = instruction.column;
+        switch (instruction.value_type) {
+            case MarshalInstruction::ValueType::None:
+                break;
+            case MarshalInstruction::ValueType::Int:
+                StringUtils::append_integer(
+                        buffer,
+                        static_cast<Int64ColumnReader*>(column)->get_value(message_index)
+                );
+                break;
+            case MarshalInstruction::ValueType::DeltaInt:
+                StringUtils::append_integer(
+                        buffer,
+                        static_cast<DeltaEncodedInt64ColumnReader*>(column)->get_value(
+                                message_index
+                        )
+                );
+                break;
+            case MarshalInstruction::ValueType::Float:
+                StringUtils::append_float(
+                        buffer,
+                        static_cast<FloatColumnReader*>(column)->get_value(message_index)
+                );
+                break;
+            case MarshalInstruction::ValueType::Bool:
+                buffer += static_cast<BooleanColumnReader*>(column)->get_value(message_index)
+                                  ? "true"
+                                  : "false";
+                break;
+            case MarshalInstruction::ValueType::EscapedString:
+                column->extract_escaped_string_value_into_buffer(message_index, buffer);
+                break;
+            case MarshalInstruction::ValueType::String:
+                column->extract_string_value_into_buffer(message_index, buffer);
+                break;
+        }
+    }
+}
+
+void SchemaReader::compile_json_template() {
+    // Run the serializer over the template once, emitting every constant part of the record (keys,
+    // brackets, quotes, and separators) but leaving a gap wherever a column's value goes. The
+    // constant text between two gaps becomes the fragment of an instruction.
     m_json_serializer.reset();
     m_json_serializer.begin_document();
-    size_t column_id_index = 0;
-    BaseColumnReader* column;
+    auto& json_template = m_json_serializer.get_serialized_string();
+    size_t column_id_index{0};
+    size_t fragment_begin{0};
+    auto const append_column_key = [&]() {
+        auto const column_id{m_reordered_columns[column_id_index]->get_id()};
+        m_json_serializer.append_key(m_global_schema_tree->get_node(column_id).get_key_name());
+    };
+    auto const add_value = [&](MarshalInstruction::ValueType value_type, bool is_quoted) {
+        if (is_quoted) {
+            json_template += '"';
+        }
+        m_marshal_instructions.push_back(
+                {fragment_begin,
+                 json_template.size() - fragment_begin,
+                 value_type,
+                 m_reordered_columns[column_id_index++]}
+        );
+        fragment_begin = json_template.size();
+        json_template += is_quoted ? "\"," : ",";
+    };
+
     JsonSerializer::Op op;
     while (m_json_serializer.get_next_op(op)) {
         switch (op) {
@@ -96,85 +168,62 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
                 break;
             }
             case JsonSerializer::Op::AddIntField: {
-                column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value(
-                        std::to_string(std::get<int64_t>(column->extract_value(message_index)))
-                );
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::Int, false);
                 break;
             }
             case JsonSerializer::Op::AddIntValue: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value(
-                        std::to_string(std::get<int64_t>(column->extract_value(message_index)))
-                );
+                add_value(MarshalInstruction::ValueType::Int, false);
+                break;
+            }
+            case JsonSerializer::Op::AddDeltaIntField: {
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::DeltaInt, false);
+                break;
+            }
+            case JsonSerializer::Op::AddDeltaIntValue: {
+                add_value(MarshalInstruction::ValueType::DeltaInt, false);
                 break;
             }
             case JsonSerializer::Op::AddFloatField: {
-                column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value(
-                        std::to_string(std::get<double>(column->extract_value(message_index)))
-                );
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::Float, false);
                 break;
             }
             case JsonSerializer::Op::AddFloatValue: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value(
-                        std::to_string(std::get<double>(column->extract_value(message_index)))
-                );
+                add_value(MarshalInstruction::ValueType::Float, false);
                 break;
             }
             case JsonSerializer::Op::AddFormattedFloatField: {
-                column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value_from_column(column, message_index);
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::String, false);
                 break;
             }
             case JsonSerializer::Op::AddFormattedFloatValue: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value_from_column(column, message_index);
+                add_value(MarshalInstruction::ValueType::String, false);
                 break;
             }
             case JsonSerializer::Op::AddBoolField: {
-                column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value(
-                        std::get<uint8_t>(column->extract_value(message_index)) != 0 ? "true"
-                                                                                     : "false"
-                );
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::Bool, false);
                 break;
             }
             case JsonSerializer::Op::AddBoolValue: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value(
-                        std::get<uint8_t>(column->extract_value(message_index)) != 0 ? "true"
-                                                                                     : "false"
-                );
+                add_value(MarshalInstruction::ValueType::Bool, false);
                 break;
             }
             case JsonSerializer::Op::AddStringField: {
-                column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value_from_column_with_quotes(column, message_index);
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::EscapedString, true);
                 break;
             }
             case JsonSerializer::Op::AddStringValue: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value_from_column_with_quotes(column, message_index);
+                add_value(MarshalInstruction::ValueType::EscapedString, true);
                 break;
             }
             case JsonSerializer::Op::AddArrayField: {
-                column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_key(
-                        m_global_schema_tree->get_node(column->get_id()).get_key_name()
-                );
-                m_json_serializer.append_value_from_column(column, message_index);
+                append_column_key();
+                add_value(MarshalInstruction::ValueType::String, false);
                 break;
             }
             case JsonSerializer::Op::AddNullField: {
@@ -188,9 +237,16 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
         }
     }
-
     m_json_serializer.end_document();
-    return m_json_serializer.get_serialized_string();
+
+    m_marshal_instructions.push_back(
+            {fragment_begin,
+             json_template.size() - fragment_begin,
+             MarshalInstruction::ValueType::None,
+             nullptr}
+    );
+    m_template_fragments = std::move(json_template);
+    m_json_serializer.reset();
 }
 
 bool SchemaReader::get_next_message(std::string& message) {
@@ -201,41 +257,150 @@ bool SchemaReader::get_next_message(std::string& message) {
     if (false == m_serializer_initialized) {
         initialize_serializer();
     }
-    message = generate_json_string(m_cur_message);
-
-    if (message.back() != '\n') {
-        message += '\n';
-    }
+    message.clear();
+    marshal_record(m_cur_message, message);
+    message += '\n';
 
     m_cur_message++;
     return true;
 }
 
-bool SchemaReader::get_next_message(std::string& message, FilterClass* filter) {
-    while (m_cur_message < m_num_messages) {
-        if (false == filter->filter(m_cur_message)) {
-            m_cur_message++;
-            continue;
-        }
+auto SchemaReader::get_next_messages(std::string& buffer, size_t max_num_messages) -> size_t {
+    if (false == m_serializer_initialized) {
+        initialize_serializer();
+    }
 
-        if (m_should_marshal_records) {
-            if (false == m_serializer_initialized) {
-                initialize_serializer();
-            }
-            message = generate_json_string(m_cur_message);
+    auto const num_messages{std::min<uint64_t>(max_num_messages, m_num_messages - m_cur_message)};
+    for (auto const end_message{m_cur_message + num_messages}; m_cur_message < end_message;
+         ++m_cur_message)
+    {
+        marshal_record(m_cur_message, buffer);
+        buffer += '\n';
+    }
+    return num_messages;
+}
 
-            if (message.back() != '\n') {
-                message += '\n';
+auto SchemaReader::advance_to_next_accepted_message(FilterClass* filter) -> bool {
+    if (false == filter->supports_batch_filtering()) {
+        for (; m_cur_message < m_num_messages; ++m_cur_message) {
+            if (filter->filter(m_cur_message)) {
+                return true;
             }
         }
-
-        m_cur_message++;
-        return true;
+        return false;
     }
 
+    for (; m_cur_message < m_num_messages; ++m_cur_message) {
+        if (m_cur_message >= m_selection_end) {
+            select_messages(
+                    filter,
+                    m_cur_message,
+                    std::min(cFilterBatchSize, m_num_messages - m_cur_message)
+            );
+        }
+        if (0 != m_selection[m_cur_message - m_selection_begin]) {
+            return true;
+        }
+    }
     return false;
 }
 
+void SchemaReader::select_messages(
+        FilterClass* filter,
+        uint64_t begin_message,
+        size_t num_messages
+) {
+    m_selection_begin = begin_message;
+    m_selection_end = begin_message + num_messages;
+    m_selection.resize(cFilterBatchSize);
+    if (filter->supports_batch_filtering()) {
+        filter->filter_batch(begin_message, num_messages, m_selection.data());
+        return;
+    }
+    for (size_t i = 0; i < num_messages; ++i) {
+        m_selection[i] = filter->filter(begin_message + i) ? 1 : 0;
+    }
+}
+
+auto SchemaReader::get_next_message_batch(FilterClass* filter, search::MessageBatch& batch)
+        -> bool {
+    if (done()) {
+        return false;
+    }
+
+    auto const num_messages = std::min(cFilterBatchSize, m_num_messages - m_cur_message);
+    select_messages(filter, m_cur_message, num_messages);
+    batch.begin_message = m_cur_message;
+    batch.selection = {m_selection.data(), num_messages};
+    batch.num_selected = static_cast<size_t>(
+            std::count_if(batch.selection.begin(), batch.selection.end(), [](uint8_t selected) {
+                return 0 != selected;
+            })
+    );
+
+    batch.timestamps = {};
+    if (batch.num_selected > 0 && nullptr != m_timestamp_column) {
+        m_batch_timestamps.resize(cFilterBatchSize);
+        extract_timestamps(m_cur_message, num_messages, m_batch_timestamps.data());
+        batch.timestamps = {m_batch_timestamps.data(), num_messages};
+    }
+
+    m_cur_message += num_messages;
+    return true;
+}
+
+void SchemaReader::extract_timestamps(
+        uint64_t begin_message,
+        size_t num_messages,
+        epochtime_t* timestamps
+) {
+    switch (m_timestamp_column->get_type()) {
+        case NodeType::DateString:
+            static_cast<DateStringColumnReader*>(m_timestamp_column)
+                    ->get_encoded_times()
+                    .copy_to(begin_message, num_messages, timestamps);
+            break;
+        case NodeType::Integer:
+            static_cast<Int64ColumnReader*>(m_timestamp_column)
+                    ->get_values()
+                    .copy_to(begin_message, num_messages, timestamps);
+            break;
+        case NodeType::DeltaInteger:
+            static_cast<DeltaEncodedInt64ColumnReader*>(m_timestamp_column)
+                    ->extract_values(begin_message, num_messages, timestamps);
+            break;
+        case NodeType::Float: {
+            auto const values = static_cast<FloatColumnReader*>(m_timestamp_column)->get_values();
+            for (size_t i = 0; i < num_messages; ++i) {
+                timestamps[i] = static_cast<epochtime_t>(values[begin_message + i]);
+            }
+            break;
+        }
+        default:
+            // Same as m_get_timestamp for unsupported timestamp column types
+            std::fill_n(timestamps, num_messages, 0);
+            break;
+    }
+}
+
+bool SchemaReader::get_next_message(std::string& message, FilterClass* filter) {
+    if (false == advance_to_next_accepted_message(filter)) {
+        return false;
+    }
+
+    if (m_should_marshal_records) {
+        if (false == m_serializer_initialized) {
+            initialize_serializer();
+        }
+        message.clear();
+        marshal_record(m_cur_message, message);
+        message += '\n';
+    }
+
+    m_cur_message++;
+    return true;
+}
+
 bool SchemaReader::get_next_message_with_metadata(
         std::string& message,
         epochtime_t& timestamp,
@@ -244,31 +409,24 @@ bool SchemaReader::get_next_message_with_metadata(
 ) {
     // TODO: If we already get max_num_results messages, we can skip messages
     // with the timestamp less than the smallest timestamp in the priority queue
-    while (m_cur_message < m_num_messages) {
-        if (false == filter->filter(m_cur_message)) {
-            m_cur_message++;
-            continue;
-        }
-
-        if (m_should_marshal_records) {
-            if (false == m_serializer_initialized) {
-                initialize_serializer();
-            }
-            message = generate_json_string(m_cur_message);
+    if (false == advance_to_next_accepted_message(filter)) {
+        return false;
+    }
 
-            if (message.back() != '\n') {
-                message += '\n';
-            }
+    if (m_should_marshal_records) {
+        if (false == m_serializer_initialized) {
+            initialize_serializer();
         }
-
-        timestamp = m_get_timestamp();
-        log_event_idx = get_next_log_event_idx();
-
-        m_cur_message++;
-        return true;
+        message.clear();
+        marshal_record(m_cur_message, message);
+        message += '\n';
     }
 
-    return false;
+    timestamp = m_get_timestamp();
+    log_event_idx = get_next_log_event_idx();
+
+    m_cur_message++;
+    return true;
 }
 
 void SchemaReader::initialize_filter(FilterClass* filter) {
@@ -442,12 +600,16 @@ size_t SchemaReader::generate_structured_array_template(
                     m_json_serializer.add_op(JsonSerializer::Op::EndArray);
                     break;
                 }
-                case NodeType::DeltaInteger:
                 case NodeType::Integer: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddIntValue);
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
+                case NodeType::DeltaInteger: {
+                    m_json_serializer.add_op(JsonSerializer::Op::AddDeltaIntValue);
+                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    break;
+                }
                 case NodeType::Float: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddFloatValue);
                     m_reordered_columns.push_back(m_columns[column_idx++]);
@@ -533,12 +695,16 @@ size_t SchemaReader::generate_structured_object_template(
                     m_json_serializer.add_op(JsonSerializer::Op::EndArray);
                     break;
                 }
-                case NodeType::DeltaInteger:
                 case NodeType::Integer: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
+                case NodeType::DeltaInteger: {
+                    m_json_serializer.add_op(JsonSerializer::Op::AddDeltaIntField);
+                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    break;
+                }
                 case NodeType::Float: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
                     m_reordered_columns.push_back(m_columns[column_idx++]);
@@ -609,6 +775,7 @@ void SchemaReader::initialize_serializer() {
     {
         generate_json_template(subtree_root);
     }
+    compile_json_template();
 }
 
 void SchemaReader::generate_json_template(int32_t id) {
@@ -648,12 +815,16 @@ void SchemaReader::generate_json_template(int32_t id) {
                 m_json_serializer.add_op(JsonSerializer::Op::EndArray);
                 break;
             }
-            case NodeType::DeltaInteger:
             case NodeType::Integer: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
+            case NodeType::DeltaInteger: {
+                m_json_serializer.add_op(JsonSerializer::Op::AddDeltaIntField);
+                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                break;
+            }
             case NodeType::Float: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
@@ -1,17 +1,20 @@
 #ifndef CLP_S_SCHEMAREADER_HPP
 #define CLP_S_SCHEMAREADER_HPP
 
+#include <algorithm>
 #include <memory>
 #include <span>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ColumnReader.hpp"
 #include "FileReader.hpp"
 #include "JsonSerializer.hpp"
 #include "SchemaTree.hpp"
+#include "search/MessageBatch.hpp"
 #include "search/Projection.hpp"
 #include "ZstdDecompressor.hpp"
 
@@ -43,6 +46,26 @@ public:
      * @return true if the message is accepted
      */
     virtual bool filter(uint64_t cur_message) = 0;
+
+    /**
+     * @return true if the filter can evaluate blocks of messages via `filter_batch` for the
+     * schema it was last initialized with, false otherwise
+     */
+    virtual auto supports_batch_filtering() const -> bool { return false; }
+
+    /**
+     * Filters a contiguous block of messages. Only called when `supports_batch_filtering` returns
+     * true.
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns, for each message in the block, 1 if the message is accepted and 0
+     * otherwise
+     */
+    virtual void filter_batch(uint64_t begin_message, size_t num_messages, uint8_t* selection) {
+        for (size_t i = 0; i < num_messages; ++i) {
+            selection[i] = filter(begin_message + i) ? 1 : 0;
+        }
+    }
 };
 
 class SchemaReader {
@@ -96,6 +119,8 @@ public:
         m_schema_id = schema_id;
         m_num_messages = num_messages;
         m_cur_message = 0;
+        m_selection_begin = 0;
+        m_selection_end = 0;
         m_serializer_initialized = false;
         m_ordered_schema = ordered_schema;
         delete_columns();
@@ -110,6 +135,8 @@ public:
         m_global_id_to_unordered_object.clear();
         m_local_schema_tree.clear();
         m_json_serializer.clear();
+        m_template_fragments.clear();
+        m_marshal_instructions.clear();
         m_global_schema_tree = std::move(schema_tree);
         m_projection = std::move(projection);
         m_should_marshal_records = should_marshal_records;
@@ -168,6 +195,16 @@ public:
      */
     bool get_next_message(std::string& message);
 
+    /**
+     * Marshals up to `max_num_messages` of the next messages and appends them to a buffer, each
+     * followed by a newline. This avoids a copy per message when many messages are written to the
+     * same destination.
+     * @param buffer
+     * @param max_num_messages
+     * @return The number of messages appended
+     */
+    auto get_next_messages(std::string& buffer, size_t max_num_messages) -> size_t;
+
     /**
      * Gets the next message matching a filter
      * @param message
@@ -191,6 +228,16 @@ public:
             FilterClass* filter
     );
 
+    /**
+     * Evaluates a filter over the next block of messages without marshalling them, and extracts
+     * their timestamps if the table's timestamp column was marked and any of them match. The
+     * batch's spans remain valid until the next call to this method.
+     * @param filter
+     * @param batch Returns the block of messages
+     * @return true if there was a next block of messages, false otherwise
+     */
+    auto get_next_message_batch(FilterClass* filter, search::MessageBatch& batch) -> bool;
+
     /**
      * Initializes the filter
      * @param filter
@@ -247,7 +294,67 @@ public:
      */
     bool done() const { return m_cur_message >= m_num_messages; }
 
+    /**
+     * Skips over the next records in this table without marshalling them.
+     * @param num_messages The number of records to skip, clamped to the number of remaining records
+     */
+    void skip_messages(uint64_t num_messages) {
+        if (done()) {
+            return;
+        }
+        m_cur_message += std::min(num_messages, m_num_messages - m_cur_message);
+    }
+
 private:
+    /**
+     * A step of a compiled JSON template. Appends a constant fragment of the template (e.g.,
+     * `,"key":"`), followed by the current record's value of `column` (if any).
+     */
+    struct MarshalInstruction {
+        enum class ValueType : uint8_t {
+            None = 0,
+            Int,
+            DeltaInt,
+            Float,
+            Bool,
+            // Serialized by the column reader, then escaped (quotes are part of the fragments)
+            EscapedString,
+            // Serialized by the column reader as is
+            String,
+        };
+
+        size_t fragment_begin;
+        size_t fragment_length;
+        ValueType value_type;
+        BaseColumnReader* column;
+    };
+
+    static constexpr size_t cFilterBatchSize{1024};
+
+    /**
+     * Advances m_cur_message to the next message accepted by a filter, evaluating the filter over
+     * blocks of messages when it supports batch filtering.
+     * @param filter
+     * @return true if there is a next message accepted by the filter, false otherwise
+     */
+    auto advance_to_next_accepted_message(FilterClass* filter) -> bool;
+
+    /**
+     * Evaluates a filter over a block of messages, storing the results in m_selection.
+     * @param filter
+     * @param begin_message
+     * @param num_messages
+     */
+    void select_messages(FilterClass* filter, uint64_t begin_message, size_t num_messages);
+
+    /**
+     * Extracts the timestamps of a contiguous range of messages from the timestamp column.
+     * @param begin_message
+     * @param num_messages
+     * @param timestamps Returns the timestamps
+     */
+    void extract_timestamps(uint64_t begin_message, size_t num_messages, epochtime_t* timestamps);
+
     /**
      * Merges the current local schema tree with the section of the global schema tree corresponding
      * to the path from the root of the global schema tree to the node matching the global MPT node
@@ -262,6 +369,19 @@ private:
      */
     void generate_json_template(int32_t id);
 
+    /**
+     * Compiles the serializer's JSON template into `m_marshal_instructions`, so that marshalling a
+     * record only needs to append precomputed constant fragments and the record's values.
+     */
+    void compile_json_template();
+
+    /**
+     * Marshals a record into JSON using the compiled template and appends it to a buffer.
+     * @param message_index
+     * @param buffer
+     */
+    void marshal_record(uint64_t message_index, std::string& buffer);
+
     /**
      * Generates a json template for a structured array
      * @param id
@@ -316,6 +436,11 @@ private:
     uint64_t m_cur_message;
     std::span<int32_t> m_ordered_schema;
 
+    std::vector<uint8_t> m_selection;
+    uint64_t m_selection_begin{0};
+    uint64_t m_selection_end{0};
+    std::vector<epochtime_t> m_batch_timestamps;
+
     std::unordered_map<int32_t, BaseColumnReader*> m_column_map;
     std::vector<BaseColumnReader*> m_columns;
     std::vector<BaseColumnReader*> m_reordered_columns;
@@ -331,6 +456,9 @@ private:
     std::unordered_map<int32_t, int32_t> m_local_id_to_global_id;
 
     JsonSerializer m_json_serializer;
+    // The constant parts of the compiled JSON template, referenced by `m_marshal_instructions`
+    std::string m_template_fragments;
+    std::vector<MarshalInstruction> m_marshal_instructions;
     bool m_should_marshal_records{true};
     bool m_serializer_initialized{false};
     std::shared_ptr<search::Projection> m_projection;
@@ -26,6 +26,14 @@ size_t SchemaWriter::append_message(ParsedMessage& message) {
     return total_size;
 }
 
+auto SchemaWriter::get_statistics() const -> TableStatistics {
+    TableStatistics statistics{.num_messages = m_num_messages};
+    for (auto const* writer : m_columns) {
+        writer->update_statistics(statistics.columns[writer->get_id()]);
+    }
+    return statistics;
+}
+
 void SchemaWriter::store(ZstdCompressor& compressor) {
     for (auto& writer : m_columns) {
         writer->store(compressor);
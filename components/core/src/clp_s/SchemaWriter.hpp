@@ -6,6 +6,7 @@
 #include "ColumnWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
+#include "TableStatistics.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
@@ -50,6 +51,11 @@ public:
      */
     size_t get_total_uncompressed_size() const { return m_total_uncompressed_size; }
 
+    /**
+     * @return statistics describing the messages appended to this schema writer
+     */
+    [[nodiscard]] auto get_statistics() const -> TableStatistics;
+
 private:
     uint64_t m_num_messages;
     size_t m_total_uncompressed_size{};
@@ -35,7 +35,8 @@ enum struct ArchiveMetadataPacketType : uint8_t {
     ArchiveInfo = 0,
     ArchiveFileInfo = 1,
     TimestampDictionary = 2,
-    RangeIndex = 3
+    RangeIndex = 3,
+    TableStatistics = 4
 };
 
 struct ArchiveInfoPacket {
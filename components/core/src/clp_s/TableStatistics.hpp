@@ -0,0 +1,170 @@
+#ifndef CLP_S_TABLESTATISTICS_HPP
+#define CLP_S_TABLESTATISTICS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "../clp/Defs.h"
+#include "BloomFilter.hpp"
+
+namespace clp_s {
+/**
+ * Statistics describing the values stored in a single column of a schema table. A column that
+ * appears several times in one schema (e.g., inside a structured array) has a single set of
+ * statistics covering every occurrence.
+ */
+struct ColumnStatistics {
+    // Constants
+    // Tracking more distinct logtypes than this makes the set too large to be worth storing.
+    static constexpr size_t cMaxNumLogtypeIds{64};
+
+    /**
+     * Records an integer or epoch date value.
+     * @param value
+     */
+    void add_int_value(int64_t value) {
+        ++num_values;
+        if (int_range.has_value()) {
+            int_range->first = std::min(int_range->first, value);
+            int_range->second = std::max(int_range->second, value);
+        } else {
+            int_range.emplace(value, value);
+        }
+    }
+
+    /**
+     * Records a float value.
+     * @param value
+     */
+    void add_float_value(double value) {
+        ++num_values;
+        if (float_range.has_value()) {
+            float_range->first = std::min(float_range->first, value);
+            float_range->second = std::max(float_range->second, value);
+        } else {
+            float_range.emplace(value, value);
+        }
+    }
+
+    /**
+     * Records a boolean value.
+     * @param value
+     */
+    void add_bool_value(bool value) {
+        ++num_values;
+        if (value) {
+            ++num_true;
+        }
+    }
+
+    /**
+     * Records the logtype of a clp string value.
+     * @param logtype_id
+     */
+    void add_logtype_id(clp::logtype_dictionary_id_t logtype_id) {
+        ++num_values;
+        if (false == logtype_ids.has_value()) {
+            m_distinct_logtype_ids.insert(logtype_id);
+            return;
+        }
+        logtype_ids->insert(logtype_id);
+        if (logtype_ids->size() > cMaxNumLogtypeIds) {
+            // Switch to recording the logtypes for a filter
+            m_distinct_logtype_ids.insert(logtype_ids->cbegin(), logtype_ids->cend());
+            logtype_ids.reset();
+        }
+    }
+
+    /**
+     * Records a variable dictionary ID that appears in a variable string value or in a clp string
+     * value.
+     * @param var_id
+     */
+    void add_var_id(clp::variable_dictionary_id_t var_id) { m_distinct_var_ids.insert(var_id); }
+
+    uint64_t num_values{0};
+    // [min, max] over integer and date string values
+    std::optional<std::pair<int64_t, int64_t>> int_range;
+    // [min, max] over float values
+    std::optional<std::pair<double, double>> float_range;
+    uint64_t num_true{0};
+    // The distinct logtypes of a clp string column, or std::nullopt if they aren't tracked
+    std::optional<std::set<clp::logtype_dictionary_id_t>> logtype_ids{std::in_place};
+    // Filter over the logtypes of a clp string column with too many logtypes to record exactly
+    std::optional<BloomFilter> logtype_id_filter;
+    // Filter over the variable dictionary IDs in a variable string or clp string column
+    std::optional<BloomFilter> var_id_filter;
+
+private:
+    friend class TableStatisticsWriter;
+
+    /**
+     * Builds the filters over the recorded dictionary IDs, then releases the recorded IDs. A
+     * logtype ID filter is only built if there are too many distinct logtypes to record exactly.
+     */
+    void build_filters() {
+        if (false == logtype_ids.has_value()) {
+            logtype_id_filter = build_filter(m_distinct_logtype_ids);
+        }
+        var_id_filter = build_filter(m_distinct_var_ids);
+        m_distinct_logtype_ids = {};
+        m_distinct_var_ids = {};
+    }
+
+    /**
+     * @param ids
+     * @return A filter over the given IDs, or std::nullopt if there are none
+     */
+    static auto build_filter(std::unordered_set<uint64_t> const& ids)
+            -> std::optional<BloomFilter> {
+        if (ids.empty()) {
+            return std::nullopt;
+        }
+        BloomFilter filter{ids.size()};
+        for (auto const id : ids) {
+            filter.add(id);
+        }
+        return filter;
+    }
+
+    // The distinct dictionary IDs recorded for the filters that haven't been built yet. Logtype
+    // IDs are only recorded here once there are too many to record in `logtype_ids`.
+    std::unordered_set<uint64_t> m_distinct_logtype_ids;
+    std::unordered_set<uint64_t> m_distinct_var_ids;
+};
+
+/**
+ * Statistics describing the columns of a single schema table.
+ */
+struct TableStatistics {
+    uint64_t num_messages{0};
+    std::unordered_map<int32_t, ColumnStatistics> columns;
+};
+
+/**
+ * Names of the fields used to serialize table statistics. See `TableStatisticsWriter` for the
+ * serialized layout.
+ */
+namespace table_statistics {
+constexpr std::string_view cSchemaIdName{"s"};
+constexpr std::string_view cNumMessagesName{"n"};
+constexpr std::string_view cColumnsName{"c"};
+constexpr std::string_view cColumnIdName{"i"};
+constexpr std::string_view cNumValuesName{"n"};
+constexpr std::string_view cMinName{"min"};
+constexpr std::string_view cMaxName{"max"};
+constexpr std::string_view cNumTrueName{"t"};
+constexpr std::string_view cLogtypeIdsName{"l"};
+constexpr std::string_view cLogtypeIdFilterName{"lf"};
+constexpr std::string_view cVarIdFilterName{"vf"};
+}  // namespace table_statistics
+}  // namespace clp_s
+
+#endif  // CLP_S_TABLESTATISTICS_HPP
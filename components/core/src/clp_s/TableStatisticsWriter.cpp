@@ -0,0 +1,75 @@
+#include "TableStatisticsWriter.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "ErrorCode.hpp"
+#include "SingleFileArchiveDefs.hpp"
+#include "TableStatistics.hpp"
+#include "ZstdCompressor.hpp"
+
+namespace clp_s {
+auto TableStatisticsWriter::write(ZstdCompressor& writer) -> ErrorCode {
+    if (m_tables.empty()) {
+        return ErrorCodeSuccess;
+    }
+
+    nlohmann::json tables_array = nlohmann::json::array();
+    for (auto const& [schema_id, table] : m_tables) {
+        nlohmann::json columns_array = nlohmann::json::array();
+        for (auto const& [column_id, column] : table.columns) {
+            nlohmann::json column_obj;
+            if (column.int_range.has_value()) {
+                column_obj[table_statistics::cMinName] = column.int_range->first;
+                column_obj[table_statistics::cMaxName] = column.int_range->second;
+            } else if (column.float_range.has_value()) {
+                column_obj[table_statistics::cMinName] = column.float_range->first;
+                column_obj[table_statistics::cMaxName] = column.float_range->second;
+            } else if (column.logtype_ids.has_value() && false == column.logtype_ids->empty()) {
+                column_obj[table_statistics::cLogtypeIdsName] = column.logtype_ids.value();
+            } else if (column.logtype_ids.has_value() && column.num_values > 0) {
+                // Only boolean columns record values without a range or logtypes
+                column_obj[table_statistics::cNumTrueName] = column.num_true;
+            }
+            // Only clp string columns with too many distinct logtypes to record have this filter
+            if (column.logtype_id_filter.has_value()) {
+                column_obj[table_statistics::cLogtypeIdFilterName]
+                        = nlohmann::json::binary(column.logtype_id_filter->serialize());
+            }
+            if (column.var_id_filter.has_value()) {
+                column_obj[table_statistics::cVarIdFilterName]
+                        = nlohmann::json::binary(column.var_id_filter->serialize());
+            }
+            if (column_obj.empty()) {
+                continue;
+            }
+            column_obj[table_statistics::cColumnIdName] = column_id;
+            column_obj[table_statistics::cNumValuesName] = column.num_values;
+            columns_array.emplace_back(std::move(column_obj));
+        }
+
+        nlohmann::json table_obj;
+        table_obj[table_statistics::cSchemaIdName] = schema_id;
+        table_obj[table_statistics::cNumMessagesName] = table.num_messages;
+        table_obj[table_statistics::cColumnsName] = std::move(columns_array);
+        tables_array.emplace_back(std::move(table_obj));
+    }
+
+    std::vector<char> serialized_statistics;
+    nlohmann::json::to_msgpack(tables_array, serialized_statistics);
+    try {
+        writer.write_numeric_value(ArchiveMetadataPacketType::TableStatistics);
+        writer.write_numeric_value<uint32_t>(serialized_statistics.size());
+        writer.write(serialized_statistics.data(), serialized_statistics.size());
+    } catch (std::exception const& e) {
+        return ErrorCodeFailure;
+    }
+    m_tables.clear();
+
+    return ErrorCodeSuccess;
+}
+}  // namespace clp_s
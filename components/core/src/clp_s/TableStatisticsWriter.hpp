@@ -0,0 +1,70 @@
+#ifndef CLP_S_TABLESTATISTICSWRITER_HPP
+#define CLP_S_TABLESTATISTICSWRITER_HPP
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "ErrorCode.hpp"
+#include "SchemaWriter.hpp"
+#include "TableStatistics.hpp"
+#include "ZstdCompressor.hpp"
+
+namespace clp_s {
+/**
+ * This class is responsible for collecting and writing per-column statistics for every schema
+ * table in an archive.
+ *
+ * The statistics are written as a msgpack object structured as follows:
+ *
+ * [
+ *  {"s": <schema id>, "n": <num messages>, "c": [
+ *    {"i": <column id>, "n": <num values>, "min": <value>, "max": <value>, "t": <num true>,
+ *     "l": [<logtype id>, ...], "lf": <binary>, "vf": <binary>},
+ *    ...
+ *  ]},
+ *  ...
+ * ]
+ *
+ * Where "min" and "max" are only present for integer, float, and date string columns, "t" is only
+ * present for boolean columns, and "l" is only present for clp string columns with few enough
+ * distinct logtypes. "lf" is a serialized `BloomFilter` over the logtypes of a clp string column
+ * with too many distinct logtypes for "l", and "vf" is a serialized `BloomFilter` over the variable
+ * dictionary IDs in a variable string or clp string column. Columns without any of these fields
+ * are omitted.
+ */
+class TableStatisticsWriter {
+public:
+    /**
+     * Records the statistics of a schema table.
+     * @param schema_id
+     * @param schema_writer
+     */
+    void add_table(int32_t schema_id, SchemaWriter const& schema_writer) {
+        auto statistics{schema_writer.get_statistics()};
+        for (auto& [column_id, column] : statistics.columns) {
+            column.build_filters();
+        }
+        m_tables.insert_or_assign(schema_id, std::move(statistics));
+    }
+
+    /**
+     * Writes the statistics to a `ZstdCompressor` then clears internal state.
+     * @param writer
+     * @return ErrorCodeSuccess on success or the relevant error code on failure.
+     */
+    [[nodiscard]] auto write(ZstdCompressor& writer) -> ErrorCode;
+
+    /**
+     * @return true if there are no tables, false otherwise.
+     */
+    [[nodiscard]] auto empty() const -> bool { return m_tables.empty(); }
+
+    void clear() { m_tables.clear(); }
+
+private:
+    std::map<int32_t, TableStatistics> m_tables;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_TABLESTATISTICSWRITER_HPP
@@ -5,6 +5,7 @@
 #include <charconv>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -81,6 +82,39 @@ public:
      */
     static void escape_json_string(std::string& destination, std::string_view const source);
 
+    /**
+     * Appends the decimal representation of an integer to a buffer without creating any
+     * intermediate string.
+     * @param destination
+     * @param value
+     */
+    static void append_integer(std::string& destination, int64_t value) {
+        std::array<char, std::numeric_limits<int64_t>::digits10 + 2> buffer;
+        auto const result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        destination.append(buffer.data(), result.ptr);
+    }
+
+    /**
+     * Appends a floating point number to a buffer with six digits after the decimal point (i.e.,
+     * the same representation as `std::to_string`) without creating any intermediate string.
+     * @param destination
+     * @param value
+     */
+    static void append_float(std::string& destination, double value) {
+        constexpr int cPrecision{6};
+        // Sign, integer digits, decimal point, and fractional digits
+        std::array<char, 1 + std::numeric_limits<double>::max_exponent10 + 1 + 1 + cPrecision>
+                buffer;
+        auto const result = std::to_chars(
+                buffer.data(),
+                buffer.data() + buffer.size(),
+                value,
+                std::chars_format::fixed,
+                cPrecision
+        );
+        destination.append(buffer.data(), result.ptr);
+    }
+
 private:
     /**
      * Converts a character into its two byte hexadecimal representation.
@@ -141,6 +175,21 @@ void write_numeric_value(std::stringstream& stream, ValueType value) {
     stream.write(reinterpret_cast<char*>(&value), sizeof(value));
 }
 
+/**
+ * Mixes the bits of a 64-bit value (the finalizer of SplitMix64), so that similar values (e.g.,
+ * consecutive IDs) hash to very different values.
+ * @param value
+ * @return The mixed value
+ */
+constexpr auto mix64(uint64_t value) -> uint64_t {
+    value ^= value >> 30;
+    value *= 0xBF58'476D'1CE4'E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D0'49BB'1331'11EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
 /**
  * A span of memory where the underlying memory may not be aligned correctly for type T.
  *
@@ -176,6 +225,16 @@ public:
         return {m_begin + start * sizeof(T), size};
     }
 
+    /**
+     * Copies a contiguous range of elements into aligned storage.
+     * @param start
+     * @param size
+     * @param dest
+     */
+    void copy_to(size_t start, size_t size, T* dest) const {
+        memcpy(dest, m_begin + start * sizeof(T), size * sizeof(T));
+    }
+
 private:
     char* m_begin{nullptr};
     size_t m_size{0};
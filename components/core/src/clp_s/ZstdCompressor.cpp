@@ -20,10 +20,24 @@ ZstdCompressor::~ZstdCompressor() {
 }
 
 void ZstdCompressor::open(FileWriter& file_writer, int const compression_level) {
-    if (nullptr != m_compressed_stream_file_writer) {
+    if (nullptr != m_compressed_stream_file_writer || nullptr != m_compressed_stream_buffer) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
 
+    init_compression_stream(compression_level);
+    m_compressed_stream_file_writer = &file_writer;
+}
+
+void ZstdCompressor::open(std::vector<char>& buffer, int const compression_level) {
+    if (nullptr != m_compressed_stream_file_writer || nullptr != m_compressed_stream_buffer) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+
+    init_compression_stream(compression_level);
+    m_compressed_stream_buffer = &buffer;
+}
+
+void ZstdCompressor::init_compression_stream(int const compression_level) {
     // Setup compressed stream parameters
     size_t compressed_stream_block_size = ZSTD_CStreamOutSize();
     m_compressed_stream_block_buffer = std::make_unique<char[]>(compressed_stream_block_size);
@@ -40,22 +54,21 @@ void ZstdCompressor::open(FileWriter& file_writer, int const compression_level)
         throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
     }
 
-    m_compressed_stream_file_writer = &file_writer;
-
     m_uncompressed_stream_pos = 0;
 }
 
 void ZstdCompressor::close() {
-    if (nullptr == m_compressed_stream_file_writer) {
+    if (nullptr == m_compressed_stream_file_writer && nullptr == m_compressed_stream_buffer) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
 
     flush();
     m_compressed_stream_file_writer = nullptr;
+    m_compressed_stream_buffer = nullptr;
 }
 
 void ZstdCompressor::write(char const* data, size_t data_length) {
-    if (nullptr == m_compressed_stream_file_writer) {
+    if (nullptr == m_compressed_stream_file_writer && nullptr == m_compressed_stream_buffer) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
 
@@ -84,7 +97,7 @@ void ZstdCompressor::write(char const* data, size_t data_length) {
         }
         if (m_compressed_stream_block.pos) {
             // Write to disk only if there is data in the compressed stream block buffer
-            m_compressed_stream_file_writer->write(
+            write_compressed(
                     reinterpret_cast<char const*>(m_compressed_stream_block.dst),
                     m_compressed_stream_block.pos
             );
@@ -111,11 +124,20 @@ void ZstdCompressor::flush() {
         );
         throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
     }
-    m_compressed_stream_file_writer->write(
+    write_compressed(
             reinterpret_cast<char const*>(m_compressed_stream_block.dst),
             m_compressed_stream_block.pos
     );
 
     m_compression_stream_contains_data = false;
 }
+
+void ZstdCompressor::write_compressed(char const* data, size_t data_length) {
+    if (nullptr != m_compressed_stream_buffer) {
+        m_compressed_stream_buffer
+                ->insert(m_compressed_stream_buffer->end(), data, data + data_length);
+    } else {
+        m_compressed_stream_file_writer->write(data, data_length);
+    }
+}
 }  // namespace clp_s
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <zstd.h>
 #include <zstd_errors.h>
@@ -79,9 +80,31 @@ public:
      */
     void open(FileWriter& file_writer, int compression_level = cDefaultCompressionLevel);
 
+    /**
+     * Initialize streaming compressor to append compressed data to an in-memory buffer
+     * @param buffer
+     * @param compression_level
+     */
+    void open(std::vector<char>& buffer, int compression_level = cDefaultCompressionLevel);
+
 private:
+    // Methods
+    /**
+     * Initializes the compression stream
+     * @param compression_level
+     */
+    void init_compression_stream(int compression_level);
+
+    /**
+     * Writes compressed data to the underlying file or buffer
+     * @param data
+     * @param data_length
+     */
+    void write_compressed(char const* data, size_t data_length);
+
     // Variables
     FileWriter* m_compressed_stream_file_writer{};
+    std::vector<char>* m_compressed_stream_buffer{};
 
     // Compressed stream variables
     ZSTD_CStream* m_compression_stream;
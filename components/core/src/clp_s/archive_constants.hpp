@@ -23,6 +23,8 @@ constexpr char cArchiveTablesFile[] = "/0";
 constexpr char cArchiveArrayDictFile[] = "/array.dict";
 constexpr char cArchiveLogDictFile[] = "/log.dict";
 constexpr char cArchiveVarDictFile[] = "/var.dict";
+// Suffix of the file containing a dictionary's optional search index
+constexpr char cDictionaryIndexSuffix[] = ".idx";
 
 // Schema tree constants
 constexpr char cRootNodeName[] = "";
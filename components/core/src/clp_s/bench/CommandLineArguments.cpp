@@ -0,0 +1,133 @@
+#include "CommandLineArguments.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <spdlog/spdlog.h>
+
+#include "SyntheticLogGenerator.hpp"
+
+namespace po = boost::program_options;
+
+namespace clp_s::bench {
+CommandLineArguments::ParsingResult
+CommandLineArguments::parse_arguments(int argc, char const** argv) {
+    // Define general options
+    po::options_description general_options("General Options");
+    general_options.add_options()("help,h", "Print help");
+
+    std::string workload_names_description{"Workloads to benchmark (default: all). One of:"};
+    for (auto const workload : cAllWorkloads) {
+        workload_names_description += " ";
+        workload_names_description += workload_to_string(workload);
+    }
+
+    // Define benchmark options
+    std::vector<std::string> workload_names;
+    po::options_description benchmark_options("Benchmark Options");
+    // clang-format off
+    benchmark_options.add_options()(
+            "workloads",
+            po::value<std::vector<std::string>>(&workload_names)
+                    ->value_name("WORKLOAD")
+                    ->multitoken(),
+            workload_names_description.c_str()
+    )(
+            "input-size",
+            po::value<size_t>(&m_input_size)->value_name("SIZE")->default_value(m_input_size),
+            "Size (in bytes) of the synthetic NDJSON logs generated for each workload"
+    )(
+            "repetitions",
+            po::value<size_t>(&m_num_repetitions)
+                    ->value_name("NUM_REPETITIONS")
+                    ->default_value(m_num_repetitions),
+            "Number of times each benchmark is repeated"
+    )(
+            "seed",
+            po::value<uint64_t>(&m_seed)->value_name("SEED")->default_value(m_seed),
+            "Seed used to generate the synthetic logs"
+    )(
+            "compression-level",
+            po::value<int>(&m_compression_level)
+                    ->value_name("LEVEL")
+                    ->default_value(m_compression_level),
+            "Compression level used to compress archives"
+    )(
+            "work-dir",
+            po::value<std::string>(&m_work_dir)->value_name("DIR"),
+            "Directory in which the generated logs and archives are written (default: a new"
+            " directory in the system's temporary directory)"
+    )(
+            "output,o",
+            po::value<std::string>(&m_output_path)->value_name("FILE"),
+            "File to which the results are written as JSON (default: stdout)"
+    )(
+            "keep-files",
+            po::bool_switch(&m_keep_files),
+            "Keep the generated logs and archives after the benchmarks complete"
+    );
+    // clang-format on
+
+    po::options_description all_options;
+    all_options.add(general_options);
+    all_options.add(benchmark_options);
+
+    try {
+        po::variables_map parsed_command_line_options;
+        store(po::command_line_parser(argc, argv).options(all_options).run(),
+              parsed_command_line_options);
+        notify(parsed_command_line_options);
+
+        // Handle --help
+        if (parsed_command_line_options.count("help")) {
+            if (argc > 2) {
+                SPDLOG_WARN("Ignoring all options besides --help.");
+            }
+
+            print_basic_usage();
+
+            std::cerr << all_options << std::endl;
+            return ParsingResult::InfoCommand;
+        }
+
+        if (workload_names.empty()) {
+            m_workloads.assign(cAllWorkloads.begin(), cAllWorkloads.end());
+        }
+        for (auto const& name : workload_names) {
+            auto const workload{string_to_workload(name)};
+            if (false == workload.has_value()) {
+                throw std::invalid_argument("Unknown workload: " + name);
+            }
+            m_workloads.push_back(workload.value());
+        }
+
+        if (0 == m_input_size) {
+            throw std::invalid_argument("input-size must be greater than zero.");
+        }
+        if (0 == m_num_repetitions) {
+            throw std::invalid_argument("repetitions must be greater than zero.");
+        }
+
+        if (m_work_dir.empty()) {
+            m_work_dir = (std::filesystem::temp_directory_path() / "clp-bench").string();
+        }
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("{}", e.what());
+        print_basic_usage();
+        return ParsingResult::Failure;
+    }
+
+    return ParsingResult::Success;
+}
+
+void CommandLineArguments::print_basic_usage() const {
+    std::cerr << "Usage: " << get_program_name() << " [OPTIONS]" << std::endl;
+}
+}  // namespace clp_s::bench
@@ -0,0 +1,65 @@
+#ifndef CLP_S_BENCH_COMMANDLINEARGUMENTS_HPP
+#define CLP_S_BENCH_COMMANDLINEARGUMENTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SyntheticLogGenerator.hpp"
+
+namespace clp_s::bench {
+/**
+ * Class to parse command line arguments
+ */
+class CommandLineArguments {
+public:
+    // Types
+    enum class ParsingResult {
+        Success = 0,
+        InfoCommand,
+        Failure
+    };
+
+    // Constructors
+    explicit CommandLineArguments(std::string const& program_name) : m_program_name(program_name) {}
+
+    // Methods
+    ParsingResult parse_arguments(int argc, char const* argv[]);
+
+    std::string const& get_program_name() const { return m_program_name; }
+
+    std::vector<Workload> const& get_workloads() const { return m_workloads; }
+
+    size_t get_input_size() const { return m_input_size; }
+
+    size_t get_num_repetitions() const { return m_num_repetitions; }
+
+    uint64_t get_seed() const { return m_seed; }
+
+    int get_compression_level() const { return m_compression_level; }
+
+    std::string const& get_work_dir() const { return m_work_dir; }
+
+    std::string const& get_output_path() const { return m_output_path; }
+
+    bool should_keep_files() const { return m_keep_files; }
+
+private:
+    // Methods
+    void print_basic_usage() const;
+
+    // Variables
+    std::string m_program_name;
+    std::vector<Workload> m_workloads;
+    size_t m_input_size{64ULL * 1024 * 1024};  // 64 MiB
+    size_t m_num_repetitions{3};
+    uint64_t m_seed{1};
+    int m_compression_level{3};
+    std::string m_work_dir;
+    std::string m_output_path;
+    bool m_keep_files{false};
+};
+}  // namespace clp_s::bench
+
+#endif  // CLP_S_BENCH_COMMANDLINEARGUMENTS_HPP
@@ -0,0 +1,301 @@
+#include "SyntheticLogGenerator.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "../ErrorCode.hpp"
+#include "../FileWriter.hpp"
+
+namespace clp_s::bench {
+namespace {
+constexpr std::array<std::string_view, 4> cLevels{"INFO", "WARN", "ERROR", "DEBUG"};
+constexpr std::array<std::string_view, 8> cServices{
+        "api-gateway",
+        "auth",
+        "billing",
+        "catalog",
+        "checkout",
+        "inventory",
+        "notifications",
+        "search"
+};
+constexpr std::array<std::string_view, 4> cRegions{"us-east-1", "us-west-2", "eu-west-1", "ap-1"};
+constexpr std::array<std::string_view, 5> cStatuses{"ok", "created", "not_found", "denied", "failed"};
+constexpr std::array<std::string_view, 8> cMessages{
+        "Request handled",
+        "Cache miss, fetching from upstream",
+        "Retrying request after timeout",
+        "Connection pool exhausted",
+        "User session refreshed",
+        "Payload validation failed",
+        "Scheduled job completed",
+        "Configuration reloaded"
+};
+constexpr std::array<std::string_view, 6> cWords{
+        "alpha",
+        "bravo",
+        "charlie",
+        "delta",
+        "echo",
+        "foxtrot"
+};
+
+constexpr size_t cNumWideGroups{8};
+constexpr size_t cNumWideFieldsPerGroup{8};
+constexpr size_t cNumNumericFields{16};
+constexpr int64_t cMaxArrayLength{8};
+constexpr int64_t cErrorFrequency{8};
+
+/**
+ * @param record
+ * @param key
+ * @param value
+ */
+void append_string_field(std::string& record, std::string_view key, std::string_view value) {
+    fmt::format_to(std::back_inserter(record), R"("{}":"{}",)", key, value);
+}
+
+/**
+ * @param record
+ * @param key
+ * @param value
+ */
+void append_int_field(std::string& record, std::string_view key, int64_t value) {
+    fmt::format_to(std::back_inserter(record), R"("{}":{},)", key, value);
+}
+
+/**
+ * @param record
+ * @param key
+ * @param value
+ */
+void append_float_field(std::string& record, std::string_view key, double value) {
+    fmt::format_to(std::back_inserter(record), R"("{}":{:.3f},)", key, value);
+}
+
+/**
+ * Replaces the trailing comma of a JSON object's (or array's) last member with `terminator`, or
+ * appends `terminator` if the object is empty.
+ * @param record
+ * @param terminator
+ */
+void close_container(std::string& record, char terminator) {
+    if (',' == record.back()) {
+        record.back() = terminator;
+    } else {
+        record += terminator;
+    }
+}
+}  // namespace
+
+auto workload_to_string(Workload workload) -> std::string_view {
+    switch (workload) {
+        case Workload::Narrow:
+            return "narrow";
+        case Workload::Wide:
+            return "wide";
+        case Workload::Arrays:
+            return "arrays";
+        case Workload::HighCardinalityStrings:
+            return "high-cardinality-strings";
+        case Workload::LowCardinalityStrings:
+            return "low-cardinality-strings";
+        case Workload::NumericHeavy:
+            return "numeric-heavy";
+        default:
+            return "unknown";
+    }
+}
+
+auto string_to_workload(std::string_view name) -> std::optional<Workload> {
+    for (auto const workload : cAllWorkloads) {
+        if (workload_to_string(workload) == name) {
+            return workload;
+        }
+    }
+    return std::nullopt;
+}
+
+void SyntheticLogGenerator::append_record(std::string& record) {
+    m_timestamp += next_int(100);
+
+    record += '{';
+    append_int_field(record, "timestamp", m_timestamp);
+    append_int_field(record, cBucketKey, next_int(cNumBuckets));
+    switch (m_workload) {
+        case Workload::Narrow:
+            append_narrow_fields(record);
+            break;
+        case Workload::Wide:
+            append_wide_fields(record);
+            break;
+        case Workload::Arrays:
+            append_array_fields(record);
+            break;
+        case Workload::HighCardinalityStrings:
+            append_high_cardinality_string_fields(record);
+            break;
+        case Workload::LowCardinalityStrings:
+            append_low_cardinality_string_fields(record);
+            break;
+        case Workload::NumericHeavy:
+            append_numeric_fields(record);
+            break;
+        default:
+            break;
+    }
+    if (0 == next_int(cErrorFrequency)) {
+        record += R"("error":{)";
+        append_int_field(record, "code", 400 + next_int(200));
+        append_string_field(record, "kind", cStatuses[next_int(cStatuses.size())]);
+        close_container(record, '}');
+        record += ',';
+    }
+    close_container(record, '}');
+    record += '\n';
+}
+
+auto SyntheticLogGenerator::write_file(std::string const& path, size_t target_size) -> size_t {
+    constexpr size_t cBufferSize{1024ULL * 1024};  // 1 MiB
+
+    size_t num_records{0};
+    size_t num_bytes{0};
+    std::string buffer;
+    try {
+        FileWriter writer;
+        writer.open(path, FileWriter::OpenMode::CreateForWriting);
+        while (num_bytes < target_size) {
+            buffer.clear();
+            while (buffer.size() < cBufferSize && num_bytes + buffer.size() < target_size) {
+                append_record(buffer);
+                ++num_records;
+            }
+            writer.write(buffer.data(), buffer.size());
+            num_bytes += buffer.size();
+        }
+        writer.close();
+    } catch (std::exception const&) {
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+    return num_records;
+}
+
+void SyntheticLogGenerator::append_narrow_fields(std::string& record) {
+    append_string_field(record, "level", cLevels[next_int(cLevels.size())]);
+    fmt::format_to(
+            std::back_inserter(record),
+            R"("message":"Request handled in {} ms",)",
+            next_int(1000)
+    );
+}
+
+void SyntheticLogGenerator::append_wide_fields(std::string& record) {
+    for (size_t group{0}; group < cNumWideGroups; ++group) {
+        fmt::format_to(std::back_inserter(record), R"("group_{}":{{)", group);
+        for (size_t field{0}; field < cNumWideFieldsPerGroup; ++field) {
+            auto const key{fmt::format("field_{}", field)};
+            switch (field % 4) {
+                case 0:
+                    append_int_field(record, key, next_int(1'000'000));
+                    break;
+                case 1:
+                    append_float_field(record, key, next_double(0.0, 1000.0));
+                    break;
+                case 2:
+                    append_string_field(record, key, cWords[next_int(cWords.size())]);
+                    break;
+                default:
+                    fmt::format_to(
+                            std::back_inserter(record),
+                            R"("{}":{},)",
+                            key,
+                            0 == next_int(2) ? "true" : "false"
+                    );
+                    break;
+            }
+        }
+        close_container(record, '}');
+        record += ',';
+    }
+}
+
+void SyntheticLogGenerator::append_array_fields(std::string& record) {
+    record += R"("tags":[)";
+    for (auto i{next_int(cMaxArrayLength)}; i > 0; --i) {
+        fmt::format_to(std::back_inserter(record), R"("{}",)", cWords[next_int(cWords.size())]);
+    }
+    close_container(record, ']');
+
+    record += R"(,"values":[)";
+    for (auto i{next_int(cMaxArrayLength)}; i > 0; --i) {
+        fmt::format_to(std::back_inserter(record), "{},", next_int(100'000));
+    }
+    close_container(record, ']');
+
+    record += R"(,"spans":[)";
+    for (auto i{next_int(cMaxArrayLength)}; i > 0; --i) {
+        record += '{';
+        append_int_field(record, "id", next_int(1'000'000));
+        append_float_field(record, "duration", next_double(0.0, 10.0));
+        close_container(record, '}');
+        record += ',';
+    }
+    close_container(record, ']');
+    record += ',';
+}
+
+void SyntheticLogGenerator::append_high_cardinality_string_fields(std::string& record) {
+    constexpr size_t cRequestIdLength{32};
+    constexpr size_t cTraceIdLength{16};
+
+    record += R"("request_id":")";
+    append_hex(record, cRequestIdLength);
+    record += R"(",)";
+    fmt::format_to(std::back_inserter(record), R"("user":"user-{}",)", next_int(1'000'000'000));
+    fmt::format_to(
+            std::back_inserter(record),
+            R"("path":"/api/v1/items/{}/{}",)",
+            next_int(1'000'000),
+            cWords[next_int(cWords.size())]
+    );
+    fmt::format_to(
+            std::back_inserter(record),
+            R"("message":"Fetched item {} for session {} from host-{}.internal trace=)",
+            next_int(1'000'000),
+            next_int(1'000'000'000),
+            next_int(10'000)
+    );
+    append_hex(record, cTraceIdLength);
+    record += R"(",)";
+}
+
+void SyntheticLogGenerator::append_low_cardinality_string_fields(std::string& record) {
+    append_string_field(record, "level", cLevels[next_int(cLevels.size())]);
+    append_string_field(record, "service", cServices[next_int(cServices.size())]);
+    append_string_field(record, "region", cRegions[next_int(cRegions.size())]);
+    append_string_field(record, "status", cStatuses[next_int(cStatuses.size())]);
+    append_string_field(record, "message", cMessages[next_int(cMessages.size())]);
+}
+
+void SyntheticLogGenerator::append_numeric_fields(std::string& record) {
+    for (size_t i{0}; i < cNumNumericFields; ++i) {
+        append_int_field(record, fmt::format("counter_{}", i), next_int(1'000'000'000));
+        append_float_field(record, fmt::format("gauge_{}", i), next_double(-1000.0, 1000.0));
+    }
+}
+
+void SyntheticLogGenerator::append_hex(std::string& record, size_t length) {
+    constexpr std::string_view cHexDigits{"0123456789abcdef"};
+    for (size_t i{0}; i < length; ++i) {
+        record += cHexDigits[next_int(cHexDigits.size())];
+    }
+}
+}  // namespace clp_s::bench
@@ -0,0 +1,141 @@
+#ifndef CLP_S_BENCH_SYNTHETICLOGGENERATOR_HPP
+#define CLP_S_BENCH_SYNTHETICLOGGENERATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "../ErrorCode.hpp"
+#include "../TraceableException.hpp"
+
+namespace clp_s::bench {
+/**
+ * The shapes of synthetic logs that can be generated. Each shape stresses a different part of
+ * clp-s.
+ */
+enum class Workload : uint8_t {
+    // Few fields per record, mostly short strings
+    Narrow = 0,
+    // Many fields per record, spread across nested objects
+    Wide,
+    // Arrays of strings, numbers, and objects
+    Arrays,
+    // String fields with (nearly) unique values, which grow the variable dictionary
+    HighCardinalityStrings,
+    // String fields drawn from small sets of values
+    LowCardinalityStrings,
+    // Mostly integer and floating point fields
+    NumericHeavy,
+};
+
+constexpr std::array cAllWorkloads{
+        Workload::Narrow,
+        Workload::Wide,
+        Workload::Arrays,
+        Workload::HighCardinalityStrings,
+        Workload::LowCardinalityStrings,
+        Workload::NumericHeavy,
+};
+
+/**
+ * @param workload
+ * @return The name of the given workload
+ */
+auto workload_to_string(Workload workload) -> std::string_view;
+
+/**
+ * @param name
+ * @return The workload with the given name, or std::nullopt if there is no such workload
+ */
+auto string_to_workload(std::string_view name) -> std::optional<Workload>;
+
+/**
+ * Deterministically generates synthetic NDJSON logs for a given workload.
+ *
+ * Besides the workload's own fields, every record has:
+ * - "timestamp": a monotonically increasing epoch timestamp in milliseconds;
+ * - "bucket": an integer drawn uniformly from [0, cNumBuckets), so that a query like
+ *   `bucket < N` matches roughly N / cNumBuckets of the records regardless of the workload;
+ * - "error": an object present in roughly one out of eight records, so that every workload has
+ *   more than one schema.
+ */
+class SyntheticLogGenerator {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr int64_t cNumBuckets{1000};
+    static constexpr std::string_view cBucketKey{"bucket"};
+
+    // Constructors
+    SyntheticLogGenerator(Workload workload, uint64_t seed) : m_workload{workload}, m_rng{seed} {}
+
+    // Methods
+    /**
+     * Appends the next record, followed by a newline, to `record`.
+     * @param record
+     */
+    void append_record(std::string& record);
+
+    /**
+     * Writes records to a file until at least `target_size` bytes have been written.
+     * @param path
+     * @param target_size
+     * @return The number of records written
+     * @throw OperationFailed if the file couldn't be written
+     */
+    auto write_file(std::string const& path, size_t target_size) -> size_t;
+
+private:
+    // Methods
+    void append_narrow_fields(std::string& record);
+    void append_wide_fields(std::string& record);
+    void append_array_fields(std::string& record);
+    void append_high_cardinality_string_fields(std::string& record);
+    void append_low_cardinality_string_fields(std::string& record);
+    void append_numeric_fields(std::string& record);
+
+    // NOTE: The standard distributions are implementation-defined, so they're avoided to keep the
+    // generated logs identical across standard libraries.
+    /**
+     * @param max
+     * @return A (nearly) uniformly distributed integer in [0, max)
+     */
+    auto next_int(int64_t max) -> int64_t {
+        return static_cast<int64_t>(m_rng() % static_cast<uint64_t>(max));
+    }
+
+    /**
+     * @param min
+     * @param max
+     * @return A uniformly distributed double in [min, max)
+     */
+    auto next_double(double min, double max) -> double {
+        constexpr double cTwoToTheMinus53{0x1.0p-53};
+        return min + static_cast<double>(m_rng() >> 11) * cTwoToTheMinus53 * (max - min);
+    }
+
+    /**
+     * Appends a random lowercase hex string of the given length.
+     * @param record
+     * @param length
+     */
+    void append_hex(std::string& record, size_t length);
+
+    Workload m_workload;
+    std::mt19937_64 m_rng;
+    int64_t m_timestamp{1'700'000'000'000};
+};
+}  // namespace clp_s::bench
+
+#endif  // CLP_S_BENCH_SYNTHETICLOGGENERATOR_HPP
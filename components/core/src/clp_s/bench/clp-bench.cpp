@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/sinks/stdout_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "../../clp/Stopwatch.hpp"
+#include "../ArchiveReader.hpp"
+#include "../Defs.hpp"
+#include "../InputConfig.hpp"
+#include "../JsonParser.hpp"
+#include "../search/ast/ConvertToExists.hpp"
+#include "../search/ast/EmptyExpr.hpp"
+#include "../search/ast/Expression.hpp"
+#include "../search/ast/NarrowTypes.hpp"
+#include "../search/ast/OrOfAndForm.hpp"
+#include "../search/kql/kql.hpp"
+#include "../search/Output.hpp"
+#include "../search/OutputHandler.hpp"
+#include "../search/Projection.hpp"
+#include "../search/SchemaMatch.hpp"
+#include "../TimestampPattern.hpp"
+#include "CommandLineArguments.hpp"
+#include "SyntheticLogGenerator.hpp"
+
+using clp_s::bench::CommandLineArguments;
+using clp_s::bench::SyntheticLogGenerator;
+using clp_s::bench::Workload;
+
+namespace {
+// Version of the results' format, which should be incremented whenever a field is removed or its
+// meaning changes
+constexpr int cResultsFormatVersion{1};
+
+/**
+ * Output handler that only counts the results it receives.
+ */
+class CountingOutputHandler : public clp_s::search::OutputHandler {
+public:
+    // Constructors
+    explicit CountingOutputHandler(size_t& num_results)
+            : OutputHandler(false, true),
+              m_num_results{num_results} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            [[maybe_unused]] clp_s::epochtime_t timestamp,
+            [[maybe_unused]] std::string_view archive_id,
+            [[maybe_unused]] int64_t log_event_idx
+    ) override {
+        write(message);
+    }
+
+    void write([[maybe_unused]] std::string_view message) override { ++m_num_results; }
+
+private:
+    size_t& m_num_results;
+};
+
+/**
+ * A query whose selectivity is known from the way the synthetic logs are generated.
+ */
+struct SelectivityQuery {
+    std::string query;
+    double expected_selectivity;
+};
+
+/**
+ * The timings of a benchmark's repetitions.
+ */
+class Timings {
+public:
+    void add(double seconds) { m_seconds.push_back(seconds); }
+
+    [[nodiscard]] auto get_median() const -> double {
+        auto sorted{m_seconds};
+        std::ranges::sort(sorted);
+        auto const mid{sorted.size() / 2};
+        if (0 == sorted.size() % 2) {
+            return (sorted[mid - 1] + sorted[mid]) / 2;
+        }
+        return sorted[mid];
+    }
+
+    /**
+     * @param benchmark
+     * @param scope Either "micro" for a single stage, or "macro" for an end-to-end operation
+     * @return A JSON object describing the timings
+     */
+    [[nodiscard]] auto to_json(std::string_view benchmark, std::string_view scope) const
+            -> nlohmann::json {
+        return {{"benchmark", benchmark},
+                {"scope", scope},
+                {"times_s", m_seconds},
+                {"min_s", std::ranges::min(m_seconds)},
+                {"median_s", get_median()},
+                {"max_s", std::ranges::max(m_seconds)}};
+    }
+
+private:
+    std::vector<double> m_seconds;
+};
+
+/**
+ * Compresses a file into archives.
+ * @param input_path
+ * @param archives_dir
+ * @param compression_level
+ * @param ingest_stopwatch Measures the time taken to parse and ingest the input
+ * @param close_stopwatch Measures the time taken to close the archives
+ * @return Whether compression succeeded
+ */
+auto compress(
+        std::string const& input_path,
+        std::string const& archives_dir,
+        int compression_level,
+        clp::Stopwatch& ingest_stopwatch,
+        clp::Stopwatch& close_stopwatch
+) -> bool;
+
+/**
+ * Decompresses every archive in a directory without writing the decompressed records anywhere.
+ * @param archives_dir
+ * @param marshal_stopwatch Measures the time taken to marshal records, excluding the time taken
+ * to open archives and read their tables
+ * @return The total size of the decompressed records
+ */
+auto decompress_archives(std::string const& archives_dir, clp::Stopwatch& marshal_stopwatch)
+        -> size_t;
+
+/**
+ * Searches every archive in a directory.
+ * @param archives_dir
+ * @param query
+ * @return The number of results, or std::nullopt if the search failed
+ */
+auto search_archives(std::string const& archives_dir, std::string const& query)
+        -> std::optional<size_t>;
+
+/**
+ * Searches an archive.
+ * @param archive_reader
+ * @param expr
+ * @param num_results Incremented by the number of results in the archive
+ * @return Whether the search succeeded
+ */
+auto search_archive(
+        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
+        std::shared_ptr<clp_s::search::ast::Expression> expr,
+        size_t& num_results
+) -> bool;
+
+/**
+ * @param path
+ * @return The total size of the regular files in the given directory tree
+ */
+auto get_directory_size(std::filesystem::path const& path) -> size_t;
+
+/**
+ * @param num_bytes
+ * @param seconds
+ * @return The throughput in MB/s (10^6 bytes per second)
+ */
+auto get_throughput(size_t num_bytes, double seconds) -> double;
+
+/**
+ * Runs every benchmark for a workload.
+ * @param command_line_arguments
+ * @param workload
+ * @param results Returns the results of each benchmark
+ * @return Whether every benchmark succeeded
+ */
+auto run_workload(
+        CommandLineArguments const& command_line_arguments,
+        Workload workload,
+        nlohmann::json& results
+) -> bool;
+
+auto compress(
+        std::string const& input_path,
+        std::string const& archives_dir,
+        int compression_level,
+        clp::Stopwatch& ingest_stopwatch,
+        clp::Stopwatch& close_stopwatch
+) -> bool {
+    constexpr size_t cTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
+    constexpr size_t cMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
+    constexpr size_t cMinTableSize{1ULL * 1024 * 1024};  // 1 MiB
+
+    clp_s::JsonParserOption option{};
+    option.input_paths.emplace_back(
+            clp_s::Path{.source = clp_s::InputSource::Filesystem, .path = input_path}
+    );
+    option.archives_dir = archives_dir;
+    option.target_encoded_size = cTargetEncodedSize;
+    option.max_document_size = cMaxDocumentSize;
+    option.min_table_size = cMinTableSize;
+    option.compression_level = compression_level;
+    option.timestamp_key = "timestamp";
+
+    clp_s::JsonParser parser{option};
+    ingest_stopwatch.start();
+    auto const ingested{parser.ingest()};
+    ingest_stopwatch.stop();
+    if (false == ingested) {
+        SPDLOG_ERROR("Failed to ingest {}", input_path);
+        return false;
+    }
+
+    close_stopwatch.start();
+    std::ignore = parser.store();
+    close_stopwatch.stop();
+    return true;
+}
+
+auto decompress_archives(std::string const& archives_dir, clp::Stopwatch& marshal_stopwatch)
+        -> size_t {
+    size_t num_bytes{0};
+    std::string message;
+    clp_s::ArchiveReader archive_reader;
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        clp_s::Path const archive_path{
+                .source = clp_s::InputSource::Filesystem,
+                .path = entry.path().string()
+        };
+        archive_reader.open(archive_path, clp_s::NetworkAuthOption{});
+        archive_reader.read_dictionaries_and_metadata();
+        archive_reader.open_packed_streams();
+        for (auto const& schema_reader : archive_reader.read_all_tables()) {
+            marshal_stopwatch.start();
+            while (schema_reader->get_next_message(message)) {
+                num_bytes += message.size();
+            }
+            marshal_stopwatch.stop();
+        }
+        archive_reader.close();
+    }
+    return num_bytes;
+}
+
+auto search_archives(std::string const& archives_dir, std::string const& query)
+        -> std::optional<size_t> {
+    auto query_stream{std::istringstream{query}};
+    auto const expr{clp_s::search::kql::parse_kql_expression(query_stream)};
+    if (nullptr == expr) {
+        SPDLOG_ERROR("Failed to parse query '{}'", query);
+        return std::nullopt;
+    }
+
+    size_t num_results{0};
+    auto archive_reader{std::make_shared<clp_s::ArchiveReader>()};
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        clp_s::Path const archive_path{
+                .source = clp_s::InputSource::Filesystem,
+                .path = entry.path().string()
+        };
+        archive_reader->open(archive_path, clp_s::NetworkAuthOption{});
+        if (false == search_archive(archive_reader, expr->copy(), num_results)) {
+            return std::nullopt;
+        }
+        archive_reader->close();
+    }
+    return num_results;
+}
+
+auto search_archive(
+        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
+        std::shared_ptr<clp_s::search::ast::Expression> expr,
+        size_t& num_results
+) -> bool {
+    namespace ast = clp_s::search::ast;
+
+    // A query can only become logically false here if it's logically false for every archive, in
+    // which case there are no results.
+    ast::OrOfAndForm standardize_pass;
+    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        return true;
+    }
+    ast::NarrowTypes narrow_pass;
+    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        return true;
+    }
+    ast::ConvertToExists convert_pass;
+    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        return true;
+    }
+
+    auto match_pass{std::make_shared<clp_s::search::SchemaMatch>(
+            archive_reader->get_schema_tree(),
+            archive_reader->get_schema_map()
+    )};
+    if (expr = match_pass->run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        return true;
+    }
+
+    auto projection{std::make_shared<clp_s::search::Projection>(
+            clp_s::search::ProjectionMode::ReturnAllColumns
+    )};
+    projection->resolve_columns(archive_reader->get_schema_tree());
+    archive_reader->set_projection(projection);
+
+    clp_s::search::Output output{
+            match_pass,
+            expr,
+            archive_reader,
+            std::make_unique<CountingOutputHandler>(num_results),
+            false
+    };
+    return output.filter();
+}
+
+auto get_directory_size(std::filesystem::path const& path) -> size_t {
+    size_t size{0};
+    for (auto const& entry : std::filesystem::recursive_directory_iterator{path}) {
+        if (entry.is_regular_file()) {
+            size += entry.file_size();
+        }
+    }
+    return size;
+}
+
+auto get_throughput(size_t num_bytes, double seconds) -> double {
+    constexpr double cBytesPerMegabyte{1'000'000.0};
+    if (seconds <= 0) {
+        return 0;
+    }
+    return static_cast<double>(num_bytes) / cBytesPerMegabyte / seconds;
+}
+
+auto run_workload(
+        CommandLineArguments const& command_line_arguments,
+        Workload workload,
+        nlohmann::json& results
+) -> bool {
+    auto const workload_name{clp_s::bench::workload_to_string(workload)};
+    auto const workload_dir{std::filesystem::path{command_line_arguments.get_work_dir()}
+                            / workload_name};
+    auto const input_path{(workload_dir / "logs.jsonl").string()};
+    auto const archives_dir{(workload_dir / "archives").string()};
+    auto const num_repetitions{command_line_arguments.get_num_repetitions()};
+
+    std::filesystem::remove_all(workload_dir);
+    std::filesystem::create_directories(workload_dir);
+
+    SPDLOG_INFO("Generating '{}' logs.", workload_name);
+    SyntheticLogGenerator generator{workload, command_line_arguments.get_seed()};
+    auto const num_records{
+            generator.write_file(input_path, command_line_arguments.get_input_size())
+    };
+    auto const input_size{std::filesystem::file_size(input_path)};
+
+    auto add_result = [&](nlohmann::json result) {
+        result["workload"] = workload_name;
+        result["num_records"] = num_records;
+        results.emplace_back(std::move(result));
+    };
+
+    // Compression
+    SPDLOG_INFO("Benchmarking compression of '{}' logs.", workload_name);
+    Timings ingest_timings;
+    Timings close_timings;
+    Timings compress_timings;
+    size_t archives_size{0};
+    for (size_t i{0}; i < num_repetitions; ++i) {
+        std::filesystem::remove_all(archives_dir);
+        clp::Stopwatch ingest_stopwatch;
+        clp::Stopwatch close_stopwatch;
+        if (false
+            == compress(
+                    input_path,
+                    archives_dir,
+                    command_line_arguments.get_compression_level(),
+                    ingest_stopwatch,
+                    close_stopwatch
+            ))
+        {
+            return false;
+        }
+        auto const ingest_time{ingest_stopwatch.get_time_taken_in_seconds()};
+        auto const close_time{close_stopwatch.get_time_taken_in_seconds()};
+        ingest_timings.add(ingest_time);
+        close_timings.add(close_time);
+        compress_timings.add(ingest_time + close_time);
+        archives_size = get_directory_size(archives_dir);
+    }
+
+    auto ingest_result{ingest_timings.to_json("compress.ingest", "micro")};
+    ingest_result["input_bytes"] = input_size;
+    ingest_result["throughput_mb_s"] = get_throughput(input_size, ingest_timings.get_median());
+    add_result(std::move(ingest_result));
+    add_result(close_timings.to_json("compress.close", "micro"));
+    auto compress_result{compress_timings.to_json("compress", "macro")};
+    compress_result["input_bytes"] = input_size;
+    compress_result["archive_bytes"] = archives_size;
+    compress_result["compression_ratio"]
+            = static_cast<double>(input_size) / static_cast<double>(archives_size);
+    compress_result["throughput_mb_s"] = get_throughput(input_size, compress_timings.get_median());
+    add_result(std::move(compress_result));
+
+    // Decompression
+    SPDLOG_INFO("Benchmarking decompression of '{}' logs.", workload_name);
+    Timings marshal_timings;
+    Timings decompress_timings;
+    size_t decompressed_size{0};
+    for (size_t i{0}; i < num_repetitions; ++i) {
+        clp::Stopwatch decompress_stopwatch;
+        clp::Stopwatch marshal_stopwatch;
+        decompress_stopwatch.start();
+        decompressed_size = decompress_archives(archives_dir, marshal_stopwatch);
+        decompress_stopwatch.stop();
+        marshal_timings.add(marshal_stopwatch.get_time_taken_in_seconds());
+        decompress_timings.add(decompress_stopwatch.get_time_taken_in_seconds());
+    }
+
+    auto marshal_result{marshal_timings.to_json("decompress.marshal", "micro")};
+    marshal_result["output_bytes"] = decompressed_size;
+    marshal_result["throughput_mb_s"]
+            = get_throughput(decompressed_size, marshal_timings.get_median());
+    add_result(std::move(marshal_result));
+    auto decompress_result{decompress_timings.to_json("decompress", "macro")};
+    decompress_result["output_bytes"] = decompressed_size;
+    decompress_result["throughput_mb_s"]
+            = get_throughput(decompressed_size, decompress_timings.get_median());
+    add_result(std::move(decompress_result));
+
+    // Search
+    SPDLOG_INFO("Benchmarking search of '{}' logs.", workload_name);
+    std::vector<SelectivityQuery> queries;
+    constexpr auto cNumBuckets{SyntheticLogGenerator::cNumBuckets};
+    for (int64_t num_matching_buckets{1}; num_matching_buckets <= cNumBuckets;
+         num_matching_buckets *= 10)
+    {
+        queries.push_back(
+                {fmt::format("{} < {}", SyntheticLogGenerator::cBucketKey, num_matching_buckets),
+                 static_cast<double>(num_matching_buckets) / static_cast<double>(cNumBuckets)}
+        );
+    }
+    for (auto const& [query, expected_selectivity] : queries) {
+        Timings search_timings;
+        size_t num_results{0};
+        for (size_t i{0}; i < num_repetitions; ++i) {
+            clp::Stopwatch search_stopwatch;
+            search_stopwatch.start();
+            auto const result{search_archives(archives_dir, query)};
+            search_stopwatch.stop();
+            if (false == result.has_value()) {
+                return false;
+            }
+            num_results = result.value();
+            search_timings.add(search_stopwatch.get_time_taken_in_seconds());
+        }
+
+        auto search_result{search_timings.to_json("search", "macro")};
+        search_result["query"] = query;
+        search_result["expected_selectivity"] = expected_selectivity;
+        search_result["num_results"] = num_results;
+        add_result(std::move(search_result));
+    }
+
+    if (false == command_line_arguments.should_keep_files()) {
+        std::filesystem::remove_all(workload_dir);
+    }
+    return true;
+}
+}  // namespace
+
+int main(int argc, char const* argv[]) {
+    try {
+        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        spdlog::set_default_logger(stderr_logger);
+        spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
+    } catch (std::exception& e) {
+        return 1;
+    }
+
+    CommandLineArguments command_line_arguments("clp-bench");
+    auto parsing_result = command_line_arguments.parse_arguments(argc, argv);
+    switch (parsing_result) {
+        case CommandLineArguments::ParsingResult::Failure:
+            return 1;
+        case CommandLineArguments::ParsingResult::InfoCommand:
+            return 0;
+        case CommandLineArguments::ParsingResult::Success:
+            // Continue processing
+            break;
+    }
+
+    clp_s::TimestampPattern::init();
+
+    nlohmann::json results = nlohmann::json::array();
+    try {
+        for (auto const workload : command_line_arguments.get_workloads()) {
+            if (false == run_workload(command_line_arguments, workload, results)) {
+                return 1;
+            }
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Encountered error while benchmarking - {}", e.what());
+        return 1;
+    }
+
+    nlohmann::json const report{
+            {"format_version", cResultsFormatVersion},
+            {"config",
+             {{"input_size", command_line_arguments.get_input_size()},
+              {"repetitions", command_line_arguments.get_num_repetitions()},
+              {"seed", command_line_arguments.get_seed()},
+              {"compression_level", command_line_arguments.get_compression_level()}}},
+            {"results", std::move(results)}
+    };
+    auto const& output_path{command_line_arguments.get_output_path()};
+    if (output_path.empty()) {
+        std::cout << report.dump(2) << std::endl;
+        return 0;
+    }
+    std::ofstream output_file{output_path};
+    output_file << report.dump(2) << std::endl;
+    if (false == output_file.good()) {
+        SPDLOG_ERROR("Failed to write results to {}", output_path);
+        return 1;
+    }
+    return 0;
+}
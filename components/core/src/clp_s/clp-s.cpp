@@ -1,24 +1,33 @@
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 #include <mongocxx/instance.hpp>
 #include <nlohmann/json.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include "../clp/ClaimQueue.hpp"
 #include "../clp/CurlGlobalInstance.hpp"
 #include "../clp/ir/constants.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
+#include "../clp/Thread.hpp"
+#include "../clp/type_utils.hpp"
 #include "../reducer/network_utils.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
 #include "JsonConstructor.hpp"
 #include "JsonParser.hpp"
 #include "kv_ir_search.hpp"
@@ -36,7 +45,10 @@
 #include "search/Output.hpp"
 #include "search/OutputHandler.hpp"
 #include "search/Projection.hpp"
+#include "search/QueryResultCache.hpp"
+#include "search/QueuedOutputHandler.hpp"
 #include "search/SchemaMatch.hpp"
+#include "search/SearchResultQueue.hpp"
 #include "TimestampPattern.hpp"
 
 using namespace clp_s::search;
@@ -61,21 +73,101 @@ bool compress(CommandLineArguments const& command_line_arguments);
  */
 void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_option);
 
+/**
+ * Callable that creates the output handler for a search, returning nullptr on failure.
+ */
+using OutputHandlerFactory = std::function<std::unique_ptr<OutputHandler>()>;
+
+/**
+ * Creates the output handler specified by the command line arguments.
+ * @param command_line_arguments
+ * @param reducer_socket_fd
+ * @return The output handler, or nullptr on failure
+ */
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd);
+
 /**
  * Searches the given archive.
  * @param command_line_arguments
  * @param archive_reader
  * @param expr A copy of the search AST which may be modified
- * @param reducer_socket_fd
+ * @param output_handler_factory Creates the output handler for the archive's results
+ * @param result_cache The cache consulted before searching the archive's tables, or nullptr if
+ * results shouldn't be cached
  * @return Whether the search succeeded
  */
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
         std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
         std::shared_ptr<ast::Expression> expr,
-        int reducer_socket_fd
+        OutputHandlerFactory const& output_handler_factory,
+        QueryResultCache* result_cache
+);
+
+/**
+ * Searches the given archives using a pool of search threads. Each thread searches whole archives
+ * with its own `ArchiveReader` and forwards its results through a bounded queue to this thread,
+ * which outputs them using a single output handler.
+ * @param command_line_arguments
+ * @param archive_paths
+ * @param expr
+ * @param reducer_socket_fd
+ * @param result_cache
+ * @return Whether the search succeeded
+ */
+bool search_archives_in_parallel(
+        CommandLineArguments const& command_line_arguments,
+        std::vector<clp_s::Path> const& archive_paths,
+        std::shared_ptr<ast::Expression> const& expr,
+        int reducer_socket_fd,
+        QueryResultCache* result_cache
 );
 
+/**
+ * Queue of archive paths shared by all search threads.
+ */
+using ArchivePathQueue = clp::ClaimQueue<clp_s::Path>;
+
+/**
+ * Thread that searches archives claimed from an `ArchivePathQueue`, forwarding its results to a
+ * `SearchResultQueue`.
+ */
+class SearchThread : public clp::Thread {
+public:
+    // Constructors
+    SearchThread(
+            CommandLineArguments const& command_line_arguments,
+            ArchivePathQueue& archive_queue,
+            std::shared_ptr<ast::Expression> const& expr,
+            SearchResultQueue& queue,
+            OutputHandler const& output_handler,
+            QueryResultCache* result_cache
+    )
+            : m_command_line_arguments{command_line_arguments},
+              m_archive_queue{archive_queue},
+              m_expr{expr},
+              m_queue{queue},
+              m_output_handler{output_handler},
+              m_result_cache{result_cache} {}
+
+    // Methods
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+protected:
+    // Methods implementing `clp::Thread`
+    void thread_method() override;
+
+private:
+    CommandLineArguments const& m_command_line_arguments;
+    ArchivePathQueue& m_archive_queue;
+    std::shared_ptr<ast::Expression> const& m_expr;
+    SearchResultQueue& m_queue;
+    OutputHandler const& m_output_handler;
+    QueryResultCache* m_result_cache;
+    bool m_succeeded{true};
+};
+
 bool compress(CommandLineArguments const& command_line_arguments) {
     auto archives_dir = std::filesystem::path(command_line_arguments.get_archives_dir());
 
@@ -103,8 +195,12 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     option.print_archive_stats = command_line_arguments.print_archive_stats();
     option.retain_float_format = command_line_arguments.get_retain_float_format();
     option.single_file_archive = command_line_arguments.get_single_file_archive();
+    option.index_dictionaries = command_line_arguments.get_index_dictionaries();
     option.structurize_arrays = command_line_arguments.get_structurize_arrays();
     option.record_log_order = command_line_arguments.get_record_log_order();
+    option.num_ingestion_threads = command_line_arguments.get_num_ingestion_threads();
+    option.num_table_compression_threads
+            = command_line_arguments.get_num_table_compression_threads();
 
     clp_s::JsonParser parser(option);
     if (false == parser.ingest()) {
@@ -120,11 +216,58 @@ void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_opt
     constructor.store();
 }
 
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd) {
+    std::unique_ptr<OutputHandler> output_handler;
+    try {
+        switch (command_line_arguments.get_output_handler_type()) {
+            case CommandLineArguments::OutputHandlerType::Network:
+                output_handler = std::make_unique<clp_s::NetworkOutputHandler>(
+                        command_line_arguments.get_network_dest_host(),
+                        command_line_arguments.get_network_dest_port()
+                );
+                break;
+            case CommandLineArguments::OutputHandlerType::Reducer:
+                if (command_line_arguments.do_count_results_aggregation()) {
+                    output_handler = std::make_unique<clp_s::CountOutputHandler>(reducer_socket_fd);
+                } else if (command_line_arguments.do_count_by_time_aggregation()) {
+                    output_handler = std::make_unique<clp_s::CountByTimeOutputHandler>(
+                            reducer_socket_fd,
+                            command_line_arguments.get_count_by_time_bucket_size()
+                    );
+                } else {
+                    SPDLOG_ERROR("Unhandled aggregation type.");
+                    return nullptr;
+                }
+                break;
+            case CommandLineArguments::OutputHandlerType::ResultsCache:
+                output_handler = std::make_unique<clp_s::ResultsCacheOutputHandler>(
+                        command_line_arguments.get_mongodb_uri(),
+                        command_line_arguments.get_mongodb_collection(),
+                        command_line_arguments.get_batch_size(),
+                        command_line_arguments.get_max_num_results()
+                );
+                break;
+            case CommandLineArguments::OutputHandlerType::Stdout:
+                output_handler = std::make_unique<clp_s::StandardOutputHandler>();
+                break;
+            default:
+                SPDLOG_ERROR("Unhandled OutputHandlerType.");
+                return nullptr;
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to create output handler - {}", e.what());
+        return nullptr;
+    }
+    return output_handler;
+}
+
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
         std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
         std::shared_ptr<ast::Expression> expr,
-        int reducer_socket_fd
+        OutputHandlerFactory const& output_handler_factory,
+        QueryResultCache* result_cache
 ) {
     auto const& query = command_line_arguments.get_query();
 
@@ -224,47 +367,44 @@ bool search_archive(
     }
     projection->resolve_columns(archive_reader->get_schema_tree());
     archive_reader->set_projection(projection);
+    archive_reader->set_num_prefetched_streams(command_line_arguments.get_num_prefetched_streams());
 
-    std::unique_ptr<OutputHandler> output_handler;
-    try {
-        switch (command_line_arguments.get_output_handler_type()) {
-            case CommandLineArguments::OutputHandlerType::Network:
-                output_handler = std::make_unique<clp_s::NetworkOutputHandler>(
-                        command_line_arguments.get_network_dest_host(),
-                        command_line_arguments.get_network_dest_port()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Reducer:
-                if (command_line_arguments.do_count_results_aggregation()) {
-                    output_handler = std::make_unique<clp_s::CountOutputHandler>(reducer_socket_fd);
-                } else if (command_line_arguments.do_count_by_time_aggregation()) {
-                    output_handler = std::make_unique<clp_s::CountByTimeOutputHandler>(
-                            reducer_socket_fd,
-                            command_line_arguments.get_count_by_time_bucket_size()
-                    );
-                } else {
-                    SPDLOG_ERROR("Unhandled aggregation type.");
-                    return false;
-                }
-                break;
-            case CommandLineArguments::OutputHandlerType::ResultsCache:
-                output_handler = std::make_unique<clp_s::ResultsCacheOutputHandler>(
-                        command_line_arguments.get_mongodb_uri(),
-                        command_line_arguments.get_mongodb_collection(),
-                        command_line_arguments.get_batch_size(),
-                        command_line_arguments.get_max_num_results()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Stdout:
-                output_handler = std::make_unique<clp_s::StandardOutputHandler>();
-                break;
-            default:
-                SPDLOG_ERROR("Unhandled OutputHandlerType.");
+    auto output_handler{output_handler_factory()};
+    if (nullptr == output_handler) {
+        return false;
+    }
+
+    // Consult the result cache before decompressing any of the archive's packed streams. Handlers
+    // that aggregate blocks of messages bypass the cache, since caching their results would mean
+    // recording every matching log event.
+    RecordingOutputHandler* recording_output_handler{nullptr};
+    if (nullptr != result_cache && false == output_handler->should_aggregate_batches()) {
+        QueryResultCache::Key const result_cache_key{
+                std::string{archive_reader->get_archive_id()},
+                QueryResultCache::normalize_query(query),
+                command_line_arguments.get_projection_columns(),
+                command_line_arguments.get_search_begin_ts(),
+                command_line_arguments.get_search_end_ts(),
+                command_line_arguments.get_ignore_case(),
+                output_handler->should_output_metadata(),
+                output_handler->should_marshal_records()
+        };
+        switch (result_cache->try_output(result_cache_key, *output_handler)) {
+            case QueryResultCache::OutputResult::Succeeded:
+                return true;
+            case QueryResultCache::OutputResult::Failed:
                 return false;
+            case QueryResultCache::OutputResult::NotCached:
+                break;
         }
-    } catch (std::exception const& e) {
-        SPDLOG_ERROR("Failed to create output handler - {}", e.what());
-        return false;
+
+        auto recording_handler{std::make_unique<RecordingOutputHandler>(
+                *result_cache,
+                result_cache_key,
+                std::move(output_handler)
+        )};
+        recording_output_handler = recording_handler.get();
+        output_handler = std::move(recording_handler);
     }
 
     // output result
@@ -275,13 +415,171 @@ bool search_archive(
             std::move(output_handler),
             command_line_arguments.get_ignore_case()
     );
-    return output.filter();
+    if (false == output.filter()) {
+        return false;
+    }
+
+    if (nullptr != recording_output_handler) {
+        recording_output_handler->commit();
+    }
+    return true;
+}
+
+void SearchThread::thread_method() {
+    OutputHandlerFactory const output_handler_factory = [&]() -> std::unique_ptr<OutputHandler> {
+        return std::make_unique<QueuedOutputHandler>(m_queue, m_output_handler);
+    };
+
+    auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+    try {
+        for (auto const* archive_path{m_archive_queue.try_claim()};
+             nullptr != archive_path && false == m_queue.is_aborted();
+             archive_path = m_archive_queue.try_claim())
+        {
+            try {
+                archive_reader->open(*archive_path, m_command_line_arguments.get_network_auth());
+            } catch (std::exception const& e) {
+                SPDLOG_ERROR("Failed to open archive - {}", e.what());
+                m_succeeded = false;
+                break;
+            }
+            if (false
+                == search_archive(
+                        m_command_line_arguments,
+                        archive_reader,
+                        m_expr->copy(),
+                        output_handler_factory,
+                        m_result_cache
+                ))
+            {
+                m_succeeded = false;
+                break;
+            }
+            archive_reader->close();
+        }
+    } catch (std::exception const& e) {
+        // The queue is only aborted after another thread has already reported a failure.
+        if (false == m_queue.is_aborted()) {
+            SPDLOG_ERROR("Encountered error in search thread - {}", e.what());
+        }
+        m_succeeded = false;
+    }
+
+    if (false == m_succeeded) {
+        m_archive_queue.abort();
+        m_queue.abort();
+    }
+    m_queue.close_producer();
+}
+
+bool search_archives_in_parallel(
+        CommandLineArguments const& command_line_arguments,
+        std::vector<clp_s::Path> const& archive_paths,
+        std::shared_ptr<ast::Expression> const& expr,
+        int reducer_socket_fd,
+        QueryResultCache* result_cache
+) {
+    // Each search thread can have one batch in flight while a few more wait to be output.
+    constexpr size_t cNumQueuedBatchesPerThread{4};
+
+    auto output_handler{create_output_handler(command_line_arguments, reducer_socket_fd)};
+    if (nullptr == output_handler) {
+        return false;
+    }
+
+    auto const num_threads{
+            std::min(command_line_arguments.get_num_search_threads(), archive_paths.size())
+    };
+    SearchResultQueue queue{num_threads * cNumQueuedBatchesPerThread, num_threads};
+    ArchivePathQueue archive_queue{archive_paths};
+    std::vector<std::unique_ptr<SearchThread>> threads;
+    threads.reserve(num_threads);
+    for (size_t i{0}; i < num_threads; ++i) {
+        threads.emplace_back(std::make_unique<SearchThread>(
+                command_line_arguments,
+                archive_queue,
+                expr,
+                queue,
+                *output_handler,
+                result_cache
+        ));
+        threads.back()->start();
+    }
+
+    // When merging the top results, the output handler is only flushed once every archive has been
+    // searched, so that it keeps the latest results across all archives.
+    auto const should_flush_per_table{false == command_line_arguments.get_merge_top_results()};
+    bool succeeded{true};
+    try {
+        while (auto batch{queue.pop()}) {
+            for (auto const& result : batch->results) {
+                if (batch->has_metadata) {
+                    output_handler->write(
+                            result.message,
+                            result.timestamp,
+                            result.archive_id,
+                            result.log_event_idx
+                    );
+                } else {
+                    output_handler->write(result.message);
+                }
+            }
+            if (nullptr != batch->aggregate) {
+                output_handler->merge(*batch->aggregate);
+            }
+            if (batch->ends_table && should_flush_per_table) {
+                if (auto const ecode{output_handler->flush()};
+                    clp_s::ErrorCode::ErrorCodeSuccess != ecode)
+                {
+                    SPDLOG_ERROR(
+                            "Failed to flush output handler, error={}.",
+                            clp::enum_to_underlying_type(ecode)
+                    );
+                    succeeded = false;
+                    break;
+                }
+            }
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to output search results - {}", e.what());
+        succeeded = false;
+    }
+    if (false == succeeded) {
+        archive_queue.abort();
+        queue.abort();
+    }
+
+    for (auto& thread : threads) {
+        thread->join();
+        if (false == thread->succeeded()) {
+            succeeded = false;
+        }
+    }
+    if (false == succeeded) {
+        return false;
+    }
+
+    if (auto const ecode{output_handler->flush()}; clp_s::ErrorCode::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    if (auto const ecode{output_handler->finish()}; clp_s::ErrorCode::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    return true;
 }
 }  // namespace
 
 int main(int argc, char const* argv[]) {
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
@@ -319,6 +617,7 @@ int main(int argc, char const* argv[]) {
         option.output_dir = command_line_arguments.get_output_dir();
         option.ordered = command_line_arguments.get_ordered_decompression();
         option.target_ordered_chunk_size = command_line_arguments.get_target_ordered_chunk_size();
+        option.ordered_memory_budget = command_line_arguments.get_ordered_memory_budget();
         option.print_ordered_chunk_stats = command_line_arguments.print_ordered_chunk_stats();
         option.network_auth = command_line_arguments.get_network_auth();
         if (false == command_line_arguments.get_mongodb_uri().empty()) {
@@ -364,6 +663,29 @@ int main(int argc, char const* argv[]) {
             }
         }
 
+        std::unique_ptr<QueryResultCache> result_cache;
+        if (false == command_line_arguments.get_result_cache_dir().empty()) {
+            try {
+                result_cache = std::make_unique<QueryResultCache>(
+                        command_line_arguments.get_result_cache_dir(),
+                        command_line_arguments.get_result_cache_size()
+                );
+            } catch (std::exception const& e) {
+                SPDLOG_ERROR("Failed to open result cache - {}", e.what());
+                return 1;
+            }
+        }
+
+        // Searching archives in parallel funnels every result to a single output handler, which is
+        // also required to merge the top results across archives.
+        auto const should_search_in_parallel{
+                command_line_arguments.get_num_search_threads() > 1
+                || command_line_arguments.get_merge_top_results()
+        };
+        OutputHandlerFactory const output_handler_factory = [&]() {
+            return create_output_handler(command_line_arguments, reducer_socket_fd);
+        };
+        std::vector<clp_s::Path> archive_paths;
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
         for (auto const& input_path : command_line_arguments.get_input_paths()) {
             if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
@@ -414,6 +736,11 @@ int main(int argc, char const* argv[]) {
                 }
             }
 
+            if (should_search_in_parallel) {
+                archive_paths.emplace_back(input_path);
+                continue;
+            }
+
             try {
                 archive_reader->open(input_path, command_line_arguments.get_network_auth());
             } catch (std::exception const& e) {
@@ -425,13 +752,27 @@ int main(int argc, char const* argv[]) {
                         command_line_arguments,
                         archive_reader,
                         expr->copy(),
-                        reducer_socket_fd
+                        output_handler_factory,
+                        result_cache.get()
                 ))
             {
                 return 1;
             }
             archive_reader->close();
         }
+
+        if (false == archive_paths.empty()
+            && false
+                       == search_archives_in_parallel(
+                               command_line_arguments,
+                               archive_paths,
+                               expr,
+                               reducer_socket_fd,
+                               result_cache.get()
+                       ))
+        {
+            return 1;
+        }
     }
 
     return 0;
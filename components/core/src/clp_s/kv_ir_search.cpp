@@ -15,6 +15,7 @@
 #include <ystdlib/error_handling/Result.hpp>
 
 #include "../clp/ErrorCode.hpp"
+#include "../clp/ffi/ir_stream/ContiguousIrBuffer.hpp"
 #include "../clp/ffi/ir_stream/Deserializer.hpp"
 #include "../clp/ffi/ir_stream/IrUnitType.hpp"
 #include "../clp/ffi/ir_stream/search/QueryHandler.hpp"
@@ -113,7 +114,7 @@ private:
  *   failed. This specific error code is returned instead of propagating the return values of
  *   `clp::ffi::ir_stream::Deserializer::create`, allowing callers to identify cases where the input
  *   might not be a kv-pair IR stream.
- * - Forwards `clp::ffi::ir_stream::Deserializer::deserialize_next_ir_unit`'s return values.
+ * - Forwards `clp::ffi::ir_stream::ContiguousIrBuffer::deserialize_next_ir_unit`'s return values.
  * - Forwards `clp::ffi::ir_stream::search::QueryHandler::create`'s return values.
  * - Forwards `IrUnitHandler::create`'s return values.
  */
@@ -226,8 +227,9 @@ auto deserialize_and_search_kv_ir_stream(
     }
 
     auto& deserializer{deserializer_result.value()};
+    clp::ffi::ir_stream::ContiguousIrBuffer ir_buffer{stream_reader};
     while (IrUnitType::EndOfStream
-           != YSTDLIB_ERROR_HANDLING_TRYX(deserializer.deserialize_next_ir_unit(stream_reader)))
+           != YSTDLIB_ERROR_HANDLING_TRYX(ir_buffer.deserialize_next_ir_unit(deserializer)))
     {}
 
     return ystdlib::error_handling::success();
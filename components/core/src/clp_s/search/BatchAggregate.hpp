@@ -0,0 +1,32 @@
+#ifndef CLP_S_SEARCH_BATCHAGGREGATE_HPP
+#define CLP_S_SEARCH_BATCHAGGREGATE_HPP
+
+#include "MessageBatch.hpp"
+
+namespace clp_s::search {
+/**
+ * An aggregation over the matching messages of blocks of messages. Aggregates of the same kind can
+ * be computed separately (e.g., by different search threads) and then merged.
+ */
+class BatchAggregate {
+public:
+    // Destructor
+    virtual ~BatchAggregate() = default;
+
+    // Methods
+    /**
+     * Adds the matching messages in a block of messages to the aggregate.
+     * @param batch
+     */
+    virtual auto add(MessageBatch const& batch) -> void = 0;
+
+    /**
+     * Merges another aggregate of the same kind into this one.
+     * @param other
+     * @throw std::bad_cast if `other` is of a different kind
+     */
+    virtual auto merge(BatchAggregate const& other) -> void = 0;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_BATCHAGGREGATE_HPP
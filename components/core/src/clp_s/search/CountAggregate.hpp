@@ -0,0 +1,36 @@
+#ifndef CLP_S_SEARCH_COUNTAGGREGATE_HPP
+#define CLP_S_SEARCH_COUNTAGGREGATE_HPP
+
+#include <cstdint>
+
+#include "BatchAggregate.hpp"
+#include "MessageBatch.hpp"
+
+namespace clp_s::search {
+/**
+ * Aggregate that counts log events.
+ */
+class CountAggregate : public BatchAggregate {
+public:
+    // Methods
+    /**
+     * Adds a single log event to the count.
+     */
+    auto increment() -> void { ++m_count; }
+
+    auto add(MessageBatch const& batch) -> void override {
+        m_count += static_cast<int64_t>(batch.num_selected);
+    }
+
+    auto merge(BatchAggregate const& other) -> void override {
+        m_count += dynamic_cast<CountAggregate const&>(other).m_count;
+    }
+
+    [[nodiscard]] auto get_count() const -> int64_t { return m_count; }
+
+private:
+    int64_t m_count{0};
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_COUNTAGGREGATE_HPP
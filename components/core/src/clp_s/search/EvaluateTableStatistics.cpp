@@ -0,0 +1,286 @@
+#include "EvaluateTableStatistics.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../../clp/Defs.h"
+#include "../../clp/Query.hpp"
+#include "../TableStatistics.hpp"
+#include "../Utils.hpp"
+#include "ast/AndExpr.hpp"
+#include "ast/Expression.hpp"
+#include "ast/FilterExpr.hpp"
+#include "ast/FilterOperation.hpp"
+#include "ast/Literal.hpp"
+#include "ast/OrExpr.hpp"
+
+using clp_s::search::ast::AndExpr;
+using clp_s::search::ast::Expression;
+using clp_s::search::ast::FilterExpr;
+using clp_s::search::ast::FilterOperation;
+using clp_s::search::ast::LiteralType;
+using clp_s::search::ast::OrExpr;
+
+namespace clp_s::search {
+namespace {
+/**
+ * Evaluates a comparison against every value in the range [min, max].
+ * @tparam T
+ * @param op
+ * @param operand
+ * @param range
+ * @return EvaluatedValue::True if every value in the range satisfies the comparison,
+ * EvaluatedValue::False if no value does, and EvaluatedValue::Unknown otherwise
+ */
+template <typename T>
+auto evaluate_range(FilterOperation op, T operand, std::pair<T, T> const& range)
+        -> EvaluatedValue {
+    auto const& [min, max] = range;
+    switch (op) {
+        case FilterOperation::EQ:
+            if (operand < min || operand > max) {
+                return EvaluatedValue::False;
+            }
+            return (min == max) ? EvaluatedValue::True : EvaluatedValue::Unknown;
+        case FilterOperation::NEQ:
+            if (operand < min || operand > max) {
+                return EvaluatedValue::True;
+            }
+            return (min == max) ? EvaluatedValue::False : EvaluatedValue::Unknown;
+        case FilterOperation::LT:
+            if (max < operand) {
+                return EvaluatedValue::True;
+            }
+            return (min >= operand) ? EvaluatedValue::False : EvaluatedValue::Unknown;
+        case FilterOperation::LTE:
+            if (max <= operand) {
+                return EvaluatedValue::True;
+            }
+            return (min > operand) ? EvaluatedValue::False : EvaluatedValue::Unknown;
+        case FilterOperation::GT:
+            if (min > operand) {
+                return EvaluatedValue::True;
+            }
+            return (max <= operand) ? EvaluatedValue::False : EvaluatedValue::Unknown;
+        case FilterOperation::GTE:
+            if (min >= operand) {
+                return EvaluatedValue::True;
+            }
+            return (max < operand) ? EvaluatedValue::False : EvaluatedValue::Unknown;
+        default:
+            return EvaluatedValue::Unknown;
+    }
+}
+}  // namespace
+
+auto EvaluateTableStatistics::run(std::shared_ptr<Expression> const& expr) -> EvaluatedValue {
+    if (std::dynamic_pointer_cast<OrExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::True) {
+                return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all false
+        return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+    } else if (std::dynamic_pointer_cast<AndExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::False) {
+                return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all true
+        return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+    } else if (auto filter = std::dynamic_pointer_cast<FilterExpr>(expr)) {
+        auto const ret = evaluate_filter(filter.get());
+        if (ret == EvaluatedValue::True) {
+            return filter->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+        } else if (ret == EvaluatedValue::False) {
+            return filter->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+        }
+        return EvaluatedValue::Unknown;
+    }
+    return EvaluatedValue::Unknown;
+}
+
+auto EvaluateTableStatistics::evaluate_filter(FilterExpr* filter) -> EvaluatedValue {
+    auto const* column = filter->get_column().get();
+    auto const& operand = filter->get_operand();
+    auto const op = filter->get_operation();
+    if (column->is_pure_wildcard() || nullptr == operand || FilterOperation::EXISTS == op
+        || FilterOperation::NEXISTS == op)
+    {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const it = m_statistics.columns.find(column->get_column_id());
+    if (m_statistics.columns.end() == it) {
+        return EvaluatedValue::Unknown;
+    }
+    auto const& statistics = it->second;
+
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+        case LiteralType::EpochDateT: {
+            int64_t value{};
+            if (false == statistics.int_range.has_value() || false == operand->as_int(value, op)) {
+                return EvaluatedValue::Unknown;
+            }
+            return evaluate_range(op, value, statistics.int_range.value());
+        }
+        case LiteralType::FloatT: {
+            double value{};
+            if (false == statistics.float_range.has_value()
+                || false == operand->as_float(value, op))
+            {
+                return EvaluatedValue::Unknown;
+            }
+            return evaluate_range(op, value, statistics.float_range.value());
+        }
+        case LiteralType::BooleanT: {
+            bool value{};
+            if (0 == statistics.num_values || false == operand->as_bool(value, op)) {
+                return EvaluatedValue::Unknown;
+            }
+            if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+                return EvaluatedValue::Unknown;
+            }
+            bool const target = (FilterOperation::EQ == op) == value;
+            auto const num_targets = target ? statistics.num_true
+                                            : statistics.num_values - statistics.num_true;
+            if (0 == num_targets) {
+                return EvaluatedValue::False;
+            }
+            return (statistics.num_values == num_targets) ? EvaluatedValue::True
+                                                          : EvaluatedValue::Unknown;
+        }
+        case LiteralType::ClpStringT:
+            return evaluate_clp_string_filter(filter, statistics);
+        case LiteralType::VarStringT:
+            return evaluate_var_string_filter(filter, statistics);
+        default:
+            return EvaluatedValue::Unknown;
+    }
+}
+
+auto EvaluateTableStatistics::evaluate_clp_string_filter(
+        FilterExpr* filter,
+        ColumnStatistics const& statistics
+) -> EvaluatedValue {
+    if (nullptr == m_clp_string_queries || FilterOperation::EQ != filter->get_operation()) {
+        return EvaluatedValue::Unknown;
+    }
+    bool const has_logtype_ids{statistics.logtype_ids.has_value()};
+    if (false == has_logtype_ids && false == statistics.logtype_id_filter.has_value()
+        && false == statistics.var_id_filter.has_value())
+    {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const it = m_clp_string_queries->find(filter);
+    if (m_clp_string_queries->end() == it || nullptr == it->second) {
+        return EvaluatedValue::Unknown;
+    }
+    auto const* query = it->second;
+    if (query->search_string_matches_all() || false == query->contains_sub_queries()) {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const column_may_contain_logtype = [&](clp::logtype_dictionary_id_t logtype_id) -> bool {
+        if (has_logtype_ids) {
+            return statistics.logtype_ids->contains(logtype_id);
+        }
+        return false == statistics.logtype_id_filter.has_value()
+               || statistics.logtype_id_filter->possibly_contains(logtype_id);
+    };
+    auto const column_may_contain_var = [&](clp::variable_dictionary_id_t var_id) -> bool {
+        return false == statistics.var_id_filter.has_value()
+               || statistics.var_id_filter->possibly_contains(var_id);
+    };
+
+    // A record can only match a subquery if it has one of the subquery's logtypes and contains
+    // every dictionary variable in the subquery
+    for (auto const& subquery : query->get_sub_queries()) {
+        bool may_match_logtype{false};
+        if (has_logtype_ids) {
+            for (auto const logtype_id : statistics.logtype_ids.value()) {
+                if (subquery.matches_logtype(logtype_id)) {
+                    may_match_logtype = true;
+                    break;
+                }
+            }
+        } else {
+            may_match_logtype = std::ranges::any_of(
+                    subquery.get_possible_logtypes(),
+                    column_may_contain_logtype
+            );
+        }
+        if (false == may_match_logtype) {
+            continue;
+        }
+
+        bool const may_match_vars = std::ranges::all_of(
+                subquery.get_vars(),
+                [&](clp::QueryVar const& var) -> bool {
+                    if (false == var.is_dict_var()) {
+                        return true;
+                    }
+                    if (var.is_precise_var()) {
+                        return column_may_contain_var(var.get_var_dict_id());
+                    }
+                    return std::ranges::any_of(
+                            var.get_possible_var_dict_ids(),
+                            column_may_contain_var
+                    );
+                }
+        );
+        if (may_match_vars) {
+            return EvaluatedValue::Unknown;
+        }
+    }
+    return EvaluatedValue::False;
+}
+
+auto EvaluateTableStatistics::evaluate_var_string_filter(
+        FilterExpr* filter,
+        ColumnStatistics const& statistics
+) -> EvaluatedValue {
+    if (nullptr == m_var_string_matches || FilterOperation::EQ != filter->get_operation()
+        || false == statistics.var_id_filter.has_value())
+    {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const it = m_var_string_matches->find(filter);
+    if (m_var_string_matches->end() == it || nullptr == it->second) {
+        return EvaluatedValue::Unknown;
+    }
+
+    // A record can only match if its value is one of the matching dictionary entries
+    for (auto const var_id : *it->second) {
+        if (statistics.var_id_filter->possibly_contains(static_cast<uint64_t>(var_id))) {
+            return EvaluatedValue::Unknown;
+        }
+    }
+    return EvaluatedValue::False;
+}
+}  // namespace clp_s::search
@@ -0,0 +1,89 @@
+#ifndef CLP_S_SEARCH_EVALUATETABLESTATISTICS_HPP
+#define CLP_S_SEARCH_EVALUATETABLESTATISTICS_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../clp/Query.hpp"
+#include "../TableStatistics.hpp"
+#include "../Utils.hpp"
+#include "ast/Expression.hpp"
+#include "ast/FilterExpr.hpp"
+
+namespace clp_s::search {
+/**
+ * This pass attempts to prove the output of an expression for every record in a schema table based
+ * on the per-column statistics recorded for that table, e.g. `status >= 500` can't match a table
+ * whose "status" column has a maximum value of 404.
+ */
+class EvaluateTableStatistics {
+public:
+    // Types
+    using VarStringMatches = std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*>;
+
+    // Constructors
+    /**
+     * @param statistics The statistics of the schema table being evaluated.
+     * @param clp_string_queries Optional map from filters on clp string columns to the queries
+     * used to search those columns. When provided, the logtypes and variables recorded for clp
+     * string columns are checked against each query.
+     * @param var_string_matches Optional map from filters on variable string columns to the IDs of
+     * the variable dictionary entries they match. When provided, the variables recorded for
+     * variable string columns are checked against each filter's matching IDs.
+     */
+    explicit EvaluateTableStatistics(
+            TableStatistics const& statistics,
+            std::unordered_map<ast::Expression*, clp::Query*> const* clp_string_queries = nullptr,
+            VarStringMatches const* var_string_matches = nullptr
+    )
+            : m_statistics{statistics},
+              m_clp_string_queries{clp_string_queries},
+              m_var_string_matches{var_string_matches} {}
+
+    /**
+     * Takes an expression that has been resolved against the table's schema and attempts to prove
+     * its output (true/false/unknown). The expression isn't modified.
+     * @param expr
+     * @return The evaluated value of the expression given the statistics (True, False, Unknown)
+     */
+    auto run(std::shared_ptr<ast::Expression> const& expr) -> EvaluatedValue;
+
+private:
+    /**
+     * Evaluates a filter against the statistics of the column it targets, ignoring inversion.
+     * @param filter
+     * @return The evaluated value of the filter (True, False, Unknown)
+     */
+    auto evaluate_filter(ast::FilterExpr* filter) -> EvaluatedValue;
+
+    /**
+     * Evaluates a filter on a clp string column against the logtypes and variables recorded for
+     * the column, ignoring inversion.
+     * @param filter
+     * @param statistics
+     * @return EvaluatedValue::False if no record in the column can match, EvaluatedValue::Unknown
+     * otherwise
+     */
+    auto evaluate_clp_string_filter(ast::FilterExpr* filter, ColumnStatistics const& statistics)
+            -> EvaluatedValue;
+
+    /**
+     * Evaluates a filter on a variable string column against the variables recorded for the
+     * column, ignoring inversion.
+     * @param filter
+     * @param statistics
+     * @return EvaluatedValue::False if no record in the column can match, EvaluatedValue::Unknown
+     * otherwise
+     */
+    auto evaluate_var_string_filter(ast::FilterExpr* filter, ColumnStatistics const& statistics)
+            -> EvaluatedValue;
+
+    TableStatistics const& m_statistics;
+    std::unordered_map<ast::Expression*, clp::Query*> const* m_clp_string_queries;
+    VarStringMatches const* m_var_string_matches;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_EVALUATETABLESTATISTICS_HPP
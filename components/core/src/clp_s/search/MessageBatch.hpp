@@ -0,0 +1,59 @@
+#ifndef CLP_S_SEARCH_MESSAGEBATCH_HPP
+#define CLP_S_SEARCH_MESSAGEBATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../Defs.hpp"
+
+namespace clp_s::search {
+/**
+ * A contiguous block of messages from a schema table, along with which of them match the query.
+ */
+struct MessageBatch {
+    // The index of the block's first message within its table
+    uint64_t begin_message{0};
+    // One byte per message in the block, non-zero if the message matches the query
+    std::span<uint8_t const> selection;
+    // The number of matching messages in the block
+    size_t num_selected{0};
+    // The timestamp of each message in the block. Empty if no message in the block matches, or if
+    // the table's timestamps weren't extracted (in which case every timestamp is 0).
+    std::span<epochtime_t const> timestamps;
+};
+
+/**
+ * Calls `add_run` once for each run of consecutive messages with equal keys that contains matching
+ * messages. Messages in a table are often clustered by key (e.g., by timestamp), so this lets
+ * aggregations update their (comparatively expensive) group table once per run rather than once
+ * per message.
+ * @tparam KeyType
+ * @tparam AddRunFunc
+ * @param keys The key of each message in the block.
+ * @param selection The selection of each message in the block.
+ * @param add_run Called with a run's key and its number of matching messages.
+ */
+template <typename KeyType, typename AddRunFunc>
+void for_each_selected_run(
+        std::span<KeyType const> keys,
+        std::span<uint8_t const> selection,
+        AddRunFunc add_run
+) {
+    size_t run_begin{0};
+    while (run_begin < keys.size()) {
+        auto const key = keys[run_begin];
+        int64_t num_selected{0};
+        size_t run_end{run_begin};
+        for (; run_end < keys.size() && keys[run_end] == key; ++run_end) {
+            num_selected += static_cast<int64_t>(0 != selection[run_end]);
+        }
+        if (num_selected > 0) {
+            add_run(key, num_selected);
+        }
+        run_begin = run_end;
+    }
+}
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_MESSAGEBATCH_HPP
@@ -15,7 +15,9 @@
 #include "ast/FilterOperation.hpp"
 #include "ast/Literal.hpp"
 #include "ast/OrExpr.hpp"
+#include "EvaluateTableStatistics.hpp"
 #include "EvaluateTimestampIndex.hpp"
+#include "MessageBatch.hpp"
 
 using clp_s::search::ast::AndExpr;
 using clp_s::search::ast::ColumnDescriptor;
@@ -35,7 +37,6 @@ namespace clp_s::search {
 bool Output::filter() {
     std::vector<int32_t> matched_schemas;
     bool has_array = false;
-    bool has_array_search = false;
 
     m_archive_reader->read_metadata();
     for (auto schema_id : m_archive_reader->get_schema_ids()) {
@@ -44,9 +45,6 @@ bool Output::filter() {
             if (m_match->has_array(schema_id)) {
                 has_array = true;
             }
-            if (m_match->has_array_search(schema_id)) {
-                has_array_search = true;
-            }
         }
     }
 
@@ -61,30 +59,46 @@ bool Output::filter() {
     // timestamp column after column resolution.
     EvaluateTimestampIndex timestamp_index(m_archive_reader->get_timestamp_dictionary());
     if (EvaluatedValue::False == timestamp_index.run(m_expr)) {
-        m_archive_reader->close();
         return true;
     }
 
-    m_archive_reader->read_variable_dictionary();
-    m_archive_reader->read_log_type_dictionary();
+    // Skip schema tables whose per-column statistics prove that none of their records can match
+    std::erase_if(matched_schemas, [&](int32_t schema_id) {
+        auto const* statistics = m_archive_reader->get_table_statistics(schema_id);
+        if (nullptr == statistics) {
+            return false;
+        }
+        EvaluateTableStatistics statistics_pass(*statistics);
+        return EvaluatedValue::False
+               == statistics_pass.run(m_match->get_query_for_schema(schema_id));
+    });
+    if (matched_schemas.empty()) {
+        return true;
+    }
+
+    m_archive_reader->read_variable_dictionary()->read_index();
+    m_archive_reader->read_log_type_dictionary()->read_index();
 
     if (has_array) {
-        if (has_array_search) {
-            m_archive_reader->read_array_dictionary();
-        } else {
-            m_archive_reader->read_array_dictionary(true);
-        }
+        m_archive_reader->read_array_dictionary();
     }
 
     m_query_runner.global_init();
+
+    // Skip schema tables that can't match (e.g., after constant propagation or using their column
+    // filters) before prefetching, so that their packed streams aren't decompressed needlessly
+    std::erase_if(matched_schemas, [&](int32_t schema_id) {
+        return EvaluatedValue::False == m_query_runner.schema_init(schema_id);
+    });
+
     m_archive_reader->open_packed_streams();
+    m_archive_reader->prefetch_schema_tables(matched_schemas);
 
     std::string message;
     auto const archive_id = m_archive_reader->get_archive_id();
     for (int32_t schema_id : matched_schemas) {
-        if (EvaluatedValue::False == m_query_runner.schema_init(schema_id)) {
-            continue;
-        }
+        // The pass above left the query runner initialized for the last table
+        m_query_runner.schema_init(schema_id);
 
         auto& reader = m_archive_reader->read_schema_table(
                 schema_id,
@@ -93,7 +107,12 @@ bool Output::filter() {
         );
         reader.initialize_filter(&m_query_runner);
 
-        if (m_output_handler->should_output_metadata()) {
+        if (m_output_handler->should_aggregate_batches()) {
+            MessageBatch batch;
+            while (reader.get_next_message_batch(&m_query_runner, batch)) {
+                m_output_handler->aggregate(batch);
+            }
+        } else if (m_output_handler->should_output_metadata()) {
             epochtime_t timestamp{};
             int64_t log_event_idx{};
             while (reader.get_next_message_with_metadata(
@@ -42,6 +42,7 @@ public:
      * Filters messages within the archive and outputs the filtered messages to the configured
      * OutputHandler.
      *
+     * NOTE: The archive reader is left open; closing it is the caller's responsibility.
      * @return true if the filtering operation completed successfully; false otherwise.
      */
     auto filter() -> bool;
@@ -1,11 +1,14 @@
 #ifndef CLP_S_SEARCH_OUTPUTHANDLER_HPP
 #define CLP_S_SEARCH_OUTPUTHANDLER_HPP
 
+#include <memory>
 #include <string_view>
 #include <vector>
 
 #include "../Defs.hpp"
 #include "../ErrorCode.hpp"
+#include "BatchAggregate.hpp"
+#include "MessageBatch.hpp"
 
 namespace clp_s::search {
 /**
@@ -42,6 +45,39 @@ public:
      */
     virtual void write(std::string_view message) = 0;
 
+    /**
+     * @return Whether the handler only aggregates matching log events, in which case it's given
+     * blocks of messages (via `aggregate`) evaluated directly on the table's columns instead of
+     * one `write` call per matching log event. Such searches bypass the result cache, since it
+     * records and replays individual results. Handlers that return true must also implement
+     * `create_batch_aggregate` and `merge`, so that blocks can be aggregated when searching in
+     * parallel.
+     */
+    [[nodiscard]] virtual auto should_aggregate_batches() const -> bool { return false; }
+
+    /**
+     * Aggregates the matching messages in a block of messages. Only called if
+     * `should_aggregate_batches` returns true.
+     * @param batch
+     */
+    virtual auto aggregate([[maybe_unused]] MessageBatch const& batch) -> void {}
+
+    /**
+     * Creates an empty aggregate of the kind this handler computes in `aggregate`, so that blocks
+     * of messages can be aggregated elsewhere (e.g., on a search thread) and then merged into this
+     * handler using `merge`. May be called concurrently with the handler's other methods.
+     * @return The aggregate, or nullptr if the handler doesn't aggregate batches
+     */
+    [[nodiscard]] virtual auto create_batch_aggregate() const -> std::unique_ptr<BatchAggregate> {
+        return nullptr;
+    }
+
+    /**
+     * Merges an aggregate created by `create_batch_aggregate` into the handler's aggregate.
+     * @param aggregate
+     */
+    virtual auto merge([[maybe_unused]] BatchAggregate const& aggregate) -> void {}
+
     /**
      * Flushes the output handler after each table that gets searched.
      * @return ErrorCodeSuccess on success or relevant error code on error
@@ -0,0 +1,537 @@
+#include "QueryResultCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../../clp/ErrorCode.hpp"
+#include "../../clp/hash_utils.hpp"
+#include "../../clp/type_utils.hpp"
+#include "../Defs.hpp"
+#include "../ErrorCode.hpp"
+#include "../FileWriter.hpp"
+#include "../ZstdCompressor.hpp"
+#include "../ZstdDecompressor.hpp"
+
+namespace clp_s::search {
+namespace {
+constexpr std::string_view cEntryExtension{".result"};
+constexpr std::string_view cTempEntryExtension{".tmp"};
+constexpr uint8_t cEntryFormatVersion{2};
+
+// An entry is its header followed by a sequence of results, each preceded by `cResultMarker`.
+// Results aren't counted up front so that they can be streamed into the entry as they're found.
+constexpr uint8_t cResultMarker{0};
+constexpr uint8_t cEndOfTableMarker{1};
+constexpr uint8_t cEndOfEntryMarker{2};
+
+/**
+ * Appends a length-prefixed string to a serialized key.
+ * @param str
+ * @param serialized_key
+ */
+void append_string(std::string_view str, std::string& serialized_key) {
+    auto const length{static_cast<uint64_t>(str.size())};
+    serialized_key.append(reinterpret_cast<char const*>(&length), sizeof(length));
+    serialized_key.append(str);
+}
+
+/**
+ * Appends an optional timestamp to a serialized key.
+ * @param timestamp
+ * @param serialized_key
+ */
+void append_timestamp(std::optional<epochtime_t> timestamp, std::string& serialized_key) {
+    serialized_key.push_back(timestamp.has_value() ? '\1' : '\0');
+    auto const value{timestamp.value_or(0)};
+    serialized_key.append(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/**
+ * Reads the header of an entry with the given serialized key.
+ * @param decompressor
+ * @param serialized_key
+ * @return Whether the header is valid and belongs to the given key
+ */
+auto read_entry_header(ZstdDecompressor& decompressor, std::string const& serialized_key)
+        -> bool {
+    uint8_t format_version{};
+    if (ErrorCodeSuccess != decompressor.try_read_numeric_value(format_version)
+        || cEntryFormatVersion != format_version)
+    {
+        return false;
+    }
+
+    uint64_t key_length{};
+    std::string entry_key;
+    return ErrorCodeSuccess == decompressor.try_read_numeric_value(key_length)
+           && key_length == serialized_key.size()
+           && ErrorCodeSuccess == decompressor.try_read_string(key_length, entry_key)
+           && entry_key == serialized_key;
+}
+
+/**
+ * Reads the next result or marker of an entry.
+ * @param decompressor
+ * @param has_metadata Whether each result is followed by its timestamp and log event index
+ * @param marker Returns the marker preceding the result, or ending a table or the entry
+ * @param message Returns the result's message
+ * @param timestamp Returns the result's timestamp
+ * @param log_event_idx Returns the result's log event index
+ * @return Whether the result or marker was read successfully
+ */
+auto read_entry_item(
+        ZstdDecompressor& decompressor,
+        bool has_metadata,
+        uint8_t& marker,
+        std::string& message,
+        epochtime_t& timestamp,
+        int64_t& log_event_idx
+) -> bool {
+    if (ErrorCodeSuccess != decompressor.try_read_numeric_value(marker)) {
+        return false;
+    }
+    if (cEndOfTableMarker == marker || cEndOfEntryMarker == marker) {
+        return true;
+    }
+    if (cResultMarker != marker) {
+        return false;
+    }
+
+    uint64_t message_length{};
+    if (ErrorCodeSuccess != decompressor.try_read_numeric_value(message_length)
+        || ErrorCodeSuccess != decompressor.try_read_string(message_length, message))
+    {
+        return false;
+    }
+    return false == has_metadata
+           || (ErrorCodeSuccess == decompressor.try_read_numeric_value(timestamp)
+               && ErrorCodeSuccess == decompressor.try_read_numeric_value(log_event_idx));
+}
+}  // namespace
+
+QueryResultCache::QueryResultCache(std::string const& cache_dir, size_t max_size)
+        : m_cache_dir{cache_dir},
+          m_max_size{max_size} {
+    std::error_code error_code;
+    std::filesystem::create_directories(m_cache_dir, error_code);
+    if (error_code) {
+        SPDLOG_ERROR(
+                "Failed to create result cache directory {} - {}",
+                cache_dir,
+                error_code.message()
+        );
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+
+    std::vector<std::tuple<std::filesystem::file_time_type, size_t, std::filesystem::path>> entries;
+    m_estimated_size = scan_entries(entries);
+}
+
+auto QueryResultCache::normalize_query(std::string_view query) -> std::string {
+    std::string normalized_query;
+    normalized_query.reserve(query.size());
+    bool is_quoted{false};
+    bool is_escaped{false};
+    bool has_pending_space{false};
+    for (auto const c : query) {
+        if (false == is_quoted && 0 != std::isspace(static_cast<unsigned char>(c))) {
+            has_pending_space = false == normalized_query.empty();
+            continue;
+        }
+        if (has_pending_space) {
+            normalized_query.push_back(' ');
+            has_pending_space = false;
+        }
+        normalized_query.push_back(c);
+
+        if (is_escaped) {
+            is_escaped = false;
+        } else if ('\\' == c) {
+            is_escaped = true;
+        } else if ('"' == c) {
+            is_quoted = false == is_quoted;
+        }
+    }
+    return normalized_query;
+}
+
+auto QueryResultCache::try_output(Key const& key, OutputHandler& output_handler)
+        -> OutputResult {
+    auto const serialized_key{serialize_key(key)};
+    auto const entry_path{get_entry_path(serialized_key)};
+    if (false == entry_path.has_value()) {
+        return OutputResult::NotCached;
+    }
+
+    std::error_code error_code;
+    if (false == std::filesystem::exists(entry_path.value(), error_code)) {
+        return OutputResult::NotCached;
+    }
+
+    ZstdDecompressor decompressor;
+    try {
+        if (ErrorCodeSuccess != decompressor.open(entry_path->string())) {
+            return OutputResult::NotCached;
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to read result cache entry {} - {}", entry_path->string(), e.what());
+        return OutputResult::NotCached;
+    }
+    if (false == read_entry_header(decompressor, serialized_key)) {
+        // Hash collisions are astronomically unlikely, so the entry is most likely corrupt.
+        SPDLOG_WARN("Ignoring invalid result cache entry {}", entry_path->string());
+        decompressor.close();
+        return OutputResult::NotCached;
+    }
+
+    // Mark the entry as the most recently used. The entry may have been evicted concurrently, in
+    // which case there's nothing to mark.
+    std::filesystem::last_write_time(
+            entry_path.value(),
+            std::filesystem::file_time_type::clock::now(),
+            error_code
+    );
+
+    // Stream the results to the output handler, reusing the message's buffer across results
+    bool has_output_results{false};
+    uint8_t marker{};
+    std::string message;
+    epochtime_t timestamp{};
+    int64_t log_event_idx{};
+    while (read_entry_item(
+            decompressor,
+            key.should_output_metadata,
+            marker,
+            message,
+            timestamp,
+            log_event_idx
+    ))
+    {
+        if (cEndOfEntryMarker == marker) {
+            decompressor.close();
+            if (auto const ecode{output_handler.finish()}; ErrorCodeSuccess != ecode) {
+                SPDLOG_ERROR(
+                        "Failed to flush output handler, error={}.",
+                        clp::enum_to_underlying_type(ecode)
+                );
+                return OutputResult::Failed;
+            }
+            return OutputResult::Succeeded;
+        }
+
+        has_output_results = true;
+        if (cEndOfTableMarker == marker) {
+            if (auto const ecode{output_handler.flush()}; ErrorCodeSuccess != ecode) {
+                decompressor.close();
+                SPDLOG_ERROR(
+                        "Failed to flush output handler, error={}.",
+                        clp::enum_to_underlying_type(ecode)
+                );
+                return OutputResult::Failed;
+            }
+        } else if (output_handler.should_output_metadata()) {
+            output_handler.write(message, timestamp, key.archive_id, log_event_idx);
+        } else {
+            output_handler.write(message);
+        }
+    }
+    decompressor.close();
+
+    if (false == has_output_results) {
+        SPDLOG_WARN("Ignoring invalid result cache entry {}", entry_path->string());
+        return OutputResult::NotCached;
+    }
+    // Remove the entry so that the next search recreates it rather than failing again
+    SPDLOG_ERROR("Result cache entry {} is corrupt", entry_path->string());
+    std::filesystem::remove(entry_path.value(), error_code);
+    return OutputResult::Failed;
+}
+
+auto QueryResultCache::serialize_key(Key const& key) -> std::string {
+    std::string serialized_key;
+    append_string(key.archive_id, serialized_key);
+    append_string(key.query, serialized_key);
+    auto const num_projection_columns{static_cast<uint64_t>(key.projection_columns.size())};
+    serialized_key.append(
+            reinterpret_cast<char const*>(&num_projection_columns),
+            sizeof(num_projection_columns)
+    );
+    for (auto const& column : key.projection_columns) {
+        append_string(column, serialized_key);
+    }
+    append_timestamp(key.search_begin_ts, serialized_key);
+    append_timestamp(key.search_end_ts, serialized_key);
+    serialized_key.push_back(key.ignore_case ? '\1' : '\0');
+    serialized_key.push_back(key.should_output_metadata ? '\1' : '\0');
+    serialized_key.push_back(key.should_marshal_records ? '\1' : '\0');
+    return serialized_key;
+}
+
+auto QueryResultCache::get_entry_path(std::string const& serialized_key) const
+        -> std::optional<std::filesystem::path> {
+    std::vector<unsigned char> hash;
+    try {
+        if (clp::ErrorCode_Success
+            != clp::get_sha256_hash(
+                    {reinterpret_cast<unsigned char const*>(serialized_key.data()),
+                     serialized_key.size()},
+                    hash
+            ))
+        {
+            SPDLOG_WARN("Failed to hash result cache key");
+            return std::nullopt;
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to hash result cache key - {}", e.what());
+        return std::nullopt;
+    }
+    return m_cache_dir / (clp::convert_to_hex_string(hash) + std::string{cEntryExtension});
+}
+
+void QueryResultCache::insert(
+        std::filesystem::path const& temp_entry_path,
+        std::filesystem::path const& entry_path,
+        size_t entry_size
+) {
+    std::error_code error_code;
+    std::filesystem::rename(temp_entry_path, entry_path, error_code);
+    if (error_code) {
+        SPDLOG_WARN(
+                "Failed to insert result cache entry {} - {}",
+                entry_path.string(),
+                error_code.message()
+        );
+        std::filesystem::remove(temp_entry_path, error_code);
+        return;
+    }
+
+    std::lock_guard<std::mutex> const lock{m_mutex};
+    // Replacing an existing entry overestimates the total size, which at worst causes an earlier
+    // scan.
+    m_estimated_size += entry_size;
+    if (m_estimated_size > m_max_size) {
+        evict();
+    }
+}
+
+auto QueryResultCache::scan_entries(
+        std::vector<std::tuple<std::filesystem::file_time_type, size_t, std::filesystem::path>>&
+                entries
+) const -> size_t {
+    // Entries may be inserted or evicted concurrently by other processes, so errors are ignored and
+    // the total size is only an estimate.
+    size_t total_size{0};
+    std::error_code error_code;
+    for (std::filesystem::directory_iterator it{m_cache_dir, error_code}, end;
+         false == static_cast<bool>(error_code) && it != end;
+         it.increment(error_code))
+    {
+        auto const& path{it->path()};
+        if (cEntryExtension != path.extension().string()) {
+            continue;
+        }
+        auto const size{it->file_size(error_code)};
+        if (error_code) {
+            error_code.clear();
+            continue;
+        }
+        auto const last_write_time{it->last_write_time(error_code)};
+        if (error_code) {
+            error_code.clear();
+            continue;
+        }
+        entries.emplace_back(last_write_time, size, path);
+        total_size += size;
+    }
+    return total_size;
+}
+
+void QueryResultCache::evict() {
+    std::vector<std::tuple<std::filesystem::file_time_type, size_t, std::filesystem::path>> entries;
+    m_estimated_size = scan_entries(entries);
+    if (m_estimated_size <= m_max_size) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end());
+    std::error_code error_code;
+    for (auto const& [last_write_time, size, path] : entries) {
+        if (m_estimated_size <= m_max_size) {
+            break;
+        }
+        std::filesystem::remove(path, error_code);
+        m_estimated_size -= size;
+    }
+}
+
+RecordingOutputHandler::RecordingOutputHandler(
+        QueryResultCache& cache,
+        QueryResultCache::Key const& key,
+        std::unique_ptr<OutputHandler> output_handler
+)
+        : OutputHandler(
+                  output_handler->should_output_metadata(),
+                  output_handler->should_marshal_records()
+          ),
+          m_cache{cache},
+          m_output_handler{std::move(output_handler)} {
+    static std::atomic_size_t next_temp_entry_idx{0};
+
+    auto const serialized_key{QueryResultCache::serialize_key(key)};
+    auto entry_path{m_cache.get_entry_path(serialized_key)};
+    if (false == entry_path.has_value()) {
+        return;
+    }
+    m_entry_path = std::move(entry_path.value());
+
+    // Name the temporary entry uniquely across the threads and processes sharing the cache
+    m_temp_entry_path = m_entry_path;
+    m_temp_entry_path += "." + std::to_string(::getpid()) + "."
+                         + std::to_string(next_temp_entry_idx.fetch_add(1, std::memory_order_relaxed))
+                         + std::string{cTempEntryExtension};
+    try {
+        m_file_writer.open(m_temp_entry_path.string(), FileWriter::OpenMode::CreateForWriting);
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to create result cache entry {} - {}", m_entry_path.string(), e.what());
+        return;
+    }
+    m_is_recording = true;
+    try {
+        m_compressor.open(m_file_writer);
+        m_compressor.write_numeric_value(cEntryFormatVersion);
+        m_compressor.write_numeric_value(static_cast<uint64_t>(serialized_key.size()));
+        m_compressor.write_string(serialized_key);
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to write result cache entry {} - {}", m_entry_path.string(), e.what());
+        discard();
+    }
+}
+
+RecordingOutputHandler::~RecordingOutputHandler() {
+    discard();
+}
+
+void RecordingOutputHandler::write(
+        std::string_view message,
+        epochtime_t timestamp,
+        std::string_view archive_id,
+        int64_t log_event_idx
+) {
+    m_output_handler->write(message, timestamp, archive_id, log_event_idx);
+    record(message, timestamp, log_event_idx);
+}
+
+void RecordingOutputHandler::write(std::string_view message) {
+    m_output_handler->write(message);
+    record(message, 0, 0);
+}
+
+auto RecordingOutputHandler::flush() -> ErrorCode {
+    record_marker(cEndOfTableMarker);
+    return m_output_handler->flush();
+}
+
+auto RecordingOutputHandler::finish() -> ErrorCode {
+    return m_output_handler->finish();
+}
+
+void RecordingOutputHandler::commit() {
+    record_marker(cEndOfEntryMarker);
+    if (false == m_is_recording) {
+        return;
+    }
+
+    size_t entry_size{};
+    try {
+        m_compressor.close();
+        entry_size = m_file_writer.get_pos();
+        m_file_writer.close();
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to write result cache entry {} - {}", m_entry_path.string(), e.what());
+        discard();
+        return;
+    }
+    m_is_recording = false;
+    if (entry_size > m_cache.get_max_size()) {
+        std::error_code error_code;
+        std::filesystem::remove(m_temp_entry_path, error_code);
+        return;
+    }
+    m_cache.insert(m_temp_entry_path, m_entry_path, entry_size);
+}
+
+void RecordingOutputHandler::record(
+        std::string_view message,
+        epochtime_t timestamp,
+        int64_t log_event_idx
+) {
+    if (false == m_is_recording) {
+        return;
+    }
+    try {
+        m_compressor.write_numeric_value(cResultMarker);
+        m_compressor.write_numeric_value(static_cast<uint64_t>(message.size()));
+        m_compressor.write(message.data(), message.size());
+        if (should_output_metadata()) {
+            m_compressor.write_numeric_value(timestamp);
+            m_compressor.write_numeric_value(log_event_idx);
+        }
+        // The compressor buffers less than a block, so the file's size is a close lower bound on
+        // the entry's size.
+        if (m_file_writer.get_pos() > m_cache.get_max_size()) {
+            discard();
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to write result cache entry {} - {}", m_entry_path.string(), e.what());
+        discard();
+    }
+}
+
+void RecordingOutputHandler::record_marker(uint8_t marker) {
+    if (false == m_is_recording) {
+        return;
+    }
+    try {
+        m_compressor.write_numeric_value(marker);
+    } catch (std::exception const& e) {
+        SPDLOG_WARN("Failed to write result cache entry {} - {}", m_entry_path.string(), e.what());
+        discard();
+    }
+}
+
+void RecordingOutputHandler::discard() {
+    if (false == m_is_recording) {
+        return;
+    }
+    m_is_recording = false;
+
+    // The entry is being thrown away, so failing to finish writing it doesn't matter.
+    try {
+        m_compressor.close();
+    } catch (std::exception const&) {}
+    try {
+        m_file_writer.close();
+    } catch (std::exception const&) {}
+    std::error_code error_code;
+    std::filesystem::remove(m_temp_entry_path, error_code);
+}
+}  // namespace clp_s::search
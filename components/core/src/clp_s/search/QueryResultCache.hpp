@@ -0,0 +1,263 @@
+#ifndef CLP_S_SEARCH_QUERYRESULTCACHE_HPP
+#define CLP_S_SEARCH_QUERYRESULTCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "../Defs.hpp"
+#include "../ErrorCode.hpp"
+#include "../FileWriter.hpp"
+#include "../TraceableException.hpp"
+#include "../ZstdCompressor.hpp"
+#include "OutputHandler.hpp"
+
+namespace clp_s::search {
+/**
+ * A local on-disk cache of the results of searching an archive, so that repeating a search (e.g.,
+ * from a dashboard that refreshes periodically) can skip decompressing the archive's packed
+ * streams.
+ *
+ * Each entry is a zstd-compressed file named after the SHA256 hash of its key, and contains the
+ * full key so that hash collisions are detected rather than returning another query's results.
+ * Entries are streamed to a temporary file by `RecordingOutputHandler` and then renamed, so that
+ * concurrent readers (threads or processes) never see a partially written entry. Entries are also
+ * streamed back to an output handler when read, so neither direction holds an entry's results in
+ * memory.
+ *
+ * The total size of the entries is bounded by evicting the least recently used entries, where an
+ * entry's last write time is refreshed each time it's read. The cache directory is only scanned
+ * when this process's estimate of the total size exceeds the maximum, since other processes may
+ * insert or evict entries concurrently.
+ *
+ * The cache is best effort: failing to read or write an entry is logged and treated as a miss.
+ */
+class QueryResultCache {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    /**
+     * Everything that determines the results an output handler receives when searching an
+     * archive.
+     */
+    struct Key {
+        std::string archive_id;
+        // The query, normalized with `normalize_query`
+        std::string query;
+        std::vector<std::string> projection_columns;
+        std::optional<epochtime_t> search_begin_ts;
+        std::optional<epochtime_t> search_end_ts;
+        bool ignore_case{false};
+        bool should_output_metadata{false};
+        bool should_marshal_records{false};
+    };
+
+    enum class OutputResult : uint8_t {
+        NotCached,
+        Succeeded,
+        Failed
+    };
+
+    // Constructors
+    /**
+     * @param cache_dir Directory containing the cache's entries, created if it doesn't exist
+     * @param max_size Maximum total size of the cache's entries, in bytes
+     * @throw OperationFailed if the cache directory couldn't be created
+     */
+    QueryResultCache(std::string const& cache_dir, size_t max_size);
+
+    // Methods
+    /**
+     * Normalizes a query's text so that queries differing only in unquoted whitespace share the
+     * same cache entries.
+     * @param query
+     * @return The query with leading and trailing whitespace removed and each run of unquoted
+     * whitespace replaced with a single space
+     */
+    [[nodiscard]] static auto normalize_query(std::string_view query) -> std::string;
+
+    [[nodiscard]] auto get_max_size() const -> size_t { return m_max_size; }
+
+    /**
+     * Outputs the cached results for the given key, flushing the output handler after each table
+     * as `Output` does, and marks the entry as the most recently used.
+     *
+     * An entry that turns out to be corrupt after some of its results were output can't be
+     * treated as a miss, so it's removed and the output fails instead.
+     * @param key
+     * @param output_handler
+     * @return OutputResult::NotCached if the results aren't cached, or if the entry is invalid
+     * before any result was output
+     * @return OutputResult::Succeeded if the results were output and the output handler finished
+     * @return OutputResult::Failed otherwise
+     */
+    [[nodiscard]] auto try_output(Key const& key, OutputHandler& output_handler) -> OutputResult;
+
+private:
+    friend class RecordingOutputHandler;
+
+    // Methods
+    /**
+     * @param key
+     * @return `key` serialized into a byte string that's unique to its contents
+     */
+    [[nodiscard]] static auto serialize_key(Key const& key) -> std::string;
+
+    /**
+     * @param serialized_key
+     * @return The path of the entry for the given key, or std::nullopt if it couldn't be computed
+     */
+    [[nodiscard]] auto get_entry_path(std::string const& serialized_key) const
+            -> std::optional<std::filesystem::path>;
+
+    /**
+     * Renames a completely written temporary entry into place, evicting the least recently used
+     * entries if the cache's estimated size exceeds its maximum size.
+     * @param temp_entry_path
+     * @param entry_path
+     * @param entry_size
+     */
+    void insert(
+            std::filesystem::path const& temp_entry_path,
+            std::filesystem::path const& entry_path,
+            size_t entry_size
+    );
+
+    /**
+     * Scans the cache directory for the cache's total size.
+     * @param entries Returns the last write time, size, and path of each entry
+     * @return The total size of the entries
+     */
+    [[nodiscard]] auto scan_entries(
+            std::vector<std::tuple<std::filesystem::file_time_type, size_t, std::filesystem::path>>&
+                    entries
+    ) const -> size_t;
+
+    /**
+     * Removes the least recently used entries until the cache's total size is at most
+     * `m_max_size`, resynchronizing the estimated size with the cache directory.
+     */
+    void evict();
+
+    // Variables
+    std::filesystem::path m_cache_dir;
+    size_t m_max_size;
+    // Guards `m_estimated_size` and serializes this process's evictions
+    std::mutex m_mutex;
+    // The total size of the entries, as of the last scan plus the entries inserted since
+    size_t m_estimated_size{0};
+};
+
+/**
+ * Output handler that forwards results to another output handler while streaming them into a
+ * temporary `QueryResultCache` entry. Each flush marks the end of a table. Once the search
+ * completes, `commit` inserts the entry into the cache; otherwise, the temporary entry is removed
+ * when the handler is destroyed.
+ *
+ * Recording stops if the entry exceeds the cache's maximum size, since it could never fit in the
+ * cache.
+ */
+class RecordingOutputHandler : public OutputHandler {
+public:
+    // Constructors
+    /**
+     * @param cache
+     * @param key
+     * @param output_handler
+     */
+    RecordingOutputHandler(
+            QueryResultCache& cache,
+            QueryResultCache::Key const& key,
+            std::unique_ptr<OutputHandler> output_handler
+    );
+
+    // Delete copy & move constructors and assignment operators
+    RecordingOutputHandler(RecordingOutputHandler const&) = delete;
+    RecordingOutputHandler(RecordingOutputHandler&&) = delete;
+    auto operator=(RecordingOutputHandler const&) -> RecordingOutputHandler& = delete;
+    auto operator=(RecordingOutputHandler&&) -> RecordingOutputHandler& = delete;
+
+    // Destructor
+    ~RecordingOutputHandler() override;
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override;
+
+    void write(std::string_view message) override;
+
+    /**
+     * Flushes the underlying output handler, ending the current table.
+     * @return Same as the underlying output handler's `flush`
+     */
+    [[nodiscard]] auto flush() -> ErrorCode override;
+
+    /**
+     * @return Same as the underlying output handler's `finish`
+     */
+    [[nodiscard]] auto finish() -> ErrorCode override;
+
+    // Methods
+    /**
+     * @return Whether the results stopped being recorded, either because they exceeded the
+     * cache's maximum size or because the entry couldn't be written
+     */
+    [[nodiscard]] auto has_overflowed() const -> bool { return false == m_is_recording; }
+
+    /**
+     * Ends the entry and inserts it into the cache, unless recording stopped. Should only be
+     * called once all of the search's results were output successfully.
+     */
+    void commit();
+
+private:
+    // Methods
+    /**
+     * Streams a result into the temporary entry, and stops recording if that fails or the entry
+     * exceeds the cache's maximum size.
+     * @param message
+     * @param timestamp
+     * @param log_event_idx
+     */
+    void record(std::string_view message, epochtime_t timestamp, int64_t log_event_idx);
+
+    /**
+     * Streams the marker ending the current table or the entry into the temporary entry.
+     * @param marker
+     */
+    void record_marker(uint8_t marker);
+
+    /**
+     * Stops recording, closing and removing the temporary entry.
+     */
+    void discard();
+
+    // Variables
+    QueryResultCache& m_cache;
+    std::unique_ptr<OutputHandler> m_output_handler;
+    bool m_is_recording{false};
+    std::filesystem::path m_entry_path;
+    std::filesystem::path m_temp_entry_path;
+    FileWriter m_file_writer;
+    ZstdCompressor m_compressor;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_QUERYRESULTCACHE_HPP
@@ -1,6 +1,11 @@
 #include "QueryRunner.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include <log_surgeon/Lexer.hpp>
@@ -20,6 +25,7 @@
 #include "ast/Literal.hpp"
 #include "ast/OrExpr.hpp"
 #include "ast/SearchUtils.hpp"
+#include "EvaluateTableStatistics.hpp"
 #include "EvaluateTimestampIndex.hpp"
 
 using clp_s::search::ast::AndExpr;
@@ -37,6 +43,69 @@ using clp_s::search::ast::OrExpr;
 #define eval(op, a, b) (((op) == FilterOperation::EQ) ? ((a) == (b)) : ((a) != (b)))
 
 namespace clp_s::search {
+namespace {
+/**
+ * Compares every value in a block against an operand and ORs the result into a selection vector.
+ *
+ * NOTE: GCC only vectorizes this loop for 64-bit values when 64-bit vector comparisons are
+ * available (SSE4.2 on x86-64). For the default x86-64 target it stays a branch-free scalar loop.
+ * @tparam T
+ * @tparam Compare
+ * @param values
+ * @param num_values
+ * @param operand
+ * @param selection
+ */
+template <typename T, typename Compare>
+void compare_block(T const* values, size_t num_values, T operand, uint8_t* selection) {
+    Compare const compare{};
+    for (size_t i = 0; i < num_values; ++i) {
+        selection[i] |= static_cast<uint8_t>(compare(values[i], operand));
+    }
+}
+
+/**
+ * Dispatches `compare_block` on a filter operation.
+ * @tparam T
+ * @param op
+ * @param values
+ * @param num_values
+ * @param operand
+ * @param selection
+ */
+template <typename T>
+void compare_block(
+        FilterOperation op,
+        T const* values,
+        size_t num_values,
+        T operand,
+        uint8_t* selection
+) {
+    switch (op) {
+        case FilterOperation::EQ:
+            compare_block<T, std::equal_to<T>>(values, num_values, operand, selection);
+            break;
+        case FilterOperation::NEQ:
+            compare_block<T, std::not_equal_to<T>>(values, num_values, operand, selection);
+            break;
+        case FilterOperation::LT:
+            compare_block<T, std::less<T>>(values, num_values, operand, selection);
+            break;
+        case FilterOperation::GT:
+            compare_block<T, std::greater<T>>(values, num_values, operand, selection);
+            break;
+        case FilterOperation::LTE:
+            compare_block<T, std::less_equal<T>>(values, num_values, operand, selection);
+            break;
+        case FilterOperation::GTE:
+            compare_block<T, std::greater_equal<T>>(values, num_values, operand, selection);
+            break;
+        default:
+            break;
+    }
+}
+}  // namespace
+
 void QueryRunner::global_init() {
     populate_internal_columns();
     populate_string_queries(m_expr);
@@ -56,6 +125,21 @@ auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
         return m_expression_value;
     }
 
+    if (auto const* statistics = m_archive_reader->get_table_statistics(schema_id);
+        nullptr != statistics && m_expression_value != EvaluatedValue::True)
+    {
+        EvaluateTableStatistics
+                statistics_pass(*statistics, &m_expr_clp_query, &m_expr_var_match_map);
+        auto const value = statistics_pass.run(m_expr);
+        if (EvaluatedValue::False == value) {
+            m_expression_value = EvaluatedValue::False;
+            return m_expression_value;
+        }
+        if (EvaluatedValue::True == value) {
+            m_expression_value = EvaluatedValue::True;
+        }
+    }
+
     add_wildcard_columns_to_searched_columns();
     return m_expression_value;
 }
@@ -98,6 +182,9 @@ void QueryRunner::init(SchemaReader* reader, std::vector<BaseColumnReader*> cons
         auto column_id = column_reader->get_id();
         initialize_reader(column_id, column_reader);
     }
+
+    m_batch_filtering_supported = EvaluatedValue::True == m_expression_value
+                                  || can_evaluate_batch(m_expr.get());
 }
 
 std::string& QueryRunner::get_cached_decompressed_unstructured_array(int32_t column_id) {
@@ -121,6 +208,14 @@ bool QueryRunner::filter(uint64_t cur_message) {
     return evaluate(m_expr.get(), m_schema);
 }
 
+void QueryRunner::filter_batch(uint64_t begin_message, size_t num_messages, uint8_t* selection) {
+    if (EvaluatedValue::True == m_expression_value) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+    evaluate_batch(m_expr.get(), begin_message, num_messages, selection, 0);
+}
+
 bool QueryRunner::evaluate(Expression* expr, int32_t schema) {
     if (m_expression_value == EvaluatedValue::True) {
         return true;
@@ -321,6 +416,328 @@ bool QueryRunner::evaluate_filter(FilterExpr* expr, int32_t schema) {
     }
 }
 
+auto QueryRunner::can_evaluate_batch(Expression* expr) -> bool {
+    if (auto* filter = dynamic_cast<FilterExpr*>(expr)) {
+        return can_evaluate_filter_batch(filter);
+    }
+
+    for (auto it = expr->op_begin(); it != expr->op_end(); ++it) {
+        if (false == can_evaluate_batch(static_cast<Expression*>(it->get()))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto QueryRunner::can_evaluate_filter_batch(FilterExpr* expr) -> bool {
+    auto* column = expr->get_column().get();
+    if (column->is_pure_wildcard()) {
+        return false;
+    }
+
+    int32_t column_id = column->get_column_id();
+    auto basic_readers_have_types = [&](NodeType first_type, NodeType second_type) -> bool {
+        return std::ranges::all_of(m_basic_readers[column_id], [&](BaseColumnReader* reader) {
+            return first_type == reader->get_type() || second_type == reader->get_type();
+        });
+    };
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+            return basic_readers_have_types(NodeType::Integer, NodeType::DeltaInteger);
+        case LiteralType::FloatT:
+            return basic_readers_have_types(NodeType::Float, NodeType::FormattedFloat);
+        case LiteralType::BooleanT:
+            return basic_readers_have_types(NodeType::Boolean, NodeType::Boolean);
+        case LiteralType::VarStringT:
+            return true;
+        case LiteralType::EpochDateT:
+            return m_datestring_readers.contains(column_id);
+        default:
+            return false;
+    }
+}
+
+void QueryRunner::evaluate_batch(
+        Expression* expr,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection,
+        size_t depth
+) {
+    if (auto* filter = dynamic_cast<FilterExpr*>(expr)) {
+        std::fill_n(selection, num_messages, 0);
+        evaluate_filter_batch(filter, begin_message, num_messages, selection);
+    } else {
+        // The AST has been simplified so that every non-filter expression is either an AND-expr or
+        // an OR-expr
+        bool const is_and = nullptr != dynamic_cast<AndExpr*>(expr);
+        std::fill_n(selection, num_messages, is_and ? 1 : 0);
+
+        // A deque never invalidates references to existing elements when it grows, so the child
+        // selection stays valid while deeper levels allocate their own scratch space.
+        if (m_batch_selections.size() <= depth) {
+            m_batch_selections.resize(depth + 1);
+        }
+        auto& child_selection = m_batch_selections[depth];
+        child_selection.resize(num_messages);
+
+        for (auto it = expr->op_begin(); it != expr->op_end(); ++it) {
+            evaluate_batch(
+                    static_cast<Expression*>(it->get()),
+                    begin_message,
+                    num_messages,
+                    child_selection.data(),
+                    depth + 1
+            );
+
+            // The child's data pointer is hoisted out of the loops since GCC can't vectorize them
+            // if it must assume that stores through `selection` alias the vector's internals. The
+            // early-exit checks reduce into a byte so the loops don't widen each selection byte.
+            auto const* child = child_selection.data();
+            if (is_and) {
+                uint8_t any_selected{0};
+                for (size_t i = 0; i < num_messages; ++i) {
+                    selection[i] &= child[i];
+                    any_selected |= selection[i];
+                }
+                if (0 == any_selected) {
+                    break;
+                }
+            } else {
+                uint8_t all_selected{1};
+                for (size_t i = 0; i < num_messages; ++i) {
+                    selection[i] |= child[i];
+                    all_selected &= selection[i];
+                }
+                if (1 == all_selected) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (expr->is_inverted()) {
+        for (size_t i = 0; i < num_messages; ++i) {
+            selection[i] ^= 1;
+        }
+    }
+}
+
+void QueryRunner::evaluate_filter_batch(
+        FilterExpr* expr,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    auto* column = expr->get_column().get();
+    int32_t column_id = column->get_column_id();
+    auto literal = expr->get_operand();
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+            evaluate_int_filter_batch(
+                    expr->get_operation(),
+                    column_id,
+                    literal,
+                    begin_message,
+                    num_messages,
+                    selection
+            );
+            break;
+        case LiteralType::FloatT:
+            evaluate_float_filter_batch(
+                    expr->get_operation(),
+                    column_id,
+                    literal,
+                    begin_message,
+                    num_messages,
+                    selection
+            );
+            break;
+        case LiteralType::BooleanT:
+            evaluate_bool_filter_batch(
+                    expr->get_operation(),
+                    column_id,
+                    literal,
+                    begin_message,
+                    num_messages,
+                    selection
+            );
+            break;
+        case LiteralType::VarStringT:
+            evaluate_var_string_filter_batch(
+                    expr->get_operation(),
+                    m_var_string_readers[column_id],
+                    m_expr_var_match_map.at(expr),
+                    begin_message,
+                    num_messages,
+                    selection
+            );
+            break;
+        case LiteralType::EpochDateT:
+            evaluate_epoch_date_filter_batch(
+                    expr->get_operation(),
+                    m_datestring_readers.at(column_id),
+                    literal,
+                    begin_message,
+                    num_messages,
+                    selection
+            );
+            break;
+        default:
+            break;
+    }
+}
+
+void QueryRunner::evaluate_int_filter_batch(
+        FilterOperation op,
+        int32_t column_id,
+        std::shared_ptr<Literal> const& operand,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+
+    int64_t op_value;
+    if (false == operand->as_int(op_value, op)) {
+        return;
+    }
+
+    m_batch_int_values.resize(num_messages);
+    for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+        if (NodeType::DeltaInteger == reader->get_type()) {
+            static_cast<DeltaEncodedInt64ColumnReader*>(reader)
+                    ->extract_values(begin_message, num_messages, m_batch_int_values.data());
+        } else {
+            static_cast<Int64ColumnReader*>(reader)->get_values().copy_to(
+                    begin_message,
+                    num_messages,
+                    m_batch_int_values.data()
+            );
+        }
+        compare_block(op, m_batch_int_values.data(), num_messages, op_value, selection);
+    }
+}
+
+void QueryRunner::evaluate_float_filter_batch(
+        FilterOperation op,
+        int32_t column_id,
+        std::shared_ptr<Literal> const& operand,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+
+    double op_value;
+    if (false == operand->as_float(op_value, op)) {
+        return;
+    }
+
+    m_batch_float_values.resize(num_messages);
+    for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+        auto const values = NodeType::FormattedFloat == reader->get_type()
+                                    ? static_cast<FormattedFloatColumnReader*>(reader)->get_values()
+                                    : static_cast<FloatColumnReader*>(reader)->get_values();
+        values.copy_to(begin_message, num_messages, m_batch_float_values.data());
+        compare_block(op, m_batch_float_values.data(), num_messages, op_value, selection);
+    }
+}
+
+void QueryRunner::evaluate_bool_filter_batch(
+        FilterOperation op,
+        int32_t column_id,
+        std::shared_ptr<Literal> const& operand,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+
+    bool op_value;
+    if (false == operand->as_bool(op_value, op)) {
+        return;
+    }
+    if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+        return;
+    }
+
+    uint8_t const matching_value = (FilterOperation::EQ == op) == op_value ? 1 : 0;
+    m_batch_bool_values.resize(num_messages);
+    for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+        static_cast<BooleanColumnReader*>(reader)->get_values().copy_to(
+                begin_message,
+                num_messages,
+                m_batch_bool_values.data()
+        );
+        for (size_t i = 0; i < num_messages; ++i) {
+            auto const value = static_cast<uint8_t>(0 != m_batch_bool_values[i]);
+            selection[i] |= static_cast<uint8_t>(value == matching_value);
+        }
+    }
+}
+
+void QueryRunner::evaluate_var_string_filter_batch(
+        FilterOperation op,
+        std::vector<VariableStringColumnReader*> const& readers,
+        std::unordered_set<int64_t> const* matching_vars,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+
+    if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+        return;
+    }
+
+    bool const is_eq = FilterOperation::EQ == op;
+    m_batch_var_ids.resize(num_messages);
+    for (VariableStringColumnReader* reader : readers) {
+        reader->get_variable_ids().copy_to(begin_message, num_messages, m_batch_var_ids.data());
+        for (size_t i = 0; i < num_messages; ++i) {
+            bool const matched
+                    = matching_vars->contains(static_cast<int64_t>(m_batch_var_ids[i]));
+            selection[i] |= static_cast<uint8_t>(is_eq == matched);
+        }
+    }
+}
+
+void QueryRunner::evaluate_epoch_date_filter_batch(
+        FilterOperation op,
+        DateStringColumnReader* reader,
+        std::shared_ptr<Literal> const& operand,
+        uint64_t begin_message,
+        size_t num_messages,
+        uint8_t* selection
+) {
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        std::fill_n(selection, num_messages, 1);
+        return;
+    }
+
+    int64_t op_value;
+    if (false == operand->as_int(op_value, op)) {
+        return;
+    }
+
+    m_batch_int_values.resize(num_messages);
+    reader->get_encoded_times().copy_to(begin_message, num_messages, m_batch_int_values.data());
+    compare_block(op, m_batch_int_values.data(), num_messages, op_value, selection);
+}
+
 bool QueryRunner::evaluate_int_filter(
         FilterOperation op,
         int32_t column_id,
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -90,6 +91,12 @@ protected:
     // Methods inherited from FilterClass
     auto filter(uint64_t cur_message) -> bool override;
 
+    [[nodiscard]] auto supports_batch_filtering() const -> bool override {
+        return m_batch_filtering_supported;
+    }
+
+    void filter_batch(uint64_t begin_message, size_t num_messages, uint8_t* selection) override;
+
     /**
      * Clears all column readers.
      */
@@ -154,6 +161,14 @@ private:
     bool m_maybe_string{false};
     bool m_maybe_number{false};
 
+    // Scratch space for evaluating the expression over blocks of messages
+    bool m_batch_filtering_supported{false};
+    std::deque<std::vector<uint8_t>> m_batch_selections;
+    std::vector<int64_t> m_batch_int_values;
+    std::vector<double> m_batch_float_values;
+    std::vector<uint8_t> m_batch_bool_values;
+    std::vector<uint64_t> m_batch_var_ids;
+
     /**
      * Initializes the variables. Init is called once for each schema after which filter is called
      * once for every message in the schema
@@ -178,6 +193,143 @@ private:
      */
     auto evaluate_filter(ast::FilterExpr* expr, int32_t schema) -> bool;
 
+    /**
+     * Checks whether an expression can be evaluated over blocks of messages for the current
+     * schema. This is the case when every filter in the expression targets a single resolved
+     * column whose values can be read as a contiguous typed array.
+     * @param expr
+     * @return true if the expression can be evaluated in batches, false otherwise
+     */
+    auto can_evaluate_batch(ast::Expression* expr) -> bool;
+
+    /**
+     * Checks whether a filter expression can be evaluated over blocks of messages for the current
+     * schema.
+     * @param expr
+     * @return true if the filter can be evaluated in batches, false otherwise
+     */
+    auto can_evaluate_filter_batch(ast::FilterExpr* expr) -> bool;
+
+    /**
+     * Evaluates an expression over a contiguous block of messages
+     * @param expr
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the expression and 0 otherwise
+     * @param depth The depth of `expr` in the expression tree
+     */
+    void evaluate_batch(
+            ast::Expression* expr,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection,
+            size_t depth
+    );
+
+    /**
+     * Evaluates a filter expression over a contiguous block of messages, ignoring inversion
+     * @param expr
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter and 0 otherwise
+     */
+    void evaluate_filter_batch(
+            ast::FilterExpr* expr,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
+    /**
+     * Evaluates an int filter expression over a contiguous block of messages
+     * @param op
+     * @param column_id
+     * @param operand
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter
+     */
+    void evaluate_int_filter_batch(
+            ast::FilterOperation op,
+            int32_t column_id,
+            std::shared_ptr<ast::Literal> const& operand,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
+    /**
+     * Evaluates a float filter expression over a contiguous block of messages
+     * @param op
+     * @param column_id
+     * @param operand
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter
+     */
+    void evaluate_float_filter_batch(
+            ast::FilterOperation op,
+            int32_t column_id,
+            std::shared_ptr<ast::Literal> const& operand,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
+    /**
+     * Evaluates a bool filter expression over a contiguous block of messages
+     * @param op
+     * @param column_id
+     * @param operand
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter
+     */
+    void evaluate_bool_filter_batch(
+            ast::FilterOperation op,
+            int32_t column_id,
+            std::shared_ptr<ast::Literal> const& operand,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
+    /**
+     * Evaluates a var string filter expression over a contiguous block of messages
+     * @param op
+     * @param readers
+     * @param matching_vars
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter
+     */
+    void evaluate_var_string_filter_batch(
+            ast::FilterOperation op,
+            std::vector<VariableStringColumnReader*> const& readers,
+            std::unordered_set<int64_t> const* matching_vars,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
+    /**
+     * Evaluates an epoch date string filter expression over a contiguous block of messages
+     * @param op
+     * @param reader
+     * @param operand
+     * @param begin_message
+     * @param num_messages
+     * @param selection Returns 1 for every message that matches the filter
+     */
+    void evaluate_epoch_date_filter_batch(
+            ast::FilterOperation op,
+            DateStringColumnReader* reader,
+            std::shared_ptr<ast::Literal> const& operand,
+            uint64_t begin_message,
+            size_t num_messages,
+            uint8_t* selection
+    );
+
     /**
      * Evaluates a wildcard filter expression
      * @param expr
@@ -0,0 +1,65 @@
+#include "QueuedOutputHandler.hpp"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../Defs.hpp"
+#include "../ErrorCode.hpp"
+#include "MessageBatch.hpp"
+#include "SearchResultQueue.hpp"
+
+namespace clp_s::search {
+void QueuedOutputHandler::write(
+        std::string_view message,
+        epochtime_t timestamp,
+        std::string_view archive_id,
+        int64_t log_event_idx
+) {
+    m_batch.has_metadata = true;
+    m_batch.results.emplace_back(
+            std::string{message},
+            timestamp,
+            std::string{archive_id},
+            log_event_idx
+    );
+    if (m_batch.results.size() >= cMaxBatchSize) {
+        if (ErrorCode::ErrorCodeSuccess != push_batch(false)) {
+            throw OperationFailed(ErrorCode::ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
+}
+
+void QueuedOutputHandler::write(std::string_view message) {
+    m_batch.results.emplace_back(std::string{message});
+    if (m_batch.results.size() >= cMaxBatchSize) {
+        if (ErrorCode::ErrorCodeSuccess != push_batch(false)) {
+            throw OperationFailed(ErrorCode::ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+    }
+}
+
+auto QueuedOutputHandler::aggregate(MessageBatch const& batch) -> void {
+    if (0 == batch.num_selected) {
+        return;
+    }
+    if (nullptr == m_batch.aggregate) {
+        m_batch.aggregate = m_output_handler.create_batch_aggregate();
+    }
+    m_batch.aggregate->add(batch);
+}
+
+auto QueuedOutputHandler::push_batch(bool ends_table) -> ErrorCode {
+    if (m_batch.results.empty() && nullptr == m_batch.aggregate
+        && (false == ends_table || false == m_table_has_pushed_results))
+    {
+        return ErrorCode::ErrorCodeSuccess;
+    }
+
+    m_batch.ends_table = ends_table;
+    auto const pushed{m_queue.push(std::exchange(m_batch, SearchResultBatch{}))};
+    m_table_has_pushed_results = false == ends_table;
+    m_batch.results.reserve(cMaxBatchSize);
+    return pushed ? ErrorCode::ErrorCodeSuccess : ErrorCode::ErrorCodeFailure;
+}
+}  // namespace clp_s::search
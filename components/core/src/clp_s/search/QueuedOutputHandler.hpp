@@ -0,0 +1,102 @@
+#ifndef CLP_S_SEARCH_QUEUEDOUTPUTHANDLER_HPP
+#define CLP_S_SEARCH_QUEUEDOUTPUTHANDLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../Defs.hpp"
+#include "../ErrorCode.hpp"
+#include "../TraceableException.hpp"
+#include "MessageBatch.hpp"
+#include "OutputHandler.hpp"
+#include "SearchResultQueue.hpp"
+
+namespace clp_s::search {
+/**
+ * Output handler used by a search thread to forward its results to a `SearchResultQueue`, from
+ * which a single consumer outputs them using the real output handler. Results are buffered and
+ * pushed in batches to limit contention on the queue.
+ *
+ * If the real output handler aggregates batches, blocks of messages are aggregated on the search
+ * thread instead, and each table's partial aggregate is pushed for the consumer to merge.
+ */
+class QueuedOutputHandler : public OutputHandler {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr size_t cMaxBatchSize{1024};
+
+    // Constructors
+    /**
+     * @param queue
+     * @param output_handler The real output handler, which must outlive this handler
+     */
+    QueuedOutputHandler(SearchResultQueue& queue, OutputHandler const& output_handler)
+            : OutputHandler(
+                      output_handler.should_output_metadata(),
+                      output_handler.should_marshal_records()
+              ),
+              m_queue{queue},
+              m_output_handler{output_handler} {}
+
+    // Methods inherited from OutputHandler
+    /**
+     * @throw OperationFailed if the queue was aborted
+     */
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override;
+
+    /**
+     * @throw OperationFailed if the queue was aborted
+     */
+    void write(std::string_view message) override;
+
+    [[nodiscard]] auto should_aggregate_batches() const -> bool override {
+        return m_output_handler.should_aggregate_batches();
+    }
+
+    auto aggregate(MessageBatch const& batch) -> void override;
+
+    /**
+     * Pushes the buffered results and partial aggregate, marking the end of the current schema
+     * table.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailure if the queue was aborted
+     */
+    [[nodiscard]] auto flush() -> ErrorCode override { return push_batch(true); }
+
+    /**
+     * Pushes any remaining buffered results and partial aggregate.
+     * @return Same as `flush`
+     */
+    [[nodiscard]] auto finish() -> ErrorCode override { return push_batch(false); }
+
+private:
+    /**
+     * Pushes the buffered results and partial aggregate onto the queue.
+     * @param ends_table
+     * @return Same as `flush`
+     */
+    [[nodiscard]] auto push_batch(bool ends_table) -> ErrorCode;
+
+    SearchResultQueue& m_queue;
+    OutputHandler const& m_output_handler;
+    SearchResultBatch m_batch;
+    // Whether results of the current schema table were pushed before the current batch
+    bool m_table_has_pushed_results{false};
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_QUEUEDOUTPUTHANDLER_HPP
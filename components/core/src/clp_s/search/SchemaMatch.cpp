@@ -480,23 +480,7 @@ void SchemaMatch::split_expression_by_schema(
             if (false == descriptor->is_pure_wildcard()) {
                 descriptor->set_column_id(get_column_id_for_descriptor(old_descriptor, schema_id));
                 auto literal_type = get_literal_type_for_column(old_descriptor, schema_id);
-                if (literal_type == LiteralType::ArrayT) {
-                    m_array_search_schema_ids.insert(schema_id);
-                }
                 descriptor->set_matching_type(literal_type);
-            } else if ((descriptor->is_pure_wildcard()
-                        && descriptor->matches_type(LiteralType::ArrayT)
-                        && 0 == m_array_search_schema_ids.count(schema_id)))
-            {
-                for (auto column_id : (*m_schemas)[schema_id]) {
-                    if (Schema::schema_entry_is_unordered_object(column_id)) {
-                        continue;
-                    }
-                    if (NodeType::UnstructuredArray == m_tree->get_node(column_id).get_type()) {
-                        m_array_search_schema_ids.insert(schema_id);
-                        break;
-                    }
-                }
             }
             queries[schema_id] = new_filter;
         }
@@ -575,10 +559,6 @@ bool SchemaMatch::has_array(int32_t schema_id) {
     return m_array_schema_ids.count(schema_id);
 }
 
-bool SchemaMatch::has_array_search(int32_t schema_id) {
-    return m_array_search_schema_ids.count(schema_id);
-}
-
 LiteralType SchemaMatch::get_literal_type_for_column(ColumnDescriptor* column, int32_t schema) {
     return node_to_literal_type(
             m_tree->get_node(get_column_id_for_descriptor(column, schema)).get_type()
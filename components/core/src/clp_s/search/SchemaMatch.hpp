@@ -61,13 +61,6 @@ public:
      */
     bool has_array(int32_t schema_id);
 
-    /**
-     * Checks if the schema has an array field to be searched against
-     * @param schema_id
-     * @return true if the schema has, false otherwise
-     */
-    bool has_array_search(int32_t schema_id);
-
 private:
     std::unordered_map<uint32_t, std::set<ast::ColumnDescriptor*>> m_column_to_descriptor;
     // TODO: The value in the map can be a set of k:v pairs with a hash & comparison
@@ -78,7 +71,6 @@ private:
     std::unordered_map<ast::Expression*, std::unordered_set<int32_t>> m_expression_to_schemas;
     std::unordered_set<int32_t> m_matched_schema_ids;
     std::unordered_set<int32_t> m_array_schema_ids;
-    std::unordered_set<int32_t> m_array_search_schema_ids;
     std::map<int32_t, std::shared_ptr<ast::Expression>> m_schema_to_query;
 
     std::unordered_map<int32_t, std::set<int32_t>> m_schema_to_searched_columns;
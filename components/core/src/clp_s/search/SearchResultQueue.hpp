@@ -0,0 +1,138 @@
+#ifndef CLP_S_SEARCH_SEARCHRESULTQUEUE_HPP
+#define CLP_S_SEARCH_SEARCHRESULTQUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Defs.hpp"
+#include "BatchAggregate.hpp"
+
+namespace clp_s::search {
+/**
+ * A single search result. `archive_id` is only populated for results that include metadata.
+ */
+struct SearchResult {
+    std::string message;
+    epochtime_t timestamp{0};
+    std::string archive_id;
+    int64_t log_event_idx{0};
+};
+
+/**
+ * A batch of search results produced by a single search thread.
+ */
+struct SearchResultBatch {
+    std::vector<SearchResult> results;
+    // The thread's partial aggregate of the blocks it aggregated since its previous batch, if any,
+    // which the consumer should merge into its output handler
+    std::unique_ptr<BatchAggregate> aggregate;
+    // Whether the results include metadata (i.e., whether they should be output with it)
+    bool has_metadata{false};
+    // Whether the batch ends the results of a schema table, in which case the consumer should flush
+    // its output handler after outputting the batch
+    bool ends_table{false};
+};
+
+/**
+ * A bounded multi-producer, single-consumer queue used to funnel the results of several search
+ * threads to a single output handler. Producers block while the queue is full so that a slow output
+ * handler bounds the amount of memory used by buffered results.
+ */
+class SearchResultQueue {
+public:
+    // Constructors
+    /**
+     * @param capacity Maximum number of batches buffered in the queue
+     * @param num_producers Number of producers that will call `close_producer` once they're done
+     */
+    SearchResultQueue(size_t capacity, size_t num_producers)
+            : m_capacity{capacity},
+              m_num_open_producers{num_producers} {}
+
+    // Methods
+    /**
+     * Pushes a batch onto the queue, blocking until there's room for it.
+     * @param batch
+     * @return Whether the batch was pushed, or false if the queue was aborted
+     */
+    [[nodiscard]] auto push(SearchResultBatch batch) -> bool {
+        std::unique_lock lock{m_mutex};
+        m_not_full.wait(lock, [&] { return m_aborted || m_batches.size() < m_capacity; });
+        if (m_aborted) {
+            return false;
+        }
+        m_batches.emplace_back(std::move(batch));
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * Pops the oldest batch off the queue, blocking until one is available.
+     * @return The batch, or std::nullopt once every producer is closed and the queue is empty, or
+     * if the queue was aborted
+     */
+    [[nodiscard]] auto pop() -> std::optional<SearchResultBatch> {
+        std::unique_lock lock{m_mutex};
+        m_not_empty.wait(lock, [&] {
+            return m_aborted || false == m_batches.empty() || 0 == m_num_open_producers;
+        });
+        if (m_aborted || m_batches.empty()) {
+            return std::nullopt;
+        }
+        auto batch{std::move(m_batches.front())};
+        m_batches.pop_front();
+        m_not_full.notify_one();
+        return batch;
+    }
+
+    /**
+     * Indicates that one of the producers won't push any more batches.
+     */
+    void close_producer() {
+        std::lock_guard const lock{m_mutex};
+        if (m_num_open_producers > 0) {
+            --m_num_open_producers;
+        }
+        m_not_empty.notify_all();
+    }
+
+    /**
+     * @return Whether the queue was aborted
+     */
+    [[nodiscard]] auto is_aborted() -> bool {
+        std::lock_guard const lock{m_mutex};
+        return m_aborted;
+    }
+
+    /**
+     * Discards every buffered batch and unblocks every producer and the consumer. Any subsequent
+     * pushes fail.
+     */
+    void abort() {
+        std::lock_guard const lock{m_mutex};
+        m_aborted = true;
+        m_batches.clear();
+        m_not_full.notify_all();
+        m_not_empty.notify_all();
+    }
+
+private:
+    size_t m_capacity;
+    size_t m_num_open_producers;
+    bool m_aborted{false};
+    std::deque<SearchResultBatch> m_batches;
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_SEARCHRESULTQUEUE_HPP
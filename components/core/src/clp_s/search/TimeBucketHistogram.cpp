@@ -0,0 +1,54 @@
+#include "TimeBucketHistogram.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+#include "BatchAggregate.hpp"
+#include "MessageBatch.hpp"
+
+namespace clp_s::search {
+auto TimeBucketHistogram::add(MessageBatch const& batch) -> void {
+    if (0 == batch.num_selected) {
+        return;
+    }
+    if (batch.timestamps.empty()) {
+        m_bucket_counts[get_bucket(0)] += static_cast<int64_t>(batch.num_selected);
+        return;
+    }
+
+    // Compute every message's bucket in a branch-free loop (regardless of whether the message
+    // matches) so that the compiler can unroll or vectorize it.
+    auto const num_messages = batch.timestamps.size();
+    m_batch_buckets.resize(num_messages);
+    for (size_t i = 0; i < num_messages; ++i) {
+        m_batch_buckets[i] = get_bucket(batch.timestamps[i]);
+    }
+
+    // Messages are usually sorted or clustered by time, so runs tend to be long and each run's
+    // bucket is usually next to the previous run's, making the previous bucket a good insertion
+    // hint.
+    auto hint = m_bucket_counts.end();
+    for_each_selected_run(
+            std::span<int64_t const>{m_batch_buckets},
+            batch.selection,
+            [&](int64_t bucket, int64_t count) {
+                hint = m_bucket_counts.try_emplace(hint, bucket, 0);
+                hint->second += count;
+            }
+    );
+}
+
+auto TimeBucketHistogram::merge(BatchAggregate const& other) -> void {
+    // The other histogram's buckets are in ascending order, so each one belongs after the previous
+    auto hint = m_bucket_counts.begin();
+    for (auto const& [bucket, count] :
+         dynamic_cast<TimeBucketHistogram const&>(other).m_bucket_counts)
+    {
+        auto const it = m_bucket_counts.try_emplace(hint, bucket, 0);
+        it->second += count;
+        hint = std::next(it);
+    }
+}
+}  // namespace clp_s::search
@@ -0,0 +1,64 @@
+#ifndef CLP_S_SEARCH_TIMEBUCKETHISTOGRAM_HPP
+#define CLP_S_SEARCH_TIMEBUCKETHISTOGRAM_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "../Defs.hpp"
+#include "BatchAggregate.hpp"
+#include "MessageBatch.hpp"
+
+namespace clp_s::search {
+/**
+ * Histogram that counts log events in fixed-size time buckets, where each bucket is identified by
+ * its start time.
+ */
+class TimeBucketHistogram : public BatchAggregate {
+public:
+    // Constructors
+    /**
+     * @param bucket_size The size of each bucket, in the same unit as timestamps. Must be positive.
+     */
+    explicit TimeBucketHistogram(int64_t bucket_size) : m_bucket_size{bucket_size} {}
+
+    // Methods implementing BatchAggregate
+    auto add(MessageBatch const& batch) -> void override;
+
+    /**
+     * Adds the counts of another histogram with the same bucket size to this one.
+     * @param other
+     * @throw std::bad_cast if `other` isn't a histogram
+     */
+    auto merge(BatchAggregate const& other) -> void override;
+
+    // Methods
+    /**
+     * Adds a single log event to the histogram.
+     * @param timestamp
+     */
+    auto add(epochtime_t timestamp) -> void { m_bucket_counts[get_bucket(timestamp)] += 1; }
+
+    [[nodiscard]] auto get_bucket_size() const -> int64_t { return m_bucket_size; }
+
+    /**
+     * @return A map from each non-empty bucket's start time to its count
+     */
+    [[nodiscard]] auto get_bucket_counts() const -> std::map<int64_t, int64_t> const& {
+        return m_bucket_counts;
+    }
+
+private:
+    // Methods
+    [[nodiscard]] auto get_bucket(epochtime_t timestamp) const -> int64_t {
+        return (timestamp / m_bucket_size) * m_bucket_size;
+    }
+
+    // Variables
+    int64_t m_bucket_size;
+    std::vector<int64_t> m_batch_buckets;
+    std::map<int64_t, int64_t> m_bucket_counts;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_TIMEBUCKETHISTOGRAM_HPP
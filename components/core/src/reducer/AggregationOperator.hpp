@@ -0,0 +1,201 @@
+#ifndef REDUCER_AGGREGATIONOPERATOR_HPP
+#define REDUCER_AGGREGATIONOPERATOR_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Operator.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordGroupIterator.hpp"
+
+namespace reducer {
+/**
+ * The kind of records an AggregationOperator outputs for each group.
+ */
+enum class AggregationOutput : uint8_t {
+    // Records containing the aggregate's mergeable state, to be merged by a later stage (e.g.,
+    // results that search workers send to the reducer).
+    PartialResult,
+    // Records containing the aggregate's final value (e.g., results published by the reducer).
+    FinalResult
+};
+
+/**
+ * Requirements for a mergeable aggregate that can be computed by an AggregationOperator.
+ *
+ * An aggregate only holds its state; its `Config` (shared by every group's aggregate) is passed to
+ * each of its methods. An aggregate is constructed from its config, and:
+ * - `add` accumulates a raw record into the aggregate;
+ * - `merge` merges all the records of a group output by another aggregate (with the same config)
+ *   as a partial result;
+ * - `get_partial_result` appends records containing the aggregate's mergeable state;
+ * - `get_final_result` appends records containing the aggregate's final value.
+ */
+template <typename AggregateType>
+concept AggregateReq = requires(
+        AggregateType aggregate,
+        AggregateType const const_aggregate,
+        typename AggregateType::Config const& config,
+        Record const& record,
+        ConstRecordIterator& record_it,
+        std::vector<KeyValueRecord>& records
+) {
+    AggregateType{config};
+    { aggregate.add(config, record) } -> std::same_as<void>;
+    { aggregate.merge(config, record_it) } -> std::same_as<void>;
+    { const_aggregate.get_partial_result(config, records) } -> std::same_as<void>;
+    { const_aggregate.get_final_result(config, records) } -> std::same_as<void>;
+};
+
+/**
+ * A RecordGroupIterator that exposes a hash map which maps GroupTags to aggregates, optionally
+ * filtered by a set of GroupTags.
+ */
+template <AggregateReq AggregateType>
+class AggregateMapRecordGroupIterator : public RecordGroupIterator {
+public:
+    using Config = typename AggregateType::Config;
+    using Map = std::unordered_map<GroupTags, AggregateType, GroupTagsHash>;
+
+    AggregateMapRecordGroupIterator(Map const& map, Config const& config, AggregationOutput output)
+            : m_config{config},
+              m_output{output},
+              m_group{nullptr, m_records} {
+        m_map_its.reserve(map.size());
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            m_map_its.emplace_back(it);
+        }
+        m_cur = m_map_its.cbegin();
+    }
+
+    AggregateMapRecordGroupIterator(
+            Map const& map,
+            std::set<GroupTags> const& filter,
+            Config const& config,
+            AggregationOutput output
+    )
+            : m_config{config},
+              m_output{output},
+              m_group{nullptr, m_records} {
+        for (auto const& tags : filter) {
+            if (auto it = map.find(tags); map.cend() != it) {
+                m_map_its.emplace_back(it);
+            }
+        }
+        m_cur = m_map_its.cbegin();
+    }
+
+    // Disable copy and move construction/assignment since m_config is a reference and m_group
+    // references m_records
+    AggregateMapRecordGroupIterator(AggregateMapRecordGroupIterator const&) = delete;
+    AggregateMapRecordGroupIterator(AggregateMapRecordGroupIterator&&) = delete;
+    AggregateMapRecordGroupIterator& operator=(AggregateMapRecordGroupIterator const&) = delete;
+    AggregateMapRecordGroupIterator& operator=(AggregateMapRecordGroupIterator&&) = delete;
+
+    ~AggregateMapRecordGroupIterator() override = default;
+
+    RecordGroup& get() override {
+        auto const& [tags, aggregate] = **m_cur;
+        m_records.clear();
+        if (AggregationOutput::PartialResult == m_output) {
+            aggregate.get_partial_result(m_config, m_records);
+        } else {
+            aggregate.get_final_result(m_config, m_records);
+        }
+        m_group.set_tags(&tags);
+        m_group.set_records(m_records);
+        return m_group;
+    }
+
+    void next() override { ++m_cur; }
+
+    bool done() override { return m_cur == m_map_its.cend(); }
+
+private:
+    Config const& m_config;
+    AggregationOutput m_output;
+    std::vector<typename Map::const_iterator> m_map_its;
+    typename std::vector<typename Map::const_iterator>::const_iterator m_cur;
+    std::vector<KeyValueRecord> m_records;
+    KeyValueRecordGroup m_group;
+};
+
+/**
+ * Operator that computes a mergeable aggregate per record group, using a hash map as the group
+ * table.
+ *
+ * Inter-stage record groups contain raw records, which are added to the group's aggregate.
+ * Intra-stage record groups contain partial results output by another AggregationOperator with the
+ * same aggregate and config, which are merged into the group's aggregate. This allows each search
+ * worker to aggregate its own matches and send only the (small) partial results to the reducer.
+ * @tparam AggregateType
+ */
+template <AggregateReq AggregateType>
+class AggregationOperator : public Operator {
+public:
+    using Config = typename AggregateType::Config;
+
+    /**
+     * @param config The config for each group's aggregate.
+     * @param output The kind of records to output for each group.
+     */
+    AggregationOperator(Config config, AggregationOutput output)
+            : m_config{std::move(config)},
+              m_output{output} {}
+
+    void
+    push_intra_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override {
+        get_aggregate(tags).merge(m_config, record_it);
+    }
+
+    void
+    push_inter_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override {
+        auto& aggregate = get_aggregate(tags);
+        for (; false == record_it.done(); record_it.next()) {
+            aggregate.add(m_config, record_it.get());
+        }
+    }
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override {
+        return std::make_unique<AggregateMapRecordGroupIterator<AggregateType>>(
+                m_groups,
+                m_config,
+                m_output
+        );
+    }
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator(
+            std::set<GroupTags> const& filtered_tags
+    ) override {
+        return std::make_unique<AggregateMapRecordGroupIterator<AggregateType>>(
+                m_groups,
+                filtered_tags,
+                m_config,
+                m_output
+        );
+    }
+
+private:
+    /**
+     * @param tags
+     * @return The aggregate for the given group, creating it if it doesn't exist.
+     */
+    AggregateType& get_aggregate(GroupTags const& tags) {
+        return m_groups.try_emplace(tags, m_config).first->second;
+    }
+
+    Config m_config;
+    AggregationOutput m_output;
+    std::unordered_map<GroupTags, AggregateType, GroupTagsHash> m_groups;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_AGGREGATIONOPERATOR_HPP
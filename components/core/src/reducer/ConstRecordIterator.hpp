@@ -75,6 +75,26 @@ private:
     std::vector<Record>::const_iterator m_end;
 };
 
+/**
+ * A ConstRecordIterator over a collection of KeyValueRecord objects.
+ */
+class KeyValueRecordIterator : public ConstRecordIterator {
+public:
+    explicit KeyValueRecordIterator(std::vector<KeyValueRecord> const& records)
+            : m_cur{records.cbegin()},
+              m_end{records.cend()} {}
+
+    [[nodiscard]] Record const& get() const override { return *m_cur; }
+
+    void next() override { ++m_cur; }
+
+    bool done() override { return m_cur == m_end; }
+
+private:
+    std::vector<KeyValueRecord>::const_iterator m_cur;
+    std::vector<KeyValueRecord>::const_iterator m_end;
+};
+
 /**
  * A stubbed out ConstRecordIterator with no records.
  */
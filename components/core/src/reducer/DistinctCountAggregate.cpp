@@ -0,0 +1,140 @@
+#include "DistinctCountAggregate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * Hashes the given value into 64 well-mixed bits. The hash must be the same on every search worker
+ * and the reducer (and across runs), so std::hash can't be used.
+ * @param value
+ * @return The hash of `value`, computed using 64-bit FNV-1a followed by MurmurHash3's 64-bit
+ * finalizer.
+ */
+uint64_t hash_value(std::string_view value) {
+    constexpr uint64_t cFnvOffsetBasis{0xcbf2'9ce4'8422'2325ULL};
+    constexpr uint64_t cFnvPrime{0x0000'0100'0000'01b3ULL};
+    uint64_t hash{cFnvOffsetBasis};
+    for (auto const c : value) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= cFnvPrime;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51'afd7'ed55'8ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ce'b9fe'1a85'ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @param num_registers
+ * @return The bias correction constant for a HyperLogLog sketch with the given number of registers.
+ */
+double get_alpha(size_t num_registers) {
+    switch (num_registers) {
+        case 16:
+            return 0.673;
+        case 32:
+            return 0.697;
+        case 64:
+            return 0.709;
+        default:
+            return 0.7213 / (1.0 + 1.079 / static_cast<double>(num_registers));
+    }
+}
+}  // namespace
+
+DistinctCountAggregate::DistinctCountAggregate(Config const& config)
+        : m_precision{std::clamp(config.precision, Config::cMinPrecision, Config::cMaxPrecision)},
+          m_registers(size_t{1} << m_precision, 0) {}
+
+void DistinctCountAggregate::add(Config const& config, Record const& record) {
+    auto const hash = hash_value(record.get_string_view(config.field_key));
+
+    // The top `m_precision` bits select the register, and the register tracks the maximum rank
+    // (position of the first set bit) of the remaining bits.
+    auto const register_idx = static_cast<size_t>(hash >> (64 - m_precision));
+    auto const remaining_bits = hash << m_precision;
+    auto const max_rank = 64 - m_precision + 1;
+    auto const rank = static_cast<uint8_t>(
+            0 == remaining_bits ? max_rank : std::countl_zero(remaining_bits) + 1
+    );
+
+    auto& reg = m_registers[register_idx];
+    reg = std::max(reg, rank);
+}
+
+void DistinctCountAggregate::merge(
+        [[maybe_unused]] Config const& config,
+        ConstRecordIterator& record_it
+) {
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        auto const register_idx = record.get_int64_value(cRegisterKey);
+        auto const rank = record.get_int64_value(cRankKey);
+        if (register_idx < 0 || static_cast<size_t>(register_idx) >= m_registers.size()
+            || rank <= 0 || rank > 64)
+        {
+            // Ignore records from sketches with a different precision
+            continue;
+        }
+        auto& reg = m_registers[static_cast<size_t>(register_idx)];
+        reg = std::max(reg, static_cast<uint8_t>(rank));
+    }
+}
+
+void DistinctCountAggregate::get_partial_result(
+        [[maybe_unused]] Config const& config,
+        std::vector<KeyValueRecord>& records
+) const {
+    for (size_t i = 0; i < m_registers.size(); ++i) {
+        if (0 == m_registers[i]) {
+            continue;
+        }
+        auto& record = records.emplace_back();
+        record.add_int64_value(cRegisterKey, static_cast<int64_t>(i));
+        record.add_int64_value(cRankKey, m_registers[i]);
+    }
+}
+
+void DistinctCountAggregate::get_final_result(
+        [[maybe_unused]] Config const& config,
+        std::vector<KeyValueRecord>& records
+) const {
+    records.emplace_back().add_int64_value(cDistinctCountKey, std::llround(estimate()));
+}
+
+double DistinctCountAggregate::estimate() const {
+    auto const num_registers = static_cast<double>(m_registers.size());
+
+    double inverse_sum{0.0};
+    size_t num_zero_registers{0};
+    for (auto const reg : m_registers) {
+        inverse_sum += std::ldexp(1.0, -static_cast<int>(reg));
+        if (0 == reg) {
+            ++num_zero_registers;
+        }
+    }
+
+    auto const raw_estimate
+            = get_alpha(m_registers.size()) * num_registers * num_registers / inverse_sum;
+    // Use linear counting for small cardinalities, where the raw estimate is heavily biased. No
+    // large-range correction is necessary since hashes are 64 bits wide.
+    constexpr double cSmallRangeThreshold{2.5};
+    if (raw_estimate <= cSmallRangeThreshold * num_registers && num_zero_registers > 0) {
+        return num_registers * std::log(num_registers / static_cast<double>(num_zero_registers));
+    }
+    return raw_estimate;
+}
+}  // namespace reducer
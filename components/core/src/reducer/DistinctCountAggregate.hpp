@@ -0,0 +1,64 @@
+#ifndef REDUCER_DISTINCTCOUNTAGGREGATE_HPP
+#define REDUCER_DISTINCTCOUNTAGGREGATE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AggregationOperator.hpp"
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+/**
+ * Aggregate that approximates the number of distinct values of a string field using a HyperLogLog
+ * sketch.
+ *
+ * The sketch has 2^precision one-byte registers, and its estimates have a relative standard error
+ * of about 1.04 / sqrt(2^precision) (e.g., ~1.6% for the default precision). Partial results
+ * contain one record per non-zero register, so sketches of small groups stay small.
+ */
+class DistinctCountAggregate {
+public:
+    struct Config {
+        // Constants
+        static constexpr uint8_t cMinPrecision{4};
+        static constexpr uint8_t cMaxPrecision{16};
+        static constexpr uint8_t cDefaultPrecision{12};
+
+        // Variables
+        // The key of the field to aggregate, read using Record::get_string_view.
+        std::string field_key;
+        // Clamped to [cMinPrecision, cMaxPrecision].
+        uint8_t precision{cDefaultPrecision};
+    };
+
+    static constexpr std::string_view cRegisterKey{"register"};
+    static constexpr std::string_view cRankKey{"rank"};
+    static constexpr std::string_view cDistinctCountKey{"distinct_count"};
+
+    explicit DistinctCountAggregate(Config const& config);
+
+    void add(Config const& config, Record const& record);
+
+    void merge(Config const& config, ConstRecordIterator& record_it);
+
+    void get_partial_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+    void get_final_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+    /**
+     * @return The estimated number of distinct values added to the sketch.
+     */
+    [[nodiscard]] double estimate() const;
+
+private:
+    uint8_t m_precision;
+    std::vector<uint8_t> m_registers;
+};
+
+using DistinctCountOperator = AggregationOperator<DistinctCountAggregate>;
+}  // namespace reducer
+
+#endif  // REDUCER_DISTINCTCOUNTAGGREGATE_HPP
@@ -1,12 +1,28 @@
 #ifndef REDUCER_GROUPTAGS_HPP
 #define REDUCER_GROUPTAGS_HPP
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
 namespace reducer {
 // We will do something fancier for GroupTags in the future, but this is good enough to get started
 using GroupTags = std::vector<std::string>;
+
+/**
+ * Hash functor for using GroupTags as the key of a hash map.
+ */
+struct GroupTagsHash {
+    size_t operator()(GroupTags const& tags) const {
+        size_t hash{tags.size()};
+        for (auto const& tag : tags) {
+            // Same mixing step as boost::hash_combine
+            hash ^= std::hash<std::string>{}(tag) + 0x9e37'79b9 + (hash << 6U) + (hash >> 2U);
+        }
+        return hash;
+    }
+};
 }  // namespace reducer
 
 #endif  // REDUCER_GROUPTAGS_HPP
@@ -0,0 +1,165 @@
+#ifndef REDUCER_NUMERICAGGREGATES_HPP
+#define REDUCER_NUMERICAGGREGATES_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AggregationOperator.hpp"
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+/**
+ * Config for aggregates over a numeric field of each record.
+ */
+struct NumericFieldConfig {
+    // The key of the field to aggregate, read using Record::get_double_value.
+    std::string field_key;
+};
+
+/**
+ * Aggregate that sums a numeric field.
+ */
+class SumAggregate {
+public:
+    using Config = NumericFieldConfig;
+
+    static constexpr std::string_view cSumKey{"sum"};
+
+    explicit SumAggregate([[maybe_unused]] Config const& config) {}
+
+    void add(Config const& config, Record const& record) {
+        m_sum += record.get_double_value(config.field_key);
+    }
+
+    void merge([[maybe_unused]] Config const& config, ConstRecordIterator& record_it) {
+        for (; false == record_it.done(); record_it.next()) {
+            m_sum += record_it.get().get_double_value(cSumKey);
+        }
+    }
+
+    void get_partial_result(
+            [[maybe_unused]] Config const& config,
+            std::vector<KeyValueRecord>& records
+    ) const {
+        records.emplace_back().add_double_value(cSumKey, m_sum);
+    }
+
+    void get_final_result(Config const& config, std::vector<KeyValueRecord>& records) const {
+        get_partial_result(config, records);
+    }
+
+private:
+    double m_sum{0.0};
+};
+
+/**
+ * Aggregate that finds the minimum or maximum of a numeric field. Groups without any records have
+ * no result.
+ * @tparam is_min Whether to find the minimum rather than the maximum.
+ */
+template <bool is_min>
+class ExtremumAggregate {
+public:
+    using Config = NumericFieldConfig;
+
+    static constexpr std::string_view cResultKey{is_min ? "min" : "max"};
+
+    explicit ExtremumAggregate([[maybe_unused]] Config const& config) {}
+
+    void add(Config const& config, Record const& record) {
+        update(record.get_double_value(config.field_key));
+    }
+
+    void merge([[maybe_unused]] Config const& config, ConstRecordIterator& record_it) {
+        for (; false == record_it.done(); record_it.next()) {
+            update(record_it.get().get_double_value(cResultKey));
+        }
+    }
+
+    void get_partial_result(
+            [[maybe_unused]] Config const& config,
+            std::vector<KeyValueRecord>& records
+    ) const {
+        if (m_result.has_value()) {
+            records.emplace_back().add_double_value(cResultKey, m_result.value());
+        }
+    }
+
+    void get_final_result(Config const& config, std::vector<KeyValueRecord>& records) const {
+        get_partial_result(config, records);
+    }
+
+private:
+    void update(double value) {
+        if (false == m_result.has_value() || (is_min ? value < *m_result : value > *m_result)) {
+            m_result = value;
+        }
+    }
+
+    std::optional<double> m_result;
+};
+
+using MinAggregate = ExtremumAggregate<true>;
+using MaxAggregate = ExtremumAggregate<false>;
+
+/**
+ * Aggregate that computes the arithmetic mean of a numeric field. Groups without any records have
+ * no result.
+ */
+class MeanAggregate {
+public:
+    using Config = NumericFieldConfig;
+
+    static constexpr std::string_view cSumKey{"sum"};
+    static constexpr std::string_view cCountKey{"count"};
+    static constexpr std::string_view cMeanKey{"mean"};
+
+    explicit MeanAggregate([[maybe_unused]] Config const& config) {}
+
+    void add(Config const& config, Record const& record) {
+        m_sum += record.get_double_value(config.field_key);
+        ++m_count;
+    }
+
+    void merge([[maybe_unused]] Config const& config, ConstRecordIterator& record_it) {
+        for (; false == record_it.done(); record_it.next()) {
+            auto const& record = record_it.get();
+            m_sum += record.get_double_value(cSumKey);
+            m_count += record.get_int64_value(cCountKey);
+        }
+    }
+
+    void get_partial_result(
+            [[maybe_unused]] Config const& config,
+            std::vector<KeyValueRecord>& records
+    ) const {
+        auto& record = records.emplace_back();
+        record.add_double_value(cSumKey, m_sum);
+        record.add_int64_value(cCountKey, m_count);
+    }
+
+    void get_final_result(
+            [[maybe_unused]] Config const& config,
+            std::vector<KeyValueRecord>& records
+    ) const {
+        if (m_count > 0) {
+            records.emplace_back().add_double_value(cMeanKey, m_sum / static_cast<double>(m_count));
+        }
+    }
+
+private:
+    double m_sum{0.0};
+    int64_t m_count{0};
+};
+
+using SumOperator = AggregationOperator<SumAggregate>;
+using MinOperator = AggregationOperator<MinAggregate>;
+using MaxOperator = AggregationOperator<MaxAggregate>;
+using MeanOperator = AggregationOperator<MeanAggregate>;
+}  // namespace reducer
+
+#endif  // REDUCER_NUMERICAGGREGATES_HPP
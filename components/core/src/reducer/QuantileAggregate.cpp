@@ -0,0 +1,190 @@
+#include "QuantileAggregate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+namespace {
+// The number of buffered centroids, relative to the compression, that triggers a compression
+constexpr double cBufferCapacityFactor{5.0};
+
+/**
+ * Computes the quantile limit of a centroid starting at the given quantile, using the t-digest's
+ * k1 scale function, k(q) = compression / (2 * pi) * asin(2q - 1), which allows one unit of k per
+ * centroid.
+ * @param compression
+ * @param quantile The quantile at which the centroid starts.
+ * @return The maximum quantile at which the centroid can end.
+ */
+double get_quantile_limit(double compression, double quantile) {
+    auto const scale = compression / (2 * std::numbers::pi);
+    auto const k = scale * std::asin(2 * quantile - 1) + 1;
+    // k(1) = compression / 4
+    auto const clamped_k = std::min(k, compression / 4);
+    return (std::sin(clamped_k / scale) + 1) / 2;
+}
+}  // namespace
+
+QuantileAggregate::QuantileAggregate(Config const& config)
+        : m_compression{std::max(config.compression, 1.0)},
+          m_buffer_capacity{static_cast<size_t>(std::ceil(cBufferCapacityFactor * m_compression))
+          } {}
+
+void QuantileAggregate::add(Config const& config, Record const& record) {
+    auto const value = record.get_double_value(config.field_key);
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    add_centroid({value, 1.0});
+}
+
+void QuantileAggregate::merge(
+        [[maybe_unused]] Config const& config,
+        ConstRecordIterator& record_it
+) {
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        auto const mean = record.get_double_value(cMeanKey);
+        auto const weight = record.get_double_value(cWeightKey);
+        // Every mean is within the digest's range, and the zero-weight records contain its exact
+        // minimum and maximum.
+        m_min = std::min(m_min, mean);
+        m_max = std::max(m_max, mean);
+        if (weight > 0) {
+            add_centroid({mean, weight});
+        }
+    }
+}
+
+void QuantileAggregate::get_partial_result(
+        [[maybe_unused]] Config const& config,
+        std::vector<KeyValueRecord>& records
+) const {
+    if (0 == m_total_weight) {
+        return;
+    }
+    auto const add_record = [&](double mean, double weight) {
+        auto& record = records.emplace_back();
+        record.add_double_value(cMeanKey, mean);
+        record.add_double_value(cWeightKey, weight);
+    };
+    for (auto const& centroid : get_compressed_centroids()) {
+        add_record(centroid.mean, centroid.weight);
+    }
+    add_record(m_min, 0.0);
+    add_record(m_max, 0.0);
+}
+
+void QuantileAggregate::get_final_result(
+        Config const& config,
+        std::vector<KeyValueRecord>& records
+) const {
+    if (0 == m_total_weight) {
+        return;
+    }
+    auto const centroids = get_compressed_centroids();
+    for (auto const quantile : config.quantiles) {
+        auto& record = records.emplace_back();
+        record.add_double_value(cQuantileKey, quantile);
+        record.add_double_value(cValueKey, interpolate_quantile(centroids, quantile));
+    }
+}
+
+double QuantileAggregate::get_quantile(double quantile) const {
+    if (0 == m_total_weight) {
+        return 0.0;
+    }
+    return interpolate_quantile(get_compressed_centroids(), quantile);
+}
+
+void QuantileAggregate::add_centroid(Centroid centroid) {
+    m_buffer.emplace_back(centroid);
+    m_total_weight += centroid.weight;
+    if (m_buffer.size() < m_buffer_capacity) {
+        return;
+    }
+    m_centroids = get_compressed_centroids();
+    m_buffer.clear();
+}
+
+double QuantileAggregate::interpolate_quantile(
+        std::vector<Centroid> const& centroids,
+        double quantile
+) const {
+    // Each centroid's weight is assumed to be spread evenly around its mean, so values between two
+    // adjacent centroids are interpolated between their means.
+    auto const index = std::clamp(quantile, 0.0, 1.0) * m_total_weight;
+
+    auto const& first = centroids.front();
+    if (index < first.weight / 2) {
+        return m_min + (first.mean - m_min) * index / (first.weight / 2);
+    }
+
+    auto cumulative_weight = first.weight / 2;
+    for (size_t i = 0; i + 1 < centroids.size(); ++i) {
+        auto const& cur = centroids[i];
+        auto const& next = centroids[i + 1];
+        auto const weight_between_means = (cur.weight + next.weight) / 2;
+        if (index < cumulative_weight + weight_between_means) {
+            auto const fraction = (index - cumulative_weight) / weight_between_means;
+            return cur.mean + (next.mean - cur.mean) * fraction;
+        }
+        cumulative_weight += weight_between_means;
+    }
+
+    auto const& last = centroids.back();
+    auto const fraction = std::min((index - cumulative_weight) / (last.weight / 2), 1.0);
+    return last.mean + (m_max - last.mean) * fraction;
+}
+
+std::vector<QuantileAggregate::Centroid> QuantileAggregate::get_compressed_centroids() const {
+    if (m_buffer.empty()) {
+        return m_centroids;
+    }
+    std::vector<Centroid> centroids;
+    centroids.reserve(m_centroids.size() + m_buffer.size());
+    centroids.insert(centroids.end(), m_centroids.cbegin(), m_centroids.cend());
+    centroids.insert(centroids.end(), m_buffer.cbegin(), m_buffer.cend());
+    std::sort(centroids.begin(), centroids.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+    return compress(m_compression, centroids);
+}
+
+std::vector<QuantileAggregate::Centroid>
+QuantileAggregate::compress(double compression, std::vector<Centroid> const& centroids) {
+    std::vector<Centroid> compressed_centroids;
+    if (centroids.empty()) {
+        return compressed_centroids;
+    }
+
+    double total_weight{0.0};
+    for (auto const& centroid : centroids) {
+        total_weight += centroid.weight;
+    }
+
+    auto cur = centroids.front();
+    double weight_before_cur{0.0};
+    auto weight_limit = total_weight * get_quantile_limit(compression, 0.0);
+    for (size_t i = 1; i < centroids.size(); ++i) {
+        auto const& next = centroids[i];
+        if (weight_before_cur + cur.weight + next.weight <= weight_limit) {
+            cur.weight += next.weight;
+            cur.mean += (next.mean - cur.mean) * next.weight / cur.weight;
+            continue;
+        }
+        compressed_centroids.emplace_back(cur);
+        weight_before_cur += cur.weight;
+        weight_limit
+                = total_weight * get_quantile_limit(compression, weight_before_cur / total_weight);
+        cur = next;
+    }
+    compressed_centroids.emplace_back(cur);
+    return compressed_centroids;
+}
+}  // namespace reducer
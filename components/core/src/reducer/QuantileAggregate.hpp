@@ -0,0 +1,117 @@
+#ifndef REDUCER_QUANTILEAGGREGATE_HPP
+#define REDUCER_QUANTILEAGGREGATE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AggregationOperator.hpp"
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+/**
+ * Aggregate that approximates quantiles of a numeric field using a merging t-digest.
+ *
+ * The digest summarizes values as weighted centroids, where centroids near the extreme quantiles
+ * are kept small so that tail quantiles (e.g., p99) stay accurate. The number of centroids is
+ * bounded by about `Config::compression`. Incoming values are buffered and merged into the
+ * centroids in batches.
+ *
+ * Partial results contain one record per centroid, plus two zero-weight records holding the exact
+ * minimum and maximum, so that merged digests can interpolate the extreme quantiles.
+ */
+class QuantileAggregate {
+public:
+    struct Config {
+        // Constants
+        static constexpr double cDefaultCompression{100.0};
+
+        // Variables
+        // The key of the field to aggregate, read using Record::get_double_value.
+        std::string field_key;
+        // Larger values improve accuracy at the cost of more centroids. Values below 1 are treated
+        // as 1.
+        double compression{cDefaultCompression};
+        // The quantiles (in [0, 1]) to output in the final result.
+        std::vector<double> quantiles{0.5, 0.9, 0.99};
+    };
+
+    static constexpr std::string_view cMeanKey{"mean"};
+    static constexpr std::string_view cWeightKey{"weight"};
+    static constexpr std::string_view cQuantileKey{"quantile"};
+    static constexpr std::string_view cValueKey{"value"};
+
+    explicit QuantileAggregate(Config const& config);
+
+    void add(Config const& config, Record const& record);
+
+    void merge(Config const& config, ConstRecordIterator& record_it);
+
+    void get_partial_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+    /**
+     * Appends one record per configured quantile. Groups without any records have no result.
+     */
+    void get_final_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+    /**
+     * @param quantile
+     * @return The estimated value at the given quantile, or 0 if the digest is empty.
+     */
+    [[nodiscard]] double get_quantile(double quantile) const;
+
+private:
+    // Types
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Methods
+    /**
+     * Adds a centroid to the buffer, compressing the buffer into the digest when it's full.
+     * @param centroid
+     */
+    void add_centroid(Centroid centroid);
+
+    /**
+     * @param centroids The digest's compressed centroids.
+     * @param quantile
+     * @return The estimated value at the given quantile, interpolated between centroid means (and
+     * the minimum/maximum at the edges).
+     */
+    [[nodiscard]] double
+    interpolate_quantile(std::vector<Centroid> const& centroids, double quantile) const;
+
+    /**
+     * @return The digest's centroids after merging any buffered centroids, sorted by mean.
+     */
+    [[nodiscard]] std::vector<Centroid> get_compressed_centroids() const;
+
+    /**
+     * Merges the given centroids (which must be sorted by mean) so that each resulting centroid
+     * spans at most one unit of the t-digest's scale function.
+     * @param compression
+     * @param centroids
+     * @return The merged centroids, sorted by mean.
+     */
+    [[nodiscard]] static std::vector<Centroid>
+    compress(double compression, std::vector<Centroid> const& centroids);
+
+    // Variables
+    double m_compression;
+    size_t m_buffer_capacity;
+    std::vector<Centroid> m_centroids;
+    std::vector<Centroid> m_buffer;
+    double m_min{std::numeric_limits<double>::infinity()};
+    double m_max{-std::numeric_limits<double>::infinity()};
+    double m_total_weight{0.0};
+};
+
+using QuantileOperator = AggregationOperator<QuantileAggregate>;
+}  // namespace reducer
+
+#endif  // REDUCER_QUANTILEAGGREGATE_HPP
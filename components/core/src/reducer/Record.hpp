@@ -4,8 +4,10 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "RecordTypedKeyIterator.hpp"
 
@@ -94,6 +96,96 @@ private:
     int64_t m_value{};
 };
 
+/**
+ * Record implementation which owns an arbitrary number of typed key-value pairs.
+ *
+ * Lookups scan the elements linearly, so this class is only meant for records with a handful of
+ * elements, such as the results of an aggregation.
+ */
+class KeyValueRecord : public Record {
+public:
+    void add_string_value(std::string_view key, std::string value) {
+        m_elements.emplace_back(key, std::move(value));
+    }
+
+    void add_int64_value(std::string_view key, int64_t value) {
+        m_elements.emplace_back(key, value);
+    }
+
+    void add_double_value(std::string_view key, double value) {
+        m_elements.emplace_back(key, value);
+    }
+
+    [[nodiscard]] std::string_view get_string_view(std::string_view key) const override {
+        auto const* value = find<std::string>(key);
+        return nullptr == value ? std::string_view{} : std::string_view{*value};
+    }
+
+    [[nodiscard]] int64_t get_int64_value(std::string_view key) const override {
+        auto const* value = find<int64_t>(key);
+        return nullptr == value ? 0 : *value;
+    }
+
+    [[nodiscard]] double get_double_value(std::string_view key) const override {
+        auto const* value = find<double>(key);
+        return nullptr == value ? 0.0 : *value;
+    }
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+        return std::make_unique<TypedKeyIterator>(m_elements);
+    }
+
+private:
+    using Element = std::pair<std::string, std::variant<std::string, int64_t, double>>;
+
+    /**
+     * A RecordTypedKeyIterator over the elements of a KeyValueRecord.
+     */
+    class TypedKeyIterator : public RecordTypedKeyIterator {
+    public:
+        explicit TypedKeyIterator(std::vector<Element> const& elements)
+                : m_it{elements.cbegin()},
+                  m_end{elements.cend()} {}
+
+        TypedRecordKey get() override {
+            auto const& [key, value] = *m_it;
+            if (std::holds_alternative<int64_t>(value)) {
+                return {key, ValueType::Int64};
+            }
+            if (std::holds_alternative<double>(value)) {
+                return {key, ValueType::Double};
+            }
+            return {key, ValueType::String};
+        }
+
+        void next() override { ++m_it; }
+
+        bool done() override { return m_it == m_end; }
+
+    private:
+        std::vector<Element>::const_iterator m_it;
+        std::vector<Element>::const_iterator m_end;
+    };
+
+    /**
+     * @tparam ValueType
+     * @param key
+     * @return A pointer to the value of the first element with the given key, or nullptr if no
+     * such element exists or its value doesn't have the given type.
+     */
+    template <typename ValueType>
+    [[nodiscard]] ValueType const* find(std::string_view key) const {
+        for (auto const& [element_key, value] : m_elements) {
+            if (element_key == key) {
+                return std::get_if<ValueType>(&value);
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<Element> m_elements;
+};
+
 /**
  * Record implementation for an empty record.
  */
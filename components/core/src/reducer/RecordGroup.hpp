@@ -76,6 +76,33 @@ private:
     MultiRecordIterator m_iterator;
 };
 
+/**
+ * RecordGroup implementation that exposes a collection of KeyValueRecords with GroupTags.
+ *
+ * The Records and GroupTags can be updated allowing this class to act as an adapter for a larger
+ * set of data.
+ */
+class KeyValueRecordGroup : public RecordGroup {
+public:
+    KeyValueRecordGroup(GroupTags const* tags, std::vector<KeyValueRecord> const& records)
+            : m_tags{tags},
+              m_iterator{records} {}
+
+    [[nodiscard]] GroupTags const& get_tags() const override { return *m_tags; }
+
+    void set_tags(GroupTags const* tags) { m_tags = tags; }
+
+    void set_records(std::vector<KeyValueRecord> const& records) {
+        m_iterator = KeyValueRecordIterator(records);
+    }
+
+    [[nodiscard]] ConstRecordIterator& record_iter() override { return m_iterator; }
+
+private:
+    GroupTags const* m_tags{nullptr};
+    KeyValueRecordIterator m_iterator;
+};
+
 /**
  * Stubbed out RecordGroup with empty GroupTags and no records.
  */
@@ -0,0 +1,202 @@
+#include "TopKAggregate.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * @tparam CounterEntry A pair of a value and its counter.
+ * @param lhs
+ * @param rhs
+ * @return Whether the lhs value should be ordered before the rhs value in results, i.e., whether it
+ * has a larger count or, for equal counts, a lexicographically smaller value.
+ */
+template <typename CounterEntry>
+bool is_ordered_before(CounterEntry const& lhs, CounterEntry const& rhs) {
+    if (lhs.second.count != rhs.second.count) {
+        return lhs.second.count > rhs.second.count;
+    }
+    return lhs.first < rhs.first;
+}
+}  // namespace
+
+TopKAggregate::TopKAggregate(Config const& config)
+        : m_num_counters{std::max({config.k, config.num_counters, size_t{1}})} {
+    m_counters.reserve(m_num_counters);
+    m_heap.reserve(m_num_counters);
+}
+
+void TopKAggregate::add(Config const& config, Record const& record) {
+    auto const value = record.get_string_view(config.field_key);
+
+    if (auto it = m_counters.find(value); m_counters.end() != it) {
+        ++it->second.count;
+        sift_down(it->second.heap_idx);
+        return;
+    }
+
+    if (m_heap.size() < m_num_counters) {
+        auto [it, inserted] = m_counters.emplace(std::string{value}, Counter{1, 0, m_heap.size()});
+        m_heap.emplace_back(&*it);
+        sift_up(m_heap.size() - 1);
+        return;
+    }
+
+    // Replace the value with the minimum count, assuming the new value may have occurred as often
+    auto const min_count = m_heap.front()->second.count;
+    m_counters.erase(m_counters.find(m_heap.front()->first));
+    auto [it, inserted]
+            = m_counters.emplace(std::string{value}, Counter{min_count + 1, min_count, 0});
+    m_heap.front() = &*it;
+    sift_down(0);
+}
+
+void TopKAggregate::merge([[maybe_unused]] Config const& config, ConstRecordIterator& record_it) {
+    CounterMap other_counters;
+    int64_t other_min_count{0};
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        auto const count = record.get_int64_value(cCountKey);
+        auto const error = record.get_int64_value(cErrorKey);
+        auto const [it, inserted] = other_counters.try_emplace(
+                std::string{record.get_string_view(cValueKey)},
+                Counter{count, error, 0}
+        );
+        if (false == inserted) {
+            it->second.count += count;
+            it->second.error += error;
+        }
+        other_min_count = (1 == other_counters.size()) ? count : std::min(other_min_count, count);
+    }
+    if (other_counters.size() < m_num_counters) {
+        // The other aggregate wasn't full, so values it didn't track never occurred
+        other_min_count = 0;
+    }
+    auto const min_count = get_min_count_if_full();
+
+    std::vector<std::pair<std::string, Counter>> merged_counters;
+    merged_counters.reserve(m_counters.size() + other_counters.size());
+    for (auto const& [value, counter] : m_counters) {
+        Counter merged_counter{counter.count + other_min_count, counter.error + other_min_count, 0};
+        if (auto it = other_counters.find(value); other_counters.end() != it) {
+            merged_counter.count = counter.count + it->second.count;
+            merged_counter.error = counter.error + it->second.error;
+            other_counters.erase(it);
+        }
+        merged_counters.emplace_back(value, merged_counter);
+    }
+    for (auto& [value, counter] : other_counters) {
+        merged_counters.emplace_back(
+                value,
+                Counter{counter.count + min_count, counter.error + min_count, 0}
+        );
+    }
+    reset_counters(std::move(merged_counters));
+}
+
+void TopKAggregate::get_partial_result(
+        [[maybe_unused]] Config const& config,
+        std::vector<KeyValueRecord>& records
+) const {
+    for (auto const& [value, counter] : m_counters) {
+        auto& record = records.emplace_back();
+        record.add_string_value(cValueKey, value);
+        record.add_int64_value(cCountKey, counter.count);
+        record.add_int64_value(cErrorKey, counter.error);
+    }
+}
+
+void TopKAggregate::get_final_result(Config const& config, std::vector<KeyValueRecord>& records)
+        const {
+    std::vector<CounterMap::value_type const*> top_counters(m_heap.cbegin(), m_heap.cend());
+    auto const num_results = std::min(config.k, top_counters.size());
+    std::partial_sort(
+            top_counters.begin(),
+            top_counters.begin() + static_cast<std::ptrdiff_t>(num_results),
+            top_counters.end(),
+            [](auto const* lhs, auto const* rhs) { return is_ordered_before(*lhs, *rhs); }
+    );
+    for (size_t i = 0; i < num_results; ++i) {
+        auto const& [value, counter] = *top_counters[i];
+        auto& record = records.emplace_back();
+        record.add_string_value(cValueKey, value);
+        record.add_int64_value(cCountKey, counter.count);
+        record.add_int64_value(cErrorKey, counter.error);
+    }
+}
+
+int64_t TopKAggregate::get_min_count_if_full() const {
+    if (m_heap.empty() || m_heap.size() < m_num_counters) {
+        return 0;
+    }
+    return m_heap.front()->second.count;
+}
+
+void TopKAggregate::reset_counters(std::vector<std::pair<std::string, Counter>> counters) {
+    if (counters.size() > m_num_counters) {
+        std::nth_element(
+                counters.begin(),
+                counters.begin() + static_cast<std::ptrdiff_t>(m_num_counters),
+                counters.end(),
+                [](auto const& lhs, auto const& rhs) { return is_ordered_before(lhs, rhs); }
+        );
+        counters.resize(m_num_counters);
+    }
+
+    m_counters.clear();
+    m_heap.clear();
+    for (auto& [value, counter] : counters) {
+        counter.heap_idx = m_heap.size();
+        auto [it, inserted] = m_counters.emplace(std::move(value), counter);
+        m_heap.emplace_back(&*it);
+    }
+    for (auto i = m_heap.size() / 2; i > 0; --i) {
+        sift_down(i - 1);
+    }
+}
+
+void TopKAggregate::sift_up(size_t heap_idx) {
+    while (heap_idx > 0) {
+        auto const parent_idx = (heap_idx - 1) / 2;
+        if (m_heap[parent_idx]->second.count <= m_heap[heap_idx]->second.count) {
+            break;
+        }
+        swap_heap_entries(parent_idx, heap_idx);
+        heap_idx = parent_idx;
+    }
+}
+
+void TopKAggregate::sift_down(size_t heap_idx) {
+    while (true) {
+        auto min_idx = heap_idx;
+        for (auto const child_idx : {2 * heap_idx + 1, 2 * heap_idx + 2}) {
+            if (child_idx < m_heap.size()
+                && m_heap[child_idx]->second.count < m_heap[min_idx]->second.count)
+            {
+                min_idx = child_idx;
+            }
+        }
+        if (min_idx == heap_idx) {
+            break;
+        }
+        swap_heap_entries(heap_idx, min_idx);
+        heap_idx = min_idx;
+    }
+}
+
+void TopKAggregate::swap_heap_entries(size_t lhs_idx, size_t rhs_idx) {
+    std::swap(m_heap[lhs_idx], m_heap[rhs_idx]);
+    m_heap[lhs_idx]->second.heap_idx = lhs_idx;
+    m_heap[rhs_idx]->second.heap_idx = rhs_idx;
+}
+}  // namespace reducer
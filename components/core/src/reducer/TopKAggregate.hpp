@@ -0,0 +1,124 @@
+#ifndef REDUCER_TOPKAGGREGATE_HPP
+#define REDUCER_TOPKAGGREGATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AggregationOperator.hpp"
+#include "ConstRecordIterator.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+/**
+ * Aggregate that finds the most frequent values of a string field using the Space-Saving algorithm.
+ *
+ * The aggregate tracks at most `Config::num_counters` values. Each tracked value has a count that
+ * overestimates its true frequency by at most its error, and any value whose true frequency exceeds
+ * (total number of records / num_counters) is guaranteed to be tracked. Summaries are merged by
+ * summing the counts of each value, where a value missing from a full summary is assumed to have
+ * that summary's minimum count (the largest count it could have had without being tracked).
+ */
+class TopKAggregate {
+public:
+    struct Config {
+        // Constants
+        static constexpr size_t cDefaultK{10};
+        static constexpr size_t cDefaultNumCounters{100};
+
+        // Variables
+        // The key of the field to aggregate, read using Record::get_string_view.
+        std::string field_key;
+        // The number of values in the final result.
+        size_t k{cDefaultK};
+        // The number of values tracked by each aggregate. Larger values improve accuracy. Values
+        // smaller than `k` are treated as `k`.
+        size_t num_counters{cDefaultNumCounters};
+    };
+
+    static constexpr std::string_view cValueKey{"value"};
+    static constexpr std::string_view cCountKey{"count"};
+    static constexpr std::string_view cErrorKey{"error"};
+
+    explicit TopKAggregate(Config const& config);
+
+    void add(Config const& config, Record const& record);
+
+    void merge(Config const& config, ConstRecordIterator& record_it);
+
+    void get_partial_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+    /**
+     * Appends the (at most) `Config::k` values with the largest counts, in descending order of
+     * count.
+     */
+    void get_final_result(Config const& config, std::vector<KeyValueRecord>& records) const;
+
+private:
+    // Types
+    struct Counter {
+        int64_t count{0};
+        // An upper bound on how much `count` overestimates the value's true frequency
+        int64_t error{0};
+        size_t heap_idx{0};
+    };
+
+    // Hash that allows looking up counters using string views
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    using CounterMap = std::unordered_map<std::string, Counter, StringHash, std::equal_to<>>;
+
+    // Methods
+    /**
+     * @return The minimum count of all tracked values if the aggregate is full, or 0 otherwise.
+     */
+    [[nodiscard]] int64_t get_min_count_if_full() const;
+
+    /**
+     * Replaces all counters with the given ones, keeping only the `m_num_counters` with the
+     * largest counts.
+     * @param counters
+     */
+    void reset_counters(std::vector<std::pair<std::string, Counter>> counters);
+
+    /**
+     * Restores the min-heap property by moving the counter at the given index towards the root.
+     * @param heap_idx
+     */
+    void sift_up(size_t heap_idx);
+
+    /**
+     * Restores the min-heap property by moving the counter at the given index towards the leaves.
+     * @param heap_idx
+     */
+    void sift_down(size_t heap_idx);
+
+    /**
+     * Swaps two counters in the heap, updating their heap indices.
+     * @param lhs_idx
+     * @param rhs_idx
+     */
+    void swap_heap_entries(size_t lhs_idx, size_t rhs_idx);
+
+    // Variables
+    size_t m_num_counters;
+    CounterMap m_counters;
+    // Min-heap (by count) of pointers into m_counters, whose nodes have stable addresses
+    std::vector<CounterMap::value_type*> m_heap;
+};
+
+using TopKOperator = AggregationOperator<TopKAggregate>;
+}  // namespace reducer
+
+#endif  // REDUCER_TOPKAGGREGATE_HPP
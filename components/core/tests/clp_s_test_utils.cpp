@@ -18,7 +18,8 @@ auto compress_archive(
         std::optional<std::string> timestamp_key,
         bool retain_float_format,
         bool single_file_archive,
-        bool structurize_arrays
+        bool structurize_arrays,
+        bool index_dictionaries
 ) -> std::vector<clp_s::ArchiveStats> {
     constexpr auto cDefaultTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
     constexpr auto cDefaultMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
@@ -42,6 +43,7 @@ auto compress_archive(
     parser_option.retain_float_format = retain_float_format;
     parser_option.structurize_arrays = structurize_arrays;
     parser_option.single_file_archive = single_file_archive;
+    parser_option.index_dictionaries = index_dictionaries;
     if (timestamp_key.has_value()) {
         parser_option.timestamp_key = std::move(timestamp_key.value());
     }
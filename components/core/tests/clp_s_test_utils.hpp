@@ -19,6 +19,7 @@
  * @param retain_float_format
  * @param single_file_archive
  * @param structurize_arrays
+ * @param index_dictionaries
  * @return Statistics for every compressed archive.
  */
 [[nodiscard]] auto compress_archive(
@@ -27,6 +28,7 @@
         std::optional<std::string> timestamp_key,
         bool retain_float_format,
         bool single_file_archive,
-        bool structurize_arrays
+        bool structurize_arrays,
+        bool index_dictionaries = false
 ) -> std::vector<clp_s::ArchiveStats>;
 #endif  // CLP_S_TEST_UTILS_HPP
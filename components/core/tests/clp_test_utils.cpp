@@ -0,0 +1,110 @@
+#include "clp_test_utils.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/clp/CommandLineArguments.hpp"
+#include "../src/clp/clp/compression.hpp"
+#include "../src/clp/clp/FileToCompress.hpp"
+#include "../src/clp/clp/utils.hpp"
+
+void write_clp_test_log_files(std::string const& dir, size_t num_files, size_t num_lines_per_file) {
+    std::filesystem::create_directories(dir);
+    for (size_t file_ix{0}; file_ix < num_files; ++file_ix) {
+        std::ofstream file{std::filesystem::path{dir} / fmt::format("log-{}.txt", file_ix)};
+        for (size_t line_ix{0}; line_ix < num_lines_per_file; ++line_ix) {
+            auto const seconds{file_ix * num_lines_per_file + line_ix};
+            file << fmt::format(
+                    "2024-01-{:02} {:02}:{:02}:{:02}.{:03} INFO ",
+                    1 + file_ix,
+                    seconds / 3600 % 24,
+                    seconds / 60 % 60,
+                    seconds % 60,
+                    line_ix % 1000
+            );
+            switch ((file_ix + line_ix) % 4) {
+                case 0:
+                    file << fmt::format("Task task_{} finished in {} ms\n", line_ix, file_ix);
+                    break;
+                case 1:
+                    file << fmt::format(
+                            "Read {:.3f} MB from /data/file-{}-{}.bin\n",
+                            static_cast<double>(line_ix) / 7.0,
+                            file_ix,
+                            line_ix % 13
+                    );
+                    break;
+                case 2:
+                    file << fmt::format(
+                            "Container 0x{:x} on host-{} restarted\n",
+                            line_ix,
+                            file_ix
+                    );
+                    break;
+                default:
+                    file << fmt::format("File {} only message {}\n", file_ix, line_ix * 3);
+                    break;
+            }
+        }
+        file << "2024-02-01 00:00:00.000 ERROR Unexpected exception\n    at frame " << file_ix;
+    }
+}
+
+void parse_clp_arguments(
+        std::vector<std::string> const& arguments,
+        clp::clp::CommandLineArguments& command_line_args
+) {
+    std::vector<char const*> argv{"clp"};
+    for (auto const& arg : arguments) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+    REQUIRE(clp::clp::CommandLineArguments::ParsingResult::Success
+            == command_line_args.parse_arguments(static_cast<int>(argv.size() - 1), argv.data()));
+}
+
+void compress_with_clp(
+        std::string const& input_dir,
+        std::string const& archives_dir,
+        std::vector<std::string> const& options
+) {
+    auto const absolute_input_dir{std::filesystem::absolute(input_dir).string()};
+    std::vector<std::string> arguments{
+            "c",
+            archives_dir,
+            absolute_input_dir,
+            "--remove-path-prefix",
+            absolute_input_dir
+    };
+    arguments.insert(arguments.end(), options.cbegin(), options.cend());
+    clp::clp::CommandLineArguments command_line_args{"clp"};
+    parse_clp_arguments(arguments, command_line_args);
+
+    boost::filesystem::path path_prefix_to_remove{command_line_args.get_path_prefix_to_remove()};
+    std::vector<clp::clp::FileToCompress> files_to_compress;
+    std::vector<std::string> empty_directory_paths;
+    REQUIRE(clp::clp::find_all_files_and_empty_directories(
+            path_prefix_to_remove,
+            absolute_input_dir,
+            files_to_compress,
+            empty_directory_paths
+    ));
+
+    std::vector<clp::clp::FileToCompress> grouped_files_to_compress;
+    REQUIRE(clp::clp::compress(
+            command_line_args,
+            files_to_compress,
+            empty_directory_paths,
+            grouped_files_to_compress,
+            command_line_args.get_target_encoded_file_size(),
+            nullptr,
+            true
+    ));
+}
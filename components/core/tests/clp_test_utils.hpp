@@ -0,0 +1,48 @@
+#ifndef CLP_TEST_UTILS_HPP
+#define CLP_TEST_UTILS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../src/clp/clp/CommandLineArguments.hpp"
+
+/**
+ * Writes unstructured log files into a directory. Each file uses a mix of logtypes and variables
+ * that overlaps with the other files', and ends with a multi-line message without a trailing
+ * newline.
+ * @param dir
+ * @param num_files
+ * @param num_lines_per_file
+ */
+void write_clp_test_log_files(std::string const& dir, size_t num_files, size_t num_lines_per_file);
+
+/**
+ * Parses the given `clp` command line arguments.
+ *
+ * This helper uses `REQUIRE...` statements to assert that parsing was successful.
+ *
+ * @param arguments The arguments, excluding the program name
+ * @param command_line_args Returns the parsed arguments
+ */
+void parse_clp_arguments(
+        std::vector<std::string> const& arguments,
+        clp::clp::CommandLineArguments& command_line_args
+);
+
+/**
+ * Compresses every file in a directory using `clp::clp::compress` with the heuristic parser. The
+ * directory's path is removed from the paths of the compressed files.
+ *
+ * This helper uses `REQUIRE...` statements to assert that compression was successful.
+ *
+ * @param input_dir
+ * @param archives_dir
+ * @param options Additional compression options
+ */
+void compress_with_clp(
+        std::string const& input_dir,
+        std::string const& archives_dir,
+        std::vector<std::string> const& options
+);
+#endif  // CLP_TEST_UTILS_HPP
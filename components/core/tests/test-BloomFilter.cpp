@@ -0,0 +1,54 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/BloomFilter.hpp"
+
+using clp_s::BloomFilter;
+
+namespace {
+constexpr size_t cNumValues = 10'000;
+}  // namespace
+
+TEST_CASE("clp-s-bloom-filter", "[clp-s][BloomFilter]") {
+    BloomFilter filter{cNumValues};
+    // Add the even numbers so that the odd numbers can be used to measure false positives
+    for (uint64_t i = 0; i < cNumValues; ++i) {
+        filter.add(2 * i);
+    }
+
+    SECTION("No false negatives") {
+        for (uint64_t i = 0; i < cNumValues; ++i) {
+            REQUIRE(filter.possibly_contains(2 * i));
+        }
+    }
+
+    SECTION("Few false positives") {
+        size_t num_false_positives{0};
+        for (uint64_t i = 0; i < cNumValues; ++i) {
+            if (filter.possibly_contains(2 * i + 1)) {
+                ++num_false_positives;
+            }
+        }
+        // Allow for a false positive rate well above the expected ~1%
+        REQUIRE(num_false_positives < cNumValues / 20);
+    }
+
+    SECTION("Serialization round trip") {
+        auto const deserialized_filter = BloomFilter::try_deserialize(filter.serialize());
+        REQUIRE(deserialized_filter.has_value());
+        for (uint64_t i = 0; i < 2 * cNumValues; ++i) {
+            REQUIRE(filter.possibly_contains(i) == deserialized_filter->possibly_contains(i));
+        }
+    }
+
+    SECTION("Invalid serialized filters") {
+        REQUIRE_FALSE(BloomFilter::try_deserialize({}).has_value());
+        auto bytes = filter.serialize();
+        bytes.pop_back();
+        REQUIRE_FALSE(BloomFilter::try_deserialize(bytes).has_value());
+    }
+}
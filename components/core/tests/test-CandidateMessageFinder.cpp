@@ -0,0 +1,224 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_archive/reader/CandidateMessageFinder.hpp"
+
+using clp::epochtime_t;
+using clp::logtype_dictionary_id_t;
+using clp::Query;
+using clp::segment_id_t;
+using clp::streaming_archive::reader::CandidateMessageFinder;
+using clp::SubQuery;
+using std::vector;
+
+namespace {
+constexpr segment_id_t cSegmentId{0};
+
+/**
+ * Creates a query whose subqueries are all relevant to `cSegmentId`.
+ * @param search_begin_ts
+ * @param search_end_ts
+ * @param possible_logtypes_per_sub_query
+ * @return The query
+ */
+auto create_query(
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        vector<std::unordered_set<logtype_dictionary_id_t>> const& possible_logtypes_per_sub_query
+) -> Query;
+
+/**
+ * @param finder
+ * @param num_messages
+ * @return The indices of every candidate message, found using `get_next_candidate_msg_ix`.
+ */
+auto get_candidate_msgs(CandidateMessageFinder const& finder, size_t num_messages)
+        -> vector<size_t>;
+
+/**
+ * Finds the candidate messages the way `File::find_message_matching_query` did before it used
+ * `CandidateMessageFinder`, i.e., by checking every message against the query.
+ * @param query
+ * @param logtypes
+ * @param timestamps
+ * @return The indices of every candidate message
+ */
+auto get_expected_candidate_msgs(
+        Query const& query,
+        vector<logtype_dictionary_id_t> const& logtypes,
+        vector<epochtime_t> const& timestamps
+) -> vector<size_t>;
+
+auto create_query(
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        vector<std::unordered_set<logtype_dictionary_id_t>> const& possible_logtypes_per_sub_query
+) -> Query {
+    vector<SubQuery> sub_queries(possible_logtypes_per_sub_query.size());
+    for (size_t i = 0; i < sub_queries.size(); ++i) {
+        sub_queries[i].set_possible_logtypes(possible_logtypes_per_sub_query[i]);
+    }
+    Query query{search_begin_ts, search_end_ts, false, "*", std::move(sub_queries)};
+
+    std::set<segment_id_t> const segment_ids{cSegmentId};
+    query.calculate_ids_of_matching_segments(
+            [&](logtype_dictionary_id_t) -> std::set<segment_id_t> const& { return segment_ids; },
+            [&](clp::variable_dictionary_id_t) -> std::set<segment_id_t> const& {
+                return segment_ids;
+            }
+    );
+    query.make_sub_queries_relevant_to_segment(cSegmentId);
+    return query;
+}
+
+auto get_candidate_msgs(CandidateMessageFinder const& finder, size_t num_messages)
+        -> vector<size_t> {
+    vector<size_t> candidate_msgs;
+    for (auto msg_ix{finder.get_next_candidate_msg_ix(0)}; msg_ix < num_messages;
+         msg_ix = finder.get_next_candidate_msg_ix(msg_ix + 1))
+    {
+        candidate_msgs.push_back(msg_ix);
+    }
+    return candidate_msgs;
+}
+
+auto get_expected_candidate_msgs(
+        Query const& query,
+        vector<logtype_dictionary_id_t> const& logtypes,
+        vector<epochtime_t> const& timestamps
+) -> vector<size_t> {
+    vector<size_t> candidate_msgs;
+    for (size_t msg_ix = 0; msg_ix < logtypes.size(); ++msg_ix) {
+        if (false == query.timestamp_is_in_search_time_range(timestamps[msg_ix])) {
+            continue;
+        }
+        for (auto const* sub_query : query.get_relevant_sub_queries()) {
+            if (sub_query->matches_logtype(logtypes[msg_ix])) {
+                candidate_msgs.push_back(msg_ix);
+                break;
+            }
+        }
+    }
+    return candidate_msgs;
+}
+}  // namespace
+
+TEST_CASE("CandidateMessageFinder", "[CandidateMessageFinder]") {
+    // 150 messages span three bitmap words, the last of which is partially used
+    constexpr size_t cNumMessages{150};
+    constexpr epochtime_t cBeginTs{1000};
+    vector<logtype_dictionary_id_t> logtypes(cNumMessages);
+    vector<epochtime_t> timestamps(cNumMessages);
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        // Logtype IDs are sparse in the dictionary's ID space
+        logtypes[i] = (0 == i % 3) ? 5 : ((1 == i % 3) ? 900'000 : 17);
+        timestamps[i] = cBeginTs + static_cast<epochtime_t>(i);
+    }
+
+    CandidateMessageFinder finder;
+    REQUIRE_FALSE(finder.is_indexed());
+    finder.index_logtypes(logtypes.data(), cNumMessages);
+    REQUIRE(finder.is_indexed());
+    REQUIRE((vector<logtype_dictionary_id_t>{5, 900'000, 17} == finder.get_logtype_ids()));
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        REQUIRE(logtypes[i] == finder.get_logtype_ids()[finder.get_msg_logtype_ix(i)]);
+    }
+
+    SECTION("Timestamp bounds are inclusive") {
+        // Messages 63 and 129 use logtype 5 and lie in the first and last bitmap words
+        auto const query{create_query(cBeginTs + 63, cBeginTs + 129, {{5, 17}})};
+        finder.compute_candidate_msgs(query, timestamps.data());
+        auto const candidate_msgs{get_candidate_msgs(finder, cNumMessages)};
+        REQUIRE(get_expected_candidate_msgs(query, logtypes, timestamps) == candidate_msgs);
+        REQUIRE(63 == candidate_msgs.front());
+        REQUIRE(129 == candidate_msgs.back());
+    }
+
+    SECTION("Logtypes the file doesn't use are never candidates") {
+        auto const query{create_query(clp::cEpochTimeMin, clp::cEpochTimeMax, {{4, 6, 1'000'000}})};
+        finder.compute_candidate_msgs(query, timestamps.data());
+        REQUIRE(get_candidate_msgs(finder, cNumMessages).empty());
+    }
+
+    SECTION("Messages matching any relevant subquery are candidates") {
+        auto const query{create_query(clp::cEpochTimeMin, clp::cEpochTimeMax, {{4}, {900'000}})};
+        finder.compute_candidate_msgs(query, timestamps.data());
+        auto const candidate_msgs{get_candidate_msgs(finder, cNumMessages)};
+        REQUIRE(cNumMessages / 3 == candidate_msgs.size());
+        REQUIRE(get_expected_candidate_msgs(query, logtypes, timestamps) == candidate_msgs);
+    }
+
+    SECTION("Candidates are recomputed for each query") {
+        auto const first_query{create_query(clp::cEpochTimeMin, clp::cEpochTimeMax, {{5}})};
+        finder.compute_candidate_msgs(first_query, timestamps.data());
+        REQUIRE(cNumMessages / 3 == get_candidate_msgs(finder, cNumMessages).size());
+
+        auto const second_query{create_query(cBeginTs, cBeginTs - 1, {{5, 17, 900'000}})};
+        finder.compute_candidate_msgs(second_query, timestamps.data());
+        REQUIRE(get_candidate_msgs(finder, cNumMessages).empty());
+    }
+
+    SECTION("Clearing the finder") {
+        finder.clear();
+        REQUIRE_FALSE(finder.is_indexed());
+        REQUIRE(finder.get_logtype_ids().empty());
+        REQUIRE(0 == finder.get_next_candidate_msg_ix(0));
+    }
+}
+
+TEST_CASE("CandidateMessageFinder-empty-file", "[CandidateMessageFinder]") {
+    CandidateMessageFinder finder;
+    finder.index_logtypes(nullptr, 0);
+    REQUIRE(finder.get_logtype_ids().empty());
+    auto const query{create_query(clp::cEpochTimeMin, clp::cEpochTimeMax, {{0}})};
+    finder.compute_candidate_msgs(query, nullptr);
+    REQUIRE(0 == finder.get_next_candidate_msg_ix(0));
+}
+
+TEST_CASE("CandidateMessageFinder-matches-per-message-search", "[CandidateMessageFinder]") {
+    constexpr size_t cNumMessages{10'000};
+    constexpr logtype_dictionary_id_t cMaxLogtypeId{40};
+    constexpr epochtime_t cMaxTs{5000};
+
+    std::mt19937 rng{3};
+    std::uniform_int_distribution<logtype_dictionary_id_t> logtype_dist{0, cMaxLogtypeId};
+    std::uniform_int_distribution<epochtime_t> ts_dist{0, cMaxTs};
+    vector<logtype_dictionary_id_t> logtypes(cNumMessages);
+    vector<epochtime_t> timestamps(cNumMessages);
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        logtypes[i] = logtype_dist(rng);
+        timestamps[i] = ts_dist(rng);
+    }
+
+    CandidateMessageFinder finder;
+    finder.index_logtypes(logtypes.data(), cNumMessages);
+    for (int i = 0; i < 20; ++i) {
+        vector<std::unordered_set<logtype_dictionary_id_t>> possible_logtypes_per_sub_query(
+                1 + i % 3
+        );
+        for (auto& possible_logtypes : possible_logtypes_per_sub_query) {
+            for (int j = 0; j < 4; ++j) {
+                // Include IDs the file doesn't use
+                possible_logtypes.insert(logtype_dist(rng) * 2);
+            }
+        }
+        auto begin_ts{ts_dist(rng)};
+        auto end_ts{ts_dist(rng)};
+        if (begin_ts > end_ts) {
+            std::swap(begin_ts, end_ts);
+        }
+        auto const query{create_query(begin_ts, end_ts, possible_logtypes_per_sub_query)};
+        finder.compute_candidate_msgs(query, timestamps.data());
+        REQUIRE(get_expected_candidate_msgs(query, logtypes, timestamps)
+                == get_candidate_msgs(finder, cNumMessages));
+    }
+}
@@ -22,6 +22,7 @@
 #include "../src/clp/streaming_compression/passthrough/Compressor.hpp"
 #include "../src/clp/streaming_compression/passthrough/Decompressor.hpp"
 #include "../src/clp/streaming_compression/zstd/Compressor.hpp"
+#include "../src/clp/streaming_compression/zstd/Constants.hpp"
 #include "../src/clp/streaming_compression/zstd/Decompressor.hpp"
 
 using clp::ErrorCode_Success;
@@ -124,6 +125,59 @@ TEST_CASE("StreamingCompression", "[StreamingCompression]") {
         decompress_and_compare(std::move(decompressor), uncompressed_buffer, decompressed_buffer);
     }
 
+    SECTION("ZStd seekable compression") {
+        constexpr size_t cMaxFrameSize{cBufferSize / 16};
+        auto zstd_compressor = std::make_unique<clp::streaming_compression::zstd::Compressor>();
+        FileWriter file_writer;
+        file_writer.open(string(cCompressedFilePath), FileWriter::OpenMode::CREATE_FOR_WRITING);
+        zstd_compressor->open(
+                file_writer,
+                clp::streaming_compression::zstd::cDefaultCompressionLevel,
+                cMaxFrameSize
+        );
+        for (auto const chunk_size : cCompressionChunkSizes) {
+            zstd_compressor->write(uncompressed_buffer.data(), chunk_size);
+        }
+        zstd_compressor->close();
+        file_writer.close();
+
+        decompressor = std::make_unique<clp::streaming_compression::zstd::Decompressor>();
+        decompress_and_compare(std::move(decompressor), uncompressed_buffer, decompressed_buffer);
+
+        // Seeking backwards should jump to the frame containing the target position. Every
+        // position is within the last chunk written, which holds the entire source buffer.
+        auto const last_chunk_offset{
+                std::accumulate(
+                        cCompressionChunkSizes.cbegin(),
+                        cCompressionChunkSizes.cend(),
+                        size_t{0}
+                )
+                - cBufferSize
+        };
+        clp::ReadOnlyMemoryMappedFile const memory_mapped_compressed_file{
+                string(cCompressedFilePath)
+        };
+        auto const compressed_file_view{memory_mapped_compressed_file.get_view()};
+        clp::streaming_compression::zstd::Decompressor zstd_decompressor;
+        zstd_decompressor.open(compressed_file_view.data(), compressed_file_view.size());
+        constexpr size_t cRegionSize{cAlphabetLength * 4};
+        for (size_t const offset : {cBufferSize - cRegionSize, cMaxFrameSize * 3 + 5, size_t{7}}) {
+            REQUIRE(
+                    (ErrorCode_Success
+                     == zstd_decompressor.get_decompressed_stream_region(
+                             last_chunk_offset + offset,
+                             decompressed_buffer.data(),
+                             cRegionSize
+                     ))
+            );
+            REQUIRE(std::equal(
+                    decompressed_buffer.begin(),
+                    decompressed_buffer.begin() + cRegionSize,
+                    uncompressed_buffer.begin() + offset
+            ));
+        }
+    }
+
     SECTION("Passthrough compression") {
         compressor = std::make_unique<clp::streaming_compression::passthrough::Compressor>();
         compress(std::move(compressor), uncompressed_buffer.data());
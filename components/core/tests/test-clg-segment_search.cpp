@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <log_surgeon/Lexer.hpp>
+
+#include "../src/clp/clg/CommandLineArguments.hpp"
+#include "../src/clp/clg/segment_search.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/GrepCore.hpp"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+#include "../src/clp/streaming_archive/reader/Message.hpp"
+#include "clp_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp::clg::CommandLineArguments;
+using clp::epochtime_t;
+using clp::logtype_dictionary_id_t;
+using clp::Query;
+using clp::segment_id_t;
+using clp::streaming_archive::reader::Archive;
+
+namespace {
+constexpr std::string_view cInputDirectory{"test-clg-segment-search-input"};
+constexpr std::string_view cArchivesDirectory{"test-clg-segment-search-archives"};
+constexpr size_t cNumInputFiles{9};
+constexpr size_t cNumLinesPerFile{500};
+
+// A result in the layout of clg's binary output
+using Result = std::tuple<std::string, epochtime_t, logtype_dictionary_id_t, std::string>;
+
+/**
+ * Creates the queries for the given search strings the way clg does.
+ * @param search_strings
+ * @param search_begin_ts
+ * @param search_end_ts
+ * @param archive
+ * @return The queries, which consist of a single query if any search string supersedes the rest
+ */
+auto create_queries(
+        std::vector<std::string> const& search_strings,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive
+) -> std::vector<Query>;
+
+/**
+ * Searches the archive serially, the way clg does with a single thread.
+ * @param queries
+ * @param search_begin_ts
+ * @param search_end_ts
+ * @param archive
+ * @param results Returns the sorted results
+ * @return The number of matches
+ */
+auto search_serially(
+        std::vector<Query> queries,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive,
+        std::vector<Result>& results
+) -> size_t;
+
+/**
+ * Searches the archive using `clp::clg::search_segments_in_parallel`.
+ * @param queries
+ * @param search_begin_ts
+ * @param search_end_ts
+ * @param archive
+ * @param output_method
+ * @param num_threads
+ * @param output Returns the output
+ * @return The number of matches
+ */
+auto search_in_parallel(
+        std::vector<Query> const& queries,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive,
+        CommandLineArguments::OutputMethod output_method,
+        size_t num_threads,
+        std::string& output
+) -> size_t;
+
+/**
+ * @param output Results output in clg's binary format
+ * @return The sorted results
+ */
+auto parse_binary_results(std::string_view output) -> std::vector<Result>;
+
+/**
+ * @param output
+ * @return The sorted lines of the output
+ */
+auto get_sorted_lines(std::string_view output) -> std::vector<std::string>;
+
+auto create_queries(
+        std::vector<std::string> const& search_strings,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive
+) -> std::vector<Query> {
+    auto const& logtype_dict{archive.get_logtype_dictionary()};
+    auto const& var_dict{archive.get_var_dictionary()};
+    log_surgeon::lexers::ByteLexer lexer;
+    std::vector<Query> queries;
+    for (auto const& search_string : search_strings) {
+        auto query_processing_result = clp::GrepCore::process_raw_query(
+                logtype_dict,
+                var_dict,
+                search_string,
+                search_begin_ts,
+                search_end_ts,
+                false,
+                lexer,
+                true
+        );
+        if (false == query_processing_result.has_value()) {
+            continue;
+        }
+        auto& query = query_processing_result.value();
+        if (false == query.contains_sub_queries()) {
+            return {query};
+        }
+        query.calculate_ids_of_matching_segments(
+                [&](logtype_dictionary_id_t id) -> std::set<segment_id_t> const& {
+                    return logtype_dict.get_entry(id).get_ids_of_segments_containing_entry();
+                },
+                [&](clp::variable_dictionary_id_t id) -> std::set<segment_id_t> const& {
+                    return var_dict.get_entry(id).get_ids_of_segments_containing_entry();
+                }
+        );
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+auto search_serially(
+        std::vector<Query> queries,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive,
+        std::vector<Result>& results
+) -> size_t {
+    auto collect_result = [](std::string const& orig_file_path,
+                             clp::streaming_archive::reader::Message const& compressed_msg,
+                             std::string const& decompressed_msg,
+                             void* custom_arg) {
+        static_cast<std::vector<Result>*>(custom_arg)->emplace_back(
+                orig_file_path,
+                compressed_msg.get_ts_in_milli(),
+                compressed_msg.get_logtype_id(),
+                decompressed_msg
+        );
+    };
+
+    size_t num_matches{0};
+    if (1 == queries.size() && false == queries.front().contains_sub_queries()) {
+        auto file_metadata_ix
+                = archive.get_file_iterator(search_begin_ts, search_end_ts, "", false);
+        num_matches = clp::clg::search_files(
+                queries,
+                collect_result,
+                &results,
+                archive,
+                nullptr,
+                *file_metadata_ix
+        );
+    } else {
+        std::set<segment_id_t> ids_of_segments_to_search;
+        for (auto const& query : queries) {
+            for (auto const& sub_query : query.get_sub_queries()) {
+                auto const& ids = sub_query.get_ids_of_matching_segments();
+                ids_of_segments_to_search.insert(ids.cbegin(), ids.cend());
+            }
+        }
+        auto file_metadata_ix_ptr = archive.get_file_iterator(
+                search_begin_ts,
+                search_end_ts,
+                "",
+                clp::cInvalidSegmentId,
+                false
+        );
+        auto& file_metadata_ix = *file_metadata_ix_ptr;
+        num_matches = clp::clg::search_files(
+                queries,
+                collect_result,
+                &results,
+                archive,
+                nullptr,
+                file_metadata_ix
+        );
+        for (auto const segment_id : ids_of_segments_to_search) {
+            file_metadata_ix.set_segment_id(segment_id);
+            num_matches += clp::clg::search_files(
+                    queries,
+                    collect_result,
+                    &results,
+                    archive,
+                    nullptr,
+                    file_metadata_ix
+            );
+        }
+    }
+    std::ranges::sort(results);
+    return num_matches;
+}
+
+auto search_in_parallel(
+        std::vector<Query> const& queries,
+        epochtime_t search_begin_ts,
+        epochtime_t search_end_ts,
+        Archive& archive,
+        CommandLineArguments::OutputMethod output_method,
+        size_t num_threads,
+        std::string& output
+) -> size_t {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> const output_file{
+            std::tmpfile(),
+            &std::fclose
+    };
+    REQUIRE(nullptr != output_file);
+
+    std::string const file_path;
+    clp::clg::ParallelSearchConfig const config{
+            .queries = queries,
+            .archive = archive,
+            .search_begin_ts = search_begin_ts,
+            .search_end_ts = search_end_ts,
+            .file_path = file_path,
+            .output_method = output_method,
+            .output_file = output_file.get()
+    };
+    auto const num_matches{clp::clg::search_segments_in_parallel(
+            config,
+            clp::clg::get_ids_of_segments_to_search(
+                    queries,
+                    archive,
+                    search_begin_ts,
+                    search_end_ts,
+                    file_path
+            ),
+            num_threads
+    )};
+
+    output.resize(static_cast<size_t>(std::ftell(output_file.get())));
+    std::rewind(output_file.get());
+    REQUIRE(output.size() == std::fread(output.data(), 1, output.size(), output_file.get()));
+    return num_matches;
+}
+
+auto parse_binary_results(std::string_view output) -> std::vector<Result> {
+    auto read_value = [&output](auto& value) {
+        REQUIRE(sizeof(value) <= output.size());
+        std::copy_n(output.data(), sizeof(value), reinterpret_cast<char*>(&value));
+        output.remove_prefix(sizeof(value));
+    };
+    auto read_string = [&](std::string& str) {
+        size_t length{};
+        read_value(length);
+        REQUIRE(length <= output.size());
+        str.assign(output.substr(0, length));
+        output.remove_prefix(length);
+    };
+
+    std::vector<Result> results;
+    while (false == output.empty()) {
+        auto& [path, timestamp, logtype_id, msg] = results.emplace_back();
+        read_string(path);
+        read_value(timestamp);
+        read_value(logtype_id);
+        read_string(msg);
+    }
+    std::ranges::sort(results);
+    return results;
+}
+
+auto get_sorted_lines(std::string_view output) -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    while (false == output.empty()) {
+        auto const newline_pos{output.find('\n')};
+        auto const line_length{
+                std::string_view::npos == newline_pos ? output.size() : newline_pos + 1
+        };
+        lines.emplace_back(output.substr(0, line_length));
+        output.remove_prefix(line_length);
+    }
+    std::ranges::sort(lines);
+    return lines;
+}
+}  // namespace
+
+TEST_CASE("clg-search-segments-in-parallel", "[clp][clg][search]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cInputDirectory}, std::string{cArchivesDirectory}}
+    };
+
+    write_clp_test_log_files(std::string{cInputDirectory}, cNumInputFiles, cNumLinesPerFile);
+    // Small segments and encoded files spread each input file over many segments
+    compress_with_clp(
+            std::string{cInputDirectory},
+            std::string{cArchivesDirectory},
+            {"--target-segment-size", "8192", "--target-encoded-file-size", "4096"}
+    );
+
+    std::vector<std::filesystem::path> archive_paths;
+    for (auto const& entry : std::filesystem::directory_iterator{cArchivesDirectory}) {
+        if (entry.is_directory()) {
+            archive_paths.push_back(entry.path());
+        }
+    }
+    REQUIRE(1 == archive_paths.size());
+    Archive archive;
+    archive.open(archive_paths.front().string());
+    archive.refresh_dictionaries();
+
+    auto const search_strings = GENERATE(
+            std::vector<std::string>{"*"},
+            std::vector<std::string>{"*finished in 3 ms*"},
+            std::vector<std::string>{"*file-4-*", "*host-2 *", "*at frame 7*"},
+            std::vector<std::string>{"*0x1f *", "*"},
+            std::vector<std::string>{"*no such message*"}
+    );
+    auto const [search_begin_ts, search_end_ts] = GENERATE(
+            std::make_tuple(clp::cEpochTimeMin, clp::cEpochTimeMax),
+            // 2024-01-03 00:00:00 to 2024-01-05 00:00:00 UTC
+            std::make_tuple(epochtime_t{1'704'240'000'000}, epochtime_t{1'704'412'800'000})
+    );
+    auto const num_threads = GENERATE(as<size_t>{}, 2, 5, 64);
+
+    auto const queries{create_queries(search_strings, search_begin_ts, search_end_ts, archive)};
+    std::vector<Result> expected_results;
+    auto const expected_num_matches{
+            search_serially(queries, search_begin_ts, search_end_ts, archive, expected_results)
+    };
+    REQUIRE(expected_num_matches == expected_results.size());
+
+    std::string binary_output;
+    REQUIRE(expected_num_matches
+            == search_in_parallel(
+                    queries,
+                    search_begin_ts,
+                    search_end_ts,
+                    archive,
+                    CommandLineArguments::OutputMethod::StdoutBinary,
+                    num_threads,
+                    binary_output
+            ));
+    REQUIRE(expected_results == parse_binary_results(binary_output));
+
+    std::string expected_text_output;
+    for (auto const& [path, timestamp, logtype_id, msg] : expected_results) {
+        expected_text_output += path + ':' + msg;
+    }
+    std::string text_output;
+    REQUIRE(expected_num_matches
+            == search_in_parallel(
+                    queries,
+                    search_begin_ts,
+                    search_end_ts,
+                    archive,
+                    CommandLineArguments::OutputMethod::StdoutText,
+                    num_threads,
+                    text_output
+            ));
+    REQUIRE(get_sorted_lines(expected_text_output) == get_sorted_lines(text_output));
+
+    archive.close();
+}
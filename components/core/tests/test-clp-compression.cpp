@@ -0,0 +1,106 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/clp/clp/CommandLineArguments.hpp"
+#include "../src/clp/clp/decompression.hpp"
+#include "clp_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cInputDirectory{"test-clp-compression-input"};
+constexpr std::string_view cSerialArchivesDirectory{"test-clp-compression-serial-archives"};
+constexpr std::string_view cSerialOutputDirectory{"test-clp-compression-serial-out"};
+constexpr std::string_view cParallelArchivesDirectory{"test-clp-compression-parallel-archives"};
+constexpr std::string_view cParallelOutputDirectory{"test-clp-compression-parallel-out"};
+constexpr size_t cNumInputFiles{9};
+constexpr size_t cNumLinesPerFile{500};
+
+/**
+ * Compresses every input file using `clp::clp::compress`.
+ * @param archives_dir
+ * @param num_threads
+ */
+void compress_input_files(std::string_view archives_dir, size_t num_threads);
+
+/**
+ * Decompresses every archive in the given directory using `clp::clp::decompress`.
+ * @param archives_dir
+ * @param output_dir
+ */
+void decompress_archives(std::string_view archives_dir, std::string_view output_dir);
+
+/**
+ * @param dir
+ * @return A map from the name of each regular file under `dir` to its contents.
+ */
+auto read_files(std::string_view dir) -> std::map<std::string, std::string>;
+
+void compress_input_files(std::string_view archives_dir, size_t num_threads) {
+    // Use a small dictionaries size target so that each thread also splits its archives
+    compress_with_clp(
+            std::string{cInputDirectory},
+            std::string{archives_dir},
+            {"--target-dictionaries-size",
+             "4096",
+             "--compression-threads",
+             std::to_string(num_threads)}
+    );
+}
+
+void decompress_archives(std::string_view archives_dir, std::string_view output_dir) {
+    clp::clp::CommandLineArguments command_line_args{"clp"};
+    parse_clp_arguments(
+            {"x", std::string{archives_dir}, std::string{output_dir}},
+            command_line_args
+    );
+    REQUIRE(clp::clp::decompress(command_line_args, std::unordered_set<std::string>{}));
+}
+
+auto read_files(std::string_view dir) -> std::map<std::string, std::string> {
+    std::map<std::string, std::string> contents_by_name;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        if (false == entry.is_regular_file()) {
+            continue;
+        }
+        std::ifstream file{entry.path(), std::ios::binary};
+        contents_by_name.emplace(
+                entry.path().filename().string(),
+                std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}
+        );
+    }
+    return contents_by_name;
+}
+}  // namespace
+
+TEST_CASE("clp-compress-in-parallel", "[clp][compression]") {
+    auto const num_threads = GENERATE(as<size_t>{}, 2, 4, cNumInputFiles + 3);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cInputDirectory},
+             std::string{cSerialArchivesDirectory},
+             std::string{cSerialOutputDirectory},
+             std::string{cParallelArchivesDirectory},
+             std::string{cParallelOutputDirectory}}
+    };
+
+    write_clp_test_log_files(std::string{cInputDirectory}, cNumInputFiles, cNumLinesPerFile);
+    auto const input_files{read_files(cInputDirectory)};
+    REQUIRE(cNumInputFiles == input_files.size());
+
+    compress_input_files(cSerialArchivesDirectory, 1);
+    decompress_archives(cSerialArchivesDirectory, cSerialOutputDirectory);
+    REQUIRE(input_files == read_files(cSerialOutputDirectory));
+
+    compress_input_files(cParallelArchivesDirectory, num_threads);
+    decompress_archives(cParallelArchivesDirectory, cParallelOutputDirectory);
+    REQUIRE(input_files == read_files(cParallelOutputDirectory));
+}
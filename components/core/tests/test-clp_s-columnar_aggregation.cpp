@@ -0,0 +1,252 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/OutputHandlerImpl.hpp"
+#include "../src/clp_s/search/MessageBatch.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "../src/clp_s/search/QueuedOutputHandler.hpp"
+#include "../src/clp_s/search/SearchResultQueue.hpp"
+#include "../src/clp_s/search/TimeBucketHistogram.hpp"
+
+using clp_s::epochtime_t;
+using clp_s::search::MessageBatch;
+using clp_s::search::OutputHandler;
+using clp_s::search::QueuedOutputHandler;
+using clp_s::search::SearchResultQueue;
+using clp_s::search::TimeBucketHistogram;
+
+namespace {
+/**
+ * A block of messages that owns the data a `MessageBatch` views.
+ */
+struct Block {
+    std::vector<uint8_t> selection;
+    std::vector<epochtime_t> timestamps;
+};
+
+/**
+ * @param selection
+ * @return A batch starting at the first message with the given selection
+ */
+auto create_batch(std::vector<uint8_t> const& selection) -> MessageBatch {
+    MessageBatch batch;
+    batch.selection = selection;
+    for (auto const selected : selection) {
+        batch.num_selected += 0 != selected ? 1 : 0;
+    }
+    return batch;
+}
+
+/**
+ * @param block
+ * @return A batch viewing the given block
+ */
+auto create_batch(Block const& block) -> MessageBatch {
+    auto batch = create_batch(block.selection);
+    batch.timestamps = block.timestamps;
+    return batch;
+}
+
+/**
+ * Creates the blocks of messages aggregated by a search, where each table consists of several
+ * blocks with timestamps spanning multiple buckets.
+ * @param num_tables
+ * @param num_blocks_per_table
+ * @return The blocks of each table
+ */
+auto create_tables(size_t num_tables, size_t num_blocks_per_table)
+        -> std::vector<std::vector<Block>> {
+    constexpr size_t cNumMessagesPerBlock{256};
+
+    std::vector<std::vector<Block>> tables(num_tables);
+    for (size_t table_idx{0}; table_idx < num_tables; ++table_idx) {
+        for (size_t block_idx{0}; block_idx < num_blocks_per_table; ++block_idx) {
+            auto& block = tables[table_idx].emplace_back();
+            for (size_t i{0}; i < cNumMessagesPerBlock; ++i) {
+                block.selection.push_back(0 == (i + table_idx + block_idx) % 3 ? 1 : 0);
+                block.timestamps.push_back(static_cast<epochtime_t>(
+                        (table_idx * num_blocks_per_table + block_idx) * 100 + i * 11
+                ));
+            }
+        }
+    }
+    return tables;
+}
+
+/**
+ * Aggregates the given tables using the given output handler, the same way a serial search does.
+ * @param tables
+ * @param output_handler
+ */
+auto aggregate_serially(
+        std::vector<std::vector<Block>> const& tables,
+        OutputHandler& output_handler
+) -> void {
+    for (auto const& table : tables) {
+        for (auto const& block : table) {
+            output_handler.aggregate(create_batch(block));
+        }
+    }
+}
+
+/**
+ * Aggregates the given tables using the given output handler, the same way a parallel search does:
+ * each thread aggregates a subset of the tables through a `QueuedOutputHandler`, and the given
+ * output handler merges the partial aggregates it pushes.
+ * @param tables
+ * @param output_handler
+ * @return Whether every thread succeeded
+ */
+auto aggregate_in_parallel(
+        std::vector<std::vector<Block>> const& tables,
+        OutputHandler& output_handler
+) -> bool {
+    constexpr size_t cNumThreads{3};
+
+    // Catch2's assertions aren't thread-safe, so each thread records whether it succeeded instead.
+    SearchResultQueue queue{1, cNumThreads};
+    std::vector<char> thread_succeeded(cNumThreads, 1);
+    std::vector<std::thread> threads;
+    for (size_t thread_idx{0}; thread_idx < cNumThreads; ++thread_idx) {
+        threads.emplace_back([&, thread_idx]() {
+            QueuedOutputHandler queued_output_handler{queue, output_handler};
+            if (false == queued_output_handler.should_aggregate_batches()) {
+                thread_succeeded[thread_idx] = 0;
+            }
+            for (size_t table_idx{thread_idx}; table_idx < tables.size();
+                 table_idx += cNumThreads)
+            {
+                for (auto const& block : tables[table_idx]) {
+                    queued_output_handler.aggregate(create_batch(block));
+                }
+                if (clp_s::ErrorCode::ErrorCodeSuccess != queued_output_handler.flush()) {
+                    thread_succeeded[thread_idx] = 0;
+                }
+            }
+            if (clp_s::ErrorCode::ErrorCodeSuccess != queued_output_handler.finish()) {
+                thread_succeeded[thread_idx] = 0;
+            }
+            queue.close_producer();
+        });
+    }
+
+    bool succeeded{true};
+    while (auto batch{queue.pop()}) {
+        if (false == batch->results.empty() || nullptr == batch->aggregate) {
+            succeeded = false;
+            continue;
+        }
+        output_handler.merge(*batch->aggregate);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const succeeded_thread : thread_succeeded) {
+        succeeded = succeeded && 0 != succeeded_thread;
+    }
+    return succeeded;
+}
+}  // namespace
+
+TEST_CASE("clp-s-columnar-selected-runs", "[clp-s][search]") {
+    std::vector<int64_t> const keys{1, 1, 1, 2, 2, 3, 1, 1};
+    std::vector<uint8_t> const selection{1, 0, 1, 0, 0, 1, 1, 1};
+
+    std::vector<std::pair<int64_t, int64_t>> runs;
+    clp_s::search::for_each_selected_run(
+            std::span<int64_t const>{keys},
+            std::span<uint8_t const>{selection},
+            [&](int64_t key, int64_t count) { runs.emplace_back(key, count); }
+    );
+    REQUIRE(std::vector<std::pair<int64_t, int64_t>>{{1, 2}, {3, 1}, {1, 2}} == runs);
+}
+
+TEST_CASE("clp-s-columnar-time-bucket-histogram", "[clp-s][search]") {
+    constexpr int64_t cBucketSize{1000};
+    constexpr size_t cNumMessages{4096};
+
+    // Mostly increasing timestamps (including negative ones) with some out-of-order messages, and
+    // a selection that skips some messages
+    std::vector<epochtime_t> timestamps(cNumMessages);
+    std::vector<uint8_t> selection(cNumMessages);
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        timestamps[i] = static_cast<epochtime_t>(i * 7) - 5000;
+        if (0 == i % 97) {
+            timestamps[i] += 123'456;
+        }
+        selection[i] = (0 == i % 3 || 0 == i % 5) ? 1 : 0;
+    }
+
+    TimeBucketHistogram expected_histogram{cBucketSize};
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        if (0 != selection[i]) {
+            expected_histogram.add(timestamps[i]);
+        }
+    }
+
+    TimeBucketHistogram histogram{cBucketSize};
+    auto batch = create_batch(selection);
+    batch.timestamps = timestamps;
+    histogram.add(batch);
+    REQUIRE(expected_histogram.get_bucket_counts() == histogram.get_bucket_counts());
+
+    SECTION("Batch without timestamps") {
+        TimeBucketHistogram histogram_without_timestamps{cBucketSize};
+        histogram_without_timestamps.add(create_batch({1, 0, 1}));
+        REQUIRE(std::map<int64_t, int64_t>{{0, 2}}
+                == histogram_without_timestamps.get_bucket_counts());
+    }
+
+    SECTION("Batch without matches") {
+        auto const bucket_counts = histogram.get_bucket_counts();
+        histogram.add(create_batch({0, 0, 0}));
+        REQUIRE(bucket_counts == histogram.get_bucket_counts());
+    }
+}
+
+TEST_CASE("clp-s-columnar-count-handlers", "[clp-s][search]") {
+    constexpr int64_t cBucketSize{1000};
+    constexpr size_t cNumTables{7};
+    constexpr size_t cNumBlocksPerTable{5};
+
+    auto const tables = create_tables(cNumTables, cNumBlocksPerTable);
+    int64_t expected_count{0};
+    TimeBucketHistogram expected_histogram{cBucketSize};
+    for (auto const& table : tables) {
+        for (auto const& block : table) {
+            for (size_t i{0}; i < block.selection.size(); ++i) {
+                if (0 != block.selection[i]) {
+                    ++expected_count;
+                    expected_histogram.add(block.timestamps[i]);
+                }
+            }
+        }
+    }
+
+    // The handlers are never finished, so they don't need a reducer connection
+    clp_s::CountOutputHandler count_output_handler{-1};
+    clp_s::CountByTimeOutputHandler count_by_time_output_handler{-1, cBucketSize};
+
+    SECTION("Serial") {
+        aggregate_serially(tables, count_output_handler);
+        aggregate_serially(tables, count_by_time_output_handler);
+    }
+
+    SECTION("Parallel") {
+        REQUIRE(aggregate_in_parallel(tables, count_output_handler));
+        REQUIRE(aggregate_in_parallel(tables, count_by_time_output_handler));
+    }
+
+    REQUIRE(expected_count == count_output_handler.get_count());
+    REQUIRE(expected_histogram.get_bucket_counts()
+            == count_by_time_output_handler.get_bucket_counts());
+}
@@ -1,7 +1,11 @@
 #include <sys/wait.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <optional>
 #include <set>
 #include <string>
@@ -36,12 +40,14 @@ constexpr std::string_view cTestEndToEndValidFormattedFloatInputFile{
 constexpr std::string_view cTestEndToEndInvalidFormattedFloatInputFile{
         "test_invalid_formatted_float.jsonl"
 };
+constexpr std::string_view cTestEndToEndOrderedInputFile{"test-end-to-end-ordered.jsonl"};
 
 namespace {
 auto get_test_input_path_relative_to_tests_dir(std::string_view const test_input_path)
         -> std::filesystem::path;
 auto get_test_input_local_path(std::string_view const test_input_path) -> std::string;
 auto extract() -> std::filesystem::path;
+auto extract_ordered(size_t ordered_memory_budget) -> std::string;
 void compare(std::filesystem::path const& extracted_json_path);
 void literallyCompare(
         std::filesystem::path const& expected_output_json_path,
@@ -120,6 +126,41 @@ auto extract() -> std::filesystem::path {
     return extracted_json_path;
 }
 
+/**
+ * Extracts every archive in log order and returns the extracted records.
+ * @param ordered_memory_budget
+ * @return The contents of every extracted file, concatenated in order of their names
+ */
+auto extract_ordered(size_t ordered_memory_budget) -> std::string {
+    std::filesystem::remove_all(cTestEndToEndOutputDirectory);
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestEndToEndOutputDirectory;
+    constructor_option.ordered = true;
+    constructor_option.ordered_memory_budget = ordered_memory_budget;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        constructor.store();
+    }
+
+    std::vector<std::filesystem::path> extracted_paths;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndOutputDirectory)) {
+        extracted_paths.emplace_back(entry.path());
+    }
+    std::ranges::sort(extracted_paths);
+
+    std::string extracted_records;
+    for (auto const& path : extracted_paths) {
+        std::ifstream file{path};
+        extracted_records.append(std::istreambuf_iterator<char>{file}, {});
+    }
+    return extracted_records;
+}
+
 // Silence the checks below since our use of `std::system` is safe in the context of testing.
 // NOLINTBEGIN(cert-env33-c,concurrency-mt-unsafe)
 void compare(std::filesystem::path const& extracted_json_path) {
@@ -293,3 +334,54 @@ TEST_CASE("clp-s-compress-extract-invalid-formatted-floats", "[clp-s][end-to-end
             extracted_json_path
     );
 }
+
+/**
+ * Tests that decompressing in log order with a bounded amount of memory produces the same output as
+ * decompressing every table in memory.
+ */
+TEST_CASE("clp-s-compress-extract-ordered-bounded-memory", "[clp-s][end-to-end]") {
+    constexpr size_t cNumRecords{200};
+    constexpr size_t cNumSchemas{3};
+
+    auto ordered_memory_budget = GENERATE(1ULL, 256ULL, 4096ULL);
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndOutputDirectory},
+             std::string{cTestEndToEndOrderedInputFile}}
+    };
+
+    // Interleave records from several schemas so that the archive has several tables
+    {
+        std::ofstream input_file{std::string{cTestEndToEndOrderedInputFile}};
+        for (size_t i{0}; i < cNumRecords; ++i) {
+            switch ((i * 7) % cNumSchemas) {
+                case 0:
+                    input_file << fmt::format(R"({{"a":{}}})", i) << '\n';
+                    break;
+                case 1:
+                    input_file << fmt::format(R"({{"b":"record {}"}})", i) << '\n';
+                    break;
+                default:
+                    input_file << fmt::format(R"({{"a":{},"c":true}})", i) << '\n';
+                    break;
+            }
+        }
+    }
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    std::string{cTestEndToEndOrderedInputFile},
+                    std::string{cTestEndToEndArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    auto const expected_records{extract_ordered(0)};
+    REQUIRE((cNumRecords == std::ranges::count(expected_records, '\n')));
+    REQUIRE((expected_records == extract_ordered(ordered_memory_budget)));
+}
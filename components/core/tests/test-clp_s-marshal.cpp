@@ -0,0 +1,409 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/BufferViewReader.hpp"
+#include "../src/clp_s/ColumnReader.hpp"
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+#include "../src/clp_s/search/Projection.hpp"
+#include "../src/clp_s/Utils.hpp"
+
+using clp_s::NodeType;
+using clp_s::Schema;
+using clp_s::SchemaReader;
+using clp_s::SchemaTree;
+using clp_s::StringUtils;
+
+namespace {
+constexpr size_t cNumMessages{10};
+
+constexpr std::array<int64_t, cNumMessages> cIntegers{
+        std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<int64_t>::min() + 1,
+        -10,
+        -1,
+        0,
+        1,
+        9,
+        10,
+        std::numeric_limits<int64_t>::max() - 1,
+        std::numeric_limits<int64_t>::max()
+};
+
+// Consecutive values span the full range of int64_t without their difference overflowing
+constexpr std::array<int64_t, cNumMessages> cDeltaEncodedIntegers{
+        0,
+        std::numeric_limits<int64_t>::max(),
+        -1,
+        std::numeric_limits<int64_t>::min(),
+        -1,
+        1'000'000'000'000,
+        999'999'999'999,
+        42,
+        42,
+        -7
+};
+
+constexpr std::array<double, cNumMessages> cFloats{
+        -std::numeric_limits<double>::max(),
+        -1e-7,
+        -0.0,
+        0.0,
+        std::numeric_limits<double>::denorm_min(),
+        5e-7,
+        0.5,
+        1.0 / 3.0,
+        123'456'789.987'654'321,
+        std::numeric_limits<double>::max()
+};
+
+constexpr std::array<bool, cNumMessages> cBooleans{
+        true,
+        false,
+        false,
+        true,
+        true,
+        true,
+        false,
+        true,
+        false,
+        false
+};
+
+/**
+ * A column reader that holds its string values in memory, standing in for the dictionary-backed
+ * string and array readers.
+ */
+class InMemoryStringColumnReader : public clp_s::BaseColumnReader {
+public:
+    // Constructor
+    InMemoryStringColumnReader(int32_t id, NodeType type, std::vector<std::string> values)
+            : BaseColumnReader(id),
+              m_type{type},
+              m_values{std::move(values)} {}
+
+    // Methods implementing `BaseColumnReader`
+    void load(clp_s::BufferViewReader& reader, uint64_t num_messages) override {}
+
+    auto get_type() -> NodeType override { return m_type; }
+
+    auto extract_value(uint64_t cur_message)
+            -> std::variant<int64_t, double, std::string, uint8_t> override {
+        return m_values.at(cur_message);
+    }
+
+    void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override {
+        buffer += m_values.at(cur_message);
+    }
+
+    void
+    extract_escaped_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override {
+        StringUtils::escape_json_string(buffer, m_values.at(cur_message));
+    }
+
+private:
+    NodeType m_type;
+    std::vector<std::string> m_values;
+};
+
+/**
+ * Appends the raw bytes of the given values to a buffer, in the layout a column reader loads.
+ * @tparam T
+ * @param values
+ * @param buffer
+ */
+template <typename T>
+void append_column_values(std::span<T const> values, std::vector<char>& buffer);
+
+/**
+ * @param value
+ * @return `value` marshalled using `StringUtils::append_integer`
+ */
+auto marshal_integer(int64_t value) -> std::string;
+
+/**
+ * @param value
+ * @return `value` marshalled using `StringUtils::append_float`
+ */
+auto marshal_float(double value) -> std::string;
+
+/**
+ * @param message_index
+ * @return The record containing the given message's values, marshalled with `std::to_string` the
+ * way records were marshalled before `SchemaReader` formatted numbers directly into its buffer.
+ */
+auto get_expected_record(size_t message_index) -> std::string;
+
+/**
+ * Copies a buffer into a stream buffer that a `SchemaReader` can load.
+ * @param buffer
+ * @return The stream buffer
+ */
+auto make_stream_buffer(std::vector<char> const& buffer) -> std::shared_ptr<char[]>;
+
+template <typename T>
+void append_column_values(std::span<T const> values, std::vector<char>& buffer) {
+    auto const* begin{reinterpret_cast<char const*>(values.data())};
+    buffer.insert(buffer.end(), begin, begin + values.size_bytes());
+}
+
+auto marshal_integer(int64_t value) -> std::string {
+    std::string marshalled_value;
+    StringUtils::append_integer(marshalled_value, value);
+    return marshalled_value;
+}
+
+auto marshal_float(double value) -> std::string {
+    std::string marshalled_value;
+    StringUtils::append_float(marshalled_value, value);
+    return marshalled_value;
+}
+
+auto get_expected_record(size_t message_index) -> std::string {
+    return "{\"int\":" + std::to_string(cIntegers.at(message_index))
+           + ",\"delta\":" + std::to_string(cDeltaEncodedIntegers.at(message_index))
+           + ",\"float\":" + std::to_string(cFloats.at(message_index))
+           + ",\"bool\":" + (cBooleans.at(message_index) ? "true" : "false") + "}";
+}
+
+auto make_stream_buffer(std::vector<char> const& buffer) -> std::shared_ptr<char[]> {
+    std::shared_ptr<char[]> stream_buffer{new char[buffer.size()]};
+    std::ranges::copy(buffer, stream_buffer.get());
+    return stream_buffer;
+}
+}  // namespace
+
+TEST_CASE("clp-s-append-number", "[clp-s][marshal]") {
+    for (auto const value : cIntegers) {
+        REQUIRE(std::to_string(value) == marshal_integer(value));
+    }
+    for (auto const value : cDeltaEncodedIntegers) {
+        REQUIRE(std::to_string(value) == marshal_integer(value));
+    }
+    for (auto const value : cFloats) {
+        REQUIRE(std::to_string(value) == marshal_float(value));
+    }
+    for (auto const value :
+         {std::numeric_limits<double>::infinity(),
+          -std::numeric_limits<double>::infinity(),
+          std::numeric_limits<double>::min(),
+          0.000'000'5,
+          0.000'001'5,
+          2.5e-6,
+          1e15 + 0.3,
+          -9'007'199'254'740'993.0})
+    {
+        REQUIRE(std::to_string(value) == marshal_float(value));
+    }
+
+    // Appending must preserve the buffer's existing contents
+    std::string buffer{"prefix"};
+    StringUtils::append_integer(buffer, -3);
+    StringUtils::append_float(buffer, 2.25);
+    REQUIRE("prefix-32.250000" == buffer);
+}
+
+TEST_CASE("clp-s-marshal-typed-values", "[clp-s][marshal]") {
+    auto schema_tree{std::make_shared<SchemaTree>()};
+    auto const root_id{schema_tree->add_node(-1, NodeType::Object, "")};
+    std::vector<int32_t> ordered_schema{
+            schema_tree->add_node(root_id, NodeType::Integer, "int"),
+            schema_tree->add_node(root_id, NodeType::DeltaInteger, "delta"),
+            schema_tree->add_node(root_id, NodeType::Float, "float"),
+            schema_tree->add_node(root_id, NodeType::Boolean, "bool")
+    };
+
+    std::vector<char> buffer;
+    append_column_values(std::span<int64_t const>{cIntegers}, buffer);
+    std::array<int64_t, cNumMessages> deltas{};
+    deltas.front() = cDeltaEncodedIntegers.front();
+    for (size_t i{1}; i < cNumMessages; ++i) {
+        deltas.at(i) = cDeltaEncodedIntegers.at(i) - cDeltaEncodedIntegers.at(i - 1);
+    }
+    append_column_values(std::span<int64_t const>{deltas}, buffer);
+    append_column_values(std::span<double const>{cFloats}, buffer);
+    std::array<uint8_t, cNumMessages> booleans{};
+    for (size_t i{0}; i < cNumMessages; ++i) {
+        booleans.at(i) = cBooleans.at(i) ? 1 : 0;
+    }
+    append_column_values(std::span<uint8_t const>{booleans}, buffer);
+
+    SchemaReader reader;
+    reader.reset(
+            schema_tree,
+            std::make_shared<clp_s::search::Projection>(
+                    clp_s::search::ProjectionMode::ReturnAllColumns
+            ),
+            0,
+            ordered_schema,
+            cNumMessages,
+            true
+    );
+    reader.append_column(new clp_s::Int64ColumnReader(ordered_schema.at(0)));
+    reader.append_column(new clp_s::DeltaEncodedInt64ColumnReader(ordered_schema.at(1)));
+    reader.append_column(new clp_s::FloatColumnReader(ordered_schema.at(2)));
+    reader.append_column(new clp_s::BooleanColumnReader(ordered_schema.at(3)));
+    reader.load(make_stream_buffer(buffer), 0, buffer.size());
+
+    std::string expected_messages;
+    for (size_t i{0}; i < cNumMessages; ++i) {
+        expected_messages += get_expected_record(i) + '\n';
+    }
+    std::string messages;
+    REQUIRE(cNumMessages == reader.get_next_messages(messages, cNumMessages + 1));
+    REQUIRE(expected_messages == messages);
+
+    // Delta-encoded values must also decode correctly when records are marshalled out of order
+    for (size_t i{cNumMessages}; i > 0; --i) {
+        REQUIRE(get_expected_record(i - 1) == reader.generate_json_string(i - 1));
+    }
+    for (size_t const i : {3, 8, 0, 9, 5}) {
+        REQUIRE(get_expected_record(i) == reader.generate_json_string(i));
+    }
+}
+
+TEST_CASE("clp-s-marshal-compiled-template", "[clp-s][marshal]") {
+    constexpr size_t cNumRecords{3};
+
+    // {"id":_, "msg":_, "ctx":{"host":_, "inner":{"ok":_, "none":null}}, "empty":{}, "tags":_,
+    //  "q\"uote":_, "arr":[_, _, {"flag":_, "nothing":null}, [_, _], null]}
+    auto schema_tree{std::make_shared<SchemaTree>()};
+    auto const root_id{schema_tree->add_node(-1, NodeType::Object, "")};
+    auto const id_id{schema_tree->add_node(root_id, NodeType::Integer, "id")};
+    auto const msg_id{schema_tree->add_node(root_id, NodeType::VarString, "msg")};
+    auto const ctx_id{schema_tree->add_node(root_id, NodeType::Object, "ctx")};
+    auto const host_id{schema_tree->add_node(ctx_id, NodeType::VarString, "host")};
+    auto const inner_id{schema_tree->add_node(ctx_id, NodeType::Object, "inner")};
+    auto const ok_id{schema_tree->add_node(inner_id, NodeType::Boolean, "ok")};
+    auto const none_id{schema_tree->add_node(inner_id, NodeType::NullValue, "none")};
+    auto const empty_id{schema_tree->add_node(root_id, NodeType::Object, "empty")};
+    auto const tags_id{schema_tree->add_node(root_id, NodeType::UnstructuredArray, "tags")};
+    auto const quote_id{schema_tree->add_node(root_id, NodeType::Float, "q\"uote")};
+    auto const arr_id{schema_tree->add_node(root_id, NodeType::StructuredArray, "arr")};
+    auto const arr_int_id{schema_tree->add_node(arr_id, NodeType::Integer, "")};
+    auto const arr_float_id{schema_tree->add_node(arr_id, NodeType::Float, "")};
+    auto const arr_obj_id{schema_tree->add_node(arr_id, NodeType::Object, "")};
+    auto const flag_id{schema_tree->add_node(arr_obj_id, NodeType::Boolean, "flag")};
+    auto const nothing_id{schema_tree->add_node(arr_obj_id, NodeType::NullValue, "nothing")};
+    auto const sub_arr_id{schema_tree->add_node(arr_id, NodeType::StructuredArray, "")};
+    auto const sub_arr_delta_id{schema_tree->add_node(sub_arr_id, NodeType::DeltaInteger, "")};
+    auto const sub_arr_str_id{schema_tree->add_node(sub_arr_id, NodeType::VarString, "")};
+    auto const arr_null_id{schema_tree->add_node(arr_id, NodeType::NullValue, "")};
+
+    // Build the schema the way `JsonParser` does, with the structured array in the unordered region
+    Schema schema;
+    for (auto const node_id : {id_id, msg_id, host_id, ok_id, none_id, empty_id, tags_id, quote_id})
+    {
+        schema.insert_ordered(node_id);
+    }
+    auto const arr_start{schema.start_unordered_object(NodeType::StructuredArray)};
+    schema.insert_unordered(arr_int_id);
+    schema.insert_unordered(arr_float_id);
+    auto const arr_obj_start{schema.start_unordered_object(NodeType::Object)};
+    schema.insert_unordered(flag_id);
+    schema.insert_unordered(nothing_id);
+    schema.end_unordered_object(arr_obj_start);
+    auto const sub_arr_start{schema.start_unordered_object(NodeType::StructuredArray)};
+    schema.insert_unordered(sub_arr_delta_id);
+    schema.insert_unordered(sub_arr_str_id);
+    schema.end_unordered_object(sub_arr_start);
+    schema.insert_unordered(arr_null_id);
+    schema.end_unordered_object(arr_start);
+
+    std::array<int64_t, cNumRecords> const ids{0, -1, std::numeric_limits<int64_t>::max()};
+    std::vector<std::string> const msgs{"plain", "say \"hi\"\\", ""};
+    std::vector<std::string> const hosts{"a", "b", "c"};
+    std::array<uint8_t, cNumRecords> const oks{1, 0, 1};
+    std::vector<std::string> const tags{"[]", "[1,\"x\",{\"k\":null}]", "[[true]]"};
+    std::array<double, cNumRecords> const quotes{0.5, -0.0, 1e10};
+    std::array<int64_t, cNumRecords> const arr_ints{7, std::numeric_limits<int64_t>::min(), 0};
+    std::array<double, cNumRecords> const arr_floats{-2.25, 1.0 / 3.0, 0.0};
+    std::array<uint8_t, cNumRecords> const flags{0, 1, 0};
+    // Delta-encoded values 5, 2, 1'000
+    std::array<int64_t, cNumRecords> const sub_arr_deltas{5, -3, 998};
+    std::vector<std::string> const sub_arr_strs{"x", "y\tz", "end"};
+
+    std::vector<char> buffer;
+    append_column_values(std::span<int64_t const>{ids}, buffer);
+    append_column_values(std::span<uint8_t const>{oks}, buffer);
+    append_column_values(std::span<double const>{quotes}, buffer);
+    append_column_values(std::span<int64_t const>{arr_ints}, buffer);
+    append_column_values(std::span<double const>{arr_floats}, buffer);
+    append_column_values(std::span<uint8_t const>{flags}, buffer);
+    append_column_values(std::span<int64_t const>{sub_arr_deltas}, buffer);
+
+    // Add the columns the way `ArchiveReader::initialize_schema_reader` does
+    SchemaReader reader;
+    auto const projection{std::make_shared<clp_s::search::Projection>(
+            clp_s::search::ProjectionMode::ReturnAllColumns
+    )};
+    reader.reset(schema_tree, projection, 0, schema.get_ordered_schema_view(), cNumRecords, true);
+    reader.append_column(new clp_s::Int64ColumnReader(id_id));
+    reader.append_column(new InMemoryStringColumnReader(msg_id, NodeType::VarString, msgs));
+    reader.append_column(new InMemoryStringColumnReader(host_id, NodeType::VarString, hosts));
+    reader.append_column(new clp_s::BooleanColumnReader(ok_id));
+    reader.append_column(
+            new InMemoryStringColumnReader(tags_id, NodeType::UnstructuredArray, tags)
+    );
+    reader.append_column(new clp_s::FloatColumnReader(quote_id));
+    auto const arr_column_start{reader.get_column_size()};
+    reader.append_unordered_column(new clp_s::Int64ColumnReader(arr_int_id));
+    reader.append_unordered_column(new clp_s::FloatColumnReader(arr_float_id));
+    reader.append_unordered_column(new clp_s::BooleanColumnReader(flag_id));
+    reader.append_unordered_column(new clp_s::DeltaEncodedInt64ColumnReader(sub_arr_delta_id));
+    reader.append_unordered_column(
+            new InMemoryStringColumnReader(sub_arr_str_id, NodeType::VarString, sub_arr_strs)
+    );
+    reader.mark_unordered_object(
+            arr_column_start,
+            arr_id,
+            schema.get_view(arr_start, schema.size() - arr_start)
+    );
+    reader.load(make_stream_buffer(buffer), 0, buffer.size());
+
+    std::array<std::string, cNumRecords> const expected_records{
+            R"({"id":0,"msg":"plain","ctx":{"host":"a","inner":{"ok":true,"none":null}},)"
+            R"("empty":{},"tags":[],"q\"uote":0.500000,)"
+            R"("arr":[7,-2.250000,{"flag":false,"nothing":null},[5,"x"],null]})",
+            R"({"id":-1,"msg":"say \"hi\"\\","ctx":{"host":"b","inner":{"ok":false,"none":null}},)"
+            R"("empty":{},"tags":[1,"x",{"k":null}],"q\"uote":-0.000000,)"
+            R"("arr":[-9223372036854775808,0.333333,)"
+            R"({"flag":true,"nothing":null},[2,"y\tz"],null]})",
+            R"({"id":9223372036854775807,"msg":"",)"
+            R"("ctx":{"host":"c","inner":{"ok":true,"none":null}},)"
+            R"("empty":{},"tags":[[true]],"q\"uote":10000000000.000000,)"
+            R"("arr":[0,0.000000,{"flag":false,"nothing":null},[1000,"end"],null]})"
+    };
+
+    std::string expected_messages;
+    for (auto const& record : expected_records) {
+        expected_messages += record + '\n';
+    }
+    std::string messages;
+    REQUIRE(cNumRecords == reader.get_next_messages(messages, cNumRecords));
+    REQUIRE(expected_messages == messages);
+    for (size_t i{cNumRecords}; i > 0; --i) {
+        REQUIRE(expected_records.at(i - 1) == reader.generate_json_string(i - 1));
+    }
+
+    // Resetting the reader must discard the previous schema's template
+    std::vector<int32_t> id_only_schema{id_id};
+    reader.reset(schema_tree, projection, 1, id_only_schema, cNumRecords, true);
+    reader.append_column(new clp_s::Int64ColumnReader(id_id));
+    reader.load(make_stream_buffer(buffer), 0, sizeof(ids));
+    messages.clear();
+    REQUIRE(cNumRecords == reader.get_next_messages(messages, cNumRecords));
+    REQUIRE("{\"id\":0}\n{\"id\":-1}\n{\"id\":9223372036854775807}\n" == messages);
+}
@@ -0,0 +1,279 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "../src/clp_s/search/QueryResultCache.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp_s::epochtime_t;
+using clp_s::search::OutputHandler;
+using clp_s::search::QueryResultCache;
+using clp_s::search::RecordingOutputHandler;
+
+namespace {
+constexpr std::string_view cTestResultCacheDirectory{"test-result-cache"};
+constexpr size_t cMaxCacheSize{64ULL * 1024};
+
+struct Result {
+    auto operator==(Result const&) const -> bool = default;
+
+    std::string message;
+    epochtime_t timestamp{};
+    int64_t log_event_idx{};
+};
+
+using Tables = std::vector<std::vector<Result>>;
+
+/**
+ * Output handler that collects the results of each table, where each flush ends a table.
+ */
+class TableOutputHandler : public OutputHandler {
+public:
+    // Constructors
+    explicit TableOutputHandler(bool should_output_metadata)
+            : OutputHandler{should_output_metadata, true} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            [[maybe_unused]] std::string_view archive_id,
+            int64_t log_event_idx
+    ) override {
+        m_current_table.emplace_back(std::string{message}, timestamp, log_event_idx);
+    }
+
+    void write(std::string_view message) override {
+        m_current_table.emplace_back(std::string{message}, 0, 0);
+    }
+
+    [[nodiscard]] auto flush() -> clp_s::ErrorCode override {
+        m_tables.emplace_back(std::move(m_current_table));
+        m_current_table.clear();
+        return clp_s::ErrorCode::ErrorCodeSuccess;
+    }
+
+    [[nodiscard]] auto finish() -> clp_s::ErrorCode override {
+        m_has_finished = true;
+        return clp_s::ErrorCode::ErrorCodeSuccess;
+    }
+
+    // Methods
+    [[nodiscard]] auto get_tables() const -> Tables const& { return m_tables; }
+
+    [[nodiscard]] auto has_finished() const -> bool { return m_has_finished; }
+
+private:
+    Tables m_tables;
+    std::vector<Result> m_current_table;
+    bool m_has_finished{false};
+};
+
+/**
+ * @param archive_id
+ * @param should_output_metadata
+ * @return A key for a query over the given archive
+ */
+auto create_key(std::string_view archive_id, bool should_output_metadata = true)
+        -> QueryResultCache::Key {
+    return QueryResultCache::Key{
+            std::string{archive_id},
+            QueryResultCache::normalize_query("a: b AND c: \"d  e\""),
+            {"a", "c"},
+            0,
+            std::nullopt,
+            false,
+            should_output_metadata,
+            true
+    };
+}
+
+/**
+ * @param num_tables
+ * @param num_results_per_table
+ * @param message_size
+ * @return Tables filled with results containing random (i.e., incompressible) messages
+ */
+auto create_tables(size_t num_tables, size_t num_results_per_table, size_t message_size)
+        -> Tables {
+    std::mt19937 generator{std::random_device{}()};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    Tables tables(num_tables);
+    for (size_t i{0}; i < num_tables; ++i) {
+        for (size_t j{0}; j < num_results_per_table; ++j) {
+            std::string message(message_size, '\0');
+            for (auto& c : message) {
+                c = static_cast<char>(distribution(generator));
+            }
+            auto const idx{static_cast<int64_t>(i * num_results_per_table + j)};
+            tables[i].emplace_back(std::move(message), idx * 1000, idx);
+        }
+    }
+    return tables;
+}
+
+/**
+ * Writes the given tables through a `RecordingOutputHandler`, the way `Output` does, and checks
+ * that they're forwarded to the underlying output handler unchanged.
+ * @param cache
+ * @param key
+ * @param tables
+ * @param should_commit Whether to insert the recorded entry into the cache
+ */
+void record_tables(
+        QueryResultCache& cache,
+        QueryResultCache::Key const& key,
+        Tables const& tables,
+        bool should_commit = true
+) {
+    auto table_output_handler{std::make_unique<TableOutputHandler>(key.should_output_metadata)};
+    auto const& forwarded{*table_output_handler};
+    RecordingOutputHandler handler{cache, key, std::move(table_output_handler)};
+    for (auto const& table : tables) {
+        for (auto const& result : table) {
+            if (key.should_output_metadata) {
+                handler.write(result.message, result.timestamp, key.archive_id, result.log_event_idx);
+            } else {
+                handler.write(result.message);
+            }
+        }
+        REQUIRE(clp_s::ErrorCode::ErrorCodeSuccess == handler.flush());
+    }
+    REQUIRE(clp_s::ErrorCode::ErrorCodeSuccess == handler.finish());
+    REQUIRE(forwarded.has_finished());
+    REQUIRE(tables == forwarded.get_tables());
+    if (should_commit) {
+        handler.commit();
+    }
+}
+
+/**
+ * @return The paths of the files in the cache directory
+ */
+auto get_cache_files() -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> paths;
+    for (auto const& entry : std::filesystem::directory_iterator{cTestResultCacheDirectory}) {
+        paths.push_back(entry.path());
+    }
+    return paths;
+}
+}  // namespace
+
+TEST_CASE("clp-s-result-cache-normalize-query", "[clp-s][search][QueryResultCache]") {
+    REQUIRE(QueryResultCache::normalize_query("  a:  b\tAND\n c: d ") == "a: b AND c: d");
+    REQUIRE(QueryResultCache::normalize_query("a: \"b  c\"  AND d: e") == "a: \"b  c\" AND d: e");
+    REQUIRE(QueryResultCache::normalize_query("a: \"b\\\"  c\"   d") == "a: \"b\\\"  c\" d");
+}
+
+TEST_CASE("clp-s-result-cache", "[clp-s][search][QueryResultCache]") {
+    TestOutputCleaner const test_cleanup{{std::string{cTestResultCacheDirectory}}};
+    QueryResultCache cache{std::string{cTestResultCacheDirectory}, cMaxCacheSize};
+
+    SECTION("Round trip") {
+        auto const should_output_metadata = GENERATE(true, false);
+        auto const key{create_key("archive", should_output_metadata)};
+        auto tables{create_tables(3, 10, 16)};
+        // An empty table still flushes the output handler
+        tables.insert(tables.begin() + 1, std::vector<Result>{});
+        if (false == should_output_metadata) {
+            for (auto& table : tables) {
+                for (auto& result : table) {
+                    result.timestamp = 0;
+                    result.log_event_idx = 0;
+                }
+            }
+        }
+
+        TableOutputHandler miss_output_handler{should_output_metadata};
+        REQUIRE(QueryResultCache::OutputResult::NotCached
+                == cache.try_output(key, miss_output_handler));
+        REQUIRE(miss_output_handler.get_tables().empty());
+
+        record_tables(cache, key, tables);
+        TableOutputHandler output_handler{should_output_metadata};
+        REQUIRE(QueryResultCache::OutputResult::Succeeded == cache.try_output(key, output_handler));
+        REQUIRE(output_handler.has_finished());
+        REQUIRE(tables == output_handler.get_tables());
+
+        auto other_key{key};
+        other_key.search_end_ts = 0;
+        TableOutputHandler other_output_handler{should_output_metadata};
+        REQUIRE(QueryResultCache::OutputResult::NotCached
+                == cache.try_output(other_key, other_output_handler));
+    }
+
+    SECTION("Least recently used entries are evicted") {
+        // Random messages don't compress, so each entry takes about a quarter of the cache
+        auto const tables{create_tables(1, 1, cMaxCacheSize / 4)};
+        for (auto const* archive_id : {"archive-0", "archive-1", "archive-2"}) {
+            record_tables(cache, create_key(archive_id), tables);
+        }
+        TableOutputHandler output_handler{true};
+        REQUIRE(QueryResultCache::OutputResult::Succeeded
+                == cache.try_output(create_key("archive-0"), output_handler));
+        record_tables(cache, create_key("archive-3"), create_tables(1, 1, cMaxCacheSize / 2));
+        REQUIRE(QueryResultCache::OutputResult::Succeeded
+                == cache.try_output(create_key("archive-0"), output_handler));
+        REQUIRE(QueryResultCache::OutputResult::NotCached
+                == cache.try_output(create_key("archive-1"), output_handler));
+    }
+
+    SECTION("Entries that exceed the cache or aren't committed are discarded") {
+        auto const key{create_key("archive")};
+        record_tables(cache, key, create_tables(2, 4, cMaxCacheSize / 4));
+        TableOutputHandler output_handler{true};
+        REQUIRE(QueryResultCache::OutputResult::NotCached == cache.try_output(key, output_handler));
+
+        record_tables(cache, key, create_tables(2, 4, 16), false);
+        REQUIRE(QueryResultCache::OutputResult::NotCached == cache.try_output(key, output_handler));
+        REQUIRE(get_cache_files().empty());
+
+        RecordingOutputHandler handler{cache, key, std::make_unique<TableOutputHandler>(true)};
+        handler.write("a", 1, "archive", 0);
+        REQUIRE_FALSE(handler.has_overflowed());
+        auto const large_tables{create_tables(1, 1, 4 * cMaxCacheSize)};
+        handler.write(large_tables.front().front().message, 2, "archive", 1);
+        REQUIRE(handler.has_overflowed());
+        REQUIRE(get_cache_files().empty());
+    }
+
+    SECTION("Corrupt entries are removed") {
+        // The entry spans several zstd blocks, so the results before the truncation can be output
+        QueryResultCache large_cache{std::string{cTestResultCacheDirectory}, 8 * cMaxCacheSize};
+        auto const key{create_key("archive")};
+        auto const tables{create_tables(4, 16, 4096)};
+        record_tables(large_cache, key, tables);
+        auto const paths{get_cache_files()};
+        REQUIRE(1 == paths.size());
+        auto const& entry_path{paths.front()};
+
+        // An entry truncated after some of its results can only fail the output
+        std::filesystem::resize_file(entry_path, std::filesystem::file_size(entry_path) / 2);
+        TableOutputHandler truncated_output_handler{true};
+        REQUIRE(QueryResultCache::OutputResult::Failed
+                == large_cache.try_output(key, truncated_output_handler));
+        REQUIRE_FALSE(truncated_output_handler.has_finished());
+        REQUIRE(get_cache_files().empty());
+
+        // An entry whose header is corrupt is a miss
+        record_tables(large_cache, key, tables);
+        std::filesystem::resize_file(entry_path, 4);
+        TableOutputHandler output_handler{true};
+        REQUIRE(QueryResultCache::OutputResult::NotCached
+                == large_cache.try_output(key, output_handler));
+        REQUIRE(output_handler.get_tables().empty());
+    }
+}
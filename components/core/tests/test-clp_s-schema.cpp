@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaMap.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+
+namespace {
+constexpr size_t cNumRandomSchemas{2000};
+// A small ID space makes equal schemas built in different ways likely.
+constexpr int32_t cMaxNodeId{12};
+
+/**
+ * Builds a random schema the way `JsonParser` does: ordered nodes in arbitrary order, unordered
+ * nodes, and unordered objects whose delimiters are finalized after their contents are inserted.
+ * @param rng
+ * @return The schema
+ */
+auto generate_random_schema(std::mt19937& rng) -> clp_s::Schema;
+
+/**
+ * @param schema
+ * @return The schema's hash, recomputed from its contents rather than maintained incrementally.
+ */
+auto recompute_hash(clp_s::Schema const& schema) -> size_t;
+
+/**
+ * Copies a schema the way `ReaderUtils::read_schemas` deserializes it, i.e., by resizing it and
+ * writing its entries in place.
+ * @param schema
+ * @return The copy
+ */
+auto deserialize_copy(clp_s::Schema const& schema) -> clp_s::Schema;
+
+auto generate_random_schema(std::mt19937& rng) -> clp_s::Schema {
+    std::uniform_int_distribution<int32_t> node_id_dist{0, cMaxNodeId};
+    std::uniform_int_distribution<int> num_entries_dist{0, 4};
+    std::bernoulli_distribution coin{0.5};
+
+    clp_s::Schema schema;
+    std::vector<int32_t> ordered_ids;
+    for (auto i{num_entries_dist(rng)}; i > 0; --i) {
+        ordered_ids.push_back(node_id_dist(rng));
+    }
+    std::ranges::sort(ordered_ids);
+    auto const [unique_end, end] = std::ranges::unique(ordered_ids);
+    ordered_ids.erase(unique_end, end);
+    std::ranges::shuffle(ordered_ids, rng);
+
+    // Interleave the ordered insertions with unordered ones, as the parser does when it encounters
+    // arrays in the middle of an object.
+    for (auto const id : ordered_ids) {
+        schema.insert_ordered(id);
+        if (coin(rng)) {
+            schema.insert_unordered(node_id_dist(rng));
+        }
+        if (coin(rng)) {
+            auto const start{schema.start_unordered_object(clp_s::NodeType::StructuredArray)};
+            for (auto j{num_entries_dist(rng)}; j > 0; --j) {
+                schema.insert_unordered(node_id_dist(rng));
+            }
+            schema.end_unordered_object(start);
+        }
+    }
+    if (coin(rng)) {
+        clp_s::Schema nested;
+        for (auto j{num_entries_dist(rng)}; j > 0; --j) {
+            nested.insert_unordered(node_id_dist(rng));
+        }
+        schema.insert_unordered(nested);
+    }
+    return schema;
+}
+
+auto recompute_hash(clp_s::Schema const& schema) -> size_t {
+    auto copy{schema};
+    // Taking a mutable iterator invalidates the maintained hash.
+    std::ignore = copy.begin();
+    return copy.get_hash();
+}
+
+auto deserialize_copy(clp_s::Schema const& schema) -> clp_s::Schema {
+    clp_s::Schema copy;
+    copy.resize(schema.size());
+    auto view{copy.get_view(0, schema.size())};
+    std::ranges::copy(schema, view.begin());
+    copy.set_num_ordered(schema.get_num_ordered());
+    return copy;
+}
+}  // namespace
+
+TEST_CASE("clp-s-schema-hash", "[clp-s][schema]") {
+    std::mt19937 rng{42};
+    std::vector<clp_s::Schema> schemas;
+    schemas.reserve(cNumRandomSchemas);
+    for (size_t i{0}; i < cNumRandomSchemas; ++i) {
+        schemas.emplace_back(generate_random_schema(rng));
+    }
+
+    for (auto const& schema : schemas) {
+        REQUIRE(schema.get_hash() == recompute_hash(schema));
+
+        auto const copy{deserialize_copy(schema)};
+        REQUIRE(copy == schema);
+        REQUIRE(copy.get_hash() == schema.get_hash());
+    }
+
+    // Equal schemas must hash equally, no matter how they were built.
+    for (size_t i{0}; i < schemas.size(); ++i) {
+        for (size_t j{i + 1}; j < schemas.size(); ++j) {
+            if (schemas[i] == schemas[j]) {
+                REQUIRE(schemas[i].get_hash() == schemas[j].get_hash());
+            }
+        }
+    }
+
+    SECTION("Ordered insertion order doesn't matter") {
+        clp_s::Schema ascending;
+        clp_s::Schema descending;
+        for (int32_t id{0}; id <= cMaxNodeId; ++id) {
+            ascending.insert_ordered(id);
+            descending.insert_ordered(cMaxNodeId - id);
+        }
+        REQUIRE(ascending == descending);
+        REQUIRE(ascending.get_hash() == descending.get_hash());
+    }
+
+    SECTION("The ordered region is part of the schema's identity") {
+        clp_s::Schema ordered;
+        ordered.insert_ordered(1);
+        ordered.insert_ordered(2);
+        clp_s::Schema unordered;
+        unordered.insert_unordered(1);
+        unordered.insert_unordered(2);
+        REQUIRE(ordered != unordered);
+        REQUIRE(ordered.get_hash() == recompute_hash(ordered));
+        REQUIRE(unordered.get_hash() == recompute_hash(unordered));
+    }
+
+    SECTION("Reusing a cleared schema") {
+        auto schema{schemas.front()};
+        schema.clear();
+        schema.insert_ordered(3);
+        clp_s::Schema fresh;
+        fresh.insert_ordered(3);
+        REQUIRE(schema == fresh);
+        REQUIRE(schema.get_hash() == fresh.get_hash());
+    }
+}
+
+TEST_CASE("clp-s-schema-map", "[clp-s][schema]") {
+    std::mt19937 rng{7};
+    std::bernoulli_distribution repeat_previous{0.7};
+
+    // IDs assigned by a map ordered by the schemas' contents, i.e., the lookup `SchemaMap` used
+    // before it was keyed by schema hashes.
+    std::map<std::pair<size_t, std::vector<int32_t>>, int32_t> expected_ids;
+    clp_s::SchemaMap schema_map;
+    clp_s::Schema previous;
+    for (size_t i{0}; i < cNumRandomSchemas; ++i) {
+        // Consecutive records usually share a schema, which exercises the most-recent-schema check.
+        auto const schema{
+                (i > 0 && repeat_previous(rng)) ? deserialize_copy(previous)
+                                                : generate_random_schema(rng)
+        };
+        auto const key{std::make_pair(
+                schema.get_num_ordered(),
+                std::vector<int32_t>{schema.begin(), schema.end()}
+        )};
+        auto const expected_id{
+                expected_ids.try_emplace(key, static_cast<int32_t>(expected_ids.size()))
+                        .first->second
+        };
+        REQUIRE(expected_id == schema_map.add_schema(schema));
+        previous = schema;
+    }
+
+    int32_t num_schemas{0};
+    for (auto it{schema_map.schema_map_begin()}; it != schema_map.schema_map_end(); ++it) {
+        ++num_schemas;
+    }
+    REQUIRE(static_cast<size_t>(num_schemas) == expected_ids.size());
+
+    schema_map.clear();
+    REQUIRE(schema_map.schema_map_begin() == schema_map.schema_map_end());
+}
@@ -1,12 +1,23 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -29,12 +40,20 @@
 #include "../src/clp_s/search/ast/OrExpr.hpp"
 #include "../src/clp_s/search/ast/OrOfAndForm.hpp"
 #include "../src/clp_s/search/EvaluateRangeIndexFilters.hpp"
+#include "../src/clp_s/search/EvaluateTableStatistics.hpp"
 #include "../src/clp_s/search/EvaluateTimestampIndex.hpp"
 #include "../src/clp_s/search/kql/kql.hpp"
 #include "../src/clp_s/search/Output.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
 #include "../src/clp_s/search/Projection.hpp"
+#include "../src/clp_s/search/QueuedOutputHandler.hpp"
 #include "../src/clp_s/search/SchemaMatch.hpp"
+#include "../src/clp_s/search/SearchResultQueue.hpp"
+#include "../src/clp_s/search/TimeBucketHistogram.hpp"
 #include "../src/clp_s/Utils.hpp"
+#include "../src/reducer/CountOperator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
 #include "clp_s_test_utils.hpp"
 #include "TestOutputCleaner.hpp"
 
@@ -44,26 +63,102 @@ constexpr std::string_view cTestSearchInputFile{"test_search.jsonl"};
 constexpr std::string_view cTestSearchFormattedFloatFile{"test_search_formatted_float.jsonl"};
 constexpr std::string_view cTestSearchFloatTimestampFile{"test_search_float_timestamp.jsonl"};
 constexpr std::string_view cTestSearchIntTimestampFile{"test_search_int_timestamp.jsonl"};
+constexpr std::string_view cTestSearchDictionaryIdsFile{"test-clp-s-search-dictionary-ids.jsonl"};
+constexpr std::string_view cTestSearchCountsFile{"test-clp-s-search-counts.jsonl"};
 constexpr std::string_view cTestIdxKey{"idx"};
 constexpr std::string_view cTestTimestampKey{"timestamp"};
+constexpr size_t cNumPrefetchedStreams{2};
 
 namespace {
 auto get_test_input_path_relative_to_tests_dir(std::string_view test_input_path)
         -> std::filesystem::path;
 auto get_test_input_local_path(std::string_view test_input_path) -> std::string;
 auto create_first_record_match_metadata_query() -> std::shared_ptr<clp_s::search::ast::Expression>;
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results);
+void search(
+        std::string const& query,
+        bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_prefetched_streams = 0
+);
 void search(
         std::shared_ptr<clp_s::search::ast::Expression> expr,
         bool ignore_case,
-        std::vector<int64_t> const& expected_results
+        std::vector<int64_t> const& expected_results,
+        size_t num_prefetched_streams = 0
 );
 void validate_results(
         std::vector<clp_s::VectorOutputHandler::QueryResult> const& results,
         std::vector<int64_t> const& expected_results
 );
 
+/**
+ * Runs the passes that clp-s runs on a query before searching any archive.
+ * @param expr
+ * @return The transformed query
+ */
+auto standardize_query(std::shared_ptr<clp_s::search::ast::Expression> expr)
+        -> std::shared_ptr<clp_s::search::ast::Expression>;
+
+/**
+ * Searches each archive in `cTestSearchArchiveDirectory`, outputting each archive's results to a
+ * new output handler.
+ * @param expr The query, transformed by `standardize_query`
+ * @param ignore_case
+ * @param num_prefetched_streams
+ * @param create_output_handler
+ */
+void search_archives(
+        std::shared_ptr<clp_s::search::ast::Expression> const& expr,
+        bool ignore_case,
+        size_t num_prefetched_streams,
+        std::function<std::unique_ptr<clp_s::search::OutputHandler>()> const& create_output_handler
+);
+
+/**
+ * Searches each archive in `cTestSearchArchiveDirectory` with an output handler that sends its
+ * results to the reducer, and receives the results like the reducer does.
+ * @param expr The query, transformed by `standardize_query`
+ * @param create_output_handler Creates an output handler that sends its results to the given
+ * socket
+ * @return The count of each record group, summed across the archives
+ */
+auto search_and_receive_counts(
+        std::shared_ptr<clp_s::search::ast::Expression> const& expr,
+        std::function<std::unique_ptr<clp_s::search::OutputHandler>(int)> const&
+                create_output_handler
+) -> std::map<reducer::GroupTags, int64_t>;
+
+/**
+ * Validates that `CountOutputHandler` and `CountByTimeOutputHandler`, which aggregate blocks of
+ * messages, send the same counts as those of the results output one by one to a
+ * `VectorOutputHandler`.
+ * @param query
+ * @param count_by_time_bucket_size
+ */
+void validate_counts(std::string const& query, int64_t count_by_time_bucket_size);
+
+/**
+ * @param word_idx
+ * @return A distinct word without any digits, so that it's part of a logtype
+ */
+auto get_test_word(size_t word_idx) -> std::string;
+
+/**
+ * Writes records spread over several schemas, whose variable string and clp string values are
+ * mostly unique, to `cTestSearchDictionaryIdsFile`.
+ * @param num_records
+ * @param num_schemas
+ * @param num_logtypes
+ */
+void write_dictionary_ids_test_input(size_t num_records, size_t num_schemas, size_t num_logtypes);
+
+/**
+ * Writes records to `cTestSearchCountsFile` whose timestamps rotate between integer, float, and
+ * date string values, so that each timestamp column type is in its own schema table.
+ * @param num_records
+ */
+void write_counts_test_input(size_t num_records);
+
 auto get_test_input_path_relative_to_tests_dir(std::string_view test_input_path)
         -> std::filesystem::path {
     return std::filesystem::path{cTestInputFileDirectory} / test_input_path;
@@ -129,18 +224,65 @@ void validate_results(
     REQUIRE(results.size() == expected_results.size());
 }
 
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results) {
-    auto query_stream = std::istringstream{query};
-    auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
-    search(expr, ignore_case, expected_results);
+auto get_test_word(size_t word_idx) -> std::string {
+    constexpr size_t cNumLetters{26};
+    return {static_cast<char>('a' + word_idx / cNumLetters),
+            static_cast<char>('a' + word_idx % cNumLetters)};
 }
 
-void search(
-        std::shared_ptr<clp_s::search::ast::Expression> expr,
-        bool ignore_case,
-        std::vector<int64_t> const& expected_results
-) {
+void write_dictionary_ids_test_input(size_t num_records, size_t num_schemas, size_t num_logtypes) {
+    std::ofstream file{std::string{cTestSearchDictionaryIdsFile}};
+    for (size_t i{0}; i < num_records; ++i) {
+        file << fmt::format(
+                R"({{"idx":{},"var_string":"v{}","clp_string":"{} by user u{}x","k{}":true}})"
+                "\n",
+                i,
+                i,
+                get_test_word(i % num_logtypes),
+                i,
+                i % num_schemas
+        );
+    }
+}
+
+void write_counts_test_input(size_t num_records) {
+    constexpr int64_t cBeginTimestamp{1'759'417'024'100};
+    constexpr int64_t cTimestampStep{37};
+    constexpr double cMillisecondsPerSecond{1000.0};
+    constexpr size_t cNumTimestampTypes{3};
+    constexpr size_t cNumValues{100};
+
+    std::ofstream file{std::string{cTestSearchCountsFile}};
+    for (size_t i{0}; i < num_records; ++i) {
+        auto const timestamp{cBeginTimestamp + static_cast<int64_t>(i) * cTimestampStep};
+        std::string timestamp_value;
+        switch (i % cNumTimestampTypes) {
+            case 0:
+                timestamp_value = std::to_string(timestamp);
+                break;
+            case 1:
+                timestamp_value = fmt::format(
+                        "{:.3f}",
+                        static_cast<double>(timestamp) / cMillisecondsPerSecond
+                );
+                break;
+            default:
+                timestamp_value = fmt::format(R"("{}")", timestamp);
+                break;
+        }
+        file << fmt::format(
+                R"({{"idx":{},"timestamp":{},"value":{},"msg":"request took {} ms"}})"
+                "\n",
+                i,
+                timestamp_value,
+                i % cNumValues,
+                i % cNumValues
+        );
+    }
+}
+
+auto standardize_query(std::shared_ptr<clp_s::search::ast::Expression> expr)
+        -> std::shared_ptr<clp_s::search::ast::Expression> {
     REQUIRE(nullptr != expr);
     REQUIRE(nullptr == std::dynamic_pointer_cast<clp_s::search::ast::EmptyExpr>(expr));
 
@@ -155,8 +297,15 @@ void search(
     clp_s::search::ast::ConvertToExists convert_pass;
     expr = convert_pass.run(expr);
     REQUIRE(nullptr != expr);
+    return expr;
+}
 
-    std::vector<clp_s::VectorOutputHandler::QueryResult> results;
+void search_archives(
+        std::shared_ptr<clp_s::search::ast::Expression> const& expr,
+        bool ignore_case,
+        size_t num_prefetched_streams,
+        std::function<std::unique_ptr<clp_s::search::OutputHandler>()> const& create_output_handler
+) {
     for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
         auto archive_path = clp_s::Path{
@@ -164,6 +313,7 @@ void search(
                 .path{entry.path().string()}
         };
         archive_reader->open(archive_path, clp_s::NetworkAuthOption{});
+        archive_reader->set_num_prefetched_streams(num_prefetched_streams);
 
         auto archive_expr = expr->copy();
 
@@ -186,18 +336,117 @@ void search(
         archive_expr = match_pass->run(archive_expr);
         REQUIRE(nullptr != archive_expr);
 
-        auto output_handler = std::make_unique<clp_s::VectorOutputHandler>(results);
         clp_s::search::Output output_pass(
                 match_pass,
                 archive_expr,
                 archive_reader,
-                std::move(output_handler),
+                create_output_handler(),
                 ignore_case
         );
-        output_pass.filter();
+        REQUIRE(output_pass.filter());
         archive_reader->close();
     }
+}
+
+auto search_and_receive_counts(
+        std::shared_ptr<clp_s::search::ast::Expression> const& expr,
+        std::function<std::unique_ptr<clp_s::search::OutputHandler>(int)> const&
+                create_output_handler
+) -> std::map<reducer::GroupTags, int64_t> {
+    // The results are small enough to fit in the socket's buffer, so they're only received once
+    // every archive has been searched.
+    std::array<int, 2> socket_fds{-1, -1};
+    REQUIRE(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds.data()));
+    auto const [reducer_socket_fd, receiver_socket_fd] = socket_fds;
+    search_archives(expr, false, 0, [&]() { return create_output_handler(reducer_socket_fd); });
+    close(reducer_socket_fd);
+
+    std::vector<char> received;
+    std::array<char, 4096> buf{};
+    for (auto num_bytes{read(receiver_socket_fd, buf.data(), buf.size())}; num_bytes > 0;
+         num_bytes = read(receiver_socket_fd, buf.data(), buf.size()))
+    {
+        received.insert(received.end(), buf.begin(), buf.begin() + num_bytes);
+    }
+    close(receiver_socket_fd);
+
+    // Each record group is sent as its size followed by the serialized group
+    std::map<reducer::GroupTags, int64_t> counts;
+    for (size_t pos{0}; pos < received.size();) {
+        size_t group_size{};
+        REQUIRE(received.size() - pos >= sizeof(group_size));
+        std::memcpy(&group_size, received.data() + pos, sizeof(group_size));
+        pos += sizeof(group_size);
+        REQUIRE(received.size() - pos >= group_size);
+        reducer::DeserializedRecordGroup group{received.data() + pos, group_size};
+        pos += group_size;
+        for (auto& record_it = group.record_iter(); false == record_it.done(); record_it.next()) {
+            counts[group.get_tags()]
+                    += record_it.get().get_int64_value(reducer::CountOperator::cRecordElementKey);
+        }
+    }
+    return counts;
+}
 
+void validate_counts(std::string const& query, int64_t count_by_time_bucket_size) {
+    auto query_stream = std::istringstream{query};
+    auto const expr = standardize_query(clp_s::search::kql::parse_kql_expression(query_stream));
+
+    std::vector<clp_s::VectorOutputHandler::QueryResult> results;
+    search_archives(expr, false, 0, [&]() {
+        return std::make_unique<clp_s::VectorOutputHandler>(results);
+    });
+
+    // Like `CountOperator`, there's no record group if nothing matched
+    std::map<reducer::GroupTags, int64_t> expected_counts;
+    if (false == results.empty()) {
+        expected_counts.emplace(reducer::GroupTags{}, static_cast<int64_t>(results.size()));
+    }
+    clp_s::search::TimeBucketHistogram histogram{count_by_time_bucket_size};
+    for (auto const& result : results) {
+        histogram.add(result.timestamp);
+    }
+    std::map<reducer::GroupTags, int64_t> expected_counts_by_time;
+    for (auto const& [bucket, count] : histogram.get_bucket_counts()) {
+        expected_counts_by_time.emplace(reducer::GroupTags{std::to_string(bucket)}, count);
+    }
+
+    REQUIRE(expected_counts
+            == search_and_receive_counts(expr, [](int reducer_socket_fd) {
+                   return std::make_unique<clp_s::CountOutputHandler>(reducer_socket_fd);
+               }));
+    REQUIRE(expected_counts_by_time
+            == search_and_receive_counts(expr, [&](int reducer_socket_fd) {
+                   return std::make_unique<clp_s::CountByTimeOutputHandler>(
+                           reducer_socket_fd,
+                           count_by_time_bucket_size
+                   );
+               }));
+}
+
+void search(
+        std::string const& query,
+        bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_prefetched_streams
+) {
+    auto query_stream = std::istringstream{query};
+    auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
+    search(expr, ignore_case, expected_results, num_prefetched_streams);
+}
+
+void search(
+        std::shared_ptr<clp_s::search::ast::Expression> expr,
+        bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_prefetched_streams
+) {
+    expr = standardize_query(expr);
+
+    std::vector<clp_s::VectorOutputHandler::QueryResult> results;
+    search_archives(expr, ignore_case, num_prefetched_streams, [&]() {
+        return std::make_unique<clp_s::VectorOutputHandler>(results);
+    });
     validate_results(results, expected_results);
 }
 }  // namespace
@@ -228,11 +477,17 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
              {1}},
             {R"aa(ambiguous_varstring: "a*e")aa", {10, 11, 12}},
             {R"aa(ambiguous_varstring: "a\*e")aa", {12}},
+            {R"aa(ambiguous_varstring: "abc*")aa", {10}},
             {R"aa(idx: * AND NOT idx: null AND idx: 0)aa", {0}},
-            {R"aa(one > 0.9 AND one < 1.1 AND one: 1.0)aa", {13}}
+            {R"aa(one > 0.9 AND one < 1.1 AND one: 1.0)aa", {13}},
+            {R"aa(int > 0 AND NOT bool: false AND float < 2 AND var_string: a)aa", {9}},
+            {R"aa(idx > 10 OR NOT idx >= 2)aa", {0, 1, 11, 12, 13}},
+            {R"aa(idx >= 10 AND idx <= 12)aa", {10, 11, 12}},
+            {R"aa(idx > 13 OR bool: false OR arr.b < 1000)aa", {}}
     };
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto index_dictionaries = GENERATE(true, false);
 
     TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
 
@@ -243,13 +498,15 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
                     std::string{cTestIdxKey},
                     false,
                     single_file_archive,
-                    structurize_arrays
+                    structurize_arrays,
+                    index_dictionaries
             )
     );
 
     for (auto const& [query, expected_results] : queries_and_results) {
         CAPTURE(query);
         REQUIRE_NOTHROW(search(query, false, expected_results));
+        REQUIRE_NOTHROW(search(query, false, expected_results, cNumPrefetchedStreams));
     }
 
     std::shared_ptr<clp_s::search::ast::Expression> expr{nullptr};
@@ -257,6 +514,160 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
     REQUIRE_NOTHROW(search(expr, false, {0}));
 }
 
+TEST_CASE("clp-s-search-pruned-by-table-statistics", "[clp-s][search]") {
+    // Each query only matches schemas whose table statistics prove that none of their records can
+    // match, so `Output::filter` prunes every table of the archive.
+    std::vector<std::string> const queries{
+            R"aa(int > 1)aa",
+            R"aa(float < 1 AND var_string: a)aa",
+            R"aa(one > 1 OR one < 1)aa"
+    };
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    get_test_input_local_path(cTestSearchInputFile),
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    for (auto const& query : queries) {
+        CAPTURE(query);
+        for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+            auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+            archive_reader->open(
+                    clp_s::Path{
+                            .source{clp_s::InputSource::Filesystem},
+                            .path{entry.path().string()}
+                    },
+                    clp_s::NetworkAuthOption{}
+            );
+
+            auto query_stream = std::istringstream{query};
+            auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
+            REQUIRE(nullptr != expr);
+            expr = clp_s::search::ast::OrOfAndForm{}.run(expr);
+            expr = clp_s::search::ast::NarrowTypes{}.run(expr);
+            expr = clp_s::search::ast::ConvertToExists{}.run(expr);
+            auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
+                    archive_reader->get_schema_tree(),
+                    archive_reader->get_schema_map()
+            );
+            expr = match_pass->run(expr);
+            REQUIRE(nullptr != expr);
+
+            size_t num_matched_schemas{0};
+            for (auto const& [schema_id, schema] : *archive_reader->get_schema_map()) {
+                if (false == match_pass->schema_matched(schema_id)) {
+                    continue;
+                }
+                ++num_matched_schemas;
+                auto const* statistics = archive_reader->get_table_statistics(schema_id);
+                REQUIRE(nullptr != statistics);
+                clp_s::search::EvaluateTableStatistics statistics_pass{*statistics};
+                REQUIRE(clp_s::EvaluatedValue::False
+                        == statistics_pass.run(match_pass->get_query_for_schema(schema_id)));
+            }
+            REQUIRE(num_matched_schemas > 0);
+            archive_reader->close();
+        }
+
+        // The archive reader must still be open after every table was pruned, since the caller
+        // closes it.
+        REQUIRE_NOTHROW(search(query, false, {}));
+    }
+}
+
+TEST_CASE("clp-s-search-pruned-by-dictionary-id-filters", "[clp-s][search]") {
+    constexpr size_t cNumRecords{400};
+    constexpr size_t cNumSchemas{8};
+    // Each schema gets 75 of these logtypes, too many to record exactly
+    constexpr size_t cNumLogtypes{300};
+    std::vector<std::pair<std::string, std::vector<int64_t>>> const queries_and_results{
+            {R"aa(var_string: "v17")aa", {17}},
+            {R"aa(var_string: "v399")aa", {399}},
+            {R"aa(var_string: "v400")aa", {}},
+            {fmt::format(R"aa(clp_string: "{} by user u17x")aa", get_test_word(17)), {17}},
+            {fmt::format(R"aa(clp_string: "{} by user u305x")aa", get_test_word(5)), {305}},
+            {fmt::format(R"aa(clp_string: "{} by user u17x")aa", get_test_word(18)), {}},
+            {fmt::format(R"aa(clp_string: "{} by user *")aa", get_test_word(5)), {5, 305}},
+            {fmt::format(
+                     R"aa(var_string: "v17" OR clp_string: "{} by user u42x")aa",
+                     get_test_word(42)
+             ),
+             {17, 42}},
+            {R"aa(k1: true AND NOT var_string: "v17" AND idx < 60)aa", {1, 9, 25, 33, 41, 49, 57}}
+    };
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestSearchDictionaryIdsFile}}
+    };
+
+    write_dictionary_ids_test_input(cNumRecords, cNumSchemas, cNumLogtypes);
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    std::string{cTestSearchDictionaryIdsFile},
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    // Check that the filters can rule out most of the tables for a variable string query, so that
+    // the searches below exercise pruning rather than scanning every table.
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        clp_s::ArchiveReader archive_reader;
+        archive_reader.open(
+                clp_s::Path{.source{clp_s::InputSource::Filesystem}, .path{entry.path().string()}},
+                clp_s::NetworkAuthOption{}
+        );
+        auto const var_entries{
+                archive_reader.read_variable_dictionary()->get_entry_matching_value("v17", false)
+        };
+        REQUIRE(1 == var_entries.size());
+        auto const var_id{var_entries.front()->get_id()};
+
+        size_t num_tables_without_var{0};
+        size_t num_logtype_id_filters{0};
+        for (auto const& [schema_id, schema] : *archive_reader.get_schema_map()) {
+            auto const* statistics{archive_reader.get_table_statistics(schema_id)};
+            REQUIRE(nullptr != statistics);
+            bool may_contain_var{false};
+            for (auto const& [column_id, column] : statistics->columns) {
+                if (column.var_id_filter.has_value()
+                    && column.var_id_filter->possibly_contains(var_id))
+                {
+                    may_contain_var = true;
+                }
+                if (column.logtype_id_filter.has_value()) {
+                    ++num_logtype_id_filters;
+                }
+            }
+            if (false == may_contain_var) {
+                ++num_tables_without_var;
+            }
+        }
+        REQUIRE(num_tables_without_var > 0);
+        REQUIRE(num_logtype_id_filters > 0);
+        archive_reader.close();
+    }
+
+    for (auto const& [query, expected_results] : queries_and_results) {
+        CAPTURE(query);
+        REQUIRE_NOTHROW(search(query, false, expected_results));
+        REQUIRE_NOTHROW(search(query, false, expected_results, cNumPrefetchedStreams));
+    }
+}
+
 TEST_CASE("clp-s-search-formatted-float", "[clp-s][search]") {
     std::vector<std::pair<std::string, std::vector<int64_t>>> queries_and_results{
             {R"aa(NOT formattedFloatValue: 0)aa", {0, 1, 2, 6, 7, 8, 9, 10, 11, 12}},
@@ -351,3 +762,95 @@ TEST_CASE("clp-s-search-epoch-timestamp", "[clp-s][search]") {
         REQUIRE_NOTHROW(search(query, false, expected_results));
     }
 }
+
+TEST_CASE("clp-s-search-counts", "[clp-s][search]") {
+    // Enough records for each schema table to span several blocks of messages
+    constexpr size_t cNumRecords{4000};
+    constexpr int64_t cCountByTimeBucketSize{1000};
+    // Queries evaluated on blocks of messages, queries evaluated one message at a time (on the clp
+    // string column), queries matching every message, and queries whose tables are all pruned
+    std::vector<std::string> const queries{
+            R"aa(value > 50)aa",
+            R"aa(value >= 10 AND value < 20 OR idx < 100)aa",
+            R"aa(msg: "request took 1* ms")aa",
+            R"aa(msg: "request took 7 ms" OR value: 42)aa",
+            R"aa(idx: *)aa",
+            R"aa(value > 1000)aa"
+    };
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestSearchCountsFile}}
+    };
+
+    write_counts_test_input(cNumRecords);
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    std::string{cTestSearchCountsFile},
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestTimestampKey},
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    for (auto const& query : queries) {
+        CAPTURE(query);
+        REQUIRE_NOTHROW(validate_counts(query, cCountByTimeBucketSize));
+    }
+}
+
+TEST_CASE("clp-s-search-result-queue", "[clp-s][search]") {
+    constexpr size_t cNumProducers{4};
+    constexpr size_t cNumTablesPerProducer{3};
+    constexpr size_t cNumResultsPerTable{clp_s::search::QueuedOutputHandler::cMaxBatchSize + 7};
+
+    // A capacity of one batch forces the producers to block on the consumer. Catch2's assertions
+    // aren't thread-safe, so each producer records whether it succeeded instead.
+    clp_s::search::SearchResultQueue queue{1, cNumProducers};
+    std::vector<clp_s::VectorOutputHandler::QueryResult> unused_results;
+    clp_s::VectorOutputHandler const vector_handler{unused_results};
+    std::vector<char> producer_succeeded(cNumProducers, 1);
+    std::vector<std::thread> producers;
+    for (size_t producer_idx{0}; producer_idx < cNumProducers; ++producer_idx) {
+        producers.emplace_back([&queue, &vector_handler, &producer_succeeded, producer_idx]() {
+            clp_s::search::QueuedOutputHandler output_handler{queue, vector_handler};
+            for (size_t table_idx{0}; table_idx < cNumTablesPerProducer; ++table_idx) {
+                for (size_t i{0}; i < cNumResultsPerTable; ++i) {
+                    output_handler.write("message", static_cast<int64_t>(i), "archive", 0);
+                }
+                if (clp_s::ErrorCode::ErrorCodeSuccess != output_handler.flush()) {
+                    producer_succeeded[producer_idx] = 0;
+                }
+            }
+            if (clp_s::ErrorCode::ErrorCodeSuccess != output_handler.finish()) {
+                producer_succeeded[producer_idx] = 0;
+            }
+            queue.close_producer();
+        });
+    }
+
+    size_t num_results{0};
+    size_t num_tables{0};
+    while (auto batch{queue.pop()}) {
+        REQUIRE(batch->has_metadata);
+        REQUIRE(batch->results.size() <= clp_s::search::QueuedOutputHandler::cMaxBatchSize);
+        num_results += batch->results.size();
+        if (batch->ends_table) {
+            ++num_tables;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    REQUIRE(std::ranges::all_of(producer_succeeded, [](char succeeded) { return 0 != succeeded; }));
+    REQUIRE(cNumProducers * cNumTablesPerProducer * cNumResultsPerTable == num_results);
+    REQUIRE(cNumProducers * cNumTablesPerProducer == num_tables);
+    REQUIRE(false == queue.is_aborted());
+
+    queue.abort();
+    REQUIRE(false == queue.push({}));
+    REQUIRE(false == queue.pop().has_value());
+}
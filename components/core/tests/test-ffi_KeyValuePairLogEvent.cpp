@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -16,6 +17,7 @@
 
 #include "../src/clp/ffi/encoding_methods.hpp"
 #include "../src/clp/ffi/KeyValuePairLogEvent.hpp"
+#include "../src/clp/ffi/NodeIdValuePairs.hpp"
 #include "../src/clp/ffi/SchemaTree.hpp"
 #include "../src/clp/ffi/Value.hpp"
 #include "../src/clp/ir/EncodedTextAst.hpp"
@@ -23,6 +25,7 @@
 #include "../src/clp/time_types.hpp"
 
 using clp::ffi::KeyValuePairLogEvent;
+using clp::ffi::NodeIdValuePairs;
 using clp::ffi::SchemaTree;
 using clp::ffi::Value;
 using clp::ffi::value_bool_t;
@@ -288,6 +291,48 @@ TEST_CASE("ffi_Value_basic", "[ffi][Value]") {
     );
 }
 
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST_CASE("ffi_NodeIdValuePairs", "[ffi][NodeIdValuePairs]") {
+    NodeIdValuePairs node_id_value_pairs;
+    REQUIRE(node_id_value_pairs.empty());
+
+    // Insert out of order, including a duplicate node ID
+    REQUIRE(node_id_value_pairs.emplace(3, Value{static_cast<value_int_t>(3)}).second);
+    REQUIRE(node_id_value_pairs.emplace(7, Value{}).second);
+    REQUIRE(node_id_value_pairs.emplace(1, std::nullopt).second);
+    REQUIRE(node_id_value_pairs.emplace(5, Value{string{"5"}}).second);
+    auto const [duplicate_it, inserted]{node_id_value_pairs.emplace(3, Value{false})};
+    REQUIRE_FALSE(inserted);
+    REQUIRE((3 == duplicate_it->second.value().get_immutable_view<value_int_t>()));
+    REQUIRE((4 == node_id_value_pairs.size()));
+
+    // Pairs are iterated in increasing node ID order
+    vector<SchemaTree::Node::id_t> node_ids;
+    for (auto const& [node_id, value] : node_id_value_pairs) {
+        node_ids.push_back(node_id);
+    }
+    REQUIRE((vector<SchemaTree::Node::id_t>{1, 3, 5, 7} == node_ids));
+
+    REQUIRE(node_id_value_pairs.contains(5));
+    REQUIRE_FALSE(node_id_value_pairs.contains(4));
+    REQUIRE_FALSE(node_id_value_pairs.contains(8));
+    REQUIRE((node_id_value_pairs.end() == node_id_value_pairs.find(0)));
+    REQUIRE_FALSE(node_id_value_pairs.at(1).has_value());
+    REQUIRE(node_id_value_pairs.at(7).value().is_null());
+    REQUIRE_THROWS_AS(node_id_value_pairs.at(2), std::out_of_range);
+
+    NodeIdValuePairs const initialized_node_id_value_pairs{
+            {2, Value{true}},
+            {0, std::nullopt},
+            {2, Value{false}}
+    };
+    REQUIRE((2 == initialized_node_id_value_pairs.size()));
+    REQUIRE(initialized_node_id_value_pairs.at(2).value().get_immutable_view<value_bool_t>());
+
+    node_id_value_pairs.clear();
+    REQUIRE(node_id_value_pairs.empty());
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEST_CASE("ffi_KeyValuePairLogEvent_create", "[ffi]") {
     /*
@@ -1,8 +1,10 @@
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -21,6 +23,8 @@
 #include "../src/clp/BufferReader.hpp"
 #include "../src/clp/ErrorCode.hpp"
 #include "../src/clp/ffi/encoding_methods.hpp"
+#include "../src/clp/ffi/ir_stream/CompressedSerializer.hpp"
+#include "../src/clp/ffi/ir_stream/ContiguousIrBuffer.hpp"
 #include "../src/clp/ffi/ir_stream/decoding_methods.hpp"
 #include "../src/clp/ffi/ir_stream/Deserializer.hpp"
 #include "../src/clp/ffi/ir_stream/encoding_methods.hpp"
@@ -33,7 +37,9 @@
 #include "../src/clp/ffi/SchemaTree.hpp"
 #include "../src/clp/ir/LogEventDeserializer.hpp"
 #include "../src/clp/ir/types.hpp"
+#include "../src/clp/streaming_compression/zstd/Decompressor.hpp"
 #include "../src/clp/time_types.hpp"
+#include "../src/clp/WriterInterface.hpp"
 
 using clp::BufferReader;
 using clp::enum_to_underlying_type;
@@ -42,6 +48,8 @@ using clp::ffi::decode_integer_var;
 using clp::ffi::decode_message;
 using clp::ffi::encode_float_string;
 using clp::ffi::encode_integer_string;
+using clp::ffi::ir_stream::CompressedSerializer;
+using clp::ffi::ir_stream::ContiguousIrBuffer;
 using clp::ffi::ir_stream::cProtocol::EightByteEncodingMagicNumber;
 using clp::ffi::ir_stream::cProtocol::FourByteEncodingMagicNumber;
 using clp::ffi::ir_stream::cProtocol::MagicNumberLength;
@@ -165,6 +173,41 @@ private:
     bool m_is_complete{false};
 };
 
+/**
+ * Writer that stores everything written to it in memory, for testing purposes.
+ */
+class MemoryWriter : public clp::WriterInterface {
+public:
+    // Methods implementing `clp::WriterInterface`
+    auto write(char const* data, size_t data_length) -> void override {
+        m_buf.insert(m_buf.cend(), data, data + data_length);
+    }
+
+    auto flush() -> void override { ++m_num_flushes; }
+
+    auto try_seek_from_begin([[maybe_unused]] size_t pos) -> clp::ErrorCode override {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    auto try_seek_from_current([[maybe_unused]] off_t offset) -> clp::ErrorCode override {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    auto try_get_pos(size_t& pos) const -> clp::ErrorCode override {
+        pos = m_buf.size();
+        return clp::ErrorCode_Success;
+    }
+
+    // Methods
+    [[nodiscard]] auto get_buf() const -> vector<char> const& { return m_buf; }
+
+    [[nodiscard]] auto get_num_flushes() const -> size_t { return m_num_flushes; }
+
+private:
+    vector<char> m_buf;
+    size_t m_num_flushes{0};
+};
+
 /**
  * Serializes the given log events into an IR buffer.
  * @tparam encoded_variable_t Type of the encoded variables.
@@ -1359,6 +1402,220 @@ TEMPLATE_TEST_CASE(
     REQUIRE((eof_result.has_error() && std::errc::operation_not_permitted == eof_result.error()));
 }
 
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_kv_pair_log_events_contiguous_buffer",
+        "[clp][ffi][ir_stream]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    // Use a buffer smaller than most IR units so that they straddle the buffered bytes and the
+    // buffer has to grow
+    constexpr size_t cBufferCapacity{16};
+    constexpr size_t cNumLogEvents{16};
+    constexpr string_view cClpString{"uid=0, CPU usage: 99.99%, \"user_name\"=YScope"};
+
+    vector<int8_t> ir_buf;
+    auto result{Serializer<TestType>::create()};
+    REQUIRE((false == result.has_error()));
+    auto& serializer{result.value()};
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    auto const preamble_size{ir_buf.size()};
+
+    vector<nlohmann::json> expected_user_gen_json_objs;
+    auto const empty_obj = nlohmann::json::parse("{}");
+    for (size_t i{0}; i < cNumLogEvents; ++i) {
+        nlohmann::json const user_gen_json_obj
+                = {{"idx", i},
+                   {"float", 1.01 * static_cast<double>(i)},
+                   {"string", string(i, 'a')},
+                   {"clp_string", cClpString},
+                   {"obj_" + std::to_string(i % 4), {{"null", nullptr}, {"bool", 0 == i % 2}}}};
+        REQUIRE(unpack_and_serialize_msgpack_bytes(
+                nlohmann::json::to_msgpack(empty_obj),
+                nlohmann::json::to_msgpack(user_gen_json_obj),
+                serializer
+        ));
+        expected_user_gen_json_objs.emplace_back(user_gen_json_obj);
+    }
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+
+    SECTION("Complete stream") {
+        BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+        auto deserializer_result{Deserializer<IrUnitHandler>::create(reader, IrUnitHandler{})};
+        REQUIRE_FALSE(deserializer_result.has_error());
+        auto& deserializer = deserializer_result.value();
+
+        ContiguousIrBuffer ir_buffer{reader, cBufferCapacity};
+        REQUIRE((preamble_size == ir_buffer.get_pos()));
+        while (true) {
+            auto const result{ir_buffer.deserialize_next_ir_unit(deserializer)};
+            REQUIRE_FALSE(result.has_error());
+            if (result.value() == clp::ffi::ir_stream::IrUnitType::EndOfStream) {
+                break;
+            }
+        }
+        REQUIRE((ir_buf.size() == ir_buffer.get_pos()));
+        REQUIRE(deserializer.is_stream_completed());
+
+        auto const& deserialized_log_events{
+                deserializer.get_ir_unit_handler().get_deserialized_log_events()
+        };
+        REQUIRE((cNumLogEvents == deserialized_log_events.size()));
+        for (size_t idx{0}; idx < cNumLogEvents; ++idx) {
+            auto const serialized_json_result{deserialized_log_events.at(idx).serialize_to_json()};
+            REQUIRE_FALSE(serialized_json_result.has_error());
+            auto const& [actual_auto_gen_json_obj, actual_user_gen_json_obj]{
+                    serialized_json_result.value()
+            };
+            REQUIRE((empty_obj == actual_auto_gen_json_obj));
+            REQUIRE((expected_user_gen_json_objs.at(idx) == actual_user_gen_json_obj));
+        }
+    }
+
+    SECTION("Truncated stream") {
+        // Drop the end-of-stream tag and part of the last log event
+        constexpr size_t cNumBytesToDrop{4};
+        BufferReader reader{
+                size_checked_pointer_cast<char>(ir_buf.data()),
+                ir_buf.size() - cNumBytesToDrop
+        };
+        auto deserializer_result{Deserializer<IrUnitHandler>::create(reader, IrUnitHandler{})};
+        REQUIRE_FALSE(deserializer_result.has_error());
+        auto& deserializer = deserializer_result.value();
+
+        ContiguousIrBuffer ir_buffer{reader, cBufferCapacity};
+        while (true) {
+            auto const result{ir_buffer.deserialize_next_ir_unit(deserializer)};
+            if (result.has_error()) {
+                REQUIRE((std::errc::result_out_of_range == result.error()));
+                break;
+            }
+        }
+        REQUIRE_FALSE(deserializer.is_stream_completed());
+        REQUIRE((cNumLogEvents - 1
+                 == deserializer.get_ir_unit_handler().get_deserialized_log_events().size()));
+    }
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_kv_pair_log_events_compressed_batches",
+        "[clp][ffi][ir_stream]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    using MsgpackMapPair = typename Serializer<TestType>::MsgpackMapPair;
+
+    constexpr size_t cNumLogEvents{64};
+    constexpr size_t cMaxFrameSize{256};
+
+    auto const empty_obj = nlohmann::json::parse("{}");
+    vector<nlohmann::json> expected_user_gen_json_objs;
+    for (size_t i{0}; i < cNumLogEvents; ++i) {
+        expected_user_gen_json_objs.push_back(
+                {{"idx", i},
+                 {"string", "value_" + std::to_string(i)},
+                 {"key_" + std::to_string(i % 5), {{"bool", 0 == i % 2}, {"float", 0.5}}}}
+        );
+    }
+    // A log event that inserts a new key before failing to serialize, and a log event that uses
+    // the same key afterwards, to ensure cached node IDs are reverted along with the schema tree.
+    nlohmann::json const invalid_user_gen_json_obj
+            = {{"new_key", 0}, {"binary", nlohmann::json::binary({0, 1, 2})}};
+    nlohmann::json const new_key_user_gen_json_obj = {{"new_key", 1}};
+
+    // Unpack every log event, keeping the msgpack objects alive until they're serialized
+    vector<msgpack::object_handle> msgpack_obj_handles;
+    auto const unpack_as_msgpack_map = [&](nlohmann::json const& json_obj) -> msgpack::object_map {
+        auto const msgpack_bytes{nlohmann::json::to_msgpack(json_obj)};
+        msgpack_obj_handles.emplace_back(msgpack::unpack(
+                size_checked_pointer_cast<char const>(msgpack_bytes.data()),
+                msgpack_bytes.size()
+        ));
+        auto const msgpack_obj{msgpack_obj_handles.back().get()};
+        REQUIRE((msgpack::type::MAP == msgpack_obj.type));
+        return msgpack_obj.via.map;
+    };
+    auto const empty_map{unpack_as_msgpack_map(empty_obj)};
+    vector<MsgpackMapPair> msgpack_map_pairs;
+    for (auto const& user_gen_json_obj : expected_user_gen_json_objs) {
+        msgpack_map_pairs.emplace_back(empty_map, unpack_as_msgpack_map(user_gen_json_obj));
+    }
+    vector<MsgpackMapPair> const msgpack_map_pairs_with_invalid_log_event{
+            {empty_map, unpack_as_msgpack_map(new_key_user_gen_json_obj)},
+            {empty_map, unpack_as_msgpack_map(invalid_user_gen_json_obj)},
+            {empty_map, unpack_as_msgpack_map(new_key_user_gen_json_obj)}
+    };
+
+    MemoryWriter writer;
+    typename CompressedSerializer<TestType>::Config config;
+    config.max_frame_size = cMaxFrameSize;
+    // Only the size threshold should end frames
+    config.max_frame_duration = std::chrono::hours{1};
+    auto result{CompressedSerializer<TestType>::create(writer, config)};
+    REQUIRE((false == result.has_error()));
+    auto& serializer{result.value()};
+
+    auto const half_batch{std::span{msgpack_map_pairs}.first(cNumLogEvents / 2)};
+    REQUIRE((half_batch.size() == serializer.serialize_msgpack_maps(half_batch)));
+    REQUIRE((1 == serializer.serialize_msgpack_maps(msgpack_map_pairs_with_invalid_log_event)));
+    auto const other_half_batch{std::span{msgpack_map_pairs}.subspan(cNumLogEvents / 2)};
+    REQUIRE((other_half_batch.size() == serializer.serialize_msgpack_maps(other_half_batch)));
+    REQUIRE(serializer.serialize_msgpack_map(
+            empty_map,
+            unpack_as_msgpack_map(new_key_user_gen_json_obj)
+    ));
+    auto const num_frames_before_close{serializer.get_num_frames()};
+    REQUIRE((num_frames_before_close > 1));
+    serializer.close();
+    REQUIRE((num_frames_before_close + 1 == serializer.get_num_frames()));
+    REQUIRE((serializer.get_num_frames() == writer.get_num_flushes()));
+    REQUIRE_THROWS_AS(serializer.flush(), typename CompressedSerializer<TestType>::OperationFailed);
+
+    // Decompress and deserialize the stream
+    clp::streaming_compression::zstd::Decompressor decompressor;
+    decompressor.open(writer.get_buf().data(), writer.get_buf().size());
+    auto deserializer_result{Deserializer<IrUnitHandler>::create(decompressor, IrUnitHandler{})};
+    REQUIRE_FALSE(deserializer_result.has_error());
+    auto& deserializer = deserializer_result.value();
+    while (true) {
+        auto const result{deserializer.deserialize_next_ir_unit(decompressor)};
+        REQUIRE_FALSE(result.has_error());
+        if (result.value() == clp::ffi::ir_stream::IrUnitType::EndOfStream) {
+            break;
+        }
+    }
+    REQUIRE(deserializer.is_stream_completed());
+
+    vector<nlohmann::json> expected_user_gen_json_objs_in_stream{
+            expected_user_gen_json_objs.cbegin(),
+            expected_user_gen_json_objs.cbegin() + cNumLogEvents / 2
+    };
+    expected_user_gen_json_objs_in_stream.emplace_back(new_key_user_gen_json_obj);
+    expected_user_gen_json_objs_in_stream.insert(
+            expected_user_gen_json_objs_in_stream.cend(),
+            expected_user_gen_json_objs.cbegin() + cNumLogEvents / 2,
+            expected_user_gen_json_objs.cend()
+    );
+    expected_user_gen_json_objs_in_stream.emplace_back(new_key_user_gen_json_obj);
+
+    auto const& deserialized_log_events{
+            deserializer.get_ir_unit_handler().get_deserialized_log_events()
+    };
+    REQUIRE((expected_user_gen_json_objs_in_stream.size() == deserialized_log_events.size()));
+    for (size_t idx{0}; idx < deserialized_log_events.size(); ++idx) {
+        auto const serialized_json_result{deserialized_log_events.at(idx).serialize_to_json()};
+        REQUIRE_FALSE(serialized_json_result.has_error());
+        auto const& [actual_auto_gen_json_obj, actual_user_gen_json_obj]{
+                serialized_json_result.value()
+        };
+        REQUIRE((empty_obj == actual_auto_gen_json_obj));
+        REQUIRE((expected_user_gen_json_objs_in_stream.at(idx) == actual_user_gen_json_obj));
+    }
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEMPLATE_TEST_CASE(
         "ffi_ir_stream_serialize_schema_tree_node_id",
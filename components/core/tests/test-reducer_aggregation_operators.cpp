@@ -0,0 +1,287 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/reducer/AggregationOperator.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/DistinctCountAggregate.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/NumericAggregates.hpp"
+#include "../src/reducer/Operator.hpp"
+#include "../src/reducer/QuantileAggregate.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/TopKAggregate.hpp"
+
+namespace {
+using reducer::AggregationOutput;
+using reducer::DeserializedRecordGroup;
+using reducer::GroupTags;
+using reducer::KeyValueRecord;
+using reducer::KeyValueRecordIterator;
+using reducer::Operator;
+
+constexpr char cFieldKey[] = "field";
+
+/**
+ * Pushes raw records containing the given values to an operator as an inter-stage record group.
+ * @param op
+ * @param tags
+ * @param values
+ */
+void push_double_values(Operator& op, GroupTags const& tags, std::vector<double> const& values) {
+    std::vector<KeyValueRecord> records(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        records[i].add_double_value(cFieldKey, values[i]);
+    }
+    KeyValueRecordIterator record_it{records};
+    op.push_inter_stage_record_group(tags, record_it);
+}
+
+/**
+ * Pushes raw records containing the given values to an operator as an inter-stage record group.
+ * @param op
+ * @param tags
+ * @param values
+ */
+void push_string_values(
+        Operator& op,
+        GroupTags const& tags,
+        std::vector<std::string> const& values
+) {
+    std::vector<KeyValueRecord> records(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        records[i].add_string_value(cFieldKey, values[i]);
+    }
+    KeyValueRecordIterator record_it{records};
+    op.push_inter_stage_record_group(tags, record_it);
+}
+
+/**
+ * Serializes each record group output by `src` the same way search workers send results to the
+ * reducer, then pushes the deserialized record group to `dst` as an intra-stage record group.
+ * @param src
+ * @param dst
+ */
+void forward_results(Operator& src, Operator& dst) {
+    for (auto group_it = src.get_stored_result_iterator(); false == group_it->done();
+         group_it->next())
+    {
+        auto& group = group_it->get();
+        auto serialized_group = reducer::serialize(group.get_tags(), group.record_iter());
+        DeserializedRecordGroup deserialized_group{serialized_group};
+        dst.push_intra_stage_record_group(
+                deserialized_group.get_tags(),
+                deserialized_group.record_iter()
+        );
+    }
+}
+
+/**
+ * @param op
+ * @return A map from the tags of each record group output by `op` to a JSON array of its records.
+ */
+auto get_results(Operator& op) -> std::map<GroupTags, nlohmann::json> {
+    std::map<GroupTags, nlohmann::json> results;
+    for (auto group_it = op.get_stored_result_iterator(); false == group_it->done();
+         group_it->next())
+    {
+        auto& group = group_it->get();
+        auto const serialized_group = reducer::serialize(group.get_tags(), group.record_iter());
+        auto json = nlohmann::json::from_msgpack(serialized_group);
+        results.emplace(
+                group.get_tags(),
+                std::move(json[static_cast<char const*>(DeserializedRecordGroup::cRecordsKey)])
+        );
+    }
+    return results;
+}
+}  // namespace
+
+TEST_CASE("reducer_numeric_aggregation_operators", "[reducer]") {
+    GroupTags const tags_a{"a"};
+    GroupTags const tags_b{"b"};
+    reducer::NumericFieldConfig const config{cFieldKey};
+
+    SECTION("Single stage") {
+        reducer::SumOperator sum_op{config, AggregationOutput::FinalResult};
+        push_double_values(sum_op, tags_a, {1, 2, 3});
+        push_double_values(sum_op, tags_b, {10});
+        push_double_values(sum_op, tags_a, {4});
+
+        auto const results = get_results(sum_op);
+        REQUIRE(2 == results.size());
+        REQUIRE(10.0 == results.at(tags_a).at(0).at("sum").get<double>());
+        REQUIRE(10.0 == results.at(tags_b).at(0).at("sum").get<double>());
+    }
+
+    SECTION("Partial results merged across stages") {
+        reducer::MeanOperator worker_op1{config, AggregationOutput::PartialResult};
+        reducer::MeanOperator worker_op2{config, AggregationOutput::PartialResult};
+        reducer::MeanOperator reducer_op{config, AggregationOutput::FinalResult};
+        push_double_values(worker_op1, tags_a, {1, 2, 3});
+        push_double_values(worker_op2, tags_a, {4, 5});
+        push_double_values(worker_op2, tags_b, {-7});
+        forward_results(worker_op1, reducer_op);
+        forward_results(worker_op2, reducer_op);
+
+        auto const results = get_results(reducer_op);
+        REQUIRE(2 == results.size());
+        REQUIRE(3.0 == results.at(tags_a).at(0).at("mean").get<double>());
+        REQUIRE(-7.0 == results.at(tags_b).at(0).at("mean").get<double>());
+    }
+
+    SECTION("Minimum and maximum") {
+        reducer::MinOperator worker_min_op{config, AggregationOutput::PartialResult};
+        reducer::MaxOperator worker_max_op{config, AggregationOutput::PartialResult};
+        reducer::MinOperator reducer_min_op{config, AggregationOutput::FinalResult};
+        reducer::MaxOperator reducer_max_op{config, AggregationOutput::FinalResult};
+        for (auto const& values : {std::vector<double>{5, -3, 8}, std::vector<double>{2, 11}}) {
+            push_double_values(worker_min_op, tags_a, values);
+            push_double_values(worker_max_op, tags_a, values);
+            forward_results(worker_min_op, reducer_min_op);
+            forward_results(worker_max_op, reducer_max_op);
+        }
+
+        REQUIRE(-3.0 == get_results(reducer_min_op).at(tags_a).at(0).at("min").get<double>());
+        REQUIRE(11.0 == get_results(reducer_max_op).at(tags_a).at(0).at("max").get<double>());
+    }
+
+    SECTION("Filtered results") {
+        reducer::SumOperator sum_op{config, AggregationOutput::FinalResult};
+        push_double_values(sum_op, tags_a, {1});
+        push_double_values(sum_op, tags_b, {2});
+
+        size_t num_groups{0};
+        for (auto group_it = sum_op.get_stored_result_iterator({tags_b, GroupTags{"c"}});
+             false == group_it->done();
+             group_it->next())
+        {
+            REQUIRE(tags_b == group_it->get().get_tags());
+            ++num_groups;
+        }
+        REQUIRE(1 == num_groups);
+    }
+}
+
+TEST_CASE("reducer_distinct_count_aggregation_operator", "[reducer]") {
+    constexpr size_t cNumDistinctValues{20'000};
+    constexpr size_t cNumWorkers{4};
+    constexpr double cMaxRelativeError{0.05};
+    GroupTags const tags{"tag"};
+    reducer::DistinctCountAggregate::Config const config{cFieldKey};
+
+    // Each worker sees an overlapping range of values, and each value appears more than once
+    reducer::DistinctCountOperator reducer_op{config, AggregationOutput::FinalResult};
+    for (size_t worker_idx = 0; worker_idx < cNumWorkers; ++worker_idx) {
+        reducer::DistinctCountOperator worker_op{config, AggregationOutput::PartialResult};
+        std::vector<std::string> values;
+        auto const begin = worker_idx * cNumDistinctValues / (cNumWorkers + 1);
+        auto const end = begin + 2 * cNumDistinctValues / (cNumWorkers + 1);
+        for (size_t i = begin; i < end && i < cNumDistinctValues; ++i) {
+            values.emplace_back("value" + std::to_string(i));
+            values.emplace_back("value" + std::to_string(i));
+        }
+        push_string_values(worker_op, tags, values);
+        forward_results(worker_op, reducer_op);
+    }
+
+    auto const results = get_results(reducer_op);
+    auto const distinct_count = results.at(tags).at(0).at("distinct_count").get<int64_t>();
+    REQUIRE(std::abs(static_cast<double>(distinct_count) - cNumDistinctValues)
+            <= cMaxRelativeError * cNumDistinctValues);
+
+    // Small cardinalities use linear counting, which is exact when there are no collisions
+    reducer::DistinctCountOperator small_op{config, AggregationOutput::FinalResult};
+    push_string_values(small_op, tags, {"x", "y", "z", "x", "y"});
+    REQUIRE(3 == get_results(small_op).at(tags).at(0).at("distinct_count").get<int64_t>());
+}
+
+TEST_CASE("reducer_top_k_aggregation_operator", "[reducer]") {
+    GroupTags const tags{"tag"};
+    reducer::TopKAggregate::Config const config{cFieldKey, 3, 20};
+
+    // Each worker sees "frequent<i>" (50 - 5i) times, interleaved with distinct values that each
+    // appear once. The frequent values are tracked from the start, so their counts are exact.
+    reducer::TopKOperator reducer_op{config, AggregationOutput::FinalResult};
+    for (size_t worker_idx = 0; worker_idx < 2; ++worker_idx) {
+        reducer::TopKOperator worker_op{config, AggregationOutput::PartialResult};
+        std::vector<std::string> values;
+        for (size_t round = 0; round < 50; ++round) {
+            for (size_t i = 0; i < 5; ++i) {
+                if (round < 50 - i * 5) {
+                    values.emplace_back("frequent" + std::to_string(i));
+                }
+            }
+            values.emplace_back("rare" + std::to_string(worker_idx) + "_" + std::to_string(round));
+        }
+        push_string_values(worker_op, tags, values);
+        forward_results(worker_op, reducer_op);
+    }
+
+    auto const results = get_results(reducer_op);
+    auto const& records = results.at(tags);
+    REQUIRE(3 == records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        auto const& record = records.at(i);
+        REQUIRE("frequent" + std::to_string(i) == record.at("value").get<std::string>());
+        auto const count = record.at("count").get<int64_t>();
+        auto const error = record.at("error").get<int64_t>();
+        auto const true_count = static_cast<int64_t>(2 * (50 - i * 5));
+        REQUIRE(count >= true_count);
+        REQUIRE(count - error <= true_count);
+        REQUIRE(0 == error);
+    }
+}
+
+TEST_CASE("reducer_quantile_aggregation_operator", "[reducer]") {
+    constexpr int64_t cNumValues{100'000};
+    constexpr size_t cNumWorkers{4};
+    GroupTags const tags{"tag"};
+    reducer::QuantileAggregate::Config const config{cFieldKey, 100.0, {0.0, 0.5, 0.99, 1.0}};
+
+    // Distribute a shuffled permutation of [1, cNumValues] across the workers
+    reducer::QuantileOperator reducer_op{config, AggregationOutput::FinalResult};
+    std::vector<std::unique_ptr<reducer::QuantileOperator>> worker_ops;
+    for (size_t worker_idx = 0; worker_idx < cNumWorkers; ++worker_idx) {
+        worker_ops.emplace_back(std::make_unique<reducer::QuantileOperator>(
+                config,
+                AggregationOutput::PartialResult
+        ));
+    }
+    constexpr int64_t cMultiplier{7919};  // Coprime with cNumValues
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        auto const value = (i * cMultiplier) % cNumValues + 1;
+        push_double_values(
+                *worker_ops[static_cast<size_t>(i) % cNumWorkers],
+                tags,
+                {static_cast<double>(value)}
+        );
+    }
+    for (auto const& worker_op : worker_ops) {
+        forward_results(*worker_op, reducer_op);
+    }
+
+    auto const results = get_results(reducer_op);
+    auto const& records = results.at(tags);
+    REQUIRE(config.quantiles.size() == records.size());
+    std::map<double, double> values_by_quantile;
+    for (auto const& record : records) {
+        values_by_quantile.emplace(
+                record.at("quantile").get<double>(),
+                record.at("value").get<double>()
+        );
+    }
+    REQUIRE(1.0 == values_by_quantile.at(0.0));
+    REQUIRE(static_cast<double>(cNumValues) == values_by_quantile.at(1.0));
+    // The t-digest is much more accurate near the extreme quantiles
+    REQUIRE(std::abs(values_by_quantile.at(0.5) - cNumValues * 0.5) <= cNumValues * 0.01);
+    REQUIRE(std::abs(values_by_quantile.at(0.99) - cNumValues * 0.99) <= cNumValues * 0.001);
+}